@@ -65,6 +65,11 @@
 // If no argument is passed to this function, then the second option   //
 // is used.                                                            //
 //                                                                     //
+// For large multi-dimensional matrices, ::UseSparseBackend runs the   //
+// iterations on compressed copies of the matrices (indexed once,      //
+// instead of looking up each bin by its coordinates) and the          //
+// randomized unfoldings of the error calculation in parallel.         //
+//                                                                     //
 // IMPORTANT:                                                          //
 //-----------                                                          //
 // With this approach, the efficiency map must be calculated           //
@@ -92,10 +97,100 @@
 #include "TH2D.h"
 #include "TH3D.h"
 #include "TRandom3.h"
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <vector>
 
 
 ClassImp(AliCFUnfolding)
 
+//______________________________________________________________
+//
+// Compressed copy of the conditional matrix used by the sparse backend
+// (AliCFUnfolding::UseSparseBackend).
+// The measured (M) and true (T) bins present in the response matrix are
+// numbered once, the matrix is stored by rows (CSR, one row per M bin) for
+// the measured estimate and by columns (one per T bin) for the unfolded
+// spectrum, and all the spectra become plain arrays over these indices.
+// The elements of a row or a column keep the bin order of the THnSparse,
+// so that the sums are done in the same order as with the default
+// backend. The intermediate spectra are kept in double precision: the
+// results are identical for THnSparseD inputs and equal up to float
+// rounding for THnSparseF inputs (the AliCFGridSparse default), where
+// the default backend rounds them at each SetBinContent.
+//
+
+class AliCFUnfoldingSparseState {
+ public:
+  std::vector<Double_t> fPrior;         // prior for each T bin
+  std::vector<Int_t>    fPriorBins;     // filled bins of the prior in THnSparse order (T index, -1 if not in the response)
+  std::vector<Double_t> fPriorValues;   // content of these bins
+  std::vector<Double_t> fPriorTimesEff; // prior * efficiency for each T bin
+  std::vector<Double_t> fEstMeasured;   // measured estimate for each M bin
+  std::vector<Double_t> fInvResponse;   // inverse response for each element
+  std::vector<char>     fInvSet;        // element of the inverse response set at least once
+  std::vector<Double_t> fUnfolded;      // unfolded spectrum for each T bin
+  std::vector<Int_t>    fFirstFill;     // first element filling each T bin of the unfolded spectrum (-1 if none)
+};
+
+class AliCFUnfoldingSparse {
+ public:
+  AliCFUnfoldingSparse(const THnSparse* conditional, Int_t nVar);
+
+  Int_t    GetNM() const {return fNM;}
+  Int_t    GetNT() const {return fNT;}
+  Int_t    GetNElements() const {return fElemM.size();}
+  Int_t    FindM(const Int_t* coord) const {return Find(fIndexM,fNBinsM,fStrideM,coord);}
+  Int_t    FindT(const Int_t* coord) const {return Find(fIndexT,fNBinsT,fStrideT,coord);}
+  const Int_t* GetCoordM(Int_t m) const {return &fCoordM[m*fNVariables];}
+  const Int_t* GetCoordT(Int_t t) const {return &fCoordT[t*fNVariables];}
+  void     GetCoord2N(Int_t e, Int_t* coord) const;
+
+  void     GetValuesM(const THnSparse* h, std::vector<Double_t>& v) const;
+  void     GetValuesT(const THnSparse* h, std::vector<Double_t>& v) const;
+  void     SetPrior(AliCFUnfoldingSparseState& s, const THnSparse* prior) const;
+  void     SetInvResponse(AliCFUnfoldingSparseState& s, const THnSparse* invResponse) const;
+  void     SetRandomization(const THnSparse* response, const THnSparse* efficiency, const THnSparse* measured);
+  void     Randomize(TRandom3* random, std::vector<Double_t>& eff, std::vector<Double_t>& meas) const;
+
+  void     Iterate(AliCFUnfoldingSparseState& s, const std::vector<Double_t>& eff, const std::vector<Double_t>& meas) const;
+  Double_t GetConvergence(const AliCFUnfoldingSparseState& s, Int_t& nNonPositive) const;
+  void     GetUnfoldedBins(const AliCFUnfoldingSparseState& s, std::vector<Int_t>& bins) const;
+  void     UpdatePrior(AliCFUnfoldingSparseState& s, Bool_t keepBinOrder) const;
+  void     Unfold(AliCFUnfoldingSparseState& s, const std::vector<Double_t>& eff, const std::vector<Double_t>& meas, Int_t nIterations) const;
+
+ private:
+  Int_t    Find(const std::map<Long64_t,Int_t>& index, const std::vector<Int_t>& nBins, const std::vector<Long64_t>& stride, const Int_t* coord) const;
+  Int_t    Add(std::map<Long64_t,Int_t>& index, const std::vector<Long64_t>& stride, const Int_t* coord, std::vector<Int_t>& coords);
+
+  Int_t                    fNVariables;   // number of variables
+  Int_t                    fNM;           // number of M bins
+  Int_t                    fNT;           // number of T bins
+  std::vector<Int_t>       fNBinsM;       // number of bins of the M axes
+  std::vector<Int_t>       fNBinsT;       // number of bins of the T axes
+  std::vector<Long64_t>    fStrideM;      // strides of the linear M bin number
+  std::vector<Long64_t>    fStrideT;      // strides of the linear T bin number
+  std::map<Long64_t,Int_t> fIndexM;       // linear M bin number -> M index
+  std::map<Long64_t,Int_t> fIndexT;       // linear T bin number -> T index
+  std::vector<Int_t>       fCoordM;       // coordinates of the M bins
+  std::vector<Int_t>       fCoordT;       // coordinates of the T bins
+  std::vector<Int_t>       fElemM;        // M index of each element (= bin of the conditional matrix)
+  std::vector<Int_t>       fElemT;        // T index of each element
+  std::vector<Int_t>       fRowStart;     // first element of each row in fRow*
+  std::vector<Int_t>       fRowElem;      // elements by row
+  std::vector<Int_t>       fRowT;         // T index of the elements by row
+  std::vector<Double_t>    fRowCond;      // conditional probability of the elements by row
+  std::vector<Int_t>       fColStart;     // first element of each column in fCol*
+  std::vector<Int_t>       fColElem;      // elements by column
+  std::vector<Int_t>       fColM;         // M index of the elements by column
+  std::vector<Double_t>    fRandomMean;   // content of the bins to randomize (response, efficiency, measured)
+  std::vector<Double_t>    fRandomSigma;  // error of these bins
+  std::vector<Int_t>       fRandomIndex;  // T index (efficiency) or M index (measured) of these bins, -1 if unused
+  Int_t                    fNRandomResponse;   // number of response bins in fRandom*
+  Int_t                    fNRandomEfficiency; // number of efficiency bins in fRandom*
+};
+
 //______________________________________________________________
 
 AliCFUnfolding::AliCFUnfolding() :
@@ -130,7 +225,10 @@ AliCFUnfolding::AliCFUnfolding() :
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(0)
+  fRandomSeed(0),
+  fUseSparseBackend(kFALSE),
+  fNThreads(1),
+  fSparse(0x0)
 {
   //
   // default constructor
@@ -174,7 +272,10 @@ AliCFUnfolding::AliCFUnfolding(const Char_t* name, const Char_t* title, const In
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(randomSeed)
+  fRandomSeed(randomSeed),
+  fUseSparseBackend(kFALSE),
+  fNThreads(1),
+  fSparse(0x0)
 {
   //
   // named constructor
@@ -239,6 +340,7 @@ AliCFUnfolding::~AliCFUnfolding() {
   if (fRandom3)            delete fRandom3;
   if (fDeltaUnfoldedP)     delete fDeltaUnfoldedP;
   if (fDeltaUnfoldedN)     delete fDeltaUnfoldedN;
+  if (fSparse)            delete fSparse;
  
 }
 
@@ -350,6 +452,14 @@ void AliCFUnfolding::Unfold() {
   // several iterations are performed until a reasonable chi2 or convergence criterion is reached
   //
 
+  if (fUseSparseBackend && fNCalcCorrErrors == 0) {
+    if (!fUseSmoothing) {
+      UnfoldSparse();
+      return;
+    }
+    AliWarning("Smoothing is not available with the sparse backend, using the default one");
+  }
+
   Int_t iIterBayes     = 0 ;
   Double_t convergence = 0.;
 
@@ -483,8 +593,19 @@ void AliCFUnfolding::CalculateCorrelatedErrors() {
     FillDeltaUnfoldedProfile();
   }
 
+  SetCorrelatedErrors();
+
+  // now errors are calculated
+  fNCalcCorrErrors = 2;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::SetCorrelatedErrors() {
+  //
   // Get statistical errors for final unfolded spectrum
   // ie. spread of each pt bin in fDeltaUnfoldedP
+  //
   Double_t meanx2 = 0.;
   Double_t mean = 0.;
   Double_t checksigma = 0.;
@@ -499,9 +620,6 @@ void AliCFUnfolding::CalculateCorrelatedErrors() {
     //AliDebug(2,Form("filling error %e\n",sigma));
     fUnfoldedFinal->SetBinError(fCoordinatesN_M,checksigma);
   }
-
-  // now errors are calculated
-  fNCalcCorrErrors = 2;
 }
 
 //______________________________________________________________
@@ -862,3 +980,545 @@ void AliCFUnfolding::CreateFlatPrior() {
   delete [] bin;
   delete [] bins;
 }
+
+//______________________________________________________________
+
+void AliCFUnfolding::UnfoldSparse() {
+  //
+  // Same as Unfold() using the compressed matrices (see AliCFUnfoldingSparse) :
+  // the THnSparse are read once before the iterations and written once after them.
+  // After the error calculation, the prior, measured estimate and inverse response
+  // are the ones of the nominal unfolding, and not of the last randomized one.
+  //
+
+  if (!fSparse) {
+    fSparse = new AliCFUnfoldingSparse(fConditional,fNVariables);
+    fSparse->SetRandomization(fResponseOrig,fEfficiencyOrig,fMeasuredOrig);
+    AliInfo(Form("Sparse backend : %d measured bins, %d true bins, %d matrix elements",fSparse->GetNM(),fSparse->GetNT(),fSparse->GetNElements()));
+  }
+
+  AliCFUnfoldingSparseState state;
+  fSparse->SetPrior(state,fPrior);
+  fSparse->SetInvResponse(state,fInverseResponse);
+  std::vector<Double_t> eff, meas;
+  fSparse->GetValuesT(fEfficiency,eff);
+  fSparse->GetValuesM(fMeasured,meas);
+
+  Int_t iIterBayes     = 0 ;
+  Double_t convergence = 0.;
+  Bool_t priorUpdated  = kFALSE;
+
+  for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) { // bayes iterations
+
+    fSparse->Iterate(state,eff,meas);
+
+    Int_t nNonPositive = 0;
+    convergence = fSparse->GetConvergence(state,nNonPositive);
+    if (nNonPositive>0) AliWarning(Form("%d bins with priorValue <= 0. Adding 0 to convergence criterion.",nNonPositive));
+    AliDebug(0,Form("convergence at iteration %d is %e",iIterBayes,convergence));
+
+    if (fMaxConvergence>0. && convergence<fMaxConvergence) {
+      fNRandomIterations = iIterBayes;
+      AliDebug(0,Form("convergence is met at iteration %d",iIterBayes));
+      break;
+    }
+
+    // update the prior distribution
+    fSparse->UpdatePrior(state,kTRUE);
+    priorUpdated = kTRUE;
+  } // end bayes iteration
+
+  //
+  // copy the results to the THnSparse
+  //
+  fMeasuredEstimate->Reset();
+  for (Int_t m=0; m<fSparse->GetNM(); m++) {
+    if (!(state.fEstMeasured[m]>0.)) continue;
+    fMeasuredEstimate->SetBinContent(fSparse->GetCoordM(m),state.fEstMeasured[m]);
+    fMeasuredEstimate->SetBinError  (fSparse->GetCoordM(m),0.);
+  }
+
+  for (Int_t e=0; e<fSparse->GetNElements(); e++) {
+    if (!state.fInvSet[e]) continue;
+    fSparse->GetCoord2N(e,fCoordinates2N);
+    fInverseResponse->SetBinContent(fCoordinates2N,state.fInvResponse[e]);
+    fInverseResponse->SetBinError  (fCoordinates2N,0.);
+  }
+
+  std::vector<Int_t> unfoldedBins;
+  fSparse->GetUnfoldedBins(state,unfoldedBins);
+  fUnfolded->Reset();
+  for (UInt_t i=0; i<unfoldedBins.size(); i++) {
+    const Int_t t = unfoldedBins[i];
+    fUnfolded->SetBinError  (fSparse->GetCoordT(t),0.);
+    fUnfolded->SetBinContent(fSparse->GetCoordT(t),state.fUnfolded[t]);
+  }
+
+  if (priorUpdated) {
+    if (fPrior) delete fPrior ;
+    fPrior = (THnSparse*)fUnfolded->Clone() ;
+    fPrior->SetTitle("Prior");
+    fPrior->Reset();
+    for (UInt_t i=0; i<state.fPriorBins.size(); i++) {
+      const Int_t t = state.fPriorBins[i];
+      fPrior->SetBinError  (fSparse->GetCoordT(t),0.);
+      fPrior->SetBinContent(fSparse->GetCoordT(t),state.fPriorValues[i]);
+    }
+  }
+
+  fUnfoldedFinal = (THnSparse*) fUnfolded->Clone() ;
+
+  AliInfo("\n================================================\nFinished bayes iteration, now calculating errors...\n================================================\n");
+  fNCalcCorrErrors = 1;
+  CalculateCorrelatedErrorsSparse(state);
+
+  AliInfo(Form("\n\n=======================\nFinished at iteration %d : convergence is %e and you required it to be < %e\n=======================\n\n",iIterBayes,convergence,fMaxConvergence));
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::CalculateCorrelatedErrorsSparse(const AliCFUnfoldingSparseState &nominal) {
+  //
+  // Same as CalculateCorrelatedErrors() using the compressed matrices,
+  // the randomized unfoldings being run in parallel on fNThreads threads.
+  // The randomized distributions are drawn from fRandom3 in the same sequence as
+  // with the default backend. As there, the randomized response matrix does not
+  // enter the unfolding (the conditional matrix is calculated only once).
+  // Each randomized unfolding starts from the original prior and the inverse response
+  // of the nominal unfolding; the delta profile is filled in the order of the unfoldings.
+  //
+
+  Int_t nThreads = fNThreads>0 ? fNThreads : (Int_t)std::thread::hardware_concurrency();
+  if (nThreads<1) nThreads = 1;
+
+  AliCFUnfoldingSparseState start;
+  fSparse->SetPrior(start,fPriorOrig);
+  start.fInvResponse = nominal.fInvResponse;
+  start.fInvSet      = nominal.fInvSet;
+
+  // bins of the final unfolded spectrum and their delta profile
+  const Long_t nFinal = fUnfoldedFinal->GetNbins();
+  std::vector<Int_t>    finalBins(nFinal);
+  std::vector<Double_t> finalValues(nFinal), means(nFinal), meansx2(nFinal), entries(nFinal);
+  for (Long_t iBin=0; iBin<nFinal; iBin++) {
+    finalValues[iBin] = fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_T);
+    finalBins[iBin]   = fSparse->FindT(fCoordinatesN_T);
+    means[iBin]       = fDeltaUnfoldedP->GetBinContent(fCoordinatesN_T);
+    meansx2[iBin]     = fDeltaUnfoldedP->GetBinError(fCoordinatesN_T);
+    entries[iBin]     = fDeltaUnfoldedN->GetBinContent(fCoordinatesN_T);
+  }
+
+  std::vector<AliCFUnfoldingSparseState> toys(nThreads);
+  std::vector<std::vector<Double_t> > eff(nThreads), meas(nThreads);
+
+  for (Int_t first=0; first<fNRandomIterations; first+=nThreads) {
+    const Int_t n = TMath::Min(nThreads,fNRandomIterations-first);
+
+    // draw the randomized distributions sequentially, then unfold them in parallel
+    for (Int_t i=0; i<n; i++) {
+      fSparse->Randomize(fRandom3,eff[i],meas[i]);
+      toys[i] = start;
+    }
+    std::vector<std::thread> threads;
+    for (Int_t i=1; i<n; i++) {
+      threads.push_back(std::thread([this,&toys,&eff,&meas,i]() {
+	    fSparse->Unfold(toys[i],eff[i],meas[i],fMaxNumIterations);
+	  }));
+    }
+    fSparse->Unfold(toys[0],eff[0],meas[0],fMaxNumIterations);
+    for (UInt_t i=0; i<threads.size(); i++) threads[i].join();
+
+    // same as FillDeltaUnfoldedProfile()
+    for (Int_t i=0; i<n; i++) {
+      for (Long_t iBin=0; iBin<nFinal; iBin++) {
+	Double_t deltaInBin = finalValues[iBin] - (finalBins[iBin]>=0 ? toys[i].fUnfolded[finalBins[iBin]] : 0.);
+
+	Double_t mean_nplus1 = means[iBin] ;
+	mean_nplus1 *= entries[iBin] ;
+	mean_nplus1 += deltaInBin ;
+	mean_nplus1 /= (entries[iBin]+1) ;
+
+	Double_t meanx2_nplus1 = meansx2[iBin] ;
+	meanx2_nplus1 *= entries[iBin] ;
+	meanx2_nplus1 += (deltaInBin*deltaInBin) ;
+	meanx2_nplus1 /= (entries[iBin]+1) ;
+
+	means[iBin]   = mean_nplus1;
+	meansx2[iBin] = meanx2_nplus1;
+	entries[iBin] += 1;
+      }
+    }
+  }
+
+  for (Long_t iBin=0; iBin<nFinal; iBin++) {
+    fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_T);
+    fDeltaUnfoldedP->SetBinError  (fCoordinatesN_T,meansx2[iBin]) ;
+    fDeltaUnfoldedP->SetBinContent(fCoordinatesN_T,means[iBin]) ;
+    fDeltaUnfoldedN->SetBinContent(fCoordinatesN_T,entries[iBin]);
+  }
+
+  SetCorrelatedErrors();
+
+  // now errors are calculated
+  fNCalcCorrErrors = 2;
+}
+
+//______________________________________________________________
+
+AliCFUnfoldingSparse::AliCFUnfoldingSparse(const THnSparse* conditional, Int_t nVar) :
+  fNVariables(nVar),
+  fNM(0),
+  fNT(0),
+  fNBinsM(nVar),
+  fNBinsT(nVar),
+  fStrideM(nVar),
+  fStrideT(nVar),
+  fIndexM(),
+  fIndexT(),
+  fCoordM(),
+  fCoordT(),
+  fElemM(),
+  fElemT(),
+  fRowStart(),
+  fRowElem(),
+  fRowT(),
+  fRowCond(),
+  fColStart(),
+  fColElem(),
+  fColM(),
+  fRandomMean(),
+  fRandomSigma(),
+  fRandomIndex(),
+  fNRandomResponse(0),
+  fNRandomEfficiency(0)
+{
+  //
+  // numbers the M and T bins of the conditional matrix (dimensions 0 -> N-1 and N -> 2N-1)
+  // and stores it by rows and by columns
+  //
+
+  Long64_t strideM = 1;
+  Long64_t strideT = 1;
+  for (Int_t iVar=0; iVar<nVar; iVar++) {
+    fNBinsM[iVar]  = conditional->GetAxis(iVar)->GetNbins();
+    fNBinsT[iVar]  = conditional->GetAxis(nVar+iVar)->GetNbins();
+    fStrideM[iVar] = strideM;
+    fStrideT[iVar] = strideT;
+    strideM *= fNBinsM[iVar]+2;
+    strideT *= fNBinsT[iVar]+2;
+  }
+
+  const Int_t nElem = conditional->GetNbins();
+  std::vector<Int_t>    coord(2*nVar);
+  std::vector<Double_t> cond(nElem);
+  fElemM.resize(nElem);
+  fElemT.resize(nElem);
+  for (Int_t e=0; e<nElem; e++) {
+    cond[e]   = conditional->GetBinContent(e,&coord[0]);
+    fElemM[e] = Add(fIndexM,fStrideM,&coord[0],fCoordM);
+    fElemT[e] = Add(fIndexT,fStrideT,&coord[nVar],fCoordT);
+  }
+  fNM = fIndexM.size();
+  fNT = fIndexT.size();
+
+  //
+  // rows and columns, the elements keep the bin order within each of them
+  //
+  fRowStart.assign(fNM+1,0);
+  fColStart.assign(fNT+1,0);
+  for (Int_t e=0; e<nElem; e++) {
+    fRowStart[fElemM[e]+1]++;
+    fColStart[fElemT[e]+1]++;
+  }
+  for (Int_t m=0; m<fNM; m++) fRowStart[m+1] += fRowStart[m];
+  for (Int_t t=0; t<fNT; t++) fColStart[t+1] += fColStart[t];
+
+  fRowElem.resize(nElem);
+  fRowT   .resize(nElem);
+  fRowCond.resize(nElem);
+  fColElem.resize(nElem);
+  fColM   .resize(nElem);
+  std::vector<Int_t> nextRow(fRowStart.begin(),fRowStart.end()-1);
+  std::vector<Int_t> nextCol(fColStart.begin(),fColStart.end()-1);
+  for (Int_t e=0; e<nElem; e++) {
+    Int_t k = nextRow[fElemM[e]]++;
+    fRowElem[k] = e;
+    fRowT[k]    = fElemT[e];
+    fRowCond[k] = cond[e];
+    k = nextCol[fElemT[e]]++;
+    fColElem[k] = e;
+    fColM[k]    = fElemM[e];
+  }
+}
+
+//______________________________________________________________
+
+Int_t AliCFUnfoldingSparse::Add(std::map<Long64_t,Int_t>& index, const std::vector<Long64_t>& stride, const Int_t* coord, std::vector<Int_t>& coords) {
+  //
+  // returns the index of the bin with coordinates coord, numbering it if it is new
+  //
+  Long64_t key = 0;
+  for (Int_t iVar=0; iVar<fNVariables; iVar++) key += coord[iVar]*stride[iVar];
+
+  std::map<Long64_t,Int_t>::const_iterator it = index.find(key);
+  if (it != index.end()) return it->second;
+
+  const Int_t n = index.size();
+  index[key] = n;
+  coords.insert(coords.end(),coord,coord+fNVariables);
+  return n;
+}
+
+//______________________________________________________________
+
+Int_t AliCFUnfoldingSparse::Find(const std::map<Long64_t,Int_t>& index, const std::vector<Int_t>& nBins, const std::vector<Long64_t>& stride, const Int_t* coord) const {
+  //
+  // returns the index of the bin with coordinates coord, -1 if it is not in the response matrix
+  //
+  Long64_t key = 0;
+  for (Int_t iVar=0; iVar<fNVariables; iVar++) {
+    if (coord[iVar]<0 || coord[iVar]>nBins[iVar]+1) return -1;
+    key += coord[iVar]*stride[iVar];
+  }
+
+  std::map<Long64_t,Int_t>::const_iterator it = index.find(key);
+  return it != index.end() ? it->second : -1;
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingSparse::GetCoord2N(Int_t e, Int_t* coord) const {
+  //
+  // coordinates in (measured,true) space of the element e
+  //
+  const Int_t* coordM = GetCoordM(fElemM[e]);
+  const Int_t* coordT = GetCoordT(fElemT[e]);
+  for (Int_t iVar=0; iVar<fNVariables; iVar++) {
+    coord[iVar]             = coordM[iVar];
+    coord[iVar+fNVariables] = coordT[iVar];
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingSparse::GetValuesM(const THnSparse* h, std::vector<Double_t>& v) const {
+  //
+  // content of h for each M bin
+  //
+  v.assign(fNM,0.);
+  for (Int_t m=0; m<fNM; m++) v[m] = h->GetBinContent(GetCoordM(m));
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingSparse::GetValuesT(const THnSparse* h, std::vector<Double_t>& v) const {
+  //
+  // content of h for each T bin
+  //
+  v.assign(fNT,0.);
+  for (Int_t t=0; t<fNT; t++) v[t] = h->GetBinContent(GetCoordT(t));
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingSparse::SetPrior(AliCFUnfoldingSparseState& s, const THnSparse* prior) const {
+  //
+  // sets the prior of s from a THnSparse
+  // the filled bins are kept in their order for the convergence criterion
+  //
+  std::vector<Int_t> coord(fNVariables);
+  s.fPrior.assign(fNT,0.);
+  s.fPriorBins.clear();
+  s.fPriorValues.clear();
+  for (Long_t iBin=0; iBin<prior->GetNbins(); iBin++) {
+    Double_t value = prior->GetBinContent(iBin,&coord[0]);
+    Int_t t = FindT(&coord[0]);
+    if (t>=0) s.fPrior[t] = value;
+    s.fPriorBins.push_back(t);
+    s.fPriorValues.push_back(value);
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingSparse::SetInvResponse(AliCFUnfoldingSparseState& s, const THnSparse* invResponse) const {
+  //
+  // sets the inverse response of s from a THnSparse
+  //
+  const Int_t nElem = GetNElements();
+  std::vector<Int_t> coord(2*fNVariables);
+  s.fInvResponse.assign(nElem,0.);
+  s.fInvSet.assign(nElem,0);
+  for (Int_t e=0; e<nElem; e++) {
+    GetCoord2N(e,&coord[0]);
+    s.fInvResponse[e] = invResponse->GetBinContent(&coord[0]);
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingSparse::SetRandomization(const THnSparse* response, const THnSparse* efficiency, const THnSparse* measured) {
+  //
+  // stores the bins randomized by AliCFUnfolding::CreateRandomizedDist(), in the same order
+  //
+  std::vector<Int_t> coord(fNVariables);
+  fRandomMean.clear();
+  fRandomSigma.clear();
+  fRandomIndex.clear();
+
+  for (Long_t iBin=0; iBin<response->GetNbins(); iBin++) {
+    fRandomMean .push_back(response->GetBinContent(iBin));
+    fRandomSigma.push_back(response->GetBinError(iBin));
+    fRandomIndex.push_back(-1);
+  }
+  fNRandomResponse = fRandomMean.size();
+
+  for (Long_t iBin=0; iBin<efficiency->GetNbins(); iBin++) {
+    fRandomMean .push_back(efficiency->GetBinContent(iBin,&coord[0]));
+    fRandomSigma.push_back(efficiency->GetBinError(iBin));
+    fRandomIndex.push_back(FindT(&coord[0]));
+  }
+  fNRandomEfficiency = fRandomMean.size() - fNRandomResponse;
+
+  for (Long_t iBin=0; iBin<measured->GetNbins(); iBin++) {
+    fRandomMean .push_back(measured->GetBinContent(iBin,&coord[0]));
+    fRandomSigma.push_back(measured->GetBinError(iBin));
+    fRandomIndex.push_back(FindM(&coord[0]));
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingSparse::Randomize(TRandom3* random, std::vector<Double_t>& eff, std::vector<Double_t>& meas) const {
+  //
+  // randomized efficiency and measured spectrum, see AliCFUnfolding::CreateRandomizedDist()
+  // the response bins are drawn as well, to keep the same random sequence
+  //
+  eff .assign(fNT,0.);
+  meas.assign(fNM,0.);
+  const Int_t n = fRandomMean.size();
+  for (Int_t i=0; i<n; i++) {
+    Double_t ran = random->Gaus(fRandomMean[i],fRandomSigma[i]);
+    if (fRandomIndex[i]<0) continue;
+    if (i<fNRandomResponse+fNRandomEfficiency) eff[fRandomIndex[i]] = ran;
+    else                                       meas[fRandomIndex[i]] = ran;
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingSparse::Iterate(AliCFUnfoldingSparseState& s, const std::vector<Double_t>& eff, const std::vector<Double_t>& meas) const {
+  //
+  // one bayes iteration, see AliCFUnfolding::CreateEstMeasured(), CreateInvResponse() and CreateUnfolded()
+  //
+  s.fPriorTimesEff.resize(fNT);
+  s.fEstMeasured  .resize(fNM);
+  s.fUnfolded     .resize(fNT);
+  s.fFirstFill    .resize(fNT);
+
+  for (Int_t t=0; t<fNT; t++) s.fPriorTimesEff[t] = s.fPrior[t] * eff[t];
+
+  //
+  // measured estimate and inverse response, row by row
+  //
+  for (Int_t m=0; m<fNM; m++) {
+    Double_t estMeasuredValue = 0.;
+    for (Int_t k=fRowStart[m]; k<fRowStart[m+1]; k++) {
+      Double_t fill = fRowCond[k] * s.fPriorTimesEff[fRowT[k]];
+      if (fill>0.) estMeasuredValue += fill;
+    }
+    s.fEstMeasured[m] = estMeasuredValue;
+
+    for (Int_t k=fRowStart[m]; k<fRowStart[m+1]; k++) {
+      Double_t fill = (estMeasuredValue>0. ? fRowCond[k] * s.fPriorTimesEff[fRowT[k]] / estMeasuredValue : 0.) ;
+      Int_t e = fRowElem[k];
+      if (fill>0. || s.fInvResponse[e]>0.) {
+	s.fInvResponse[e] = fill;
+	s.fInvSet[e] = 1;
+      }
+    }
+  }
+
+  //
+  // unfolded spectrum, column by column
+  //
+  for (Int_t t=0; t<fNT; t++) {
+    Double_t effValue  = eff[t];
+    Double_t unfolded  = 0.;
+    Int_t    firstFill = -1;
+    for (Int_t k=fColStart[t]; k<fColStart[t+1]; k++) {
+      Int_t e = fColElem[k];
+      Double_t fill = (effValue>0. ? s.fInvResponse[e] * meas[fColM[k]] / effValue : 0.) ;
+      if (fill>0.) {
+	unfolded += fill;
+	if (firstFill<0) firstFill = e;
+      }
+    }
+    s.fUnfolded[t]  = unfolded;
+    s.fFirstFill[t] = firstFill;
+  }
+}
+
+//______________________________________________________________
+
+Double_t AliCFUnfoldingSparse::GetConvergence(const AliCFUnfoldingSparseState& s, Int_t& nNonPositive) const {
+  //
+  // see AliCFUnfolding::GetConvergence(), the bins with a non-positive prior are counted in nNonPositive
+  //
+  Double_t convergence = 0.;
+  nNonPositive = 0;
+  for (UInt_t i=0; i<s.fPriorBins.size(); i++) {
+    Double_t priorValue   = s.fPriorValues[i];
+    Double_t currentValue = (s.fPriorBins[i]>=0 ? s.fUnfolded[s.fPriorBins[i]] : 0.);
+
+    if (priorValue > 0.)
+      convergence += ((priorValue-currentValue)/priorValue)*((priorValue-currentValue)/priorValue);
+    else
+      nNonPositive++;
+  }
+  return convergence;
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingSparse::GetUnfoldedBins(const AliCFUnfoldingSparseState& s, std::vector<Int_t>& bins) const {
+  //
+  // filled T bins of the unfolded spectrum, in the order in which AliCFUnfolding::CreateUnfolded() creates them
+  //
+  std::vector<std::pair<Int_t,Int_t> > fills;
+  for (Int_t t=0; t<fNT; t++) {
+    if (s.fFirstFill[t]>=0) fills.push_back(std::make_pair(s.fFirstFill[t],t));
+  }
+  std::sort(fills.begin(),fills.end());
+
+  bins.resize(fills.size());
+  for (UInt_t i=0; i<fills.size(); i++) bins[i] = fills[i].second;
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingSparse::UpdatePrior(AliCFUnfoldingSparseState& s, Bool_t keepBinOrder) const {
+  //
+  // the unfolded spectrum becomes the prior
+  // the order of the filled bins is only needed for the convergence criterion
+  //
+  s.fPrior = s.fUnfolded;
+  if (!keepBinOrder) return;
+
+  GetUnfoldedBins(s,s.fPriorBins);
+  s.fPriorValues.resize(s.fPriorBins.size());
+  for (UInt_t i=0; i<s.fPriorBins.size(); i++) s.fPriorValues[i] = s.fUnfolded[s.fPriorBins[i]];
+}
+
+//______________________________________________________________
+
+void AliCFUnfoldingSparse::Unfold(AliCFUnfoldingSparseState& s, const std::vector<Double_t>& eff, const std::vector<Double_t>& meas, Int_t nIterations) const {
+  //
+  // nIterations bayes iterations without convergence criterion, as for the randomized unfoldings
+  // only uses s and the arguments, so that several unfoldings can run in parallel
+  //
+  for (Int_t iIterBayes=0; iIterBayes<nIterations; iIterBayes++) {
+    Iterate(s,eff,meas);
+    UpdatePrior(s,kFALSE);
+  }
+}
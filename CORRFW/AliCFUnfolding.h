@@ -16,6 +16,8 @@
 
 class TF1;
 class TRandom3;
+class AliCFUnfoldingSparse;
+class AliCFUnfoldingSparseState;
 
 class AliCFUnfolding : public TNamed {
 
@@ -42,6 +44,11 @@ class AliCFUnfolding : public TNamed {
     fSmoothFunction=fcn;                                   // the option "opt" is used if "fcn" is specified
     fSmoothOption=opt;
   } 
+
+  void UseSparseBackend(Int_t nThreads=1) { // run the iterations on compressed copies of the matrices
+    fUseSparseBackend=kTRUE;                // and the randomized unfoldings on nThreads threads (0 = number of cores).
+    fNThreads=nThreads;                     // nThreads!=1 is the only std::thread use in the tree: opt in only where the
+  }                                         // job may use that many cores. Not used together with smoothing
                                                                                                 
   void Unfold();
 
@@ -112,6 +119,10 @@ class AliCFUnfolding : public TNamed {
   Short_t        fNCalcCorrErrors;   // Book-keeping to prevend infinite loop
   UInt_t         fRandomSeed;        // Random seed
 
+  /* sparse backend */
+  Bool_t         fUseSparseBackend;  // Use the compressed matrices (see UseSparseBackend)
+  Int_t          fNThreads;          // Number of threads for the randomized unfoldings (default 1, 0 = number of cores)
+  AliCFUnfoldingSparse *fSparse;     //! Compressed conditional matrix and bin indices
 
   // functions
   void     Init();                  // initialisation of the internal settings
@@ -131,8 +142,13 @@ class AliCFUnfolding : public TNamed {
   void     CreateRandomizedDist();      // Create randomized dist from measured distribution
   void     FillDeltaUnfoldedProfile();  // Fills the fDeltaUnfoldedP profile
   void     SetMaxConvergencePerDOF (Double_t val);
+  void     SetCorrelatedErrors();       // Sets the errors of the final unfolded spectrum from the delta profile
+
+  /* sparse backend */
+  void     UnfoldSparse();                                                  // Unfold() using the compressed matrices
+  void     CalculateCorrelatedErrorsSparse(const AliCFUnfoldingSparseState &nominal); // randomized unfoldings in parallel
 
-  ClassDef(AliCFUnfolding,1);
+  ClassDef(AliCFUnfolding,2);
 };
 
 #endif
@@ -0,0 +1,229 @@
+//
+// Class AliMixEventMemoryBuffer
+//
+// AliMixEventMemoryBuffer keeps a bounded ring buffer of event snapshots
+// in memory for every mixing pool (entry list of AliMixEventPool).
+// Used by AliMixInputEventHandler in memory mixing mode, so mixed
+// partners are taken from memory instead of reading them again from tree.
+//
+
+#include "AliLog.h"
+
+#include "AliMixEventMemoryBuffer.h"
+
+ClassImp(AliMixEventMemoryBuffer)
+
+//_________________________________________________________________________________________________
+AliMixEventMemoryBuffer::AliMixEventMemoryBuffer(Int_t depth, Long64_t maxBytes, EEvictionPolicy policy) : TObject(),
+   fDepth(depth > 0 ? depth : 1),
+   fMaxBytes(maxBytes),
+   fEvictionPolicy(policy),
+   fNPools(0),
+   fEvents(),
+   fEntries(),
+   fSizes(),
+   fSequence(),
+   fHead(),
+   fCount(),
+   fBytes(0),
+   fNextSequence(0),
+   fNEvicted(0)
+{
+   //
+   // Default constructor.
+   //
+   fEvents.SetOwner(kTRUE);
+}
+
+//_________________________________________________________________________________________________
+AliMixEventMemoryBuffer::~AliMixEventMemoryBuffer()
+{
+   //
+   // Destructor
+   //
+   fEvents.Delete();
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventMemoryBuffer::Print(const Option_t *) const
+{
+   //
+   // Prints usefull information
+   //
+   AliInfo(Form("depth=%d maxBytes=%lld policy=%d pools=%d bytes=%lld evicted=%lld", fDepth, fMaxBytes, fEvictionPolicy, fNPools, fBytes, fNEvicted));
+   for (Int_t i = 0; i < fNPools; i++) {
+      if (fCount[i] > 0) AliDebug(AliLog::kDebug, Form("pool[%d] %d", i, fCount[i]));
+   }
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventMemoryBuffer::Clear(Option_t *)
+{
+   //
+   // Removes all snapshots (pools are kept)
+   //
+   fEvents.Delete();
+   fEntries.Reset(-1);
+   fSizes.Reset();
+   fSequence.Reset();
+   fHead.Reset(-1);
+   fCount.Reset();
+   fBytes = 0;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventMemoryBuffer::SetDepth(Int_t depth)
+{
+   //
+   // Sets depth of every pool. Can be done only before first snapshot is added
+   //
+   if (fNPools > 0) {
+      AliError("Depth can not be changed after snapshots were added !!!");
+      return;
+   }
+   fDepth = depth > 0 ? depth : 1;
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventMemoryBuffer::ExpandPools(Int_t nPools)
+{
+   //
+   // Expands buffers to nPools pools
+   //
+   if (nPools <= fNPools) return kTRUE;
+   Int_t nSlots = nPools * fDepth;
+   fEvents.Expand(nSlots);
+   fEntries.Set(nSlots);
+   fSizes.Set(nSlots);
+   fSequence.Set(nSlots);
+   fHead.Set(nPools);
+   fCount.Set(nPools);
+   for (Int_t i = fNPools; i < nPools; i++) {
+      fHead[i] = -1;
+      fCount[i] = 0;
+   }
+   for (Int_t i = fNPools * fDepth; i < nSlots; i++) fEntries[i] = -1;
+   fNPools = nPools;
+   return kTRUE;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventMemoryBuffer::SlotIndex(Int_t idPool, Int_t i) const
+{
+   //
+   // Returns index of i-th newest snapshot (i=0 is newest) of pool in buffers
+   //
+   Int_t slot = fHead[idPool] - i;
+   if (slot < 0) slot += fDepth;
+   return idPool * fDepth + slot;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventMemoryBuffer::EvictOldest(Int_t idPool)
+{
+   //
+   // Removes oldest snapshot of pool
+   //
+   if (idPool < 0 || idPool >= fNPools || fCount[idPool] < 1) return;
+   Int_t index = SlotIndex(idPool, fCount[idPool] - 1);
+   delete fEvents.RemoveAt(index);
+   fBytes -= fSizes[index];
+   fSizes[index] = 0;
+   fEntries[index] = -1;
+   fCount[idPool]--;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventMemoryBuffer::FindOldestPool() const
+{
+   //
+   // Returns pool with oldest snapshot over all pools (-1 if buffer is empty)
+   //
+   Int_t idOldest = -1;
+   Long64_t seqOldest = 0;
+   for (Int_t i = 0; i < fNPools; i++) {
+      if (fCount[i] < 1) continue;
+      Long64_t seq = fSequence[SlotIndex(i, fCount[i] - 1)];
+      if (idOldest < 0 || seq < seqOldest) {
+         idOldest = i;
+         seqOldest = seq;
+      }
+   }
+   return idOldest;
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventMemoryBuffer::Add(Int_t idPool, TObject *snapshot, Long64_t entry, Long64_t nBytes)
+{
+   //
+   // Adds snapshot of nBytes bytes to pool (buffer takes ownership). When
+   // pool is full its oldest snapshot is replaced. When byte budget is exceeded, oldest
+   // snapshots are evicted from same pool (kEvictOldestInPool) or over all
+   // pools (kEvictOldestGlobal).
+   //
+   if (idPool < 0 || !snapshot) {
+      delete snapshot;
+      return kFALSE;
+   }
+   if (fMaxBytes > 0 && nBytes > fMaxBytes) {
+      AliDebug(AliLog::kDebug, Form("Snapshot size %lld is higher than budget %lld !!!", nBytes, fMaxBytes));
+      delete snapshot;
+      return kFALSE;
+   }
+   ExpandPools(idPool + 1);
+
+   // make space in pool
+   if (fCount[idPool] == fDepth) EvictOldest(idPool);
+
+   // make space in byte budget
+   if (fMaxBytes > 0) {
+      while (fBytes + nBytes > fMaxBytes) {
+         Int_t idEvict = idPool;
+         if (fEvictionPolicy == kEvictOldestGlobal || fCount[idPool] < 1) idEvict = FindOldestPool();
+         if (idEvict < 0) break;
+         EvictOldest(idEvict);
+         fNEvicted++;
+      }
+   }
+
+   fHead[idPool] = (fHead[idPool] + 1) % fDepth;
+   Int_t index = idPool * fDepth + fHead[idPool];
+   fEvents.AddAt(snapshot, index);
+   fEntries[index] = entry;
+   fSizes[index] = nBytes;
+   fSequence[index] = fNextSequence++;
+   fCount[idPool]++;
+   fBytes += nBytes;
+   AliDebug(AliLog::kDebug + 1, Form("pool[%d] entry %lld (%lld bytes) added, %d in pool, %lld bytes in buffer", idPool, entry, nBytes, fCount[idPool], fBytes));
+   return kTRUE;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventMemoryBuffer::GetNEvents(Int_t idPool) const
+{
+   //
+   // Returns number of snapshots in pool
+   //
+   if (idPool < 0 || idPool >= fNPools) return 0;
+   return fCount[idPool];
+}
+
+//_________________________________________________________________________________________________
+TObject *AliMixEventMemoryBuffer::GetEvent(Int_t idPool, Int_t i) const
+{
+   //
+   // Returns i-th newest snapshot of pool (i=0 is newest)
+   //
+   if (i < 0 || i >= GetNEvents(idPool)) return 0;
+   return fEvents.At(SlotIndex(idPool, i));
+}
+
+//_________________________________________________________________________________________________
+Long64_t AliMixEventMemoryBuffer::GetEntry(Int_t idPool, Int_t i) const
+{
+   //
+   // Returns entry in chain of i-th newest snapshot of pool (i=0 is newest)
+   //
+   if (i < 0 || i >= GetNEvents(idPool)) return -1;
+   return fEntries[SlotIndex(idPool, i)];
+}
@@ -0,0 +1,72 @@
+//
+// Class AliMixEventMemoryBuffer
+//
+// AliMixEventMemoryBuffer keeps a bounded ring buffer of event snapshots
+// in memory for every mixing pool (entry list of AliMixEventPool).
+// Used by AliMixInputEventHandler in memory mixing mode, so mixed
+// partners are taken from memory instead of reading them again from tree.
+//
+
+#ifndef ALIMIXEVENTMEMORYBUFFER_H
+#define ALIMIXEVENTMEMORYBUFFER_H
+
+#include <TObject.h>
+#include <TObjArray.h>
+#include <TArrayI.h>
+#include <TArrayL64.h>
+
+class AliMixEventMemoryBuffer : public TObject {
+public:
+   enum EEvictionPolicy { kEvictOldestInPool = 0, kEvictOldestGlobal = 1 };
+
+   AliMixEventMemoryBuffer(Int_t depth = 10, Long64_t maxBytes = 0, EEvictionPolicy policy = kEvictOldestInPool);
+   virtual ~AliMixEventMemoryBuffer();
+
+   virtual void Print(const Option_t *option = "") const;
+   virtual void Clear(Option_t *option = "");
+
+   Bool_t      Add(Int_t idPool, TObject *snapshot, Long64_t entry, Long64_t nBytes = 0);
+
+   Int_t       GetNEvents(Int_t idPool) const;
+   TObject    *GetEvent(Int_t idPool, Int_t i) const;
+   Long64_t    GetEntry(Int_t idPool, Int_t i) const;
+   Int_t       GetNPools() const { return fNPools; }
+   Int_t       GetDepth() const { return fDepth; }
+   Long64_t    GetMaxBytes() const { return fMaxBytes; }
+   Long64_t    GetBytes() const { return fBytes; }
+   Long64_t    GetNEvicted() const { return fNEvicted; }
+   EEvictionPolicy GetEvictionPolicy() const { return (EEvictionPolicy) fEvictionPolicy; }
+
+   void        SetDepth(Int_t depth);
+   void        SetMaxBytes(Long64_t maxBytes) { fMaxBytes = maxBytes; }
+   void        SetEvictionPolicy(EEvictionPolicy policy) { fEvictionPolicy = policy; }
+
+private:
+
+   Bool_t      ExpandPools(Int_t nPools);
+   Int_t       SlotIndex(Int_t idPool, Int_t i) const;
+   void        EvictOldest(Int_t idPool);
+   Int_t       FindOldestPool() const;
+
+   Int_t       fDepth;                 // maximum number of snapshots per pool
+   Long64_t    fMaxBytes;              // byte budget for all snapshots (0 means no limit)
+   Int_t       fEvictionPolicy;        // eviction policy (EEvictionPolicy)
+
+   Int_t       fNPools;                //! number of pools
+   TObjArray   fEvents;                //! snapshots (index idPool*fDepth+slot)
+   TArrayL64   fEntries;               //! entries in chain of snapshots
+   TArrayL64   fSizes;                 //! sizes of snapshots in bytes
+   TArrayL64   fSequence;              //! insertion sequence of snapshots
+   TArrayI     fHead;                  //! slot of newest snapshot per pool
+   TArrayI     fCount;                 //! number of snapshots per pool
+   Long64_t    fBytes;                 //! bytes used by all snapshots
+   Long64_t    fNextSequence;          //! next insertion sequence number
+   Long64_t    fNEvicted;              //! number of snapshots evicted because of byte budget
+
+   AliMixEventMemoryBuffer(const AliMixEventMemoryBuffer &obj);
+   AliMixEventMemoryBuffer &operator=(const AliMixEventMemoryBuffer &obj);
+
+   ClassDef(AliMixEventMemoryBuffer, 1)
+};
+
+#endif
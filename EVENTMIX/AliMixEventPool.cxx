@@ -23,7 +23,11 @@ AliMixEventPool::AliMixEventPool(const char *name, const char *title) : TNamed(n
    fListOfEventCuts(),
    fBinNumber(0),
    fBufferSize(0),
-   fMixNumber(0)
+   fMixNumber(0),
+   fIndexReady(kFALSE),
+   fNumCuts(0),
+   fCuts(0),
+   fStrides(0)
 {
    //
    // Default constructor.
@@ -37,7 +41,11 @@ AliMixEventPool::AliMixEventPool(const AliMixEventPool &obj) : TNamed(obj),
    fListOfEventCuts(obj.fListOfEventCuts),
    fBinNumber(obj.fBinNumber),
    fBufferSize(obj.fBufferSize),
-   fMixNumber(obj.fMixNumber)
+   fMixNumber(obj.fMixNumber),
+   fIndexReady(kFALSE),
+   fNumCuts(0),
+   fCuts(0),
+   fStrides(0)
 {
    //
    // Copy constructor
@@ -59,6 +67,7 @@ AliMixEventPool &AliMixEventPool::operator=(const AliMixEventPool &obj)
       fBinNumber = obj.fBinNumber;
       fBufferSize = obj.fBufferSize;
       fMixNumber = obj.fMixNumber;
+      DeleteIndex();
    }
    return *this;
 }
@@ -71,6 +80,7 @@ AliMixEventPool::~AliMixEventPool()
    // Destructor
    //
    AliDebug(AliLog::kDebug + 5, "<-");
+   DeleteIndex();
    AliDebug(AliLog::kDebug + 5, "->");
 }
 //_________________________________________________________________________________________________
@@ -80,6 +90,7 @@ void AliMixEventPool::AddCut(AliMixEventCutObj *cut)
    // Adds cut
    //
    if (cut && cut->IsValid()) fListOfEventCuts.Add(new AliMixEventCutObj(*cut));
+   fIndexReady = kFALSE;
 }
 //_________________________________________________________________________________________________
 void AliMixEventPool::Print(const Option_t *option) const
@@ -111,10 +122,50 @@ Int_t AliMixEventPool::Init()
    fBinNumber++;
    AliDebug(AliLog::kDebug, Form("fBinnumber = %d", fBinNumber));
    AddEntryList();
+   InitIndex();
    AliDebug(AliLog::kDebug + 5, "->");
    return 0;
 }
 
+//_________________________________________________________________________________________________
+Bool_t AliMixEventPool::InitIndex()
+{
+   //
+   // Inits flattened index of entry lists. Entry lists are created with
+   // the first cut varying fastest, so id of entry list (starting with 1)
+   // for bins b[i] (starting with 1) of cuts is
+   //    1 + sum_i (b[i] - 1) * stride[i],  stride[i] = prod_{j<i} nbins[j]
+   //
+   DeleteIndex();
+   fNumCuts = fListOfEventCuts.GetEntriesFast();
+   if (fNumCuts > 0) {
+      fCuts = new AliMixEventCutObj*[fNumCuts];
+      fStrides = new Int_t[fNumCuts];
+   }
+   Int_t stride = 1;
+   for (Int_t i = 0; i < fNumCuts; i++) {
+      fCuts[i] = (AliMixEventCutObj *) fListOfEventCuts.At(i);
+      fStrides[i] = stride;
+      stride *= fCuts[i]->GetNumberOfBins();
+   }
+   fIndexReady = kTRUE;
+   return kTRUE;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventPool::DeleteIndex()
+{
+   //
+   // Deletes flattened index
+   //
+   delete [] fCuts;
+   delete [] fStrides;
+   fCuts = 0;
+   fStrides = 0;
+   fNumCuts = 0;
+   fIndexReady = kFALSE;
+}
+
 //_________________________________________________________________________________________________
 void AliMixEventPool::CreateEntryListsRecursivly(Int_t index)
 {
@@ -174,9 +225,7 @@ Bool_t AliMixEventPool::AddEntry(Long64_t entry, AliVEvent *ev)
       return kFALSE;
    }
    Int_t idEntryList = -1;
-   TEntryList *el =  FindEntryList(ev, idEntryList);
-   if (el) {
-      el->Enter(entry);
+   if (AddEntries(1, &entry, &ev, &idEntryList) > 0) {
       AliDebug(AliLog::kDebug, Form("Entry %lld was added with idEntryList %d !!!", entry, idEntryList));
       return kTRUE;
    }
@@ -192,35 +241,88 @@ TEntryList *AliMixEventPool::FindEntryList(AliVEvent *ev, Int_t &idEntryList)
    // Find entrlist in list of entrlist
    //
    AliDebug(AliLog::kDebug + 5, "<-");
-   Int_t num = fListOfEventCuts.GetEntriesFast();
-   if (num < 1) return 0;
-   Int_t *indexes = new Int_t[num] ;
-   Int_t *lenght = new Int_t[num];
-   Int_t i = 0;
-   TObjArrayIter next(&fListOfEventCuts);
-   AliMixEventCutObj *cut;
-   while ((cut = (AliMixEventCutObj *) next())) {
-      indexes[i] = cut->GetIndex(ev);
-      if (indexes[i] < 0) {
-         AliDebug(AliLog::kDebug, Form("idEntryList %d", -1));
-         delete [] indexes;
-         delete [] lenght;
-         return 0;
-      }
-      lenght[i] = cut->GetNumberOfBins();
-      AliDebug(AliLog::kDebug + 1, Form("indexes[%d] %d", i, indexes[i]));
-      i++;
-   }
-   idEntryList = 0;
-   SearchIndexRecursive(fListOfEventCuts.GetEntries() - 1, &indexes[0], &lenght[0], idEntryList);
+   Int_t id = FindEntryListId(ev);
+   if (id < 1) return 0;
+   idEntryList = id;
    AliDebug(AliLog::kDebug, Form("idEntryList %d", idEntryList - 1));
    // index which start with 0 (idEntryList-1)
-   delete [] indexes;
-   delete [] lenght;
    AliDebug(AliLog::kDebug + 5, "->");
    return (TEntryList *) fListOfEntryList.At(idEntryList - 1);
 }
 
+//_________________________________________________________________________________________________
+Int_t AliMixEventPool::FindEntryListId(AliVEvent *ev)
+{
+   //
+   // Returns id of entry list (starting with 1) for event
+   // or -1 when event is out of range of any cut
+   //
+   Int_t id = -1;
+   FindEntryListIds(1, &ev, &id);
+   AliDebug(AliLog::kDebug, Form("idEntryList %d", id));
+   return id;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventPool::FindEntryListIds(Int_t nEvents, AliVEvent **ev, Int_t *idEntryList)
+{
+   //
+   // Finds ids of entry lists (starting with 1) for chunk of events.
+   // Cuts are evaluated one after the other for the whole chunk.
+   // Events out of range of any cut get id -1.
+   // Returns number of events with valid id
+   //
+   if (nEvents < 1 || !ev || !idEntryList) return 0;
+   Int_t iEv, bin;
+   for (iEv = 0; iEv < nEvents; iEv++) idEntryList[iEv] = -1;
+   if (!fIndexReady && !InitIndex()) return 0;
+   for (iEv = 0; iEv < nEvents; iEv++) idEntryList[iEv] = (fNumCuts > 0 && ev[iEv]) ? 1 : -1;
+   for (Int_t i = 0; i < fNumCuts; i++) {
+      for (iEv = 0; iEv < nEvents; iEv++) {
+         if (idEntryList[iEv] < 0) continue;
+         bin = fCuts[i]->GetIndex(ev[iEv]);
+         if (bin < 0) idEntryList[iEv] = -1;
+         else idEntryList[iEv] += (bin - 1) * fStrides[i];
+      }
+   }
+   Int_t nFound = 0;
+   for (iEv = 0; iEv < nEvents; iEv++) if (idEntryList[iEv] > 0) nFound++;
+   return nFound;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventPool::AddEntries(Int_t nEvents, const Long64_t *entry, AliVEvent **ev, Int_t *idEntryList)
+{
+   //
+   // Adds chunk of entries to correct entry lists. Events are classified
+   // in chunks with FindEntryListIds. When idEntryList is given, it is
+   // filled with id of entry list of every event (-1 when not added).
+   // Returns number of added entries
+   //
+   if (nEvents < 1 || !entry || !ev) return 0;
+   const Int_t kChunk = 256;
+   Int_t chunkIds[kChunk];
+   Int_t nAdded = 0, n, j;
+   Int_t *ids;
+   TEntryList *el;
+   for (Int_t iEv = 0; iEv < nEvents; iEv += kChunk) {
+      n = (nEvents - iEv < kChunk) ? nEvents - iEv : kChunk;
+      ids = idEntryList ? &idEntryList[iEv] : chunkIds;
+      FindEntryListIds(n, &ev[iEv], ids);
+      for (j = 0; j < n; j++) {
+         el = (entry[iEv + j] < 0 || ids[j] < 1) ? 0 : (TEntryList *) fListOfEntryList.At(ids[j] - 1);
+         if (!el) {
+            ids[j] = -1;
+            continue;
+         }
+         el->Enter(entry[iEv + j]);
+         nAdded++;
+      }
+   }
+   AliDebug(AliLog::kDebug, Form("%d of %d entries were added", nAdded, nEvents));
+   return nAdded;
+}
+
 //_________________________________________________________________________________________________
 void AliMixEventPool::SearchIndexRecursive(Int_t num, Int_t *i, Int_t *d, Int_t &index)
 {
@@ -36,6 +36,9 @@ public:
 
    Bool_t      AddEntry(Long64_t entry, AliVEvent *ev);
    TEntryList *FindEntryList(AliVEvent *ev, Int_t &idEntryList);
+   Int_t       FindEntryListId(AliVEvent *ev);
+   Int_t       FindEntryListIds(Int_t nEvents, AliVEvent **ev, Int_t *idEntryList);
+   Int_t       AddEntries(Int_t nEvents, const Long64_t *entry, AliVEvent **ev, Int_t *idEntryList = 0);
 
    void        AddCut(AliMixEventCutObj *cut);
 
@@ -51,6 +54,9 @@ public:
 
 private:
 
+   Bool_t      InitIndex();
+   void        DeleteIndex();
+
    TObjArray   fListOfEntryList;       // list of entry lists
    TObjArray   fListOfEventCuts;       // list of entry lists
 
@@ -58,6 +64,11 @@ private:
    Int_t       fBufferSize;            // buffer size
    Int_t       fMixNumber;             // mixing number
 
+   Bool_t      fIndexReady;            //! flattened index is initialized
+   Int_t       fNumCuts;               //! number of cuts in flattened index
+   AliMixEventCutObj **fCuts;          //! cuts in flattened index [fNumCuts]
+   Int_t      *fStrides;               //! stride of each cut in flattened index [fNumCuts]
+
    ClassDef(AliMixEventPool, 1)
 };
 
@@ -0,0 +1,120 @@
+//
+// Class AliMixEventSnapshot
+//
+// AliMixEventSnapshot is compact copy of event kept in memory by
+// AliMixInputEventHandler in memory mixing mode. Only primary vertex,
+// values of event mixing cuts and kinematics of tracks are stored.
+//
+
+#include <TObjArray.h>
+
+#include "AliVEvent.h"
+#include "AliVVertex.h"
+#include "AliVTrack.h"
+
+#include "AliMixEventCutObj.h"
+#include "AliMixEventPool.h"
+#include "AliMixEventSnapshot.h"
+
+ClassImp(AliMixEventSnapshot)
+
+//_________________________________________________________________________________________________
+AliMixEventSnapshot::AliMixEventSnapshot() : TObject(),
+   fRunNumber(0),
+   fCutValues(),
+   fPt(),
+   fEta(),
+   fPhi(),
+   fCharge(),
+   fID(),
+   fLabel()
+{
+   //
+   // Default constructor.
+   //
+   fVertex[0] = fVertex[1] = fVertex[2] = 0;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventSnapshot::Clear(Option_t *)
+{
+   //
+   // Removes all tracks and cut values
+   //
+   fRunNumber = 0;
+   fVertex[0] = fVertex[1] = fVertex[2] = 0;
+   fCutValues.Set(0);
+   fPt.Set(0);
+   fEta.Set(0);
+   fPhi.Set(0);
+   fCharge.Set(0);
+   fID.Set(0);
+   fLabel.Set(0);
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventSnapshot::Fill(AliVEvent *ev, AliMixEventPool *evPool)
+{
+   //
+   // Fills snapshot from event. Values of cuts of event pool
+   // are stored in same order as cuts are in pool.
+   //
+   Clear();
+   if (!ev) return;
+   fRunNumber = ev->GetRunNumber();
+   const AliVVertex *vtx = ev->GetPrimaryVertex();
+   if (vtx) {
+      fVertex[0] = vtx->GetX();
+      fVertex[1] = vtx->GetY();
+      fVertex[2] = vtx->GetZ();
+   }
+   if (evPool) {
+      TObjArray *cuts = evPool->GetListOfEventCuts();
+      fCutValues.Set(cuts->GetEntriesFast());
+      for (Int_t i = 0; i < cuts->GetEntriesFast(); i++) {
+         fCutValues[i] = ((AliMixEventCutObj *) cuts->At(i))->GetValue(ev);
+      }
+   }
+   Int_t nTracks = ev->GetNumberOfTracks();
+   fPt.Set(nTracks);
+   fEta.Set(nTracks);
+   fPhi.Set(nTracks);
+   fCharge.Set(nTracks);
+   fID.Set(nTracks);
+   fLabel.Set(nTracks);
+   Int_t n = 0;
+   AliVParticle *part = 0;
+   AliVTrack *track = 0;
+   for (Int_t i = 0; i < nTracks; i++) {
+      part = ev->GetTrack(i);
+      if (!part) continue;
+      track = dynamic_cast<AliVTrack *>(part);
+      fPt[n] = part->Pt();
+      fEta[n] = part->Eta();
+      fPhi[n] = part->Phi();
+      fCharge[n] = part->Charge();
+      fID[n] = track ? track->GetID() : i;
+      fLabel[n] = part->GetLabel();
+      n++;
+   }
+   if (n < nTracks) {
+      fPt.Set(n);
+      fEta.Set(n);
+      fPhi.Set(n);
+      fCharge.Set(n);
+      fID.Set(n);
+      fLabel.Set(n);
+   }
+}
+
+//_________________________________________________________________________________________________
+Long64_t AliMixEventSnapshot::GetNBytes() const
+{
+   //
+   // Returns size of snapshot in memory (object and contents of arrays)
+   //
+   Long64_t nBytes = sizeof(AliMixEventSnapshot);
+   nBytes += fCutValues.GetSize() * sizeof(Double_t);
+   nBytes += GetNumberOfTracks() * (3 * sizeof(Float_t) + sizeof(Char_t) + 2 * sizeof(Int_t));
+   return nBytes;
+}
@@ -0,0 +1,64 @@
+//
+// Class AliMixEventSnapshot
+//
+// AliMixEventSnapshot is compact copy of event kept in memory by
+// AliMixInputEventHandler in memory mixing mode. Only primary vertex,
+// values of event mixing cuts and kinematics of tracks are stored.
+//
+
+#ifndef ALIMIXEVENTSNAPSHOT_H
+#define ALIMIXEVENTSNAPSHOT_H
+
+#include <TObject.h>
+#include <TArrayC.h>
+#include <TArrayD.h>
+#include <TArrayF.h>
+#include <TArrayI.h>
+
+class AliVEvent;
+class AliMixEventPool;
+class AliMixEventSnapshot : public TObject {
+public:
+   AliMixEventSnapshot();
+   virtual ~AliMixEventSnapshot() {}
+
+   virtual void Clear(Option_t *option = "");
+
+   void        Fill(AliVEvent *ev, AliMixEventPool *evPool = 0);
+
+   Int_t       GetRunNumber() const { return fRunNumber; }
+   Double_t    GetVertexX() const { return fVertex[0]; }
+   Double_t    GetVertexY() const { return fVertex[1]; }
+   Double_t    GetVertexZ() const { return fVertex[2]; }
+   Int_t       GetNumberOfCutValues() const { return fCutValues.GetSize(); }
+   Double_t    GetCutValue(Int_t i) const { return fCutValues.At(i); }
+
+   Int_t       GetNumberOfTracks() const { return fPt.GetSize(); }
+   Float_t     GetTrackPt(Int_t i) const { return fPt.At(i); }
+   Float_t     GetTrackEta(Int_t i) const { return fEta.At(i); }
+   Float_t     GetTrackPhi(Int_t i) const { return fPhi.At(i); }
+   Short_t     GetTrackCharge(Int_t i) const { return fCharge.At(i); }
+   Int_t       GetTrackID(Int_t i) const { return fID.At(i); }
+   Int_t       GetTrackLabel(Int_t i) const { return fLabel.At(i); }
+
+   Long64_t    GetNBytes() const;
+
+private:
+
+   Int_t       fRunNumber;             // run number
+   Float_t     fVertex[3];             // primary vertex
+   TArrayD     fCutValues;             // values of event mixing cuts (same order as in pool)
+   TArrayF     fPt;                    // pt of tracks
+   TArrayF     fEta;                   // eta of tracks
+   TArrayF     fPhi;                   // phi of tracks
+   TArrayC     fCharge;                // charge of tracks
+   TArrayI     fID;                    // id of tracks
+   TArrayI     fLabel;                 // MC label of tracks
+
+   AliMixEventSnapshot(const AliMixEventSnapshot &obj);
+   AliMixEventSnapshot &operator=(const AliMixEventSnapshot &obj);
+
+   ClassDef(AliMixEventSnapshot, 1)
+};
+
+#endif
@@ -10,13 +10,17 @@
 #include <TFile.h>
 #include <TChain.h>
 #include <TChainElement.h>
+#include <TObjString.h>
 #include <TSystem.h>
+#include <TMath.h>
 
 #include "AliLog.h"
 #include "AliAnalysisManager.h"
 #include "AliInputEventHandler.h"
 
 #include "AliMixEventPool.h"
+#include "AliMixEventMemoryBuffer.h"
+#include "AliMixEventSnapshot.h"
 #include "AliMixInputEventHandler.h"
 #include "AliMixInputHandlerInfo.h"
 
@@ -37,6 +41,13 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fDoMixExtra(kTRUE),
    fDoMixIfNotEnoughEvents(kTRUE),
    fDoMixEventGetEntryAuto(kTRUE),
+   fUseMemoryBuffer(kFALSE),
+   fMemoryBufferDepth(10),
+   fMemoryBufferMaxBytes(0),
+   fMemoryBufferPolicy(0),
+   fMemoryBufferTasks(),
+   fMemoryBuffer(0),
+   fCurrentMixSnapshot(0),
    fCurrentEntry(0),
    fCurrentEntryMain(0),
    fCurrentEntryMix(0),
@@ -49,6 +60,7 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    // Default constructor.
    //
    AliDebug(AliLog::kDebug + 10, "<-");
+   fMemoryBufferTasks.SetOwner(kTRUE);
    SetMixNumber(mixNum);
    AliDebug(AliLog::kDebug + 10, "->");
 }
@@ -59,6 +71,7 @@ AliMixInputEventHandler::~AliMixInputEventHandler() {
    // Destructor
    //
    fMixTrees.Clear();
+   delete fMemoryBuffer;
 }
 
 //_____________________________________________________________________________
@@ -112,6 +125,17 @@ Bool_t AliMixInputEventHandler::Init(TTree *tree, Option_t *opt)
       ih->SetParentHandler(this);
    }
 
+   // events of mixing input handlers are not read in memory mode
+   if (fUseMemoryBuffer) {
+      AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+      AliAnalysisTaskSE *mixTask = 0;
+      TObjArrayIter next(mgr->GetTasks());
+      while ((mixTask = dynamic_cast<AliAnalysisTaskSE *>(next()))) {
+         if (IsMemoryBufferTask(mixTask->GetName())) continue;
+         AliWarning(Form("Task %s was not added via AddMemoryBufferTask(). Its UserExecMix() will not be called in memory mode !!!", mixTask->GetName()));
+      }
+   }
+
    AliDebug(AliLog::kDebug + 5, Form("->"));
    return kTRUE;
 }
@@ -192,7 +216,10 @@ Bool_t AliMixInputEventHandler::GetEntry()
    //
    AliDebug(AliLog::kDebug + 5, Form("<-"));
 
-   if (!fEventPool) {
+   if (fUseMemoryBuffer) {
+      MixMemoryBuffer();
+   }
+   else if (!fEventPool) {
       MixStd();
    }
    // if buffer size is higher then 1
@@ -297,8 +324,6 @@ Bool_t AliMixInputEventHandler::MixBuffer()
    Long64_t zeroChainEntries = fMixIntupHandlerInfoTmp->GetChain()->GetEntries() - inEvHMain->GetTree()->GetTree()->GetEntries();
    // fill entry
    Long64_t currentMainEntry = inEvHMain->GetTree()->GetTree()->GetReadEntry() + zeroChainEntries;
-   // fills entry
-   if (fEventPool && inEvHMain) fEventPool->AddEntry(currentMainEntry, inEvHMain->GetEvent());
    // start of
    AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
    // reset mix number
@@ -306,7 +331,8 @@ Bool_t AliMixInputEventHandler::MixBuffer()
    Long64_t elNum = 0;
    TEntryList *el = 0;
    Int_t idEntryList = -1;
-   if (fEventPool) el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
+   // fills entry and finds its entry list
+   el = AddMainEntry(currentMainEntry, inEvHMain->GetEvent(), idEntryList);
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       AliDebug(AliLog::kDebug + 3, Form("-> fEntryCounter == 0"));
@@ -398,7 +424,6 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    Long64_t zeroChainEntries = fMixIntupHandlerInfoTmp->GetChain()->GetEntries() - inEvHMain->GetTree()->GetTree()->GetEntries();
    // fill entry
    Long64_t currentMainEntry = inEvHMain->GetTree()->GetTree()->GetReadEntry() + zeroChainEntries;
-   if (fEventPool && inEvHMain) fEventPool->AddEntry(currentMainEntry, inEvHMain->GetEvent());
    // start of
    AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
    // reset mix number
@@ -406,7 +431,8 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    Long64_t elNum = 0;
    Int_t idEntryList = -1;
    TEntryList *el = 0;
-   if (fEventPool) el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
+   // fills entry and finds its entry list
+   el = AddMainEntry(currentMainEntry, inEvHMain->GetEvent(), idEntryList);
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       // runs UserExecMix for all tasks, if needed
@@ -495,6 +521,170 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithBuffer()
    return kFALSE;
 }
 
+//_____________________________________________________________________________
+Bool_t AliMixInputEventHandler::MixMemoryBuffer()
+{
+   //
+   // Mix with snapshots of previous events of same pool kept in memory.
+   // No mixed event is read from tree. Snapshot of current event is
+   // added to buffer after mixing.
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   AliDebug(AliLog::kDebug + 1, "Mix method");
+   // get correct handler
+   AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+   AliMultiInputEventHandler *mh = dynamic_cast<AliMultiInputEventHandler *>(mgr->GetInputEventHandler());
+   AliInputEventHandler *inEvHMain = 0;
+   if (mh) inEvHMain = dynamic_cast<AliInputEventHandler *>(mh->GetFirstInputEventHandler());
+   else inEvHMain = dynamic_cast<AliInputEventHandler *>(mgr->GetInputEventHandler());
+   if (!inEvHMain || !inEvHMain->GetEvent()) return kFALSE;
+
+   // check for PhysSelection
+   if (!IsEventCurrentSelected()) return kFALSE;
+
+   if (!fMemoryBuffer) fMemoryBuffer = new AliMixEventMemoryBuffer(fMemoryBufferDepth, fMemoryBufferMaxBytes, (AliMixEventMemoryBuffer::EEvictionPolicy) fMemoryBufferPolicy);
+
+   fCurrentMixEntry.Reset();
+   fCurrentMixSnapshot = 0;
+
+   // find out zero chain entries
+   Long64_t zeroChainEntries = fMixIntupHandlerInfoTmp->GetChain()->GetEntries() - inEvHMain->GetTree()->GetTree()->GetEntries();
+   // fill entry
+   Long64_t currentMainEntry = inEvHMain->GetTree()->GetTree()->GetReadEntry() + zeroChainEntries;
+   // start of
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
+   // reset mix number
+   fNumberMixed = 0;
+   // pool of current event (1 when no event pool is used)
+   Int_t idEntryList = 1;
+   if (fEventPool && fEventPool->GetListOfEventCuts()->GetEntries() > 0) {
+      if (!AddMainEntry(currentMainEntry, inEvHMain->GetEvent(), idEntryList)) {
+         AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (el null) +++++++++++++++++++", fEntryCounter));
+         UserExecMixAllTasks(fEntryCounter, -1, currentMainEntry, -1, 0);
+         return kTRUE;
+      }
+   }
+
+   Int_t idPool = idEntryList - 1;
+   Int_t nInPool = fMemoryBuffer->GetNEvents(idPool);
+   if (nInPool < 1 || (!fDoMixIfNotEnoughEvents && nInPool < fMixNumber)) {
+      UserExecMixAllTasks(fEntryCounter, (fDoMixIfNotEnoughEvents ? idEntryList : -1), currentMainEntry, -1, 0);
+      AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (%d) NOT ENOUGH EVENTS IN MEMORY => NEED=%d +++++++++++++++++++", fEntryCounter, nInPool, fMixNumber));
+   } else {
+      Int_t mixNum = TMath::Min(fMixNumber, nInPool);
+      Long64_t entryMixReal = 0;
+      for (Int_t counter = 0; counter < mixNum; counter++) {
+         fCurrentMixEntry.Reset();
+         entryMixReal = fMemoryBuffer->GetEntry(idPool, counter);
+         fCurrentMixSnapshot = fMemoryBuffer->GetEvent(idPool, counter);
+         fCurrentMixEntry.Enter(entryMixReal);
+         fNumberMixed++;
+         UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, entryMixReal, fNumberMixed);
+      }
+      fCurrentMixSnapshot = 0;
+   }
+
+   // keep snapshot of current event for mixing with next events
+   Long64_t nBytes = 0;
+   TObject *snapshot = MakeEventSnapshot(inEvHMain->GetEvent(), nBytes);
+   fMemoryBuffer->Add(idPool, snapshot, currentMainEntry, nBytes);
+
+   AliDebug(AliLog::kDebug + 3, Form("fEntryCounter=%lld fMixEventNumber=%d", fEntryCounter, fNumberMixed));
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
+   AliDebug(AliLog::kDebug + 5, Form("->"));
+   return kTRUE;
+}
+
+//_____________________________________________________________________________
+TEntryList *AliMixInputEventHandler::AddMainEntry(Long64_t entry, AliVEvent *ev, Int_t &idEntryList)
+{
+   //
+   // Adds entry of main event to its entry list of event pool and returns
+   // this entry list (0 if event is out of range of cuts). Event is classified
+   // once by AliMixEventPool::AddEntries, which also returns id of entry list.
+   //
+   idEntryList = -1;
+   if (!fEventPool || !ev) return 0;
+   fEventPool->AddEntries(1, &entry, &ev, &idEntryList);
+   if (idEntryList < 1) return 0;
+   return (TEntryList *) fEventPool->GetListOfEntryLists()->At(idEntryList - 1);
+}
+
+//_____________________________________________________________________________
+TObject *AliMixInputEventHandler::MakeEventSnapshot(AliVEvent *ev, Long64_t &nBytes)
+{
+   //
+   // Creates snapshot of event kept in memory buffer and sets its size in bytes.
+   // Default is AliMixEventSnapshot (vertex, values of pool cuts and tracks).
+   // Derived handlers can keep other information needed for mixing.
+   //
+   nBytes = 0;
+   if (!ev) return 0;
+   AliMixEventSnapshot *snapshot = new AliMixEventSnapshot();
+   snapshot->Fill(ev, fEventPool);
+   nBytes = snapshot->GetNBytes();
+   return snapshot;
+}
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::UseMemoryBuffer(Bool_t b, Int_t depth, Long64_t maxBytes, Int_t evictionPolicy)
+{
+   //
+   // Enables mixing with snapshots kept in memory
+   //  depth          - number of snapshots kept per pool
+   //  maxBytes       - byte budget for all snapshots (0 means no limit)
+   //  evictionPolicy - AliMixEventMemoryBuffer::kEvictOldestInPool or kEvictOldestGlobal
+   // Tasks using snapshots have to be added via AddMemoryBufferTask()
+   //
+   fUseMemoryBuffer = b;
+   fMemoryBufferDepth = depth;
+   fMemoryBufferMaxBytes = maxBytes;
+   fMemoryBufferPolicy = evictionPolicy;
+   if (fUseMemoryBuffer && fBufferSize > 1) {
+      AliWarning(Form("BufferSize(%d) > 1 is not supported with memory buffer. Mixing is done with %d events from memory", fBufferSize, fMixNumber));
+   }
+   if (fUseMemoryBuffer && fMixNumber > fMemoryBufferDepth) {
+      AliWarning(Form("fMixNumber(%d) is higher than memory buffer depth (%d)", fMixNumber, fMemoryBufferDepth));
+   }
+}
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::AddMemoryBufferTask(const char *taskName)
+{
+   //
+   // Adds task which takes mixed events via GetMixedSnapshot() (or GetMixedEvent()).
+   // In memory mode only UserExecMix() of these tasks is called, because
+   // events of mixing input handlers (InputEventHandler(i)->GetEvent())
+   // are not read from tree.
+   //
+   if (!taskName || IsMemoryBufferTask(taskName)) return;
+   fMemoryBufferTasks.Add(new TObjString(taskName));
+}
+
+//_____________________________________________________________________________
+AliMixEventSnapshot *AliMixInputEventHandler::GetMixedSnapshot() const
+{
+   //
+   // Returns snapshot of current mixed event in memory mode
+   // (should be used in UserExecMix() only)
+   //
+   return dynamic_cast<AliMixEventSnapshot *>(fCurrentMixSnapshot);
+}
+
+//_____________________________________________________________________________
+AliVEvent *AliMixInputEventHandler::GetMixedEvent(Int_t idHandler)
+{
+   //
+   // Returns current mixed event (should be used in UserExecMix() only).
+   // In memory mode it is snapshot from memory only when derived handler
+   // keeps events as snapshots (use GetMixedSnapshot() otherwise).
+   //
+   if (fUseMemoryBuffer) return dynamic_cast<AliVEvent *>(fCurrentMixSnapshot);
+   AliInputEventHandler *ih = (AliInputEventHandler *) InputEventHandler(idHandler);
+   if (!ih) return 0;
+   return ih->GetEvent();
+}
+
 //_____________________________________________________________________________
 Bool_t AliMixInputEventHandler::FinishEvent()
 {
@@ -533,6 +723,7 @@ void AliMixInputEventHandler::UserExecMixAllTasks(Long64_t entryCounter, Int_t i
       fCurrentEntryMain = entryMainReal;
       fCurrentEntryMix = entryMixReal;
       fCurrentBinIndex = idEntryList;
+      if (fUseMemoryBuffer && !IsMemoryBufferTask(mixTask->GetName())) continue;
       if (entryMixReal >= 0) mixTask->UserExecMix("");
    }
 }
@@ -605,6 +796,9 @@ Bool_t AliMixInputEventHandler::GetEntryMixedEvent(Int_t id) {
    // (Should be used in UserExecMix() only)
    //
 
+   // mixed event is already in memory
+   if (fUseMemoryBuffer) return (fCurrentMixSnapshot != 0);
+
    AliMixInputHandlerInfo *mihi = (AliMixInputHandlerInfo *) fMixTrees.At(id);
 
    Long64_t entryMix = fCurrentMixEntry.GetEntry(fCurrentMixEntry.GetN()-id-1);
@@ -11,6 +11,7 @@
 #define ALIMIXINPUTEVENTHANDLER_H
 
 #include <TObjArray.h>
+#include <TList.h>
 #include <TEntryList.h>
 #include <TArrayI.h>
 
@@ -21,6 +22,8 @@
 class TChain;
 class TChainElement;
 class AliMixEventPool;
+class AliMixEventMemoryBuffer;
+class AliMixEventSnapshot;
 class AliMixInputHandlerInfo;
 class AliInputEventHandler;
 class AliMixInputEventHandler : public AliMultiInputEventHandler {
@@ -71,6 +74,16 @@ public:
 
    void                    DoMixEventGetEntryAuto(Bool_t doAuto=kTRUE) { fDoMixEventGetEntryAuto = doAuto; }
 
+   // mixing from memory (snapshots of selected events are kept per pool in memory)
+   void                    UseMemoryBuffer(Bool_t b = kTRUE, Int_t depth = 10, Long64_t maxBytes = 0, Int_t evictionPolicy = 0);
+   void                    AddMemoryBufferTask(const char *taskName);
+   Bool_t                  IsMemoryBufferTask(const char *taskName) const { return fMemoryBufferTasks.FindObject(taskName) != 0; }
+   Bool_t                  IsUsingMemoryBuffer() const { return fUseMemoryBuffer; }
+   AliMixEventMemoryBuffer *GetMemoryBuffer() const { return fMemoryBuffer; }
+   TObject                *CurrentMixSnapshot() const { return fCurrentMixSnapshot; }
+   AliMixEventSnapshot    *GetMixedSnapshot() const;
+   AliVEvent              *GetMixedEvent(Int_t idHandler=0);
+
    Bool_t                  GetEntryMainEvent();
    Bool_t                  GetEntryMixedEvent(Int_t idHandler=0);
 protected:
@@ -89,6 +102,13 @@ private:
    Bool_t                  fDoMixExtra;            // mix extra events to get enough combinations
    Bool_t                  fDoMixIfNotEnoughEvents;// mix events if they don't have enough events to mix
    Bool_t                  fDoMixEventGetEntryAuto;// flag for preparing mixed events automatically (default on)
+   Bool_t                  fUseMemoryBuffer;       // mix with snapshots kept in memory instead of reading from tree
+   Int_t                   fMemoryBufferDepth;     // number of snapshots kept per pool
+   Long64_t                fMemoryBufferMaxBytes;  // byte budget for all snapshots (0 means no limit)
+   Int_t                   fMemoryBufferPolicy;    // eviction policy (AliMixEventMemoryBuffer::EEvictionPolicy)
+   TList                   fMemoryBufferTasks;     // names of tasks mixed with snapshots in memory mode
+   AliMixEventMemoryBuffer *fMemoryBuffer;         //! snapshots of events per pool
+   TObject                *fCurrentMixSnapshot;    //! snapshot of current mixed event
 
    // mixing info
    Long64_t fCurrentEntry;       //! current entry number (adds 1 for every event processed on each worker)
@@ -104,13 +124,16 @@ private:
    virtual Bool_t          MixBuffer();
    virtual Bool_t          MixEventsMoreTimesWithOneEvent();
    virtual Bool_t          MixEventsMoreTimesWithBuffer();
+   virtual Bool_t          MixMemoryBuffer();
+   virtual TObject        *MakeEventSnapshot(AliVEvent *ev, Long64_t &nBytes);
+   TEntryList             *AddMainEntry(Long64_t entry, AliVEvent *ev, Int_t &idEntryList);
 
    void                    UserExecMixAllTasks(Long64_t entryCounter, Int_t idEntryList, Long64_t entryMainReal, Long64_t entryMixReal, Int_t numMixed);
 
    AliMixInputEventHandler(const AliMixInputEventHandler &handler);
    AliMixInputEventHandler &operator=(const AliMixInputEventHandler &handler);
 
-   ClassDef(AliMixInputEventHandler, 5)
+   ClassDef(AliMixInputEventHandler, 7)
 };
 
 #endif
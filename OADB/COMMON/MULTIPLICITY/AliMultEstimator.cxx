@@ -20,11 +20,14 @@
 #include "TBrowser.h"
 #include "TFormula.h"
 #include "RVersion.h"
+#include <cstdlib>
+#include <cstring>
 
 ClassImp(AliMultEstimator);
 //________________________________________________________________
 AliMultEstimator::AliMultEstimator() :
   TNamed(), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0),
+fCode(), fConstants(), fNInputs(0),
 fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 {
   // Constructor
@@ -32,6 +35,7 @@ fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 }
 AliMultEstimator::AliMultEstimator(const char * name, const char * title, TString lInitDef):
 TNamed(name,title), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0),
+fCode(), fConstants(), fNInputs(0),
 fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 {
     //Named, titled, definition constructor
@@ -46,6 +50,9 @@ fValue(e.fValue),
 fMean(e.fMean),
 fPercentile(e.fPercentile),
 fFormula(0),
+fCode(e.fCode),
+fConstants(e.fConstants),
+fNInputs(e.fNInputs),
 fkUseAnchor(e.fkUseAnchor),
 fAnchorPoint(e.fAnchorPoint),
 fAnchorPercentile(e.fAnchorPercentile)
@@ -67,6 +74,9 @@ AliMultEstimator& AliMultEstimator::operator=(const AliMultEstimator& e)
     if (fFormula) delete fFormula;
     fFormula = 0;
     if (e.fFormula) fFormula = new TFormula(*e.fFormula);
+    fCode       = e.fCode;
+    fConstants  = e.fConstants;
+    fNInputs    = e.fNInputs;
     
     //Anchor point configs
     fkUseAnchor         = e.fkUseAnchor;
@@ -121,6 +131,13 @@ void AliMultEstimator::SetupFormula(const AliMultInput* lInput)
         lVarName.Prepend("(");
         expr.ReplaceAll(lVarName, repl);
     }
+    fNInputs = nVar;
+    if (fFormula) delete fFormula;
+    fFormula = 0;
+    
+    //Plain arithmetic definitions are compiled, no TFormula needed
+    if (Compile(expr)) return;
+    
     fFormula = new TFormula(Form("e%s", GetName()), expr);
 #if ROOT_VERSION_CODE < ROOT_VERSION(5,99,4)
     fFormula->Optimize();
@@ -129,12 +146,228 @@ void AliMultEstimator::SetupFormula(const AliMultInput* lInput)
 //________________________________________________________________
 Float_t AliMultEstimator::Evaluate(const AliMultInput* lInput)
 {
-    if (!fFormula) return fValue = 0;
-    for (Int_t i = 0; i < lInput->GetNVariables(); i++) {
-        AliMultVariable* v = lInput->GetVariable(i);
-        fFormula->SetParameter(i, v->IsInteger() ?
-                               v->GetValueInteger() :
-                               v->GetValue());
+    if (!fFormula && !IsCompiled()) return fValue = 0;
+    TArrayD lValues(lInput->GetNVariables());
+    lInput->FillValues(lValues.GetArray());
+    return Evaluate(lValues.GetArray());
+}
+//________________________________________________________________
+Float_t AliMultEstimator::Evaluate(const Double_t* lInputValues)
+{
+    if (!IsCompiled()) {
+        if (!fFormula) return fValue = 0;
+        for (Int_t i = 0; i < fNInputs; i++)
+            fFormula->SetParameter(i, lInputValues[i]);
+        return fValue = fFormula->Eval(0);
+    }
+    
+    //Run postfix code, all arithmetic in double as in TFormula
+    Double_t      lStack[kMaxStackDepth];
+    Int_t         lTop  = -1;
+    const Int_t*  lCode = fCode.GetArray();
+    const Int_t   lN    = fCode.GetSize();
+    for (Int_t i = 0; i < lN; i++) {
+        switch (lCode[i]) {
+            case kOpVariable: lStack[++lTop] = lInputValues[lCode[++i]]; break;
+            case kOpConstant: lStack[++lTop] = fConstants[lCode[++i]];   break;
+            case kOpNegate:   lStack[lTop] = -lStack[lTop];              break;
+            case kOpNot:      lStack[lTop] = !lStack[lTop];              break;
+            case kOpMultiply: lTop--; lStack[lTop] *= lStack[lTop+1];    break;
+            case kOpDivide:
+                lTop--;
+#if ROOT_VERSION_CODE < ROOT_VERSION(5,99,4)
+                //TFormula of ROOT 5 returns zero for a division by zero
+                if (lStack[lTop+1] == 0) { lStack[lTop] = 0; break; }
+#endif
+                lStack[lTop] /= lStack[lTop+1];
+                break;
+            case kOpAdd:      lTop--; lStack[lTop] += lStack[lTop+1];    break;
+            case kOpSubtract: lTop--; lStack[lTop] -= lStack[lTop+1];    break;
+            case kOpLess:         lTop--; lStack[lTop] = lStack[lTop] <  lStack[lTop+1]; break;
+            case kOpGreater:      lTop--; lStack[lTop] = lStack[lTop] >  lStack[lTop+1]; break;
+            case kOpLessEqual:    lTop--; lStack[lTop] = lStack[lTop] <= lStack[lTop+1]; break;
+            case kOpGreaterEqual: lTop--; lStack[lTop] = lStack[lTop] >= lStack[lTop+1]; break;
+            case kOpEqual:        lTop--; lStack[lTop] = lStack[lTop] == lStack[lTop+1]; break;
+            case kOpNotEqual:     lTop--; lStack[lTop] = lStack[lTop] != lStack[lTop+1]; break;
+            case kOpAnd:          lTop--; lStack[lTop] = lStack[lTop] && lStack[lTop+1]; break;
+            case kOpOr:           lTop--; lStack[lTop] = lStack[lTop] || lStack[lTop+1]; break;
+        }
+    }
+    return fValue = lStack[0];
+}
+//________________________________________________________________
+Bool_t AliMultEstimator::Compile(const TString& lExpr)
+{
+    //Translate definition (variables already replaced by [i]) into
+    //postfix code; returns kFALSE if the syntax is not supported
+    fCode.Set(0);
+    fConstants.Set(0);
+    
+    const char* p = lExpr.Data();
+    Bool_t lOK = ParseOr(p);
+    while (*p == ' ' || *p == '\t') p++;
+    if (*p != '\0') lOK = kFALSE;
+    
+    //Check the stack depth needed
+    Int_t lDepth = 0, lMaxDepth = 0;
+    for (Int_t i = 0; lOK && i < fCode.GetSize(); i++) {
+        Int_t lOp = fCode[i];
+        if (lOp == kOpVariable || lOp == kOpConstant) { lDepth++; i++; }
+        else if (lOp != kOpNegate && lOp != kOpNot) lDepth--;
+        if (lDepth > lMaxDepth) lMaxDepth = lDepth;
+    }
+    if (lMaxDepth > kMaxStackDepth || fCode.GetSize() == 0) lOK = kFALSE;
+    
+    if (!lOK) {
+        fCode.Set(0);
+        fConstants.Set(0);
+    }
+    return lOK;
+}
+//________________________________________________________________
+void AliMultEstimator::Emit(Int_t lOp)
+{
+    Int_t n = fCode.GetSize();
+    fCode.Set(n+1);
+    fCode[n] = lOp;
+}
+//________________________________________________________________
+void AliMultEstimator::Emit(Int_t lOp, Int_t lArg)
+{
+    Emit(lOp);
+    Emit(lArg);
+}
+//________________________________________________________________
+//Recursive descent, one level per C++ precedence level. Each parser
+//skips leading blanks and leaves p after the last consumed character
+static Bool_t MultEstimatorSkipTo(const char*& p, const char* lToken)
+{
+    while (*p == ' ' || *p == '\t') p++;
+    Int_t n = strlen(lToken);
+    if (strncmp(p, lToken, n) != 0) return kFALSE;
+    p += n;
+    return kTRUE;
+}
+//________________________________________________________________
+Bool_t AliMultEstimator::ParseOr(const char*& p)
+{
+    if (!ParseAnd(p)) return kFALSE;
+    while (MultEstimatorSkipTo(p, "||")) {
+        if (!ParseAnd(p)) return kFALSE;
+        Emit(kOpOr);
+    }
+    return kTRUE;
+}
+//________________________________________________________________
+Bool_t AliMultEstimator::ParseAnd(const char*& p)
+{
+    if (!ParseEquality(p)) return kFALSE;
+    while (MultEstimatorSkipTo(p, "&&")) {
+        if (!ParseEquality(p)) return kFALSE;
+        Emit(kOpAnd);
+    }
+    return kTRUE;
+}
+//________________________________________________________________
+Bool_t AliMultEstimator::ParseEquality(const char*& p)
+{
+    if (!ParseRelational(p)) return kFALSE;
+    while (kTRUE) {
+        Int_t lOp;
+        if      (MultEstimatorSkipTo(p, "==")) lOp = kOpEqual;
+        else if (MultEstimatorSkipTo(p, "!=")) lOp = kOpNotEqual;
+        else break;
+        if (!ParseRelational(p)) return kFALSE;
+        Emit(lOp);
+    }
+    return kTRUE;
+}
+//________________________________________________________________
+Bool_t AliMultEstimator::ParseRelational(const char*& p)
+{
+    if (!ParseAdditive(p)) return kFALSE;
+    while (kTRUE) {
+        Int_t lOp;
+        if      (MultEstimatorSkipTo(p, "<=")) lOp = kOpLessEqual;
+        else if (MultEstimatorSkipTo(p, ">=")) lOp = kOpGreaterEqual;
+        else if (MultEstimatorSkipTo(p, "<"))  lOp = kOpLess;
+        else if (MultEstimatorSkipTo(p, ">"))  lOp = kOpGreater;
+        else break;
+        if (!ParseAdditive(p)) return kFALSE;
+        Emit(lOp);
+    }
+    return kTRUE;
+}
+//________________________________________________________________
+Bool_t AliMultEstimator::ParseAdditive(const char*& p)
+{
+    if (!ParseMultiplicative(p)) return kFALSE;
+    while (kTRUE) {
+        Int_t lOp;
+        if      (MultEstimatorSkipTo(p, "+")) lOp = kOpAdd;
+        else if (MultEstimatorSkipTo(p, "-")) lOp = kOpSubtract;
+        else break;
+        if (!ParseMultiplicative(p)) return kFALSE;
+        Emit(lOp);
+    }
+    return kTRUE;
+}
+//________________________________________________________________
+Bool_t AliMultEstimator::ParseMultiplicative(const char*& p)
+{
+    if (!ParseUnary(p)) return kFALSE;
+    while (kTRUE) {
+        Int_t lOp;
+        if      (MultEstimatorSkipTo(p, "*")) lOp = kOpMultiply;
+        else if (MultEstimatorSkipTo(p, "/")) lOp = kOpDivide;
+        else break;
+        if (!ParseUnary(p)) return kFALSE;
+        Emit(lOp);
+    }
+    return kTRUE;
+}
+//________________________________________________________________
+Bool_t AliMultEstimator::ParseUnary(const char*& p)
+{
+    if (MultEstimatorSkipTo(p, "-")) {
+        if (!ParseUnary(p)) return kFALSE;
+        Emit(kOpNegate);
+        return kTRUE;
+    }
+    if (MultEstimatorSkipTo(p, "+")) return ParseUnary(p);
+    if (MultEstimatorSkipTo(p, "!")) {
+        if (!ParseUnary(p)) return kFALSE;
+        Emit(kOpNot);
+        return kTRUE;
+    }
+    return ParsePrimary(p);
+}
+//________________________________________________________________
+Bool_t AliMultEstimator::ParsePrimary(const char*& p)
+{
+    if (MultEstimatorSkipTo(p, "(")) {
+        if (!ParseOr(p)) return kFALSE;
+        return MultEstimatorSkipTo(p, ")");
+    }
+    if (MultEstimatorSkipTo(p, "[")) {
+        char* lEnd = 0;
+        Long_t lIdx = strtol(p, &lEnd, 10);
+        if (lEnd == p || lIdx < 0 || lIdx >= fNInputs) return kFALSE;
+        p = lEnd;
+        if (!MultEstimatorSkipTo(p, "]")) return kFALSE;
+        Emit(kOpVariable, lIdx);
+        return kTRUE;
+    }
+    if ((*p >= '0' && *p <= '9') || *p == '.') {
+        char* lEnd = 0;
+        Double_t lVal = strtod(p, &lEnd);
+        if (lEnd == p) return kFALSE;
+        p = lEnd;
+        Int_t n = fConstants.GetSize();
+        fConstants.Set(n+1);
+        fConstants[n] = lVal;
+        Emit(kOpConstant, n);
+        return kTRUE;
     }
-    return fValue = fFormula->Eval(0);
+    return kFALSE;
 }
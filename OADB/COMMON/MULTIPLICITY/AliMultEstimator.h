@@ -1,6 +1,8 @@
 #ifndef AliMultEstimator_H
 #define AliMultEstimator_H
 #include <TNamed.h>
+#include <TArrayI.h>
+#include <TArrayD.h>
 class AliMultInput;
 class TFormula;
 
@@ -43,8 +45,37 @@ public:
     //Pre-processing for speed
     void SetupFormula(const AliMultInput* lInput);
     Float_t Evaluate(const AliMultInput* lInput);
+    //Evaluate from values of all input variables (see AliMultInput::FillValues)
+    Float_t Evaluate(const Double_t* lInputValues);
+    Bool_t  IsCompiled() const { return fCode.GetSize() > 0; }
     
 private:
+    //Compiled definition: postfix code evaluated on a fixed-size stack.
+    //Supports numbers, [i] inputs, parentheses, unary + - !, binary
+    //* / + - < > <= >= == != && || with C++ precedence; anything else
+    //(functions, ^, ...) is left to TFormula
+    enum EOpCode {
+        kOpVariable = 0, // followed by input index
+        kOpConstant,     // followed by index in fConstants
+        kOpNegate, kOpNot,
+        kOpMultiply, kOpDivide, kOpAdd, kOpSubtract,
+        kOpLess, kOpGreater, kOpLessEqual, kOpGreaterEqual,
+        kOpEqual, kOpNotEqual, kOpAnd, kOpOr
+    };
+    enum { kMaxStackDepth = 64 };
+    
+    Bool_t Compile(const TString& lExpr);
+    Bool_t ParseOr(const char*& p);
+    Bool_t ParseAnd(const char*& p);
+    Bool_t ParseEquality(const char*& p);
+    Bool_t ParseRelational(const char*& p);
+    Bool_t ParseAdditive(const char*& p);
+    Bool_t ParseMultiplicative(const char*& p);
+    Bool_t ParseUnary(const char*& p);
+    Bool_t ParsePrimary(const char*& p);
+    void   Emit(Int_t lOp);
+    void   Emit(Int_t lOp, Int_t lArg);
+    
     TString fDefinition; //How to evaluate based on AliMultVariables
     Bool_t fIsInteger; //Requires special treatment when calibrating
     
@@ -52,12 +83,17 @@ private:
     Float_t fMean;   // estimator mean value
     Float_t fPercentile;   //Percentile
     TFormula* fFormula; //!
+    TArrayI fCode;      //! compiled definition, empty if TFormula is used
+    TArrayD fConstants; //! numeric literals of compiled definition
+    Int_t   fNInputs;   //! number of input variables at setup
     
     //Anchor point definition
     Bool_t  fkUseAnchor;        //Use Anchor Logic (default: No)
     Float_t fAnchorPoint;       //Raw value below which
     Float_t fAnchorPercentile;  //Percentile of X-section at anchor point
     
-    ClassDef(AliMultEstimator, 1)
+    ClassDef(AliMultEstimator, 2)
+    // 1 - original implementation
+    // 2 - compiled evaluation of the definition (transient)
 };
 #endif
@@ -92,6 +92,20 @@ AliMultVariable* AliMultInput::GetVariable (Long_t iIdx) const
     return static_cast<AliMultVariable*>(fVariableList->At(iIdx));
 }
 
+void AliMultInput::FillValues(Double_t* lValues) const
+{
+    //Copy all variable values, in list order, to lValues (size >= fNVars)
+    //Single pass over the list: At(i) walks the list from its head
+    if (!fVariableList) return;
+    TIter next(fVariableList);
+    AliMultVariable* v = 0;
+    Long_t i = 0;
+    while ((v = static_cast<AliMultVariable*>(next())))
+        lValues[i++] = v->IsInteger() ?
+                       static_cast<Double_t>(v->GetValueInteger()) :
+                       static_cast<Double_t>(v->GetValue());
+}
+
 void AliMultInput::Clear(Option_t* option)
 {
     TIter next(fVariableList);
@@ -16,6 +16,7 @@ public:
     AliMultVariable* GetVariable (const TString& lName) const;
     AliMultVariable* GetVariable (Long_t iIdx) const;
     Long_t GetNVariables         () const { return fNVars; }
+    void FillValues(Double_t* lValues) const;
     void Clear(Option_t* option="");
     void Set(const AliMultInput* other);
     void Print(Option_t* option="") const;
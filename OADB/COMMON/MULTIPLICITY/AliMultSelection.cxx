@@ -37,7 +37,8 @@ fThisEvent_HasNoInconsistentVertices(0),
 fThisEvent_PassesTrackletVsCluster(0),
 fThisEvent_IsNotAsymmetricInVZERO(0),
 fThisEvent_IsNotIncompleteDAQ(0),
-fThisEvent_HasGoodVertex2016(0)
+fThisEvent_HasGoodVertex2016(0),
+fInputValues()
 {
   // Constructor
     fEstimatorList = new TList();
@@ -55,7 +56,8 @@ fThisEvent_HasNoInconsistentVertices(0),
 fThisEvent_PassesTrackletVsCluster(0),
 fThisEvent_IsNotAsymmetricInVZERO(0),
 fThisEvent_IsNotIncompleteDAQ(0),
-fThisEvent_HasGoodVertex2016(0)
+fThisEvent_HasGoodVertex2016(0),
+fInputValues()
 {
   // Constructor
     fEstimatorList = new TList();
@@ -77,7 +79,8 @@ fThisEvent_HasNoInconsistentVertices(lCopyMe.fThisEvent_HasNoInconsistentVertice
 fThisEvent_PassesTrackletVsCluster(lCopyMe.fThisEvent_PassesTrackletVsCluster),
 fThisEvent_IsNotAsymmetricInVZERO(lCopyMe.fThisEvent_IsNotAsymmetricInVZERO),
 fThisEvent_IsNotIncompleteDAQ(lCopyMe.fThisEvent_IsNotIncompleteDAQ),
-fThisEvent_HasGoodVertex2016(lCopyMe.fThisEvent_HasGoodVertex2016)
+fThisEvent_HasGoodVertex2016(lCopyMe.fThisEvent_HasGoodVertex2016),
+fInputValues()
 {
     TIter next(lCopyMe.fEstimatorList);
     AliMultEstimator* est = 0;
@@ -88,7 +91,8 @@ fThisEvent_HasGoodVertex2016(lCopyMe.fThisEvent_HasGoodVertex2016)
 AliMultSelection::AliMultSelection(AliMultSelection *lCopyMe)
     : AliMultSelectionBase(*lCopyMe),
       fNEsts(0),
-      fEstimatorList(0)
+      fEstimatorList(0),
+      fInputValues()
 {
     fEvSelCode = lCopyMe->GetEvSelCode();
 
@@ -239,11 +243,16 @@ void AliMultSelection::Evaluate( AliMultInput *lInput )
 //Master function to evaluate all existing estimators based on
 //a set of input variables. Error handling to be done with care...
 {
+    //Fetch all input variables once, shared by all estimators
+    Long_t lNVars = lInput->GetNVariables();
+    if (fInputValues.GetSize() < lNVars) fInputValues.Set(lNVars);
+    lInput->FillValues(fInputValues.GetArray());
+    
     //Loop over estimators defined in the acquired list
     AliMultEstimator* estimator = 0;
     TIter             next(fEstimatorList);
     while ((estimator = static_cast<AliMultEstimator*>(next())))
-        estimator->Evaluate(lInput);
+        estimator->Evaluate(fInputValues.GetArray());
 
 //deprecated evaluation
 #if 0
@@ -2,6 +2,7 @@
 #define AliMultSelection_H
 #include <TNamed.h>
 #include <TList.h>
+#include <TArrayD.h>
 #include "AliMultSelectionBase.h"
 #include "AliMultEstimator.h"
 
@@ -42,7 +43,7 @@ public:
     //Master "Evaluate"
     void Evaluate ( AliMultInput *lInput );
     
-    //Get ready: prepare/optimize TFormulas
+    //Get ready: compile estimator definitions (TFormula if needed)
     void Setup(const AliMultInput *lInput);
     
     TList *GetEstimatorList() { return fEstimatorList; } 
@@ -90,12 +91,15 @@ private:
     Bool_t fThisEvent_IsNotIncompleteDAQ;       //!
     Bool_t fThisEvent_HasGoodVertex2016;         //!
     
-    ClassDef(AliMultSelection, 6)
+    TArrayD fInputValues; //! values of all input variables in current event
+    
+    ClassDef(AliMultSelection, 7)
     // 1 - original implementation
     // 2 - added fEvSelCode for EvSel bypass + getter changed
     // 3 - added booleans to classify which event criteria are satisfied
     // 4 - added IsEventSelected
     // 5 - added Good vertex, adjustments
     // 6 - changed to inherit from AliMultSelectionBase
+    // 7 - added transient input buffer shared by the estimators
 };
 #endif
@@ -1428,25 +1428,13 @@ void AliMultSelectionTask::UserExec(Option_t *)
         fEvSelCode = lSelection->GetEvSelCode();
 
         //Determine Quantiles from calibration histogram
-        TH1F *lThisCalibHisto = 0x0;
-        TString lThisCalibHistoName;
+        //(flat tables prepared in AliOADBMultSelection::Setup, kNoCalib if absent)
         Float_t lThisQuantile = -1;
         for(Long_t iEst=0; iEst<lSelection->GetNEstimators(); iEst++) {
             //Changed: no need for run number, object already matches required one
-            lThisCalibHistoName = Form("hCalib_%s",lSelection->GetEstimator(iEst)->GetName());
-            lThisCalibHisto = 0x0;
-            lThisCalibHisto = fOadbMultSelection->GetCalibHisto( lThisCalibHistoName );
-            if ( ! lThisCalibHisto ) {
-                lThisQuantile = AliMultSelectionCuts::kNoCalib;
-                if( iEst < fNDebug ) fQuantiles[iEst] = lThisQuantile;
-                lSelection->GetEstimator(iEst)->SetPercentile(lThisQuantile);
-            } else {
-                lThisQuantile = lThisCalibHisto->GetBinContent( lThisCalibHisto->FindBin( lSelection->GetEstimator(iEst)->GetValue() ));
-                if( iEst < fNDebug ) {
-                    fQuantiles[iEst] = lThisQuantile; //Debug, please
-                }
-                lSelection->GetEstimator(iEst)->SetPercentile(lThisQuantile);
-            }
+            lThisQuantile = fOadbMultSelection->GetPercentile( iEst, lSelection->GetEstimator(iEst)->GetValue() );
+            if( iEst < fNDebug ) fQuantiles[iEst] = lThisQuantile; //Debug, please
+            lSelection->GetEstimator(iEst)->SetPercentile(lThisQuantile);
         }
 
         //=============================================================================
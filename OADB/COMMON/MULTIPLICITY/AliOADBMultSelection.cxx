@@ -10,6 +10,7 @@
 #include "TObjString.h"
 #include "TBrowser.h"
 #include <TMap.h>
+#include <TMath.h>
 #include <TROOT.h>
 
 ClassImp(AliOADBMultSelection);
@@ -17,7 +18,9 @@ ClassImp(AliOADBMultSelection);
 //________________________________________________________________
 //Constructors/Destructor
 AliOADBMultSelection::AliOADBMultSelection() :
-TNamed("multSel",""), fCalibList(0), fEventCuts(0), fSelection(0), fMap(0)
+TNamed("multSel",""), fCalibList(0), fEventCuts(0), fSelection(0), fMap(0),
+fCalibNBins(), fCalibXmin(), fCalibXmax(), fCalibEdgeOffset(), fCalibBinOffset(),
+fCalibEdges(), fCalibContent()
 {
     // constructor
     // fCalibList = new TList();
@@ -29,7 +32,9 @@ AliOADBMultSelection::AliOADBMultSelection(const AliOADBMultSelection& o)
 fCalibList(0),
 fEventCuts(0),
 fSelection(0),
-fMap(0)
+fMap(0),
+fCalibNBins(), fCalibXmin(), fCalibXmax(), fCalibEdgeOffset(), fCalibBinOffset(),
+fCalibEdges(), fCalibContent()
 {
     fCalibList = new TList();
     fCalibList->SetOwner (kTRUE);
@@ -41,7 +46,9 @@ fMap(0)
 }
 //________________________________________________________________
 AliOADBMultSelection::AliOADBMultSelection(const char * name, const char * title) :
-TNamed(name, title), fCalibList(0), fEventCuts(0), fSelection(0), fMap(0)
+TNamed(name, title), fCalibList(0), fEventCuts(0), fSelection(0), fMap(0),
+fCalibNBins(), fCalibXmin(), fCalibXmax(), fCalibEdgeOffset(), fCalibBinOffset(),
+fCalibEdges(), fCalibContent()
 {
     // constructor
     fCalibList = new TList();
@@ -61,6 +68,7 @@ AliOADBMultSelection& AliOADBMultSelection::operator=(const AliOADBMultSelection
         delete fMap;
         fMap = 0;
     }
+    fCalibNBins.Set(0);
     fCalibList = new TList();
     fCalibList->SetOwner (kTRUE);
     TIter next(o.fCalibList);
@@ -247,6 +255,60 @@ void AliOADBMultSelection::Setup()
         
         fMap->Add(e, h);
     }
+    
+    //Flat tables for the per-event look-up: no name search, no
+    //virtual calls. Reproduces TAxis::FindBin for non-extendable axes
+    Long_t lNEsts = sel->GetNEstimators();
+    fCalibNBins.Set(lNEsts);
+    fCalibXmin.Set(lNEsts);
+    fCalibXmax.Set(lNEsts);
+    fCalibEdgeOffset.Set(lNEsts);
+    fCalibBinOffset.Set(lNEsts);
+    fCalibEdges.Set(0);
+    fCalibContent.Set(0);
+    for(Long_t iEst=0; iEst<lNEsts; iEst++) {
+        fCalibNBins[iEst] = -1;
+        fCalibEdgeOffset[iEst] = -1;
+        fCalibBinOffset[iEst] = -1;
+        AliMultEstimator* e = sel->GetEstimator(iEst);
+        TH1F* h = e ? FindHisto(e) : 0;
+        if (!h) continue;
+        
+        const TAxis* lAxis = h->GetXaxis();
+        Int_t lNBins = lAxis->GetNbins();
+        fCalibNBins[iEst] = lNBins;
+        fCalibXmin[iEst]  = lAxis->GetXmin();
+        fCalibXmax[iEst]  = lAxis->GetXmax();
+        
+        const TArrayD* lEdges = lAxis->GetXbins();
+        if (lEdges->GetSize() > 0) {
+            Int_t lOffset = fCalibEdges.GetSize();
+            fCalibEdges.Set(lOffset + lEdges->GetSize());
+            for (Int_t i=0; i<lEdges->GetSize(); i++) fCalibEdges[lOffset+i] = lEdges->At(i);
+            fCalibEdgeOffset[iEst] = lOffset;
+        }
+        
+        Int_t lOffset = fCalibContent.GetSize();
+        fCalibContent.Set(lOffset + lNBins + 2);
+        for (Int_t i=0; i<lNBins+2; i++) fCalibContent[lOffset+i] = h->GetBinContent(i);
+        fCalibBinOffset[iEst] = lOffset;
+    }
+}
+//________________________________________________________________
+Float_t AliOADBMultSelection::GetPercentile(Long_t iEst, Double_t lValue) const
+{
+    if (iEst < 0 || iEst >= fCalibNBins.GetSize() || fCalibNBins[iEst] < 0)
+        return AliMultSelectionCuts::kNoCalib;
+    
+    Int_t lNBins = fCalibNBins[iEst];
+    Int_t lBin   = 0;
+    if (lValue < fCalibXmin[iEst]) lBin = 0;
+    else if (!(lValue < fCalibXmax[iEst])) lBin = lNBins+1;
+    else if (fCalibEdgeOffset[iEst] < 0)
+        lBin = 1 + Int_t(lNBins*(lValue-fCalibXmin[iEst])/(fCalibXmax[iEst]-fCalibXmin[iEst]));
+    else
+        lBin = 1 + TMath::BinarySearch(lNBins+1, fCalibEdges.GetArray()+fCalibEdgeOffset[iEst], lValue);
+    return fCalibContent[fCalibBinOffset[iEst]+lBin];
 }
 
 
@@ -2,6 +2,8 @@
 #define ALIOADBMULTSELECTION_H
 
 #include <TNamed.h>
+#include <TArrayI.h>
+#include <TArrayD.h>
 #include <AliMultSelection.h>
 class TBrowser;
 class TH1F;
@@ -39,6 +41,9 @@ public:
     //Use internal map
     void Setup();
     TH1F* FindHisto(AliMultEstimator* e);
+    //Calibration histogram content at lValue for estimator iEst of
+    //GetMultSelection(), kNoCalib if none; requires Setup()
+    Float_t GetPercentile(Long_t iEst, Double_t lValue) const;
     void Print(Option_t* option="") const;
     
 private:
@@ -46,7 +51,19 @@ private:
     AliMultSelectionCuts * fEventCuts; // EventCuts
     AliMultSelection     * fSelection; // Definition of Estimators
     TMap*                  fMap; //! Map estimator to histogram
-    ClassDef(AliOADBMultSelection, 1)
+    
+    //Flat copy of the calibration histograms per estimator, see Setup()
+    TArrayI fCalibNBins;      //! number of bins, -1 if no histogram
+    TArrayD fCalibXmin;       //! lower axis limit
+    TArrayD fCalibXmax;       //! upper axis limit
+    TArrayI fCalibEdgeOffset; //! offset in fCalibEdges, -1 for fixed bins
+    TArrayI fCalibBinOffset;  //! offset of underflow bin in fCalibContent
+    TArrayD fCalibEdges;      //! bin edges of variable-bin axes
+    TArrayD fCalibContent;    //! bin contents incl. under/overflow
+    
+    ClassDef(AliOADBMultSelection, 2)
+    // 1 - original implementation
+    // 2 - transient flat calibration tables
     
     
 };
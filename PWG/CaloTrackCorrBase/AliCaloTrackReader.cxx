@@ -44,6 +44,7 @@
 // ---- CaloTrackCorr ---
 #include "AliCalorimeterUtils.h"
 #include "AliCaloTrackReader.h"
+#include "AliIsolationConeMap.h"
 
 // ---- Jets ----
 #include "AliAODJet.h"
@@ -97,7 +98,7 @@ fBitEGA(0),                  fBitEJE(0),
 
 fEventType(-1),
 fTaskName(""),               fCaloUtils(0x0),
-fWeightUtils(0x0),           fEventWeight(1),
+fWeightUtils(0x0),           fIsolationConeMap(0x0),          fEventWeight(1),
 fMixedEvent(NULL),           fNMixedEvent(0),                 fVertex(NULL),
 fListMixedTracksEvents(),    fListMixedCaloEvents(),
 fLastMixedTracksEvent(-1),   fLastMixedCaloEvent(-1),
@@ -215,6 +216,8 @@ void AliCaloTrackReader::DeletePointers()
   fAcceptEventsWithBit.Reset();
   
   if ( fWeightUtils ) delete fWeightUtils ;
+
+  delete fIsolationConeMap ;
     
   //  Pointers not owned, done by the analysis frame
   //  if(fInputEvent)  delete fInputEvent ;
@@ -969,6 +972,21 @@ Int_t AliCaloTrackReader::GetTrackID(AliVTrack* track)
   return track->GetID();
 }
 
+//_____________________________
+///
+/// Map of the tracks and clusters lists of the event for the isolation
+/// cone sums, shared by all the analysis using this reader.
+/// Created the first time it is requested, cleared in ResetLists().
+///
+/// \return pointer to AliIsolationConeMap
+//_____________________________
+AliIsolationConeMap * AliCaloTrackReader::GetIsolationConeMap()
+{
+  if ( !fIsolationConeMap ) fIsolationConeMap = new AliIsolationConeMap() ;
+
+  return fIsolationConeMap ;
+}
+
 //_____________________________
 /// Init the reader. 
 /// Method to be called in AliAnaCaloTrackCorrMaker.
@@ -3096,6 +3114,8 @@ void AliCaloTrackReader::ResetLists()
   
   if(fNonStandardJets) fNonStandardJets -> Clear("C");
   fBackgroundJets->Reset();
+
+  if(fIsolationConeMap) fIsolationConeMap->Clear();
 }
 
 //___________________________________________
@@ -52,6 +52,7 @@ class AliVCluster;
 #include "AliFiducialCut.h"
 class AliCalorimeterUtils;
 #include "AliAnaWeights.h"
+class AliIsolationConeMap;
 
 // Jets
 class AliAODJetEventBackground;
@@ -619,6 +620,8 @@ public:
   AliAnaWeights       * GetWeightUtils()                   { if ( !fWeightUtils ) fWeightUtils = new AliAnaWeights() ;
                                                              return               fWeightUtils       ; }
 
+  AliIsolationConeMap * GetIsolationConeMap() ;
+
   virtual Double_t      GetBField()                  const { return fInputEvent->GetMagneticField()  ; }
   
   /// Shift phi angle in case of negative value 360 degrees. Example TLorenzVector::Phi defined in -pi to pi
@@ -850,6 +853,7 @@ public:
   AliCalorimeterUtils * fCaloUtils ;               ///<  Pointer to AliCalorimeterUtils.
 
   AliAnaWeights  * fWeightUtils ;                  ///<  Pointer to AliAnaWeights.
+  AliIsolationConeMap * fIsolationConeMap ;        ///<  Pointer to AliIsolationConeMap, tracks and clusters map shared by the isolation cuts.
   Double_t         fEventWeight ;                  ///<  Weight assigned to the event when filling histograms.
     
   AliMixedEvent  * fMixedEvent  ;                  //!<! Mixed event object. This class is not the owner.
@@ -972,7 +976,7 @@ public:
   AliCaloTrackReader & operator = (const AliCaloTrackReader & r) ; 
   
   /// \cond CLASSIMP
-  ClassDef(AliCaloTrackReader,77) ;
+  ClassDef(AliCaloTrackReader,78) ;
   /// \endcond
 
 } ;
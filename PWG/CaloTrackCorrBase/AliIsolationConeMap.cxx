@@ -0,0 +1,715 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// --- ROOT system ---
+#include <TObjArray.h>
+#include <TMath.h>
+#include <algorithm>
+
+// --- AliRoot system ---
+#include "AliAODPWG4Particle.h"
+#include "AliVTrack.h"
+#include "AliVCluster.h"
+#include "AliMixedEvent.h"
+#include "AliLog.h"
+
+// --- CaloTrackCorrelations ---
+#include "AliCaloTrackReader.h"
+#include "AliCaloPID.h"
+#include "AliIsolationConeMap.h"
+
+/// \cond CLASSIMP
+ClassImp(AliIsolationConeMap) ;
+/// \endcond
+
+/// Margin on the cell edges: a cell is taken as fully inside or outside
+/// the cone or band only if it is so within this margin, otherwise its
+/// particles are checked one by one.
+static const Double_t kCellEdgeMargin = 1.e-4;
+
+/// Smallest cell size, so that the number of cells of the map stays bounded
+/// (at most about 600 cells in phi and 100 per unit of eta).
+static const Float_t kMinCellSize = 0.01;
+
+//____________________________________
+/// Default constructor.
+//____________________________________
+AliIsolationConeMap::AliIsolationConeMap() :
+TObject(),
+fCellSize(0.1),
+fMaxAbsEta(2.),
+fNPhi(0),
+fPhiCellSize(0.),
+fCellExcluded(),
+fTMPid(0x0),
+fExcludedItems(),
+fConeItems(),
+fConeObjects(),
+fMomentum(),
+fTrackVector()
+{
+  for(Int_t is = 0; is < kNSpecies; is++)
+  {
+    fList  [is] = 0x0;
+    fNEta  [is] = 0;
+    fEtaMin[is] = 0.;
+  }
+}
+
+//____________________________________________________________
+/// Set the size of the cells in eta and phi. Sizes below kMinCellSize
+/// are raised to it, a size <= 0 puts all the particles in one cell.
+//____________________________________________________________
+void AliIsolationConeMap::SetCellSize(Float_t s)
+{
+  if(s > 0 && s < kMinCellSize)
+  {
+    AliWarning(Form("Cell size %f too small, set to %f",s,kMinCellSize));
+    s = kMinCellSize;
+  }
+
+  fCellSize = s ;
+  Clear() ;
+}
+
+//____________________________________________________________
+/// Invalidate the map, called at the end of each event.
+/// The memory of the cells and particles is kept for the next event.
+//____________________________________________________________
+void AliIsolationConeMap::Clear(const Option_t * /*opt*/)
+{
+  for(Int_t is = 0; is < kNSpecies; is++) fList[is] = 0x0;
+
+  fTMPid = 0x0;
+}
+
+//____________________________________________________________
+/// Store the tracks (species kTracks) or clusters (kClusters) of the
+/// list in the cells, with the same kinematics as in the loops of
+/// AliIsolationCut::MakeIsolationCut(). Particles with non finite eta or
+/// phi are never in the cone or bands and are not stored.
+//____________________________________________________________
+void AliIsolationConeMap::Fill(Int_t species, TObjArray * list, AliCaloTrackReader * reader)
+{
+  Int_t is = species;
+
+  std::vector<Float_t>  pts, etas, phis;
+  std::vector<Int_t>    indices, ids;
+  std::vector<Bool_t>   hasID;
+  std::vector<TObject*> objects;
+
+  Float_t pt  = -100. ;
+  Float_t eta = -100. ;
+  Float_t phi = -100. ;
+
+  Int_t nEntries = list->GetEntries();
+  for(Int_t ipr = 0; ipr < nEntries; ipr++)
+  {
+    TObject * obj = 0x0;
+    Int_t     id  = -1;
+
+    AliVTrack   * track = ( is == kTracks ) ? dynamic_cast<AliVTrack  *>(list->At(ipr)) : 0x0;
+    AliVCluster * calo  = ( is != kTracks ) ? dynamic_cast<AliVCluster*>(list->At(ipr)) : 0x0;
+
+    if(track)
+    {
+      id = reader->GetTrackID(track) ; // needed instead of track->GetID() since AOD needs some manipulations
+
+      fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+      pt  = fTrackVector.Pt();
+      eta = fTrackVector.Eta();
+      phi = fTrackVector.Phi() ;
+
+      obj = track;
+    }
+    else if(calo)
+    {
+      // Get the index where the cluster comes, to retrieve the corresponding vertex
+      Int_t evtIndex = 0 ;
+      if (reader->GetMixedEvent())
+        evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+
+      id = calo->GetID();
+
+      // Assume that come from vertex in straight line
+      calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
+
+      pt  = fMomentum.Pt()  ;
+      eta = fMomentum.Eta() ;
+      phi = fMomentum.Phi() ;
+
+      obj = calo;
+    }
+    else
+    {// Mixed event stored in AliAODPWG4Particles
+      AliAODPWG4Particle * mix = dynamic_cast<AliAODPWG4Particle*>(list->At(ipr)) ;
+      if(!mix)
+      {
+        AliWarning("Wrong data type, continue");
+        continue;
+      }
+
+      pt  = mix->Pt();
+      eta = mix->Eta();
+      phi = mix->Phi() ;
+    }
+
+    if ( phi < 0 ) phi+=TMath::TwoPi();
+
+    if ( !TMath::Finite(eta) || !TMath::Finite(phi) ) continue;
+
+    pts    .push_back(pt);
+    etas   .push_back(eta);
+    phis   .push_back(phi);
+    indices.push_back(ipr);
+    ids    .push_back(id);
+    hasID  .push_back(obj != 0x0);
+    objects.push_back(obj);
+  }
+
+  Int_t nItems = pts.size();
+
+  // Cells
+
+  Double_t etaMin = 0, etaMax = 0;
+  if(nItems > 0)
+  {
+    etaMin = *std::min_element(etas.begin(), etas.end());
+    etaMax = *std::max_element(etas.begin(), etas.end());
+  }
+  etaMin = TMath::Max(etaMin, -1.*fMaxAbsEta);
+  etaMax = TMath::Min(etaMax,  1.*fMaxAbsEta);
+
+  if(fCellSize > 0)
+  {
+    fNEta[is] = TMath::Max(1, TMath::CeilNint((etaMax-etaMin)/fCellSize));
+    fNPhi     = TMath::Max(1, TMath::Nint(TMath::TwoPi()/fCellSize));
+  }
+  else
+  {
+    fNEta[is] = 1;
+    fNPhi     = 1;
+  }
+
+  fEtaMin[is]  = etaMin;
+  fPhiCellSize = TMath::TwoPi()/fNPhi;
+
+  Int_t nCells = fNEta[is]*fNPhi;
+
+  std::vector<Int_t> cells(nItems);
+  for(Int_t i = 0; i < nItems; i++)
+  {
+    Int_t ieta = 0;
+    Double_t x = fCellSize > 0 ? (etas[i]-etaMin)/fCellSize : 0;
+    if     ( x >= fNEta[is] ) ieta = fNEta[is]-1;
+    else if( x >  0         ) ieta = Int_t(x);
+
+    Int_t iphi = 0;
+    Double_t y = phis[i]/fPhiCellSize;
+    if     ( y >= fNPhi ) iphi = fNPhi-1;
+    else if( y >  0     ) iphi = Int_t(y);
+
+    cells[i] = ieta*fNPhi+iphi;
+  }
+
+  // Sort the particles by cell, keeping the list order in each cell
+
+  fCellStart[is].assign(nCells+1, 0);
+  for(Int_t i = 0; i < nItems; i++) fCellStart[is][cells[i]+1]++;
+  for(Int_t ic = 0; ic < nCells; ic++) fCellStart[is][ic+1] += fCellStart[is][ic];
+
+  fItemPt      [is].resize(nItems);
+  fItemEta     [is].resize(nItems);
+  fItemPhi     [is].resize(nItems);
+  fItemCell    [is].resize(nItems);
+  fItemIndex   [is].resize(nItems);
+  fItemObject  [is].resize(nItems);
+  fItemTM      [is].assign(nItems, kFALSE);
+  fItemExcluded[is].assign(nItems, kFALSE);
+
+  std::vector<Int_t> next(fCellStart[is].begin(), fCellStart[is].end()-1);
+  std::vector<std::pair<Int_t,Int_t> > idItems;
+  for(Int_t i = 0; i < nItems; i++)
+  {
+    Int_t j = next[cells[i]]++;
+
+    fItemPt    [is][j] = pts[i];
+    fItemEta   [is][j] = etas[i];
+    fItemPhi   [is][j] = phis[i];
+    fItemCell  [is][j] = cells[i];
+    fItemIndex [is][j] = indices[i];
+    fItemObject[is][j] = objects[i];
+
+    if(hasID[i]) idItems.push_back(std::make_pair(ids[i], j));
+  }
+
+  // IDs of the tracks and clusters, to find the particles of the candidate
+
+  std::sort(idItems.begin(), idItems.end());
+
+  fIDs   [is].resize(idItems.size());
+  fIDItem[is].resize(idItems.size());
+  for(UInt_t i = 0; i < idItems.size(); i++)
+  {
+    fIDs   [is][i] = idItems[i].first;
+    fIDItem[is][i] = idItems[i].second;
+  }
+
+  FillCellSums(is, kFALSE);
+
+  fList[is] = list;
+
+  if(is == kClusters) fTMPid = 0x0;
+
+  AliDebug(1,Form("Species %d, %d particles in %d x %d cells",is,nItems,fNEta[is],fNPhi));
+}
+
+//____________________________________________________________
+/// Check the track matching of the stored clusters with the given PID
+/// and fill the cell sums without the track matched clusters.
+//____________________________________________________________
+void AliIsolationConeMap::FillTrackMatching(AliCaloPID * pid, AliCaloTrackReader * reader)
+{
+  Int_t nItems = fItemObject[kClusters].size();
+  for(Int_t i = 0; i < nItems; i++)
+  {
+    AliVCluster * calo = static_cast<AliVCluster*>(fItemObject[kClusters][i]);
+
+    fItemTM[kClusters][i] = calo && pid->IsTrackMatched(calo,reader->GetCaloUtils(),reader->GetInputEvent());
+  }
+
+  FillCellSums(kClusters, kTRUE);
+
+  fTMPid = pid;
+}
+
+//____________________________________________________________
+/// Fill the pT sum and maximum of each cell and the summed-area table,
+/// for all the particles or without the track matched clusters.
+//____________________________________________________________
+void AliIsolationConeMap::FillCellSums(Int_t species, Bool_t rejectTM)
+{
+  Int_t is     = species;
+  Int_t index  = 2*is + rejectTM;
+  Int_t nEta   = fNEta[is];
+  Int_t nCells = nEta*fNPhi;
+
+  fCellSum[index].assign(nCells, 0.);
+  fCellMax[index].assign(nCells, -1.);
+
+  for(Int_t ic = 0; ic < nCells; ic++)
+  {
+    for(Int_t i = fCellStart[is][ic]; i < fCellStart[is][ic+1]; i++)
+    {
+      if( rejectTM && fItemTM[is][i] ) continue;
+
+      fCellSum[index][ic] += fItemPt[is][i];
+      if( fCellMax[index][ic] < fItemPt[is][i] ) fCellMax[index][ic] = fItemPt[is][i];
+    }
+  }
+
+  // fSAT[(ieta+1)*(nPhi+1)+iphi+1] = sum of the cells [0,ieta] x [0,iphi]
+  fSAT[index].assign((nEta+1)*(fNPhi+1), 0.);
+  for(Int_t ieta = 0; ieta < nEta; ieta++)
+  {
+    Double_t row = 0;
+    for(Int_t iphi = 0; iphi < fNPhi; iphi++)
+    {
+      row += fCellSum[index][ieta*fNPhi+iphi];
+      fSAT[index][(ieta+1)*(fNPhi+1)+iphi+1] = fSAT[index][ieta*(fNPhi+1)+iphi+1] + row;
+    }
+  }
+}
+
+//____________________________________________________________
+/// \return pT sum of the cells [ieta0,ieta1] x [iphi0,iphi1].
+//____________________________________________________________
+Double_t AliIsolationConeMap::GetRectangleSum(Int_t index, Int_t ieta0, Int_t ieta1, Int_t iphi0, Int_t iphi1) const
+{
+  if( ieta0 > ieta1 || iphi0 > iphi1 ) return 0.;
+
+  Int_t w = fNPhi+1;
+
+  return fSAT[index][(ieta1+1)*w+iphi1+1] - fSAT[index][ieta0*w+iphi1+1]
+       - fSAT[index][(ieta1+1)*w+iphi0]   + fSAT[index][ieta0*w+iphi0];
+}
+
+//____________________________________________________________
+/// \return lower eta edge of the cell, the first cell is open.
+//____________________________________________________________
+Double_t AliIsolationConeMap::GetCellEtaMin(Int_t species, Int_t ieta) const
+{
+  if( ieta == 0 ) return -TMath::Infinity();
+
+  return fEtaMin[species] + ieta*fCellSize;
+}
+
+//____________________________________________________________
+/// \return upper eta edge of the cell, the last cell is open.
+//____________________________________________________________
+Double_t AliIsolationConeMap::GetCellEtaMax(Int_t species, Int_t ieta) const
+{
+  if( ieta == fNEta[species]-1 ) return TMath::Infinity();
+
+  return fEtaMin[species] + (ieta+1)*fCellSize;
+}
+
+//____________________________________________________________
+/// Get the minimum and maximum distance, as in Radius(), between the
+/// candidate and the points of the cell.
+//____________________________________________________________
+void AliIsolationConeMap::GetCellRadiusRange(Int_t species, Int_t ieta, Int_t iphi,
+                                             Float_t etaC, Float_t phiC, Double_t & rmin, Double_t & rmax) const
+{
+  Double_t eta0 = GetCellEtaMin(species, ieta);
+  Double_t eta1 = GetCellEtaMax(species, ieta);
+
+  Double_t dEtaMin = 0;
+  if     ( etaC < eta0 ) dEtaMin = eta0 - etaC;
+  else if( etaC > eta1 ) dEtaMin = etaC - eta1;
+  Double_t dEtaMax = TMath::Max(TMath::Abs(etaC - eta0), TMath::Abs(etaC - eta1));
+
+  // Delta phi as in Radius(), piecewise linear in phiC - phi, with
+  // kinks at multiples of pi: the extremes are at the edges or kinks
+  Double_t d0 = phiC - (iphi+1)*fPhiCellSize;
+  Double_t d1 = phiC -  iphi   *fPhiCellSize;
+
+  Double_t dPhiMin = TMath::Infinity();
+  Double_t dPhiMax = 0;
+  Double_t points[7] = { d0, d1, -TMath::TwoPi(), -TMath::Pi(), 0., TMath::Pi(), TMath::TwoPi() };
+  for(Int_t ip = 0; ip < 7; ip++)
+  {
+    Double_t d = points[ip];
+    if( d < d0 || d > d1 ) continue;
+
+    Double_t dPhi = TMath::Abs(d);
+    if( dPhi >= TMath::Pi() ) dPhi = TMath::Abs(TMath::TwoPi() - dPhi);
+
+    dPhiMin = TMath::Min(dPhiMin, dPhi);
+    dPhiMax = TMath::Max(dPhiMax, dPhi);
+  }
+
+  rmin = TMath::Sqrt(dEtaMin*dEtaMin + dPhiMin*dPhiMin);
+  rmax = TMath::Sqrt(dEtaMax*dEtaMax + dPhiMax*dPhiMax);
+}
+
+//____________________________________________________________
+/// Cone and UE band pT sums of the tracks or clusters of the list,
+/// with the same selection as the loops of AliIsolationCut::MakeIsolationCut():
+/// the particles in the cone have fDistMinToTrigger <= R < cone size and
+/// are on the same side as the candidate, the particles in the bands have
+/// R > cone size and R >= fDistMinToTrigger.
+///
+/// The band sums are the sums of the eta (phi) strips, from the summed-area
+/// table and the particles of the strip edge cells, minus the particles of
+/// the strips near the candidate. The cone sum is the sum of the cells fully
+/// inside the cone plus the particles of the cells crossed by the cone.
+/// The cells containing a particle of the candidate are always checked
+/// particle by particle. The sums are the same as with the loops, up to
+/// the rounding of the sums.
+///
+/// \param species: kTracks or kClusters.
+/// \param list: tracks or clusters list of the reader, the map is filled if needed.
+/// \param reader: pointer to AliCaloTrackReader.
+/// \param pid: pointer to AliCaloPID, for the track matching of the clusters.
+/// \param rejectTM: do not count the track matched clusters.
+/// \param etaC: pseudorapidity of the candidate.
+/// \param phiC: azimuthal angle of the candidate, in [0,2pi].
+/// \param coneSize: size of the isolation cone.
+/// \param distMin: minimal distance to the candidate.
+/// \param excludedIDs: track or cluster IDs of the candidate, not counted.
+/// \param nExcluded: number of IDs in excludedIDs.
+/// \param coneSum: pT sum in the cone, output.
+/// \param ptLead: updated with the leading pT in the cone, input/output.
+/// \param etaBandSum: pT sum in the eta band, output.
+/// \param phiBandSum: pT sum in the phi band, output.
+/// \param fillCone: keep the particles in the cone, see GetConeObject().
+//____________________________________________________________
+void AliIsolationConeMap::GetConeSums(Int_t species, TObjArray * list,
+                                      AliCaloTrackReader * reader, AliCaloPID * pid, Bool_t rejectTM,
+                                      Float_t etaC, Float_t phiC, Float_t coneSize, Float_t distMin,
+                                      const Int_t * excludedIDs, Int_t nExcluded,
+                                      Float_t & coneSum, Float_t & ptLead,
+                                      Float_t & etaBandSum, Float_t & phiBandSum, Bool_t fillCone)
+{
+  Int_t is = species;
+
+  if( fList[is] != list ) Fill(is, list, reader);
+
+  Bool_t rejTM = ( is == kClusters && rejectTM );
+  if( rejTM && fTMPid != pid ) FillTrackMatching(pid, reader);
+
+  Int_t index = 2*is + rejTM;
+  Int_t nEta  = fNEta[is];
+  Int_t nPhi  = fNPhi;
+
+  const Double_t eps = kCellEdgeMargin;
+
+  const std::vector<Float_t> & pts  = fItemPt [is];
+  const std::vector<Float_t> & etas = fItemEta[is];
+  const std::vector<Float_t> & phis = fItemPhi[is];
+  const std::vector<Int_t>   & cellStart = fCellStart[is];
+
+  // Particles of the candidate
+
+  fExcludedItems.clear();
+  for(Int_t iex = 0; iex < nExcluded; iex++)
+  {
+    std::pair<std::vector<Int_t>::const_iterator, std::vector<Int_t>::const_iterator> range =
+      std::equal_range(fIDs[is].begin(), fIDs[is].end(), excludedIDs[iex]);
+
+    for(std::vector<Int_t>::const_iterator it = range.first; it != range.second; ++it)
+      fExcludedItems.push_back(fIDItem[is][it - fIDs[is].begin()]);
+  }
+  std::sort(fExcludedItems.begin(), fExcludedItems.end());
+  fExcludedItems.erase(std::unique(fExcludedItems.begin(), fExcludedItems.end()), fExcludedItems.end());
+
+  fCellExcluded.assign(nEta*nPhi, kFALSE);
+  for(UInt_t iex = 0; iex < fExcludedItems.size(); iex++)
+  {
+    fItemExcluded[is][fExcludedItems[iex]] = kTRUE;
+    fCellExcluded[fItemCell[is][fExcludedItems[iex]]] = kTRUE;
+  }
+
+  Float_t etaLow = etaC-coneSize;
+  Float_t etaUp  = etaC+coneSize;
+  Float_t phiLow = phiC-coneSize;
+  Float_t phiUp  = phiC+coneSize;
+
+  // ** Eta strip of the phi band, any distance to the candidate **
+
+  Double_t phiBand = 0;
+  Int_t    fullEta0 = nEta, fullEta1 = -1;
+  for(Int_t ieta = 0; ieta < nEta; ieta++)
+  {
+    Double_t eta0 = GetCellEtaMin(is, ieta);
+    Double_t eta1 = GetCellEtaMax(is, ieta);
+
+    if( eta1 + eps < etaLow || eta0 - eps > etaUp ) continue;
+
+    if( eta0 - eps > etaLow && eta1 + eps < etaUp )
+    {
+      fullEta0 = TMath::Min(fullEta0, ieta);
+      fullEta1 = TMath::Max(fullEta1, ieta);
+      continue;
+    }
+
+    for(Int_t i = cellStart[ieta*nPhi]; i < cellStart[(ieta+1)*nPhi]; i++)
+    {
+      if( rejTM && fItemTM[is][i] ) continue;
+      if( etas[i] > etaLow && etas[i] < etaUp ) phiBand += pts[i];
+    }
+  }
+  phiBand += GetRectangleSum(index, fullEta0, fullEta1, 0, nPhi-1);
+
+  // ** Phi strip of the eta band, any distance to the candidate **
+
+  Double_t etaBand = 0;
+  Int_t    fullPhi0 = nPhi, fullPhi1 = -1;
+  for(Int_t iphi = 0; iphi < nPhi; iphi++)
+  {
+    Double_t phi0 =  iphi   *fPhiCellSize;
+    Double_t phi1 = (iphi+1)*fPhiCellSize;
+
+    if( phi1 + eps < phiLow || phi0 - eps > phiUp ) continue;
+
+    if( phi0 - eps > phiLow && phi1 + eps < phiUp )
+    {
+      fullPhi0 = TMath::Min(fullPhi0, iphi);
+      fullPhi1 = TMath::Max(fullPhi1, iphi);
+      continue;
+    }
+
+    for(Int_t ieta = 0; ieta < nEta; ieta++)
+    {
+      Int_t icell = ieta*nPhi+iphi;
+      for(Int_t i = cellStart[icell]; i < cellStart[icell+1]; i++)
+      {
+        if( rejTM && fItemTM[is][i] ) continue;
+        if( phis[i] > phiLow && phis[i] < phiUp ) etaBand += pts[i];
+      }
+    }
+  }
+  etaBand += GetRectangleSum(index, 0, nEta-1, fullPhi0, fullPhi1);
+
+  // The particles of the candidate are in the strips but never in the bands
+
+  for(UInt_t iex = 0; iex < fExcludedItems.size(); iex++)
+  {
+    Int_t i = fExcludedItems[iex];
+    if( rejTM && fItemTM[is][i] ) continue;
+
+    if( etas[i] > etaLow && etas[i] < etaUp ) phiBand -= pts[i];
+    if( phis[i] > phiLow && phis[i] < phiUp ) etaBand -= pts[i];
+  }
+
+  // ** Cells near the candidate: cone, and particles of the strips not in the bands **
+
+  Double_t cone = 0;
+  fConeItems.clear();
+
+  Float_t rNear = TMath::Max(coneSize, distMin);
+
+  Int_t ieta0 = 0, ieta1 = nEta-1;
+  while( ieta0 < nEta && GetCellEtaMax(is, ieta0) + eps < etaC - rNear ) ieta0++;
+  while( ieta1 >= 0   && GetCellEtaMin(is, ieta1) - eps > etaC + rNear ) ieta1--;
+
+  Int_t iphi0 = 0, nPhiNear = nPhi;
+  if( 2*(rNear + eps) + 2*fPhiCellSize < TMath::TwoPi() )
+  {
+    iphi0    = TMath::FloorNint((phiC - rNear - eps)/fPhiCellSize);
+    nPhiNear = TMath::Min(nPhi, TMath::FloorNint((phiC + rNear + eps)/fPhiCellSize) - iphi0 + 1);
+  }
+
+  for(Int_t ieta = ieta0; ieta <= ieta1; ieta++)
+  {
+    Double_t eta0 = GetCellEtaMin(is, ieta);
+    Double_t eta1 = GetCellEtaMax(is, ieta);
+
+    Bool_t etaAll  = ( eta0 - eps > etaLow && eta1 + eps < etaUp );
+    Bool_t etaNone = ( eta1 + eps < etaLow || eta0 - eps > etaUp );
+
+    for(Int_t jphi = 0; jphi < nPhiNear; jphi++)
+    {
+      Int_t iphi  = ((iphi0 + jphi) % nPhi + nPhi) % nPhi;
+      Int_t icell = ieta*nPhi+iphi;
+
+      if( cellStart[icell] == cellStart[icell+1] ) continue;
+
+      Double_t rmin = 0, rmax = 0;
+      GetCellRadiusRange(is, ieta, iphi, etaC, phiC, rmin, rmax);
+
+      // All the particles farther than the cone and minimal distance
+      if( rmin - eps > rNear ) continue;
+
+      Double_t phi0 =  iphi   *fPhiCellSize;
+      Double_t phi1 = (iphi+1)*fPhiCellSize;
+
+      Bool_t phiAll   = ( phi0 - eps > phiLow && phi1 + eps < phiUp );
+      Bool_t phiNone  = ( phi1 + eps < phiLow || phi0 - eps > phiUp );
+
+      Bool_t closeAll  = ( rmax + eps <  distMin );  // R < fDistMinToTrigger
+      Bool_t closeNone = ( rmin - eps >= distMin );
+      Bool_t inAll     = ( rmax + eps <  coneSize ); // R < cone size
+      Bool_t inNone    = ( rmin - eps >  coneSize );
+
+      Bool_t sideAll   = ( phi0 - eps - phiC > -TMath::PiOver2() && phi1 + eps - phiC < TMath::PiOver2() );
+      Bool_t sideNone  = ( phi0 - eps - phiC >  TMath::PiOver2() || phi1 + eps - phiC < -TMath::PiOver2() );
+
+      Bool_t uniform = ( !fCellExcluded[icell] &&
+                         ( etaAll   || etaNone   ) && ( phiAll  || phiNone  ) &&
+                         ( closeAll || closeNone ) && ( inAll   || inNone   ) &&
+                         ( sideAll  || sideNone  ) );
+
+      if( uniform )
+      {
+        Double_t sum = fCellSum[index][icell];
+
+        if( closeAll || inAll )
+        {
+          if( etaAll ) phiBand -= sum;
+          if( phiAll ) etaBand -= sum;
+        }
+
+        if( closeNone && inAll && sideAll )
+        {
+          cone += sum;
+
+          // the maximum is negative if all the particles of the cell are skipped
+          if( fCellMax[index][icell] >= 0 && ptLead < fCellMax[index][icell] ) ptLead = fCellMax[index][icell];
+
+          if( fillCone )
+          {
+            for(Int_t i = cellStart[icell]; i < cellStart[icell+1]; i++)
+              if( !IsSkipped(is, i, rejTM) ) fConeItems.push_back(i);
+          }
+        }
+
+        continue;
+      }
+
+      // Cell crossed by the cone or band edges, check the particles
+
+      for(Int_t i = cellStart[icell]; i < cellStart[icell+1]; i++)
+      {
+        if( IsSkipped(is, i, rejTM) ) continue;
+
+        Float_t pt  = pts [i];
+        Float_t eta = etas[i];
+        Float_t phi = phis[i];
+
+        Float_t rad = Radius(etaC, phiC, eta, phi);
+
+        if( rad < distMin || !( rad > coneSize ) )
+        {
+          if( eta > etaLow && eta < etaUp ) phiBand -= pt;
+          if( phi > phiLow && phi < phiUp ) etaBand -= pt;
+        }
+
+        if( rad < distMin ) continue ;
+
+        // Only the particles at the same side of candidate
+        if( TMath::Abs(phi-phiC) > TMath::PiOver2() ) continue ;
+
+        if( rad < coneSize )
+        {
+          cone += pt;
+
+          if( ptLead < pt ) ptLead = pt;
+
+          if( fillCone ) fConeItems.push_back(i);
+        }
+      }
+    }
+  }
+
+  for(UInt_t iex = 0; iex < fExcludedItems.size(); iex++) fItemExcluded[is][fExcludedItems[iex]] = kFALSE;
+
+  // Tracks or clusters in the cone, in the order of the list
+
+  fConeObjects.clear();
+  if( fillCone )
+  {
+    std::vector<std::pair<Int_t,Int_t> > order(fConeItems.size());
+    for(UInt_t i = 0; i < fConeItems.size(); i++) order[i] = std::make_pair(fItemIndex[is][fConeItems[i]], fConeItems[i]);
+    std::sort(order.begin(), order.end());
+
+    for(UInt_t i = 0; i < order.size(); i++) fConeObjects.push_back(fItemObject[is][order[i].second]);
+  }
+
+  // The differences of the sums can be slightly negative by rounding
+  coneSum    = cone;
+  etaBandSum = TMath::Max(0., etaBand);
+  phiBandSum = TMath::Max(0., phiBand);
+}
+
+//______________________________________________________________
+/// Calculate the distance to trigger from any particle.
+/// \param etaC: pseudorapidity of candidate particle.
+/// \param phiC: azimuthal angle of candidate particle.
+/// \param eta: pseudorapidity of track/cluster to be considered in cone.
+/// \param phi: azimuthal angle of track/cluster to be considered in cone.
+//______________________________________________________________
+Float_t AliIsolationConeMap::Radius(Float_t etaC, Float_t phiC,
+                                    Float_t eta , Float_t phi)
+{
+  Float_t dEta = etaC-eta;
+  Float_t dPhi = phiC-phi;
+
+  if(TMath::Abs(dPhi) >= TMath::Pi())
+    dPhi = TMath::TwoPi()-TMath::Abs(dPhi);
+
+  return TMath::Sqrt( dEta*dEta + dPhi*dPhi );
+}
@@ -0,0 +1,159 @@
+#ifndef ALIISOLATIONCONEMAP_H
+#define ALIISOLATIONCONEMAP_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+//_________________________________________________________________________
+/// \class AliIsolationConeMap
+/// \ingroup CaloTrackCorrelationsBase
+/// \brief Per event (eta,phi) map of the tracks and clusters for the isolation cone sums.
+///
+/// The tracks and clusters lists of the reader are stored once per event
+/// in (eta,phi) cells, with the pT sum and maximum of each cell and the 2D
+/// prefix sums (summed-area table) of the cells. The cone and UE band sums
+/// of AliIsolationCut are then obtained for each candidate from the cell
+/// sums of the cells fully inside or outside the cone and bands, and the
+/// particles of the boundary cells are checked one by one. The selection
+/// is the same as in the loops of AliIsolationCut::MakeIsolationCut().
+///
+/// The map is owned by AliCaloTrackReader, so that it is shared by all the
+/// isolation cuts of the analysis in the wagon, and cleared in
+/// AliCaloTrackReader::ResetLists().
+//_________________________________________________________________________
+
+// --- ROOT system ---
+#include <TObject.h>
+class TObjArray ;
+#include <TLorentzVector.h>
+#include <vector>
+
+// --- ANALYSIS system ---
+class AliCaloTrackReader ;
+class AliCaloPID;
+
+class AliIsolationConeMap : public TObject {
+
+ public:
+
+  AliIsolationConeMap() ;  // default ctor
+
+  /// Virtual destructor.
+  virtual ~AliIsolationConeMap() { ; }
+
+  // Enums
+
+  enum species { kTracks = 0, kClusters = 1, kNSpecies = 2 } ;
+
+  // Main Methods
+
+  void       Clear(const Option_t * opt = "") ;
+
+  void       GetConeSums(Int_t species, TObjArray * list,
+                         AliCaloTrackReader * reader, AliCaloPID * pid, Bool_t rejectTM,
+                         Float_t etaC, Float_t phiC, Float_t coneSize, Float_t distMin,
+                         const Int_t * excludedIDs, Int_t nExcluded,
+                         Float_t & coneSum, Float_t & ptLead,
+                         Float_t & etaBandSum, Float_t & phiBandSum, Bool_t fillCone) ;
+
+  Int_t      GetNConeObjects()       const { return fConeObjects.size() ; }
+  TObject *  GetConeObject(Int_t i)  const { return fConeObjects[i]     ; }
+
+  static Float_t Radius(Float_t etaC, Float_t phiC, Float_t eta, Float_t phi) ;
+
+  // Parameter setters and getters
+
+  Float_t    GetCellSize()           const { return fCellSize       ; }
+  Float_t    GetMaxAbsEta()          const { return fMaxAbsEta      ; }
+
+  void       SetCellSize(Float_t s) ;
+  void       SetMaxAbsEta(Float_t e)       { fMaxAbsEta = e ; Clear() ; }
+
+ private:
+
+  void       Fill(Int_t species, TObjArray * list, AliCaloTrackReader * reader) ;
+
+  void       FillTrackMatching(AliCaloPID * pid, AliCaloTrackReader * reader) ;
+
+  void       FillCellSums(Int_t species, Bool_t rejectTM) ;
+
+  void       GetCellRadiusRange(Int_t species, Int_t ieta, Int_t iphi,
+                                Float_t etaC, Float_t phiC, Double_t & rmin, Double_t & rmax) const ;
+
+  Double_t   GetRectangleSum(Int_t index, Int_t ieta0, Int_t ieta1, Int_t iphi0, Int_t iphi1) const ;
+
+  Double_t   GetCellEtaMin(Int_t species, Int_t ieta) const ;
+
+  Double_t   GetCellEtaMax(Int_t species, Int_t ieta) const ;
+
+  Bool_t     IsSkipped(Int_t species, Int_t item, Bool_t rejectTM) const
+  { return fItemExcluded[species][item] || ( rejectTM && fItemTM[species][item] ) ; }
+
+  Float_t    fCellSize ;                                ///< Size of the cells in eta and (approximately) phi.
+
+  Float_t    fMaxAbsEta ;                               ///< Maximum |eta| of the cells, particles beyond are in the first or last eta cells.
+
+  TObjArray * fList[kNSpecies] ;                        //!<! List stored in the map, 0 if not filled.
+
+  Int_t      fNEta[kNSpecies] ;                         //!<! Number of eta cells.
+
+  Int_t      fNPhi ;                                    //!<! Number of phi cells.
+
+  Double_t   fEtaMin[kNSpecies] ;                       //!<! Lower edge of the eta cells.
+
+  Double_t   fPhiCellSize ;                             //!<! Size of the phi cells.
+
+  std::vector<Int_t>    fCellStart[kNSpecies] ;         //!<! First particle of each cell, particles sorted by cell.
+
+  std::vector<Float_t>  fItemPt[kNSpecies] ;            //!<! pT of the particles.
+
+  std::vector<Float_t>  fItemEta[kNSpecies] ;           //!<! Eta of the particles.
+
+  std::vector<Float_t>  fItemPhi[kNSpecies] ;           //!<! Phi of the particles, in [0,2pi].
+
+  std::vector<Int_t>    fItemCell[kNSpecies] ;          //!<! Cell of the particles.
+
+  std::vector<Int_t>    fItemIndex[kNSpecies] ;         //!<! Index of the particles in the list.
+
+  std::vector<TObject*> fItemObject[kNSpecies] ;        //!<! Track or cluster, 0 for mixed event particles.
+
+  std::vector<Bool_t>   fItemTM[kNSpecies] ;            //!<! Cluster matched with a track.
+
+  std::vector<Bool_t>   fItemExcluded[kNSpecies] ;      //!<! Particle of the current candidate, not counted.
+
+  std::vector<Int_t>    fIDs[kNSpecies] ;               //!<! Track or cluster IDs of the particles, sorted.
+
+  std::vector<Int_t>    fIDItem[kNSpecies] ;            //!<! Particle with the ID in fIDs.
+
+  std::vector<Double_t> fCellSum[2*kNSpecies] ;         //!<! pT sum of each cell, index 2*species+1 without track matched clusters.
+
+  std::vector<Float_t>  fCellMax[2*kNSpecies] ;         //!<! Maximum pT of each cell, index 2*species+1 without track matched clusters.
+
+  std::vector<Bool_t>   fCellExcluded ;                 //!<! Cells with a particle of the current candidate.
+
+  std::vector<Double_t> fSAT[2*kNSpecies] ;             //!<! Summed-area table of the cell pT sums, same index as fCellSum.
+
+  AliCaloPID * fTMPid ;                                 //!<! PID used for the track matching of the clusters, 0 if not done.
+
+  std::vector<Int_t>    fExcludedItems ;                //!<! Particles of the current candidate.
+
+  std::vector<Int_t>    fConeItems ;                    //!<! Particles in the cone of the current candidate.
+
+  std::vector<TObject*> fConeObjects ;                  //!<! Tracks or clusters in the cone of the current candidate, in list order.
+
+  TLorentzVector fMomentum;                             //!<! Momentum of cluster, temporal object.
+
+  TVector3   fTrackVector;                              //!<! Track moment, temporal object.
+
+  /// Copy constructor not implemented.
+  AliIsolationConeMap(              const AliIsolationConeMap & m) ;
+
+  /// Assignment operator not implemented.
+  AliIsolationConeMap & operator = (const AliIsolationConeMap & m) ;
+
+  /// \cond CLASSIMP
+  ClassDef(AliIsolationConeMap,1) ;
+  /// \endcond
+
+} ;
+
+#endif //ALIISOLATIONCONEMAP_H
@@ -31,6 +31,7 @@
 #include "AliCaloPID.h"
 #include "AliFiducialCut.h"
 #include "AliIsolationCut.h"
+#include "AliIsolationConeMap.h"
 
 /// \cond CLASSIMP
 ClassImp(AliIsolationCut) ;
@@ -53,6 +54,7 @@ fDebug(0),
 fFracIsThresh(1),
 fIsTMClusterInConeRejected(1),
 fDistMinToTrigger(-1.),
+fUseConeMap(0),
 fMomentum(),
 fTrackVector()
 {
@@ -371,6 +373,8 @@ TString AliIsolationCut::GetICParametersList()
   parList+=onePar ;
   snprintf(onePar,buffersize,"fDistMinToTrigger=%1.2f \n",fDistMinToTrigger) ;
   parList+=onePar ;
+  snprintf(onePar,buffersize,"fUseConeMap=%d \n",fUseConeMap) ;
+  parList+=onePar ;
 
   return parList;
 }
@@ -396,6 +400,10 @@ void AliIsolationCut::InitParameters()
 /// Declare a candidate particle isolated depending on the
 /// cluster or track particle multiplicity and/or momentum.
 ///
+/// With SwitchOnConeMap(), the cone and UE band sums of the track and
+/// cluster lists of the reader are taken from the AliIsolationConeMap
+/// of the reader, filled once per event, instead of looping on the lists.
+///
 /// \param plCTS: List of tracks.
 /// \param plNe: List of clusters.
 /// \param reader: pointer to AliCaloTrackReader. Needed to access event info.
@@ -453,12 +461,49 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   Int_t       ntrackrefs   = 0;
   Int_t       nclusterrefs = 0;
   
+  // --------------------------------
+  // Cone and UE band sums of the reader lists from the event map,
+  // shared by all the isolation cuts, instead of the loops below.
+  // --------------------------------
+  
+  AliIsolationConeMap * coneMap = fUseConeMap ? reader->GetIsolationConeMap() : 0x0;
+  
+  Bool_t useMapTracks   = ( coneMap && plCTS && plCTS == reader->GetCTSTracks() );
+  Bool_t useMapClusters = ( coneMap && plNe  && ( plNe == reader->GetEMCALClusters() ||
+                                                  plNe == reader->GetDCALClusters()  ||
+                                                  plNe == reader->GetPHOSClusters()    ) );
+  
   // --------------------------------
   // Check charged tracks in cone.
   // --------------------------------
   
-  if(plCTS &&
+  if(useMapTracks &&
      (fPartInCone==kOnlyCharged || fPartInCone==kNeutralAndCharged))
+  {
+    // Do not count the candidate or the daughters of the candidate, see below
+    Int_t trackIDs[4];
+    Int_t nTrackIDs = 0;
+    if ( pCandidate->GetDetectorTag() == AliFiducialCut::kCTS )
+    {
+      for(Int_t i = 0; i < 4; i++) trackIDs[nTrackIDs++] = pCandidate->GetTrackLabel(i);
+    }
+    
+    coneMap->GetConeSums(AliIsolationConeMap::kTracks, plCTS, reader, pid, kFALSE,
+                         etaC, phiC, fConeSize, fDistMinToTrigger, trackIDs, nTrackIDs,
+                         coneptsumTrack, ptLead, etaBandPtSumTrack, phiBandPtSumTrack, bFillAOD);
+    
+    if(bFillAOD && coneMap->GetNConeObjects() > 0)
+    {
+      reftracks = new TObjArray(0);
+      TString tempo(aodArrayRefName)  ;
+      tempo += "Tracks" ;
+      reftracks->SetName(tempo);
+      reftracks->SetOwner(kFALSE);
+      for(Int_t i = 0; i < coneMap->GetNConeObjects(); i++) reftracks->Add(coneMap->GetConeObject(i));
+    }
+  }
+  else if(plCTS &&
+          (fPartInCone==kOnlyCharged || fPartInCone==kNeutralAndCharged))
   {
     for(Int_t ipr = 0;ipr < plCTS->GetEntries() ; ipr ++ )
     {
@@ -602,9 +647,32 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   // Check calorimeter clusters in cone.
   // --------------------------------
   
-  if(plNe &&
+  if(useMapClusters &&
      (fPartInCone==kOnlyNeutral || fPartInCone==kNeutralAndCharged))
   {
+    // Do not count the candidate (photon or pi0) or the daughters of the candidate
+    Int_t caloIDs[2] = { pCandidate->GetCaloLabel(0), pCandidate->GetCaloLabel(1) };
+    
+    // Skip matched clusters with tracks in case of neutral+charged analysis
+    Bool_t rejectTM = ( fIsTMClusterInConeRejected && fPartInCone == kNeutralAndCharged );
+    
+    coneMap->GetConeSums(AliIsolationConeMap::kClusters, plNe, reader, pid, rejectTM,
+                         etaC, phiC, fConeSize, fDistMinToTrigger, caloIDs, 2,
+                         coneptsumCluster, ptLead, etaBandPtSumCluster, phiBandPtSumCluster, bFillAOD);
+    
+    if(bFillAOD && coneMap->GetNConeObjects() > 0)
+    {
+      refclusters = new TObjArray(0);
+      TString tempo(aodArrayRefName)  ;
+      tempo += "Clusters" ;
+      refclusters->SetName(tempo);
+      refclusters->SetOwner(kFALSE);
+      for(Int_t i = 0; i < coneMap->GetNConeObjects(); i++) refclusters->Add(coneMap->GetConeObject(i));
+    }
+  }
+  else if(plNe &&
+          (fPartInCone==kOnlyNeutral || fPartInCone==kNeutralAndCharged))
+  {
     
     for(Int_t ipr = 0;ipr < plNe->GetEntries() ; ipr ++ )
     {
@@ -896,6 +964,7 @@ void AliIsolationCut::Print(const Option_t * opt) const
   printf("particle type in cone =  %d\n",    fPartInCone ) ;
   printf("using fraction for high pt leading instead of frac ? %i\n",fFracIsThresh);
   printf("minimum distance to candidate, R>%1.2f\n",fDistMinToTrigger);
+  printf("cone sums from event map ? %d\n",fUseConeMap);
   printf("    \n") ;
 }
 
@@ -909,13 +978,7 @@ void AliIsolationCut::Print(const Option_t * opt) const
 Float_t AliIsolationCut::Radius(Float_t etaC, Float_t phiC,
                                 Float_t eta , Float_t phi) const
 {
-  Float_t dEta = etaC-eta;
-  Float_t dPhi = phiC-phi;
-  
-  if(TMath::Abs(dPhi) >= TMath::Pi())
-    dPhi = TMath::TwoPi()-TMath::Abs(dPhi);
-
-  return TMath::Sqrt( dEta*dEta + dPhi*dPhi );
+  return AliIsolationConeMap::Radius(etaC, phiC, eta, phi);
 }
 
 
@@ -96,6 +96,7 @@ class AliIsolationCut : public TObject {
   Int_t      GetDebug()               const { return fDebug          ; }
   Bool_t     GetFracIsThresh()        const { return fFracIsThresh   ; }
   Float_t    GetMinDistToTrigger()    const { return fDistMinToTrigger ; }
+  Bool_t     IsConeMapOn()            const { return fUseConeMap     ; }
 
   void       SetConeSize(Float_t r)                            { fConeSize          = r    ; }
   void       SetPtThreshold(Float_t pt)                        { fPtThreshold       = pt   ; }
@@ -109,6 +110,8 @@ class AliIsolationCut : public TObject {
   void       SetFracIsThresh(Bool_t f )                        { fFracIsThresh      = f    ; }
   void       SetTrackMatchedClusterRejectionInCone(Bool_t tm)  { fIsTMClusterInConeRejected = tm ; }
   void       SetMinDistToTrigger(Float_t md)                   { fDistMinToTrigger  = md   ; }
+  void       SwitchOnConeMap()                                 { fUseConeMap        = kTRUE  ; }
+  void       SwitchOffConeMap()                                { fUseConeMap        = kFALSE ; }
     
  private:
 
@@ -135,6 +138,8 @@ class AliIsolationCut : public TObject {
   Bool_t     fIsTMClusterInConeRejected; ///< Enable to remove the Track matching removal of clusters in cone sum pt calculation in case of kNeutralAndCharged analysis
   
   Float_t    fDistMinToTrigger;  ///<  Minimal distance between isolation candidate particle and particles in cone to count them for this isolation.
+
+  Bool_t     fUseConeMap;        ///<  Get the cone and UE band sums of the reader lists from the AliIsolationConeMap of the reader.
   
   TLorentzVector fMomentum;      //!<! Momentum of cluster, temporal object.
 
@@ -147,7 +152,7 @@ class AliIsolationCut : public TObject {
   AliIsolationCut & operator = (const AliIsolationCut & g) ; 
 
   /// \cond CLASSIMP
-  ClassDef(AliIsolationCut,11) ;
+  ClassDef(AliIsolationCut,12) ;
   /// \endcond
 
 } ;
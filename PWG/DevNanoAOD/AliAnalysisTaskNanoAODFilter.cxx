@@ -57,7 +57,8 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter() // All data members
   fEvtCuts(0),
   fTrkCuts(0),
   fSetter(0),
-  fSaveCutsFlag(0)
+  fSaveCutsFlag(0),
+  fColumnarTracks(0)
 {
   // Dummy constructor ALWAYS needed for I/O.
 }
@@ -71,7 +72,8 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter(const char *name, Boo
    fEvtCuts(0),
    fTrkCuts(0),
    fSetter(0),
-   fSaveCutsFlag(saveCutsFlag)
+   fSaveCutsFlag(saveCutsFlag),
+   fColumnarTracks(0)
      
 {
   // Constructor
@@ -126,10 +128,20 @@ void AliAnalysisTaskNanoAODFilter::AddFilteredAOD(const char* aodfilename, const
   cout<<"rep: "<<rep<<endl;
   rep->SetCustomSetter(fSetter);
   std::cout << "SETTER: " << fSetter << " " << rep->GetCustomSetter() << std::endl;
+  rep->SetColumnarTracks(fColumnarTracks);
   
   ext->DropUnspecifiedBranches(); // all branches not part of a FilterBranch call (below) will be dropped
       
-  ext->FilterBranch("tracks",rep);
+  if (fColumnarTracks) {
+    // one branch per track variable, named after the columns
+    TIter nextColumn(rep->GetList());
+    TObject * column = 0;
+    while ((column = nextColumn())) {
+      if (TString(column->GetName()).BeginsWith("track_")) ext->FilterBranch(column->GetName(),rep);
+    }
+  } else {
+    ext->FilterBranch("tracks",rep);
+  }
   ext->FilterBranch("vertices",rep);  
   ext->FilterBranch("header",rep);  
             
@@ -0,0 +1,162 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+
+//-------------------------------------------------------------------------
+//     Columnar storage for nanoAOD tracks, see header for details
+//-------------------------------------------------------------------------
+
+#include "TBuffer.h"
+
+#include "AliNanoAODColumn.h"
+
+ClassImp(AliNanoAODColumnF)
+ClassImp(AliNanoAODColumnI)
+
+//______________________________________________________________________________
+AliNanoAODColumnF::AliNanoAODColumnF(const char * name) :
+  TObject(),
+  fColumnName(name),
+  fN(0),
+  fValues(0),
+  fCapacity(0)
+{
+  // ctor
+}
+
+//______________________________________________________________________________
+AliNanoAODColumnF::~AliNanoAODColumnF()
+{
+  // dtor
+  delete [] fValues;
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumnF::Set(Int_t n)
+{
+  // Resize the column to n tracks. The content is not preserved.
+  // The array only grows: it is reallocated only if n is larger
+  // than the capacity, otherwise the allocation is reused.
+  if (n < 0) n = 0;
+  if (n > fCapacity) {
+    delete [] fValues;
+    fValues = new Float_t[n];
+    fCapacity = n;
+  }
+  fN = n;
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumnF::Streamer(TBuffer &R__b)
+{
+  // Stream the column: TObject, fN and the fN values.
+  // When reading, the array is resized with Set(), so that it is
+  // not reallocated for every entry as with the automatic streamer.
+  // Version 1 was written by the automatic streamer.
+  if (R__b.IsReading()) {
+    UInt_t R__s, R__c;
+    Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
+    if (R__v < 2) {
+      R__b.ReadClassBuffer(AliNanoAODColumnF::Class(), this, R__v, R__s, R__c);
+      fCapacity = fValues ? fN : 0;
+      return;
+    }
+    TObject::Streamer(R__b);
+    Int_t n;
+    R__b >> n;
+    Set(n);
+    R__b.ReadFastArray(fValues, fN);
+    R__b.CheckByteCount(R__s, R__c, AliNanoAODColumnF::IsA());
+  } else {
+    UInt_t R__c = R__b.WriteVersion(AliNanoAODColumnF::IsA(), kTRUE);
+    TObject::Streamer(R__b);
+    R__b << fN;
+    R__b.WriteFastArray(fValues, fN);
+    R__b.SetByteCount(R__c, kTRUE);
+  }
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumnF::Clear(Option_t * /*opt*/)
+{
+  // Empty the column
+  Set(0);
+}
+
+//______________________________________________________________________________
+AliNanoAODColumnI::AliNanoAODColumnI(const char * name) :
+  TObject(),
+  fColumnName(name),
+  fN(0),
+  fValues(0),
+  fCapacity(0)
+{
+  // ctor
+}
+
+//______________________________________________________________________________
+AliNanoAODColumnI::~AliNanoAODColumnI()
+{
+  // dtor
+  delete [] fValues;
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumnI::Set(Int_t n)
+{
+  // Resize the column to n tracks. The content is not preserved.
+  // The array only grows, see AliNanoAODColumnF::Set.
+  if (n < 0) n = 0;
+  if (n > fCapacity) {
+    delete [] fValues;
+    fValues = new Int_t[n];
+    fCapacity = n;
+  }
+  fN = n;
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumnI::Streamer(TBuffer &R__b)
+{
+  // Stream the column, see AliNanoAODColumnF::Streamer.
+  if (R__b.IsReading()) {
+    UInt_t R__s, R__c;
+    Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
+    if (R__v < 2) {
+      R__b.ReadClassBuffer(AliNanoAODColumnI::Class(), this, R__v, R__s, R__c);
+      fCapacity = fValues ? fN : 0;
+      return;
+    }
+    TObject::Streamer(R__b);
+    Int_t n;
+    R__b >> n;
+    Set(n);
+    R__b.ReadFastArray(fValues, fN);
+    R__b.CheckByteCount(R__s, R__c, AliNanoAODColumnI::IsA());
+  } else {
+    UInt_t R__c = R__b.WriteVersion(AliNanoAODColumnI::IsA(), kTRUE);
+    TObject::Streamer(R__b);
+    R__b << fN;
+    R__b.WriteFastArray(fValues, fN);
+    R__b.SetByteCount(R__c, kTRUE);
+  }
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumnI::Clear(Option_t * /*opt*/)
+{
+  // Empty the column
+  Set(0);
+}
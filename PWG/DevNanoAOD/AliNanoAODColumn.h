@@ -0,0 +1,84 @@
+#ifndef ALINANOAODCOLUMN_H
+#define ALINANOAODCOLUMN_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//-------------------------------------------------------------------------
+//     Columnar storage for nanoAOD tracks
+//     One column holds a single track variable for all the tracks of an
+//     event, as a contiguous array. Each column is attached to the
+//     output tree as its own branch ("track_pt", "track_phi", ...), so
+//     that an analysis reading only a few variables only touches the
+//     corresponding baskets. The column name is not streamed: it is
+//     given by the branch name.
+//
+//     The array keeps its allocation between events: it is only
+//     reallocated when an event has more tracks than the capacity,
+//     also when reading (custom streamer).
+//
+//     AliNanoAODColumnF: float values (the variables of the mapping)
+//     AliNanoAODColumnI: integer values (label, charge)
+//-------------------------------------------------------------------------
+
+#include "TObject.h"
+#include "TString.h"
+
+class AliNanoAODColumnF : public TObject {
+
+public:
+  AliNanoAODColumnF(const char * name = "");
+  virtual ~AliNanoAODColumnF();
+
+  virtual const char * GetName() const { return fColumnName.Data(); }
+  void  SetName(const char * name) { fColumnName = name; }
+
+  virtual void Clear(Option_t * opt="") ;
+
+  Int_t  GetSize() const { return fN; }
+  void   Set(Int_t n);
+  void   SetAt(Int_t i, Float_t value) { fValues[i] = value; }
+  Float_t At(Int_t i) const { return fValues[i]; }
+  const Float_t * GetArray() const { return fValues; }
+
+private:
+  AliNanoAODColumnF(const AliNanoAODColumnF&);
+  AliNanoAODColumnF& operator=(const AliNanoAODColumnF&);
+
+  TString  fColumnName; //! name of the column (= branch name)
+  Int_t    fN;          // number of tracks in the event
+  Float_t *fValues;     //[fN] values, one per track
+  Int_t    fCapacity;   //! allocated size of fValues (>= fN)
+
+  ClassDef(AliNanoAODColumnF, 2);
+};
+
+class AliNanoAODColumnI : public TObject {
+
+public:
+  AliNanoAODColumnI(const char * name = "");
+  virtual ~AliNanoAODColumnI();
+
+  virtual const char * GetName() const { return fColumnName.Data(); }
+  void  SetName(const char * name) { fColumnName = name; }
+
+  virtual void Clear(Option_t * opt="") ;
+
+  Int_t  GetSize() const { return fN; }
+  void   Set(Int_t n);
+  void   SetAt(Int_t i, Int_t value) { fValues[i] = value; }
+  Int_t  At(Int_t i) const { return fValues[i]; }
+  const Int_t * GetArray() const { return fValues; }
+
+private:
+  AliNanoAODColumnI(const AliNanoAODColumnI&);
+  AliNanoAODColumnI& operator=(const AliNanoAODColumnI&);
+
+  TString  fColumnName; //! name of the column (= branch name)
+  Int_t    fN;          // number of tracks in the event
+  Int_t   *fValues;     //[fN] values, one per track
+  Int_t    fCapacity;   //! allocated size of fValues (>= fN)
+
+  ClassDef(AliNanoAODColumnI, 2);
+};
+
+#endif
@@ -0,0 +1,236 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+
+//-------------------------------------------------------------------------
+//     Reader for nanoAOD tracks written in columnar mode, see header
+//-------------------------------------------------------------------------
+
+#include <TTree.h>
+#include <TBranch.h>
+#include <TObjArray.h>
+#include <TObjString.h>
+#include "AliLog.h"
+
+#include "AliNanoAODColumnReader.h"
+#include "AliNanoAODColumn.h"
+#include "AliNanoAODReplicator.h"
+#include "AliNanoAODTrack.h"
+#include "AliNanoAODTrackMapping.h"
+
+ClassImp(AliNanoAODColumnReader)
+
+//______________________________________________________________________________
+AliNanoAODColumnReader::AliNanoAODColumnReader() :
+  TObject(),
+  fTree(0),
+  fNColumns(0),
+  fColumns(0),
+  fLabels(0),
+  fCharges(0),
+  fVarList(""),
+  fMappingIndex(),
+  fTrack(0),
+  fTrackIndex(-1)
+{
+  // ctor
+}
+
+//______________________________________________________________________________
+AliNanoAODColumnReader::~AliNanoAODColumnReader()
+{
+  // dtor
+  Reset();
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumnReader::Reset()
+{
+  // Disconnect from the tree and delete the columns. Only the addresses
+  // of the track columns are reset, the other branches are left untouched.
+  for (Int_t icolumn = 0; icolumn < fNColumns; icolumn++) {
+    if (fTree) fTree->ResetBranchAddress(fTree->GetBranch(fColumns[icolumn]->GetName()));
+    delete fColumns[icolumn];
+  }
+  if (fTree && fLabels) fTree->ResetBranchAddress(fTree->GetBranch(fLabels->GetName()));
+  if (fTree && fCharges) fTree->ResetBranchAddress(fTree->GetBranch(fCharges->GetName()));
+  fTree = 0;
+  delete [] fColumns;
+  fColumns = 0;
+  fNColumns = 0;
+  delete fLabels;
+  fLabels = 0;
+  delete fCharges;
+  fCharges = 0;
+  delete fTrack;
+  fTrack = 0;
+  fTrackIndex = -1;
+  fVarList = "";
+  fMappingIndex.Set(0);
+}
+
+//______________________________________________________________________________
+Bool_t AliNanoAODColumnReader::Connect(TTree * tree, const char * vars)
+{
+  // Attach the track columns of the tree. If vars (comma separated) is
+  // given, only those variables are read; otherwise all the columns
+  // found in the tree are connected.
+
+  Reset();
+  if (!tree) return kFALSE;
+
+  const TString prefix = AliNanoAODReplicator::GetTrackColumnName("");
+  const TString labelName = AliNanoAODReplicator::GetTrackColumnName("label");
+  const TString chargeName = AliNanoAODReplicator::GetTrackColumnName("charge");
+
+  TObjArray * requested = 0;
+  if (vars) {
+    TString varList(vars);
+    varList.ReplaceAll(" ", "");
+    requested = varList.Tokenize(",");
+  }
+
+  // Collect the variable columns to connect, in the order of the tree
+  TObjArray * branches = tree->GetListOfBranches();
+  TObjArray selected;
+  selected.SetOwner(kTRUE);
+  for (Int_t ibranch = 0; ibranch < branches->GetEntriesFast(); ibranch++) {
+    TString name = branches->UncheckedAt(ibranch)->GetName();
+    if (!name.BeginsWith(prefix) || name == labelName || name == chargeName) continue;
+    TString var = name(prefix.Length(), name.Length() - prefix.Length());
+    Bool_t isRequested = !requested;
+    for (Int_t ivar = 0; requested && ivar < requested->GetEntriesFast(); ivar++) {
+      if (var == static_cast<TObjString*>(requested->UncheckedAt(ivar))->String()) {
+	isRequested = kTRUE;
+	break;
+      }
+    }
+    tree->SetBranchStatus(name, isRequested);
+    if (isRequested) selected.Add(new TObjString(var));
+  }
+
+  if (requested && selected.GetEntriesFast() < requested->GetEntriesFast()) {
+    AliWarning(Form("Only %d of the %d requested variables are available in the tree",
+		    selected.GetEntriesFast(), requested->GetEntriesFast()));
+  }
+  delete requested;
+
+  if (!tree->GetBranch(labelName) || !tree->GetBranch(chargeName)) {
+    AliError("The tree does not contain columnar nanoAOD tracks");
+    return kFALSE;
+  }
+
+  fTree = tree;
+  fNColumns = selected.GetEntriesFast();
+  fColumns = new AliNanoAODColumnF*[fNColumns > 0 ? fNColumns : 1];
+  for (Int_t icolumn = 0; icolumn < fNColumns; icolumn++) {
+    const TString & var = static_cast<TObjString*>(selected.UncheckedAt(icolumn))->String();
+    fColumns[icolumn] = new AliNanoAODColumnF(AliNanoAODReplicator::GetTrackColumnName(var));
+    fTree->SetBranchAddress(fColumns[icolumn]->GetName(), &fColumns[icolumn]);
+    if (icolumn) fVarList += ",";
+    fVarList += var;
+  }
+
+  fLabels = new AliNanoAODColumnI(labelName);
+  fTree->SetBranchStatus(labelName, 1);
+  fTree->SetBranchAddress(labelName, &fLabels);
+  fCharges = new AliNanoAODColumnI(chargeName);
+  fTree->SetBranchStatus(chargeName, 1);
+  fTree->SetBranchAddress(chargeName, &fCharges);
+
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+Int_t AliNanoAODColumnReader::GetEntry(Long64_t entry)
+{
+  // Read the connected columns of an event
+  fTrackIndex = -1;
+  if (!fTree) return 0;
+  return fTree->GetEntry(entry);
+}
+
+//______________________________________________________________________________
+Int_t AliNanoAODColumnReader::GetNumberOfTracks() const
+{
+  // Number of tracks in the current event
+  return fLabels ? fLabels->GetSize() : 0;
+}
+
+//______________________________________________________________________________
+Int_t AliNanoAODColumnReader::GetColumnIndex(const char * var) const
+{
+  // Index of the column of a variable, -1 if not connected
+  const TString name = AliNanoAODReplicator::GetTrackColumnName(var);
+  for (Int_t icolumn = 0; icolumn < fNColumns; icolumn++) {
+    if (name == fColumns[icolumn]->GetName()) return icolumn;
+  }
+  return -1;
+}
+
+//______________________________________________________________________________
+const Float_t * AliNanoAODColumnReader::GetColumn(Int_t icolumn) const
+{
+  // Values of a variable for all the tracks of the current event
+  if (icolumn < 0 || icolumn >= fNColumns) return 0;
+  return fColumns[icolumn]->GetArray();
+}
+
+//______________________________________________________________________________
+const Int_t * AliNanoAODColumnReader::GetLabels() const
+{
+  // Labels of all the tracks of the current event
+  return fLabels ? fLabels->GetArray() : 0;
+}
+
+//______________________________________________________________________________
+const Int_t * AliNanoAODColumnReader::GetCharges() const
+{
+  // Charges of all the tracks of the current event
+  return fCharges ? fCharges->GetArray() : 0;
+}
+
+//______________________________________________________________________________
+AliNanoAODTrack * AliNanoAODColumnReader::GetTrack(Int_t itrack)
+{
+  // Fill the track facade with track itrack of the current event.
+  // The returned object is owned by the reader and reused.
+
+  if (itrack < 0 || itrack >= GetNumberOfTracks()) return 0;
+  if (itrack == fTrackIndex) return fTrack;
+
+  if (!fTrack) {
+    // The mapping is a singleton: if one already exists (e.g. read from
+    // the user info of the tree) the columns are matched to it by name
+    fTrack = new AliNanoAODTrack(fVarList);
+    AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance();
+    fMappingIndex.Set(fNColumns);
+    for (Int_t icolumn = 0; icolumn < fNColumns; icolumn++) {
+      TString var = fColumns[icolumn]->GetName();
+      var.Remove(0, AliNanoAODReplicator::GetTrackColumnName("").Length());
+      fMappingIndex[icolumn] = mapping->GetVarIndex(var);
+    }
+  }
+
+  for (Int_t icolumn = 0; icolumn < fNColumns; icolumn++) {
+    if (fMappingIndex[icolumn] < 0) continue;
+    fTrack->SetVar(fMappingIndex[icolumn], fColumns[icolumn]->At(itrack));
+  }
+  fTrack->SetLabel(fLabels->At(itrack));
+  fTrack->SetCharge(fCharges->At(itrack));
+  fTrackIndex = itrack;
+
+  return fTrack;
+}
@@ -0,0 +1,85 @@
+#ifndef ALINANOAODCOLUMNREADER_H
+#define ALINANOAODCOLUMNREADER_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//-------------------------------------------------------------------------
+//     Reader for nanoAOD tracks written in columnar mode
+//     (AliNanoAODReplicator::SetColumnarTracks)
+//
+//     Connect() attaches the track_<var> branches of the tree. If a
+//     list of variables is given, only those columns (plus label and
+//     charge) are read, all other track columns are switched off, so
+//     that their baskets are never read.
+//
+//     After GetEntry(), GetColumn() returns the values of a variable
+//     for all the tracks of the event. The values are streamed into the
+//     array of the column, which is reused from event to event (it is
+//     only reallocated when an event has more tracks than any before).
+//     The pointer is valid until the next GetEntry().
+//
+//     For code which needs an AliVTrack, GetTrack() fills a single
+//     AliNanoAODTrack from the connected columns. Only the connected
+//     variables are meaningful, and the object is reused: it is
+//     overwritten by the next call.
+//
+//     Usage:
+//       AliNanoAODColumnReader reader;
+//       reader.Connect(tree, "pt,phi,theta");
+//       for (Long64_t ev = 0; ev < tree->GetEntries(); ev++) {
+//         reader.GetEntry(ev);
+//         const Float_t * pt = reader.GetColumn("pt");
+//         for (Int_t i = 0; i < reader.GetNumberOfTracks(); i++) h->Fill(pt[i]);
+//       }
+//-------------------------------------------------------------------------
+
+#include "TObject.h"
+#include "TString.h"
+#include "TArrayI.h"
+
+class TTree;
+class AliNanoAODColumnF;
+class AliNanoAODColumnI;
+class AliNanoAODTrack;
+
+class AliNanoAODColumnReader : public TObject {
+
+public:
+  AliNanoAODColumnReader();
+  virtual ~AliNanoAODColumnReader();
+
+  Bool_t Connect(TTree * tree, const char * vars = 0);
+  Int_t  GetEntry(Long64_t entry);
+
+  Int_t  GetNumberOfTracks() const;
+  Int_t  GetNumberOfColumns() const { return fNColumns; }
+  const char * GetVarList() const { return fVarList.Data(); }
+
+  Int_t  GetColumnIndex(const char * var) const;
+  const Float_t * GetColumn(Int_t icolumn) const;
+  const Float_t * GetColumn(const char * var) const { return GetColumn(GetColumnIndex(var)); }
+  const Int_t * GetLabels() const;
+  const Int_t * GetCharges() const;
+
+  AliNanoAODTrack * GetTrack(Int_t itrack);
+
+private:
+  AliNanoAODColumnReader(const AliNanoAODColumnReader&);
+  AliNanoAODColumnReader& operator=(const AliNanoAODColumnReader&);
+
+  void Reset();
+
+  TTree * fTree;                  //! connected tree
+  Int_t   fNColumns;              //! number of connected variable columns
+  AliNanoAODColumnF ** fColumns;  //! [fNColumns] connected variable columns
+  AliNanoAODColumnI *  fLabels;   //! label column
+  AliNanoAODColumnI *  fCharges;  //! charge column
+  TString fVarList;               //! comma separated list of the connected variables
+  TArrayI fMappingIndex;          //! index of each column in AliNanoAODTrackMapping
+  AliNanoAODTrack * fTrack;       //! track facade, created on first use
+  Int_t   fTrackIndex;            //! track currently held by fTrack (-1 if none)
+
+  ClassDef(AliNanoAODColumnReader, 1);
+};
+
+#endif
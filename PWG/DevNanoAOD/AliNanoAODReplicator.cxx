@@ -74,6 +74,8 @@ class AliAODRecoDecay;
 #include "TCanvas.h"
 #include "AliNanoAODHeader.h"
 #include "AliNanoAODCustomSetter.h"
+#include "AliNanoAODColumn.h"
+#include "AliNanoAODTrackMapping.h"
 
 using std::cout;
 using std::endl;
@@ -93,7 +95,11 @@ AliAODBranchReplicator(),
   fParticleSelected(),
   fVarList(""),
   fVarListHeader(""),
-  fCustomSetter(0){
+  fCustomSetter(0),
+  fColumnarTracks(kFALSE),
+  fTrackColumns(0x0),
+  fLabelColumn(0x0),
+  fChargeColumn(0x0){
   // Default ctor. we need it to avoid instantiating a wrong mapping when reading from file 
   }
 
@@ -114,7 +120,11 @@ AliNanoAODReplicator::AliNanoAODReplicator(const char* name, const char* title,
   fParticleSelected(),
   fVarList(varlist),
   fVarListHeader(""),// FIXME: this should be set to a meaningful value: add an arg to the constructor
-  fCustomSetter(0)
+  fCustomSetter(0),
+  fColumnarTracks(kFALSE),
+  fTrackColumns(0x0),
+  fLabelColumn(0x0),
+  fChargeColumn(0x0)
 {
   // default ctor
   AliNanoAODTrackMapping * tm =new AliNanoAODTrackMapping(fVarList);
@@ -128,6 +138,8 @@ AliNanoAODReplicator::~AliNanoAODReplicator()
   // dtor
   delete fTrackCut;
   delete fList;
+  if (fColumnarTracks) delete fTracks; // not owned by fList in columnar mode
+  delete fTrackColumns;
 }
 
 //_____________________________________________________________________________
@@ -395,6 +407,33 @@ void AliNanoAODReplicator::FilterMC(const AliAODEvent& source)
 
 }
 
+//_____________________________________________________________________________
+void AliNanoAODReplicator::FillTrackColumns()
+{
+  // Copy the selected tracks into the columns (columnar mode).
+  // Called after FilterMC, so that the labels are already remapped.
+  // Each column is filled in one go, so that the writes are contiguous.
+
+  const Int_t ntracks = fTracks->GetEntriesFast();
+  const Int_t ncolumns = fTrackColumns->GetEntriesFast();
+
+  for (Int_t ivar = 0; ivar < ncolumns; ivar++) {
+    AliNanoAODColumnF * column = static_cast<AliNanoAODColumnF*>(fTrackColumns->UncheckedAt(ivar));
+    column->Set(ntracks);
+    for (Int_t itrack = 0; itrack < ntracks; itrack++) {
+      column->SetAt(itrack, static_cast<AliNanoAODTrack*>(fTracks->UncheckedAt(itrack))->GetVar(ivar));
+    }
+  }
+
+  fLabelColumn->Set(ntracks);
+  fChargeColumn->Set(ntracks);
+  for (Int_t itrack = 0; itrack < ntracks; itrack++) {
+    AliNanoAODTrack * track = static_cast<AliNanoAODTrack*>(fTracks->UncheckedAt(itrack));
+    fLabelColumn->SetAt(itrack, track->GetLabel());
+    fChargeColumn->SetAt(itrack, track->Charge());
+  }
+}
+
 // //_____________________________________________________________________________
 TList* AliNanoAODReplicator::GetList() const
 {
@@ -407,7 +446,23 @@ TList* AliNanoAODReplicator::GetList() const
 
       fTracks = new TClonesArray("AliNanoAODTrack");      
       fTracks->SetName("tracks"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
-      fList->Add(fTracks);    
+      if (!fColumnarTracks) {
+	fList->Add(fTracks);    
+      } else {
+	// The tracks array is only used internally (MC label remapping, custom setter):
+	// what is written out is one column per variable, plus label and charge
+	AliNanoAODTrackMapping * tm = AliNanoAODTrackMapping::GetInstance(fVarList);
+	fTrackColumns = new TObjArray(tm->GetSize());
+	for (Int_t ivar = 0; ivar < tm->GetSize(); ivar++) {
+	  AliNanoAODColumnF * column = new AliNanoAODColumnF(GetTrackColumnName(tm->GetVarName(ivar)));
+	  fTrackColumns->Add(column);
+	  fList->Add(column);
+	}
+	fLabelColumn = new AliNanoAODColumnI(GetTrackColumnName("label"));
+	fList->Add(fLabelColumn);
+	fChargeColumn = new AliNanoAODColumnI(GetTrackColumnName("charge"));
+	fList->Add(fChargeColumn);
+      }
 
       fHeader = new AliNanoAODHeader(3);// TODO: to be customized
       fHeader->SetName("header"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
@@ -470,7 +525,10 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
   }
 
   const Int_t entries = source.GetNumberOfTracks();
-  if(entries<=0) return;
+  if(entries<=0) {
+    if(fColumnarTracks) FillTrackColumns(); // do not leave the previous event in the columns
+    return;
+  }
 
   for(Int_t j=0; j<entries; j++){
     
@@ -509,6 +567,10 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
   if ( fMCMode > 0 ) {
     FilterMC(source);      
   }
+
+  if ( fColumnarTracks ) {
+    FillTrackColumns();
+  }
   
 
 }
@@ -30,6 +30,7 @@
 
 class AliAnalysisCuts;
 class TClonesArray;
+class TObjArray;
 class AliAODMCHeader;
 class AliAODVZERO;
 class AliAODTZERO;
@@ -56,6 +57,7 @@ class AliAnalysisTaskSE;
 class AliNanoAODTrack;
 class AliAODTrack;
 class AliNanoAODCustomSetter;
+class AliNanoAODColumnI;
 
 class TH1F;
 
@@ -88,6 +90,14 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   AliNanoAODCustomSetter * GetCustomSetter() { return fCustomSetter; }
   void  SetCustomSetter (AliNanoAODCustomSetter * var) { fCustomSetter = var;  }
 
+  // Columnar track storage: each variable is written to its own branch
+  // (track_<var>) holding the values of all tracks of the event, instead
+  // of the "tracks" array of AliNanoAODTrack. Must be set before GetList.
+  // Read back with AliNanoAODColumnReader.
+  Bool_t GetColumnarTracks() const { return fColumnarTracks; }
+  void   SetColumnarTracks(Bool_t var = kTRUE) { fColumnarTracks = var; }
+  static TString GetTrackColumnName(const char * var) { return TString("track_") + var; }
+
 
  private:
 
@@ -96,6 +106,7 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   void CreateLabelMap(const AliAODEvent& source);
   Int_t GetNewLabel(Int_t i);
   void FilterMC(const AliAODEvent& source);
+  void FillTrackColumns();
  
 
  private:
@@ -121,13 +132,18 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
 
   AliNanoAODCustomSetter * fCustomSetter;  // Setter class for custom variables
 
+  Bool_t fColumnarTracks; // write tracks as one branch per variable
+  mutable TObjArray* fTrackColumns; //! columns of the track variables, in the order of the mapping
+  mutable AliNanoAODColumnI* fLabelColumn; //! column of the track labels
+  mutable AliNanoAODColumnI* fChargeColumn; //! column of the track charges
+
  private:
 
   
   AliNanoAODReplicator(const AliNanoAODReplicator&);
   AliNanoAODReplicator& operator=(const AliNanoAODReplicator&);
   
-  ClassDef(AliNanoAODReplicator,1) // Branch replicator for ESD to muon AOD.
+  ClassDef(AliNanoAODReplicator,2) // Branch replicator for ESD to muon AOD.
 };
 
 #endif
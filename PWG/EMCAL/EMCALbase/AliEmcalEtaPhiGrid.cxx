@@ -0,0 +1,176 @@
+//
+// Cell grid in eta-phi for neighbour searches
+//
+
+#include "AliEmcalEtaPhiGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <TMath.h>
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalEtaPhiGrid);
+/// \endcond
+
+/// Smallest cell size: smaller radii use larger cells, which only adds candidates,
+/// so that the number of cells stays bounded (at most 628 cells in \f$\phi\f$).
+static const Double_t kMinCellSize = 0.01;
+
+/**
+ * Constructor
+ * @param[in] etaMin Lower edge of the grid in \f$\eta\f$
+ * @param[in] etaMax Upper edge of the grid in \f$\eta\f$
+ */
+AliEmcalEtaPhiGrid::AliEmcalEtaPhiGrid(Double_t etaMin, Double_t etaMax) :
+  TObject(),
+  fEtaMin(etaMin),
+  fEtaMax(etaMax),
+  fNEta(1),
+  fNPhi(1),
+  fEtaWidth(etaMax - etaMin),
+  fPhiWidth(TMath::TwoPi()),
+  fIds(),
+  fCells(),
+  fCellStart(),
+  fCellIds(),
+  fNoCellIds()
+{
+}
+
+/**
+ * Remove all the entries and set the cell size for a new search radius.
+ * The cells are slightly larger than the radius, such that two positions closer
+ * than the radius are always in the same or in adjacent cells. Radii below 0.01
+ * use cells of size 0.01.
+ * @param[in] radius Maximum distance in \f$\eta\f$ and in \f$\phi\f$ of the candidates from the query point
+ */
+void AliEmcalEtaPhiGrid::Reset(Double_t radius)
+{
+  Double_t cellSize = radius * 1.001;
+  if (cellSize > 0 && cellSize < kMinCellSize) cellSize = kMinCellSize;
+
+  fNEta = 1;
+  fNPhi = 1;
+  if (cellSize > 0 && TMath::Finite(cellSize)) {
+    if (fEtaMax > fEtaMin) fNEta = TMath::Max(1, TMath::FloorNint((fEtaMax - fEtaMin) / cellSize));
+    fNPhi = TMath::Max(1, TMath::FloorNint(TMath::TwoPi() / cellSize));
+  }
+  fEtaWidth = (fEtaMax - fEtaMin) / fNEta;
+  fPhiWidth = TMath::TwoPi() / fNPhi;
+
+  fIds.clear();
+  fCells.clear();
+  fCellIds.clear();
+  fNoCellIds.clear();
+  fCellStart.assign(fNEta * fNPhi + 1, 0);
+}
+
+/**
+ * Add an entry. The entries have to be added with increasing id for the candidates to be sorted.
+ * @param[in] id Identifier of the entry returned by GetCandidates(), e.g. its index in the event
+ * @param[in] eta Position in \f$\eta\f$
+ * @param[in] phi Position in \f$\phi\f$ (any range)
+ */
+void AliEmcalEtaPhiGrid::Add(Int_t id, Double_t eta, Double_t phi)
+{
+  Int_t cell = -1;
+  if (TMath::Finite(eta) && TMath::Finite(phi)) cell = GetEtaCell(eta) * fNPhi + GetPhiCell(phi);
+
+  fIds.push_back(id);
+  fCells.push_back(cell);
+}
+
+/**
+ * Group the entries by cell. Has to be called after the last Add() and before GetCandidates().
+ */
+void AliEmcalEtaPhiGrid::Build()
+{
+  const Int_t nCells = fNEta * fNPhi;
+  const Int_t nEntries = fIds.size();
+
+  fCellStart.assign(nCells + 1, 0);
+  for (Int_t i = 0; i < nEntries; i++) {
+    if (fCells[i] >= 0) fCellStart[fCells[i] + 1]++;
+  }
+  for (Int_t icell = 0; icell < nCells; icell++) fCellStart[icell + 1] += fCellStart[icell];
+
+  fCellIds.resize(fCellStart[nCells]);
+  fNoCellIds.clear();
+  std::vector<Int_t> next(fCellStart.begin(), fCellStart.end() - 1);
+  for (Int_t i = 0; i < nEntries; i++) {
+    if (fCells[i] >= 0) {
+      fCellIds[next[fCells[i]]++] = fIds[i];
+    }
+    else {
+      fNoCellIds.push_back(fIds[i]);
+    }
+  }
+}
+
+/**
+ * Find the entries which can be within the search radius of a point.
+ * @param[in] eta Position of the point in \f$\eta\f$
+ * @param[in] phi Position of the point in \f$\phi\f$ (any range)
+ * @param[out] candidates Ids of the candidate entries, sorted
+ * @return Number of candidates
+ */
+Int_t AliEmcalEtaPhiGrid::GetCandidates(Double_t eta, Double_t phi, std::vector<Int_t> &candidates) const
+{
+  candidates.clear();
+
+  if (!TMath::Finite(eta) || !TMath::Finite(phi)) {
+    candidates = fIds;
+  }
+  else {
+    const Int_t ieta = GetEtaCell(eta);
+    const Int_t iphi = GetPhiCell(phi);
+
+    // neighbouring cells in phi, wrapping around; with less than 3 cells all of them are neighbours
+    Int_t phiCells[3] = {iphi, -1, -1};
+    Int_t nPhiCells = 1;
+    if (fNPhi >= 3) {
+      phiCells[nPhiCells++] = (iphi + fNPhi - 1) % fNPhi;
+      phiCells[nPhiCells++] = (iphi + 1) % fNPhi;
+    }
+    else if (fNPhi == 2) {
+      phiCells[nPhiCells++] = 1 - iphi;
+    }
+
+    for (Int_t jeta = TMath::Max(0, ieta - 1); jeta <= TMath::Min(fNEta - 1, ieta + 1); jeta++) {
+      for (Int_t k = 0; k < nPhiCells; k++) {
+        const Int_t cell = jeta * fNPhi + phiCells[k];
+        candidates.insert(candidates.end(), fCellIds.begin() + fCellStart[cell], fCellIds.begin() + fCellStart[cell + 1]);
+      }
+    }
+    candidates.insert(candidates.end(), fNoCellIds.begin(), fNoCellIds.end());
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+
+  return candidates.size();
+}
+
+/**
+ * Cell in \f$\eta\f$, positions outside the grid are put in the first or last cell.
+ * @param[in] eta Position in \f$\eta\f$
+ * @return Cell index in \f$\eta\f$
+ */
+Int_t AliEmcalEtaPhiGrid::GetEtaCell(Double_t eta) const
+{
+  if (!(eta > fEtaMin)) return 0;
+  if (!(eta < fEtaMax)) return fNEta - 1;
+  return TMath::Min(fNEta - 1, Int_t((eta - fEtaMin) / fEtaWidth));
+}
+
+/**
+ * Cell in \f$\phi\f$, the position is first mapped to [0, \f$2\pi\f$).
+ * @param[in] phi Position in \f$\phi\f$
+ * @return Cell index in \f$\phi\f$
+ */
+Int_t AliEmcalEtaPhiGrid::GetPhiCell(Double_t phi) const
+{
+  Double_t p = std::fmod(phi, TMath::TwoPi());
+  if (p < 0) p += TMath::TwoPi();
+  return TMath::Max(0, TMath::Min(fNPhi - 1, Int_t(p / fPhiWidth)));
+}
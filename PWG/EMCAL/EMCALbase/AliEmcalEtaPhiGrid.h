@@ -0,0 +1,73 @@
+#ifndef ALIEMCALETAPHIGRID_H
+#define ALIEMCALETAPHIGRID_H
+
+#include <vector>
+
+#include <TObject.h>
+
+/**
+ * @class AliEmcalEtaPhiGrid
+ * @ingroup EMCALCOREFW
+ * @brief Cell grid in (\f$\eta\f$,\f$\phi\f$) to find the objects within a given distance of a point
+ *
+ * The objects (e.g. the clusters of an event) are added once per event with their position on the
+ * EMCal surface, then each query (e.g. a track extrapolated to the EMCal surface) only returns the
+ * objects in its own and in the neighbouring cells instead of all of them. The cells are at least as
+ * large as the search radius, so every object within the radius in \f$\eta\f$ and in \f$\phi\f$
+ * (taken modulo \f$2\pi\f$) is among the candidates. The candidates still have to be checked with the
+ * exact distance by the caller, which therefore obtains the same matches as with a loop over all objects.
+ *
+ * The candidates are returned sorted by their id, i.e. in the same order as a loop over all objects.
+ * Objects or queries with a non-finite position are never dropped: they are compared with everything.
+ *
+ * Usage:
+ * ~~~{.cxx}
+ * fGrid.Reset(fMaxDistance);
+ * for (Int_t i = 0; i < nClusters; i++) fGrid.Add(i, clusterEta[i], clusterPhi[i]);
+ * fGrid.Build();
+ * for (Int_t j = 0; j < nTracks; j++) {
+ *   const Int_t n = fGrid.GetCandidates(trackEta[j], trackPhi[j], candidates);
+ *   for (Int_t k = 0; k < n; k++) { ... exact distance of track j and cluster candidates[k] ... }
+ * }
+ * ~~~
+ */
+class AliEmcalEtaPhiGrid : public TObject {
+ public:
+  AliEmcalEtaPhiGrid(Double_t etaMin = -1., Double_t etaMax = 1.);
+  virtual ~AliEmcalEtaPhiGrid() {}
+
+  void                   Reset(Double_t radius);
+  void                   Add(Int_t id, Double_t eta, Double_t phi);
+  void                   Build();
+  Int_t                  GetCandidates(Double_t eta, Double_t phi, std::vector<Int_t> &candidates) const;
+
+  Int_t                  GetNEtaCells()                      const { return fNEta                         ; }
+  Int_t                  GetNPhiCells()                      const { return fNPhi                         ; }
+  Int_t                  GetNEntries()                       const { return Int_t(fIds.size())            ; }
+
+ protected:
+  Int_t                  GetEtaCell(Double_t eta)            const;
+  Int_t                  GetPhiCell(Double_t phi)            const;
+
+  Double_t               fEtaMin;                 ///< lower edge of the grid in eta (entries below are put in the first cell)
+  Double_t               fEtaMax;                 ///< upper edge of the grid in eta (entries above are put in the last cell)
+  Int_t                  fNEta;                   //!<! number of cells in eta
+  Int_t                  fNPhi;                   //!<! number of cells in phi
+  Double_t               fEtaWidth;               //!<! cell width in eta
+  Double_t               fPhiWidth;               //!<! cell width in phi
+  std::vector<Int_t>     fIds;                    //!<! ids of the entries, in the order they were added
+  std::vector<Int_t>     fCells;                  //!<! cell of each entry (-1 if the position is not finite)
+  std::vector<Int_t>     fCellStart;              //!<! first entry of each cell in fCellIds (size number of cells + 1)
+  std::vector<Int_t>     fCellIds;                //!<! ids of the entries grouped by cell
+  std::vector<Int_t>     fNoCellIds;              //!<! ids of the entries without a finite position
+
+ private:
+  AliEmcalEtaPhiGrid(const AliEmcalEtaPhiGrid &);             // Not implemented
+  AliEmcalEtaPhiGrid &operator=(const AliEmcalEtaPhiGrid &);  // Not implemented
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalEtaPhiGrid, 1); // Cell grid in eta-phi for neighbour searches
+  /// \endcond
+};
+
+#endif /* ALIEMCALETAPHIGRID_H */
@@ -14,6 +14,7 @@
 #pragma link C++ class AliEmcalDownscaleFactorsOCDB+;
 #pragma link C++ class AliEmcalAODFilterBitCuts+;
 #pragma link C++ class AliEmcalESDTrackCutsGenerator+;
+#pragma link C++ class AliEmcalEtaPhiGrid+;
 #pragma link C++ class AliEmcalParticle+;
 #pragma link C++ class AliEmcalPhysicsSelection+;
 #pragma link C++ class AliEmcalPythiaInfo+;
@@ -7,6 +7,7 @@
 
 #include <TClonesArray.h>
 #include <TClass.h>
+#include <TVector3.h>
 
 #include <AliAODCaloCluster.h>
 #include <AliESDCaloCluster.h>
@@ -36,6 +37,7 @@ AliEmcalClusTrackMatcherTask::AliEmcalClusTrackMatcherTask() :
   fEmcalClusters(0),
   fNEmcalTracks(0),
   fNEmcalClusters(0),
+  fClusterGrid(),
   fHistMatchEtaAll(0),
   fHistMatchPhiAll(0)
 {
@@ -66,6 +68,7 @@ AliEmcalClusTrackMatcherTask::AliEmcalClusTrackMatcherTask(const char *name, Boo
   fEmcalClusters(0),
   fNEmcalTracks(0),
   fNEmcalClusters(0),
+  fClusterGrid(),
   fHistMatchEtaAll(0),
   fHistMatchPhiAll(0)
 {
@@ -283,11 +286,26 @@ void AliEmcalClusTrackMatcherTask::DoMatching()
 
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  // Index the clusters by their position on the EMCal surface, such that each track
+  // is only compared with the clusters in the neighbouring cells
+  fClusterGrid.Reset(fMaxDistance);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+    Float_t pos[3] = {0};
+    emcalCluster->GetCluster()->GetPosition(pos);
+    TVector3 cpos(pos);
+    fClusterGrid.Add(icluster, cpos.Eta(), cpos.Phi());
+  }
+  fClusterGrid.Build();
+
+  std::vector<Int_t> candidates;
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    const Int_t ncandidates = fClusterGrid.GetCandidates(track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), candidates);
+    for (Int_t icandidate = 0; icandidate < ncandidates; icandidate++) {
+      const Int_t icluster = candidates[icandidate];
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
 
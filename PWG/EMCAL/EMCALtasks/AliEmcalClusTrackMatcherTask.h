@@ -2,6 +2,7 @@
 #define ALIEMCALCLUSTRACKMATCHERTASK_H
 
 #include "AliAnalysisTaskEmcal.h"
+#include "AliEmcalEtaPhiGrid.h"
 
 class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
  public:
@@ -42,6 +43,7 @@ class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
   TClonesArray *fEmcalClusters;         //!emcal clusters
   Int_t         fNEmcalTracks;          //!number of emcal tracks
   Int_t         fNEmcalClusters;        //!number of emcal clusters
+  AliEmcalEtaPhiGrid fClusterGrid;      //!emcal clusters indexed by position
   TH1          *fHistMatchEtaAll;       //!deta distribution
   TH1          *fHistMatchPhiAll;       //!dphi distribution
   TH1          *fHistMatchEta[10][9][2]; //!deta distribution
@@ -51,6 +53,6 @@ class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
   AliEmcalClusTrackMatcherTask(const AliEmcalClusTrackMatcherTask&);            // not implemented
   AliEmcalClusTrackMatcherTask &operator=(const AliEmcalClusTrackMatcherTask&); // not implemented
 
-  ClassDef(AliEmcalClusTrackMatcherTask, 8) // Cluster-Track matching task
+  ClassDef(AliEmcalClusTrackMatcherTask, 9) // Cluster-Track matching task
 };
 #endif
@@ -2,6 +2,7 @@
 #define ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 
 #include "AliEmcalCorrectionComponent.h"
+#include "AliEmcalEtaPhiGrid.h"
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
 #include "AliEmcalContainerIndexMap.h"
@@ -98,6 +99,7 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   TClonesArray *fEmcalClusters;         //!<!emcal clusters
   Int_t         fNEmcalTracks;          //!<!number of emcal tracks
   Int_t         fNEmcalClusters;        //!<!number of emcal clusters
+  AliEmcalEtaPhiGrid fClusterGrid;      //!<!emcal clusters indexed by their position on the EMCal surface
   TH1          *fHistMatchEtaAll;       //!<!deta distribution
   TH1          *fHistMatchPhiAll;       //!<!dphi distribution
   TH1          *fHistMatchEta[10][9][2]; //!<!deta distribution
@@ -115,7 +117,7 @@ private:
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterTrackMatcher> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 4); // EMCal cluster track matcher correction component
+  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 5); // EMCal cluster track matcher correction component
   /// \endcond
 };
 
@@ -31,6 +31,9 @@ AliEmcalPatchFromCellMaker::AliEmcalPatchFromCellMaker() :
   fCellTimeMax(685e-9),
   fL1Slide(0),
   fTriggerBitConfig(0x0),
+  fNPatchDimQA(0),
+  fPatchADCTable(kPatchCols, kPatchRows),
+  fPatchETable(kPatchCols, kPatchRows),
   fh3EEtaPhiCell(0),
   fh2CellEnergyVsTime(0),
   fh1CellEnergySum(0)
@@ -42,6 +45,11 @@ AliEmcalPatchFromCellMaker::AliEmcalPatchFromCellMaker() :
       fPatchESimple[i][j] = 0.;
     }
  }
+ for (Int_t i = 0; i < kMaxPatchDimQA; i++) {
+   fPatchDimQA[i] = 0;
+   fh1PatchEnergyQA[i] = 0;
+   fh1MaxPatchEnergyQA[i] = 0;
+ }
 
   SetMakeGeneralHistograms(kTRUE);
 }
@@ -57,6 +65,9 @@ AliEmcalPatchFromCellMaker::AliEmcalPatchFromCellMaker(const char *name) :
   fCellTimeMax(685e-9),
   fL1Slide(0),
   fTriggerBitConfig(0x0),
+  fNPatchDimQA(0),
+  fPatchADCTable(kPatchCols, kPatchRows),
+  fPatchETable(kPatchCols, kPatchRows),
   fh3EEtaPhiCell(0),
   fh2CellEnergyVsTime(0),
   fh1CellEnergySum(0)
@@ -68,6 +79,11 @@ AliEmcalPatchFromCellMaker::AliEmcalPatchFromCellMaker(const char *name) :
       fPatchESimple[i][j] = 0.;
     }
  }
+ for (Int_t i = 0; i < kMaxPatchDimQA; i++) {
+   fPatchDimQA[i] = 0;
+   fh1PatchEnergyQA[i] = 0;
+   fh1MaxPatchEnergyQA[i] = 0;
+ }
 
   SetMakeGeneralHistograms(kTRUE);
 }
@@ -78,6 +94,20 @@ AliEmcalPatchFromCellMaker::~AliEmcalPatchFromCellMaker()
   // Destructor.
 }
 
+//________________________________________________________________________
+void AliEmcalPatchFromCellMaker::AddPatchDimensionQA(Int_t i)
+{
+  // Add a patch dimension (in #cells) for which the energy of all the patches
+  // and of the leading patch are histogrammed. All the dimensions are obtained
+  // from the same summed-area tables as the output patches.
+
+  if (fNPatchDimQA >= kMaxPatchDimQA) {
+    AliWarning(Form("%s: at most %d patch dimensions can be added for QA, %d is ignored", GetName(), kMaxPatchDimQA, i));
+    return;
+  }
+  fPatchDimQA[fNPatchDimQA++] = i;
+}
+
 //________________________________________________________________________
 void AliEmcalPatchFromCellMaker::ExecOnce() 
 {
@@ -167,6 +197,16 @@ void AliEmcalPatchFromCellMaker::UserCreateOutputObjects()
   fh1CellEnergySum = new TH1F("fh1CellEnergySum","fh1CellEnergySum;E_{cell};time",fgkNEnBins,binsEn);
   fOutput->Add(fh1CellEnergySum);
 
+  for (Int_t i = 0; i < fNPatchDimQA; i++) {
+    TString histName = Form("fh1PatchEnergy%dx%d", fPatchDimQA[i], fPatchDimQA[i]);
+    fh1PatchEnergyQA[i] = new TH1F(histName, histName+";E_{patch};counts", fgkNEnBins, binsEn);
+    fOutput->Add(fh1PatchEnergyQA[i]);
+
+    histName = Form("fh1MaxPatchEnergy%dx%d", fPatchDimQA[i], fPatchDimQA[i]);
+    fh1MaxPatchEnergyQA[i] = new TH1F(histName, histName+";E_{patch}^{max};counts", fgkNEnBins, binsEn);
+    fOutput->Add(fh1MaxPatchEnergyQA[i]);
+  }
+
   PostData(1, fOutput); // Post data for ALL output slots > 0 here.
 
   if(binsEn)                delete [] binsEn;
@@ -199,8 +239,12 @@ Bool_t AliEmcalPatchFromCellMaker::Run()
     return kFALSE;
   }
 
+  FillPatchTables();
+
   RunSimpleOfflineTrigger();
 
+  FillPatchQA();
+
   Double_t sum = 0.;
   for (Int_t i = 0; i < kPatchCols; i++) {
     for (Int_t j = 0; j < kPatchRows; j++) {
@@ -257,6 +301,50 @@ Bool_t AliEmcalPatchFromCellMaker::FillPatchADCSimple()
   return kTRUE;
 }
 
+//________________________________________________________________________
+void AliEmcalPatchFromCellMaker::FillPatchTables()
+{
+  // Build the summed-area tables of the FastOR ADC and energy, such that
+  // the sum of any patch is obtained in constant time.
+
+  fPatchADCTable.Reset();
+  fPatchETable.Reset();
+  for (Int_t i = 0; i < kPatchCols; i++) {
+    for (Int_t j = 0; j < kPatchRows; j++) {
+      fPatchADCTable.Add(i, j, (Double_t)(ULong64_t)fPatchADCSimple[i][j]);
+      fPatchETable.Add(i, j, fPatchESimple[i][j]);
+    }
+  }
+  fPatchADCTable.Build();
+  fPatchETable.Build();
+}
+
+//________________________________________________________________________
+void AliEmcalPatchFromCellMaker::FillPatchQA()
+{
+  // Fill the energy distribution of all the patches and of the leading patch
+  // for each QA patch dimension.
+
+  const Int_t nRows = GetNPatchRows();
+  for (Int_t i = 0; i < fNPatchDimQA; i++) {
+    const Int_t dim = GetDimFastor(fPatchDimQA[i]);
+    const Int_t step = GetSlidingStepSizeFastor(fPatchDimQA[i]);
+    if (dim <= 0 || step <= 0) continue;
+
+    Double_t maxE = fPatchETable.FillPatchSums(fh1PatchEnergyQA[i], dim, step, nRows);
+    fh1MaxPatchEnergyQA[i]->Fill(maxE);
+  }
+}
+
+//________________________________________________________________________
+Int_t AliEmcalPatchFromCellMaker::GetNPatchRows() const
+{
+  // Number of FastOR rows scanned by the patch finders: the total number
+  // of TRUs in phi (apparently), within the kPatchRows rows of the tables.
+
+  return TMath::Min(fGeom->GetNTotalTRU()*2, (Int_t)kPatchRows);
+}
+
 //________________________________________________________________________
 void AliEmcalPatchFromCellMaker::RunSimpleOfflineTrigger()
 {
@@ -269,22 +357,14 @@ void AliEmcalPatchFromCellMaker::RunSimpleOfflineTrigger()
   Int_t stepSize = GetSlidingStepSizeFastor();
   Int_t maxCol = kPatchCols - patchSize;
   //  Int_t maxRow = kPatchRows - patchSize;
-  Int_t maxRow = fGeom->GetNTotalTRU()*2 - patchSize; //apparently this is the total TRU in phi ??
+  Int_t maxRow = GetNPatchRows() - patchSize;
   //  Printf("fGeom->GetNTotalTRU(): %d %d = %d x %d ;  %d x %d",fGeom->GetNTRU(),fGeom->GetNTotalTRU(),fGeom->GetNTRUEta(),fGeom->GetNTRUPhi(),fGeom->GetNModulesInTRUEta(),fGeom->GetNModulesInTRUPhi());
 
   for (Int_t i = 0; i <= maxCol; i += stepSize) {
     for (Int_t j = 0; j <= maxRow; j += stepSize) {
-      // get the trigger towers composing the patch
-      Int_t   adcAmp = 0;
-      Double_t enAmp = 0.;
-      // window
-      for (Int_t k = 0; k < patchSize; ++k) {
-        for (Int_t l = 0; l < patchSize; ++l) {
-	  // add amplitudes
-          adcAmp += (ULong64_t)fPatchADCSimple[i+k][j+l];
-	  enAmp += fPatchESimple[i+k][j+l];
-	}
-      }
+      // sum of the trigger towers composing the patch
+      Int_t   adcAmp = (Int_t)fPatchADCTable.GetPatchSum(i, j, patchSize);
+      Double_t enAmp = fPatchETable.GetPatchSum(i, j, patchSize);
 
       if (adcAmp == 0) {
 	AliDebug(2,"EMCal trigger patch with 0 ADC counts.");
@@ -342,14 +422,26 @@ void AliEmcalPatchFromCellMaker::RunSimpleOfflineTrigger()
 //________________________________________________________________________
 Int_t AliEmcalPatchFromCellMaker::GetDimFastor() const {
 
-  Int_t dim = TMath::FloorNint((Double_t)(fPatchDim/2.));
-  return dim;
+  return GetDimFastor(fPatchDim);
 }
 
 //________________________________________________________________________
 Int_t AliEmcalPatchFromCellMaker::GetSlidingStepSizeFastor() const {
 
-  Int_t dim = GetDimFastor();
+  return GetSlidingStepSizeFastor(fPatchDim);
+}
+
+//________________________________________________________________________
+Int_t AliEmcalPatchFromCellMaker::GetDimFastor(Int_t dimCells) const {
+
+  Int_t dim = TMath::FloorNint((Double_t)(dimCells/2.));
+  return dim;
+}
+
+//________________________________________________________________________
+Int_t AliEmcalPatchFromCellMaker::GetSlidingStepSizeFastor(Int_t dimCells) const {
+
+  Int_t dim = GetDimFastor(dimCells);
   if(!fL1Slide) return dim;
 
   if(dim==2) return 2;
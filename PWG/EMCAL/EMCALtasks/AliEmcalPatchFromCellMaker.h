@@ -6,6 +6,7 @@ class TH3F;
 class AliEMCALTriggerBitConfig;
 
 #include "AliAnalysisTaskEmcal.h"
+#include "AliEmcalPatchSumTable.h"
 
 class AliEmcalPatchFromCellMaker : public AliAnalysisTaskEmcal {
  public:
@@ -18,11 +19,16 @@ class AliEmcalPatchFromCellMaker : public AliAnalysisTaskEmcal {
   void               SetMinCellE(Double_t e)                           { fMinCellE            = e;    }
   void               SetCellTimeCuts(Double_t min, Double_t max)       { fCellTimeMin = min; fCellTimeMax = max; }
   void               ActivateSlidingPatch(Bool_t b)                    { fL1Slide             = b;    }
+  void               AddPatchDimensionQA(Int_t i);
+
+  const AliEmcalPatchSumTable &GetPatchADCTable() const                { return fPatchADCTable; }
+  const AliEmcalPatchSumTable &GetPatchETable() const                  { return fPatchETable;   }
 
  protected:
   enum{
     kPatchCols = 48,
-    kPatchRows = 64
+    kPatchRows = 64,
+    kMaxPatchDimQA = 4
   };
 
   void               ExecOnce();
@@ -31,13 +37,18 @@ class AliEmcalPatchFromCellMaker : public AliAnalysisTaskEmcal {
   void               UserCreateOutputObjects();
 
   Bool_t             FillPatchADCSimple();
+  void               FillPatchTables();
   void               RunSimpleOfflineTrigger();
+  void               FillPatchQA();
+  Int_t              GetNPatchRows() const;
 
   //Getters
   Int_t              GetPatchDimension() const                         { return fPatchDim;  }
   Double_t           GetPatchArea() const                              { return (Double_t)(fPatchDim*fPatchDim)*0.014*0.014; }
   Int_t              GetDimFastor() const;
   Int_t              GetSlidingStepSizeFastor() const;
+  Int_t              GetDimFastor(Int_t dimCells) const;
+  Int_t              GetSlidingStepSizeFastor(Int_t dimCells) const;
 
   TString            fCaloTriggersOutName;  // name of output patch array
   TClonesArray      *fCaloTriggersOut;      //!trigger array out
@@ -51,15 +62,21 @@ class AliEmcalPatchFromCellMaker : public AliAnalysisTaskEmcal {
   Double_t           fCellTimeMax;          // maximum time cell
   Bool_t             fL1Slide;              // sliding window on
   AliEMCALTriggerBitConfig *fTriggerBitConfig; // dummy trigger bit config
+  Int_t              fNPatchDimQA;          // number of patch dimensions for the patch energy QA
+  Int_t              fPatchDimQA[kMaxPatchDimQA]; // patch dimensions in #cells for the patch energy QA
+  AliEmcalPatchSumTable fPatchADCTable;     //!summed-area table of the FastOR ADC (truncated per FastOR as in the patch sum)
+  AliEmcalPatchSumTable fPatchETable;       //!summed-area table of the FastOR energy
 
  private:
   TH3F     *fh3EEtaPhiCell;                    //! cell E, eta, phi
   TH2F     *fh2CellEnergyVsTime;               //! emcal cell energy vs time
   TH1F     *fh1CellEnergySum;                  //! sum of energy in all emcal cells
+  TH1F     *fh1PatchEnergyQA[kMaxPatchDimQA];    //! energy of all patches for each QA dimension
+  TH1F     *fh1MaxPatchEnergyQA[kMaxPatchDimQA]; //! energy of the leading patch for each QA dimension
 
   AliEmcalPatchFromCellMaker(const AliEmcalPatchFromCellMaker&);            // not implemented
   AliEmcalPatchFromCellMaker &operator=(const AliEmcalPatchFromCellMaker&); // not implemented
 
-  ClassDef(AliEmcalPatchFromCellMaker, 1); // Task to make PicoTracks in a grid corresponding to EMCAL/DCAL acceptance
+  ClassDef(AliEmcalPatchFromCellMaker, 2); // Task to make PicoTracks in a grid corresponding to EMCAL/DCAL acceptance
 };
 #endif
@@ -0,0 +1,172 @@
+// $Id$
+//
+// Summed-area table over a grid of trigger channels (e.g. the FastOR grid
+// of EMCal+DCal). The values are filled once per event with Add(), Build()
+// computes the prefix sums, after which the sum of any rectangular patch is
+// obtained with four look-ups, independently of the patch size.
+// GetTopPatches() and FillPatchSums() scan all patch positions of a given
+// size for the leading patches and the distribution of the patch sums.
+//
+// Sums of integer values (e.g. ADC counts) are exact as long as the total
+// stays below 2^53.
+
+#include <TH1.h>
+#include <TMath.h>
+
+#include "AliLog.h"
+
+#include "AliEmcalPatchSumTable.h"
+
+ClassImp(AliEmcalPatchSumTable)
+
+//________________________________________________________________________
+AliEmcalPatchSumTable::AliEmcalPatchSumTable(Int_t nCols, Int_t nRows) :
+  TObject(),
+  fNCols(0),
+  fNRows(0),
+  fValues(),
+  fTable(),
+  fBuilt(kFALSE)
+{
+  // Constructor.
+
+  Set(nCols, nRows);
+}
+
+//________________________________________________________________________
+void AliEmcalPatchSumTable::Set(Int_t nCols, Int_t nRows)
+{
+  // Set the dimensions of the grid and clear the values.
+
+  fNCols = nCols > 0 ? nCols : 0;
+  fNRows = nRows > 0 ? nRows : 0;
+  fValues.Set(fNCols*fNRows);
+  fTable.Set((fNCols+1)*(fNRows+1));
+  Reset();
+}
+
+//________________________________________________________________________
+void AliEmcalPatchSumTable::Reset()
+{
+  // Clear the values, e.g. at the beginning of an event.
+
+  fValues.Reset();
+  fTable.Reset();
+  fBuilt = kTRUE;
+}
+
+//________________________________________________________________________
+void AliEmcalPatchSumTable::Add(Int_t col, Int_t row, Double_t v)
+{
+  // Add v to the cell (col, row).
+
+  if (col < 0 || col >= fNCols || row < 0 || row >= fNRows)
+    return;
+
+  fValues[col*fNRows + row] += v;
+  fBuilt = kFALSE;
+}
+
+//________________________________________________________________________
+void AliEmcalPatchSumTable::Build()
+{
+  // Compute the prefix sums: fTable[c][r] is the sum of the cells with
+  // column < c and row < r.
+
+  const Int_t nTableRows = fNRows + 1;
+  for (Int_t i = 0; i < fNCols; i++) {
+    Double_t colSum = 0.;
+    for (Int_t j = 0; j < fNRows; j++) {
+      colSum += fValues[i*fNRows + j];
+      fTable[(i+1)*nTableRows + j + 1] = fTable[i*nTableRows + j + 1] + colSum;
+    }
+  }
+  fBuilt = kTRUE;
+}
+
+//________________________________________________________________________
+Double_t AliEmcalPatchSumTable::GetSum(Int_t col, Int_t row, Int_t dimCol, Int_t dimRow) const
+{
+  // Sum of the patch with lower edge (col, row) and size dimCol x dimRow.
+  // The patch is clipped to the grid.
+
+  if (!fBuilt) {
+    AliError("Build() has to be called after filling the values");
+    return 0.;
+  }
+
+  Int_t c0 = TMath::Max(col, 0);
+  Int_t r0 = TMath::Max(row, 0);
+  Int_t c1 = TMath::Min(col + dimCol, fNCols);
+  Int_t r1 = TMath::Min(row + dimRow, fNRows);
+  if (c1 <= c0 || r1 <= r0)
+    return 0.;
+
+  const Int_t nTableRows = fNRows + 1;
+  return fTable[c1*nTableRows + r1] - fTable[c0*nTableRows + r1] - fTable[c1*nTableRows + r0] + fTable[c0*nTableRows + r0];
+}
+
+//________________________________________________________________________
+Int_t AliEmcalPatchSumTable::GetTopPatches(Int_t dim, Int_t step, Int_t nRows, Int_t k,
+                                           TArrayI &cols, TArrayI &rows, TArrayD &sums) const
+{
+  // Find the k patches of size dim x dim with the largest sum among the
+  // positions stepping by step, using the first nRows rows (all if <= 0).
+  // The patches are returned in decreasing order of their sum; patches with
+  // sum 0 are not considered. Returns the number of patches found.
+
+  cols.Set(k > 0 ? k : 0);
+  rows.Set(k > 0 ? k : 0);
+  sums.Set(k > 0 ? k : 0);
+  if (k <= 0 || dim <= 0 || step <= 0)
+    return 0;
+
+  if (nRows <= 0 || nRows > fNRows) nRows = fNRows;
+
+  Int_t n = 0;
+  for (Int_t i = 0; i <= fNCols - dim; i += step) {
+    for (Int_t j = 0; j <= nRows - dim; j += step) {
+      const Double_t sum = GetSum(i, j, dim, dim);
+      if (sum <= 0.) continue;
+      if (n == k && sum <= sums[k-1]) continue;
+
+      // insert keeping the order, first found first for equal sums
+      Int_t pos = n < k ? n : k - 1;
+      while (pos > 0 && sums[pos-1] < sum) {
+        cols[pos] = cols[pos-1];
+        rows[pos] = rows[pos-1];
+        sums[pos] = sums[pos-1];
+        pos--;
+      }
+      cols[pos] = i;
+      rows[pos] = j;
+      sums[pos] = sum;
+      if (n < k) n++;
+    }
+  }
+
+  return n;
+}
+
+//________________________________________________________________________
+Double_t AliEmcalPatchSumTable::FillPatchSums(TH1 *h, Int_t dim, Int_t step, Int_t nRows) const
+{
+  // Fill h with the sums of all the patches of size dim x dim stepping by
+  // step, using the first nRows rows (all if <= 0). Returns the maximum sum.
+
+  if (dim <= 0 || step <= 0)
+    return 0.;
+
+  if (nRows <= 0 || nRows > fNRows) nRows = fNRows;
+
+  Double_t max = 0.;
+  for (Int_t i = 0; i <= fNCols - dim; i += step) {
+    for (Int_t j = 0; j <= nRows - dim; j += step) {
+      const Double_t sum = GetSum(i, j, dim, dim);
+      if (h) h->Fill(sum);
+      if (sum > max) max = sum;
+    }
+  }
+
+  return max;
+}
@@ -0,0 +1,45 @@
+#ifndef ALIEMCALPATCHSUMTABLE_H
+#define ALIEMCALPATCHSUMTABLE_H
+
+// $Id$
+
+class TH1;
+
+#include <TObject.h>
+#include <TArrayD.h>
+#include <TArrayI.h>
+
+class AliEmcalPatchSumTable : public TObject {
+ public:
+  AliEmcalPatchSumTable(Int_t nCols = 0, Int_t nRows = 0);
+  virtual ~AliEmcalPatchSumTable() {}
+
+  void               Set(Int_t nCols, Int_t nRows);
+  void               Reset();
+  void               Add(Int_t col, Int_t row, Double_t v);
+  void               Build();
+
+  Int_t              GetNCols()                                  const { return fNCols; }
+  Int_t              GetNRows()                                  const { return fNRows; }
+  Double_t           GetValue(Int_t col, Int_t row)              const { return fValues[col*fNRows + row]; }
+  Double_t           GetSum(Int_t col, Int_t row, Int_t dimCol, Int_t dimRow) const;
+  Double_t           GetPatchSum(Int_t col, Int_t row, Int_t dim) const { return GetSum(col, row, dim, dim); }
+
+  Int_t              GetTopPatches(Int_t dim, Int_t step, Int_t nRows, Int_t k,
+                                   TArrayI &cols, TArrayI &rows, TArrayD &sums) const;
+  Double_t           FillPatchSums(TH1 *h, Int_t dim, Int_t step, Int_t nRows) const;
+
+ protected:
+  Int_t              fNCols;                // number of columns
+  Int_t              fNRows;                // number of rows
+  TArrayD            fValues;               //!values per cell, column major
+  TArrayD            fTable;                //!summed-area table, (fNCols+1) x (fNRows+1)
+  Bool_t             fBuilt;                //!table up to date with the values
+
+ private:
+  AliEmcalPatchSumTable(const AliEmcalPatchSumTable&);            // not implemented
+  AliEmcalPatchSumTable &operator=(const AliEmcalPatchSumTable&); // not implemented
+
+  ClassDef(AliEmcalPatchSumTable, 1); // Summed-area table for trigger patch sums
+};
+#endif
@@ -17,6 +17,7 @@
 #pragma link C++ class  AliEmcalMCTrackSelector+;
 #pragma link C++ class  AliEmcalParticleMaker+;
 #pragma link C++ class  AliEmcalPatchFromCellMaker+;
+#pragma link C++ class  AliEmcalPatchSumTable+;
 #pragma link C++ class  AliEmcalPhysicsSelectionTask+;
 #pragma link C++ class  AliEmcalPicoTrackMaker+;
 #pragma link C++ class  AliEmcalTenderTask+;
@@ -86,6 +86,7 @@ fWeightsList(NULL),
 fUsePhiWeights(kFALSE),
 fUsePtWeights(kFALSE),
 fUseEtaWeights(kFALSE),
+fUseSharedQVectors(kFALSE),
 fUseParticleWeights(NULL),
 fPhiWeights(NULL),
 fPtWeights(NULL),
@@ -231,6 +232,9 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
 
  Int_t nRefMult = anEvent->GetReferenceMultiplicity();
 
+ // Q_{m,k} and S_{p,k} can be taken from the Q-vectors shared by all flow methods only without particle weights:
+ Bool_t bSharedQVectors = fUseSharedQVectors && !(fUsePhiWeights||fUsePtWeights||fUseEtaWeights);
+
  // Start loop over data:
  for(Int_t i=0;i<nPrim;i++) 
  { 
@@ -256,23 +260,26 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
     {
      wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
     } 
-    // Calculate Re[Q_{m,k}] and Im[Q_{m,k}], (m = 1,2,3,4,5,6 and k = 0,1,2,3) for this event:
-    for(Int_t m=0;m<6;m++) 
+    if(!bSharedQVectors) // otherwise Q_{m,k} and S_{p,k} are taken from AliFlowEventSimple after the loop over data
     {
-     for(Int_t k=0;k<4;k++) // to be improved (what is the maximum k that I need?)
+     // Calculate Re[Q_{m,k}] and Im[Q_{m,k}], (m = 1,2,3,4,5,6 and k = 0,1,2,3) for this event:
+     for(Int_t m=0;m<6;m++) 
      {
-      (*fReQnk)(m,k)+=pow(wPhi*wPt*wEta,k)*TMath::Cos((m+1)*n*dPhi); 
-      (*fImQnk)(m,k)+=pow(wPhi*wPt*wEta,k)*TMath::Sin((m+1)*n*dPhi); 
-     } 
-    }
-    // Calculate partially S_{p,k} for this event (final calculation of S_{p,k} follows after the loop over data bellow):
-    for(Int_t p=0;p<4;p++) // to be improved (what is maximum p that I need?)
-    {
-     for(Int_t k=0;k<4;k++) // to be improved (what is maximum k that I need?)
-     {     
-      (*fSpk)(p,k)+=pow(wPhi*wPt*wEta,k);
+      for(Int_t k=0;k<4;k++) // to be improved (what is the maximum k that I need?)
+      {
+       (*fReQnk)(m,k)+=pow(wPhi*wPt*wEta,k)*TMath::Cos((m+1)*n*dPhi); 
+       (*fImQnk)(m,k)+=pow(wPhi*wPt*wEta,k)*TMath::Sin((m+1)*n*dPhi); 
+      } 
      }
-    }    
+     // Calculate partially S_{p,k} for this event (final calculation of S_{p,k} follows after the loop over data bellow):
+     for(Int_t p=0;p<4;p++) // to be improved (what is maximum p that I need?)
+     {
+      for(Int_t k=0;k<4;k++) // to be improved (what is maximum k that I need?)
+      {     
+       (*fSpk)(p,k)+=pow(wPhi*wPt*wEta,k);
+      }
+     }    
+    } // end of if(!bSharedQVectors)
    } // end of if(aftsTrack->InRPSelection())
    // POIs:
    if(fEvaluateDifferential3pCorrelator)
@@ -400,6 +407,28 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
     }
  } // end of for(Int_t i=0;i<nPrim;i++) 
 
+ // Q_{m,k} and S_{p,k} from the Q-vectors shared by all flow methods analysing this event:
+ if(bSharedQVectors)
+ {
+  Int_t n = fHarmonic;
+  const AliFlowQVectorCache *qVectors = anEvent->GetQVectors(6*n,3);
+  for(Int_t m=0;m<6;m++) 
+  {
+   for(Int_t k=0;k<4;k++)
+   {
+    (*fReQnk)(m,k)+=qVectors->ReQ((m+1)*n,k);
+    (*fImQnk)(m,k)+=qVectors->ImQ((m+1)*n,k);
+   }
+  }
+  for(Int_t p=0;p<4;p++)
+  {
+   for(Int_t k=0;k<4;k++)
+   {
+    (*fSpk)(p,k)+=qVectors->S(k);
+   }
+  }
+ } // end of if(bSharedQVectors)
+
  // Calculate the final expressions for S_{p,k}:
  for(Int_t p=0;p<4;p++) // to be improved (what is maximum p that I need?)
  {
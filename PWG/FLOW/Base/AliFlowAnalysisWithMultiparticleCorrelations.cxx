@@ -64,6 +64,7 @@ AliFlowAnalysisWithMultiparticleCorrelations::AliFlowAnalysisWithMultiparticleCo
  fQvectorFlagsPro(NULL),
  fCalculateQvector(kFALSE),
  fCalculateDiffQvectors(kFALSE),
+ fUseSharedQvector(kFALSE),
  // 3.) Correlations:
  fCorrelationsList(NULL),
  fCorrelationsFlagsPro(NULL),
@@ -2000,6 +2001,21 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
  Double_t dEta = 0., wEta = 1.; // pseudorapidity and corresponding eta weight
  Double_t wToPowerP = 1.; // weight raised to power p
  Int_t nCounterRPs = 0;
+ // Q-vector can be taken from the Q-vectors shared by all flow methods only without RP weights and RP selection:
+ Bool_t bSharedQvector = fUseSharedQvector && !fSelectRandomlyRPs && !fSkipSomeIntervals
+                         && !(fUseWeights[0][0]||fUseWeights[0][1]||fUseWeights[0][2]);
+ if(bSharedQvector)
+ {
+  const AliFlowQVectorCache *qVectors = anEvent->GetQVectors(fMaxHarmonic*fMaxCorrelator,0);
+  for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+  {
+   for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power, without weights w^p = 1
+   {
+    fQvector[h][wp] += TComplex(qVectors->ReQ(h,0),qVectors->ImQ(h,0));
+   }
+  }
+  if(!fCalculateDiffQvectors){return;}
+ } // if(bSharedQvector)
  for(Int_t t=0;t<nTracks;t++) // loop over all tracks
  {
   AliFlowTrackSimple *pTrack = NULL;
@@ -2018,7 +2034,7 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
 
   if(!(pTrack->InRPSelection() || pTrack->InPOISelection())){printf("\n AAAARGH: pTrack is neither RP nor POI !!!!"); continue;}
 
-  if(pTrack->InRPSelection()) // fill Q-vector components only with reference particles
+  if(pTrack->InRPSelection() && !bSharedQvector) // fill Q-vector components only with reference particles
   {
    nCounterRPs++;
    if(fSelectRandomlyRPs && nCounterRPs == fnSelectedRandomlyRPs){break;} // for(Int_t t=0;t<nTracks;t++) // loop over all tracks
@@ -157,6 +157,8 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   void SetQvectorFlagsPro(TProfile* const qvfp) {this->fQvectorFlagsPro = qvfp;};
   TProfile* GetQvectorFlagsPro() const {return this->fQvectorFlagsPro;}; 
   void SetCalculateQvector(Bool_t cqv) {this->fCalculateQvector = cqv;};
+  void SetUseSharedQvector(Bool_t usqv) {this->fUseSharedQvector = usqv;};
+  Bool_t GetUseSharedQvector() const {return this->fUseSharedQvector;};
   Bool_t GetCalculateQvector() const {return this->fCalculateQvector;};
   void SetCalculateDiffQvectors(Bool_t cdqv) {this->fCalculateDiffQvectors = cdqv;};
   Bool_t GetCalculateDiffQvectors() const {return this->fCalculateDiffQvectors;};
@@ -385,6 +387,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Bool_t fCalculateDiffQvectors; // to calculate or not to calculate p- and q-vector components, that's a Boolean...  
   TComplex fpvector[100][49][9]; // p-vector components [bin][fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1] TBI hardwired 100
   TComplex fqvector[100][49][9]; // q-vector components [bin][fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1] TBI hardwired 100
+  Bool_t fUseSharedQvector;      // take Q-vector components from AliFlowEventSimple::GetQVectors() (no RP weights only)
 
   // 3.) Correlations:
   TList *fCorrelationsList;           // list to hold all correlations objects
@@ -476,7 +479,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Int_t fHighestHarmonicEtaGaps;      // 2-p correlations with eta gaps will be calculated for harmonics [fLowestHarmonicEtaGaps,fHighestHarmonicEtaGaps]
   TProfile *fEtaGapsPro[6];           // [harmonic] different eta gaps are different bins
 
-  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,6);
+  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,7);
 
 };
 
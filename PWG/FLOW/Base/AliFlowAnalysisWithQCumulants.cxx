@@ -43,6 +43,8 @@
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowAnalysisWithQCumulants.h"
+#include "AliFlowQVectorKernel.h"
+#include "AliFlowQVectorCache.h"
 #include "TArrayD.h"
 #include "TRandom.h"
 #include "TF1.h"
@@ -134,6 +136,10 @@ AliFlowAnalysisWithQCumulants::AliFlowAnalysisWithQCumulants():
  fUse2DHistograms(kFALSE),
  fFillProfilesVsMUsingWeights(kTRUE),
  fUseQvectorTerms(kFALSE),
+ fUseQVectorKernel(kTRUE),
+ fUseSharedQVectors(kFALSE),
+ fQVectorKernelPhi(),
+ fQVectorKernelWeight(),
  fReQ(NULL),
  fImQ(NULL),
  fSpk(NULL),
@@ -379,6 +385,14 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  Int_t nPrim = anEvent->NumberOfTracks();  // nPrim = total number of primary tracks
  AliFlowTrackSimple *aftsTrack = NULL;
  Int_t n = fHarmonic; // shortcut for the harmonic 
+ // Q_{m*n,k} and S_{p,k} can be taken from the Q-vectors shared by all flow methods only without phi, pt and eta weights:
+ Bool_t bSharedQVectors = fUseSharedQVectors && !(fUsePhiWeights||fUsePtWeights||fUseEtaWeights) && fExactNoRPs<=0;
+ Int_t nRPsInKernel = 0; // number of RPs buffered for AliFlowQVectorKernel
+ if(!bSharedQVectors && fUseQVectorKernel && fQVectorKernelPhi.GetSize()<nPrim)
+ {
+  fQVectorKernelPhi.Set(nPrim);
+  fQVectorKernelWeight.Set(nPrim);
+ }
  for(Int_t i=0;i<nPrim;i++) 
  { 
   if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
@@ -409,23 +423,35 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     {
      wTrack = aftsTrack->Weight(); 
     }
-    // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
-    for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
+    if(bSharedQVectors)
     {
-     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-     {
-      (*fReQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi); 
-      (*fImQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi); 
-     } 
-    }
-    // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
-    for(Int_t p=0;p<8;p++)
+     // Q_{m*n,k} and S_{p,k} are taken from AliFlowEventSimple after the loop over data
+    } else if(fUseQVectorKernel)
     {
-     for(Int_t k=0;k<9;k++)
-     {     
-      (*fSpk)(p,k)+=pow(wPhi*wPt*wEta*wTrack,k);
-     }
-    } 
+     // Buffer phi and weight, Q_{m*n,k} and S_{p,k} are calculated in one go after the loop over data:
+     fQVectorKernelPhi[nRPsInKernel] = dPhi;
+     fQVectorKernelWeight[nRPsInKernel] = wPhi*wPt*wEta*wTrack;
+     nRPsInKernel++;
+    } else // to if(bSharedQVectors) ... else if(fUseQVectorKernel)
+      {
+       // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
+       for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
+       {
+        for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+        {
+         (*fReQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi); 
+         (*fImQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi); 
+        } 
+       }
+       // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
+       for(Int_t p=0;p<8;p++)
+       {
+        for(Int_t k=0;k<9;k++)
+        {     
+         (*fSpk)(p,k)+=pow(wPhi*wPt*wEta*wTrack,k);
+        }
+       } 
+      } // end of else // to if(bSharedQVectors) ... else if(fUseQVectorKernel)
     // Differential flow:
     if(fCalculateDiffFlow || fCalculate2DDiffFlow)
     {
@@ -548,6 +574,53 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     }
  } // end of for(Int_t i=0;i<nPrim;i++) 
 
+ // Batched calculation of Q_{m*n,k} and S_{p,k} from buffered RPs (m = 1,2,...,12, k = 0,1,...,8):
+ if(fUseQVectorKernel && nRPsInKernel>0)
+ {
+  Double_t dReQ[12*9] = {0.};
+  Double_t dImQ[12*9] = {0.};
+  Double_t dSk[9] = {0.};
+  AliFlowQVectorKernel::Fill(nRPsInKernel,fQVectorKernelPhi.GetArray(),fQVectorKernelWeight.GetArray(),
+                             (Double_t)n,12,9,dReQ,dImQ,dSk);
+  for(Int_t m=0;m<12;m++)
+  {
+   for(Int_t k=0;k<9;k++)
+   {
+    (*fReQ)(m,k)+=dReQ[m*9+k];
+    (*fImQ)(m,k)+=dImQ[m*9+k];
+   }
+  }
+  for(Int_t p=0;p<8;p++) // before the final calculation bellow S_{p,k} does not depend on p
+  {
+   for(Int_t k=0;k<9;k++)
+   {
+    (*fSpk)(p,k)+=dSk[k];
+   }
+  }
+ } // end of if(fUseQVectorKernel && nRPsInKernel>0)
+
+ // Q_{m*n,k} and S_{p,k} from the Q-vectors shared by all flow methods analysing this event (m = 1,2,...,12, k = 0,1,...,8):
+ if(bSharedQVectors)
+ {
+  AliFlowQVectorCache::EWeight eWeight = fUseTrackWeights ? AliFlowQVectorCache::kTrackWeight : AliFlowQVectorCache::kUnitWeight;
+  const AliFlowQVectorCache *qVectors = anEvent->GetQVectors(12*n,8,eWeight);
+  for(Int_t m=0;m<12;m++)
+  {
+   for(Int_t k=0;k<9;k++)
+   {
+    (*fReQ)(m,k)+=qVectors->ReQ((m+1)*n,k,eWeight);
+    (*fImQ)(m,k)+=qVectors->ImQ((m+1)*n,k,eWeight);
+   }
+  }
+  for(Int_t p=0;p<8;p++)
+  {
+   for(Int_t k=0;k<9;k++)
+   {
+    (*fSpk)(p,k)+=qVectors->S(k,eWeight);
+   }
+  }
+ } // end of if(bSharedQVectors)
+
  // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!):
  for(Int_t p=0;p<8;p++)
  {
@@ -17,6 +17,7 @@
 #include "TMatrixD.h"
 #include "TH2D.h"
 #include "TRandom3.h"
+#include "TArrayD.h"
 #include "AliFlowCommonConstants.h"
 
 class TObjArray;
@@ -287,6 +288,10 @@ class AliFlowAnalysisWithQCumulants{
   Bool_t GetFillProfilesVsMUsingWeights() const {return this->fFillProfilesVsMUsingWeights;};
   void SetUseQvectorTerms(Bool_t const uqvt){this->fUseQvectorTerms = uqvt;if(uqvt){this->fStoreControlHistograms = kTRUE;}};
   Bool_t GetUseQvectorTerms() const {return this->fUseQvectorTerms;};
+  void SetUseQVectorKernel(Bool_t const uqvk){this->fUseQVectorKernel = uqvk;};
+  Bool_t GetUseQVectorKernel() const {return this->fUseQVectorKernel;};
+  void SetUseSharedQVectors(Bool_t const usqv){this->fUseSharedQVectors = usqv;};
+  Bool_t GetUseSharedQVectors() const {return this->fUseSharedQVectors;};
 
   // Reference flow profiles:
   void SetAvMultiplicity(TProfile* const avMultiplicity) {this->fAvMultiplicity = avMultiplicity;};
@@ -627,6 +632,10 @@ class AliFlowAnalysisWithQCumulants{
   Bool_t fUse2DHistograms; // use TH2D instead of TProfile to improve numerical stability in reference flow calculation 
   Bool_t fFillProfilesVsMUsingWeights; // if the width of multiplicity bin is 1, weights are not needed  
   Bool_t fUseQvectorTerms; // use TH2D with separate Q-vector terms instead of TProfile to improve numerical stability in reference flow calculation 
+  Bool_t fUseQVectorKernel; // calculate Q_{n,k} and S_{p,k} with batched AliFlowQVectorKernel instead of pow/cos/sin per track
+  Bool_t fUseSharedQVectors; // take Q_{n,k} and S_{p,k} from Q-vectors shared via AliFlowEventSimple::GetQVectors() (no phi, pt and eta weights only)
+  TArrayD fQVectorKernelPhi; //! phi of RPs buffered for AliFlowQVectorKernel
+  TArrayD fQVectorKernelWeight; //! total weight of RPs buffered for AliFlowQVectorKernel
 
   //  3c.) event-by-event quantities:
   TMatrixD *fReQ; //! fReQ[m][k] = sum_{i=1}^{M} w_{i}^{k} cos(m*phi_{i})
@@ -847,7 +856,7 @@ class AliFlowAnalysisWithQCumulants{
   TH2D *fBootstrapCumulants; // x-axis => QC{2}, QC{4}, QC{6}, QC{8}; y-axis => subsample # 
   TH2D *fBootstrapCumulantsVsM[4]; // index => QC{2}, QC{4}, QC{6}, QC{8}; x-axis => multiplicity; y-axis => subsample # 
 
-  ClassDef(AliFlowAnalysisWithQCumulants, 4);
+  ClassDef(AliFlowAnalysisWithQCumulants, 6);
 
 };
 
@@ -42,6 +42,7 @@
 #include "AliFlowTrackSimple.h"
 #include "AliFlowTrackSimpleCuts.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowQVectorCache.h"
 #include "TRandom.h"
 
 using std::cout;
@@ -82,6 +83,7 @@ AliFlowEventSimple::AliFlowEventSimple():
   fRun(-1),
   fZNCM(0.),
   fZNAM(0.),
+  fQVectorCache(NULL),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(NULL)
 {
@@ -136,6 +138,7 @@ AliFlowEventSimple::AliFlowEventSimple( Int_t n,
   fRun(-1),
   fZNCM(0.),
   fZNAM(0.),
+  fQVectorCache(NULL),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -194,6 +197,7 @@ AliFlowEventSimple::AliFlowEventSimple(const AliFlowEventSimple& anEvent):
   fZNAQ(anEvent.fZNAQ),
   fZNCM(anEvent.fZNCM),
   fZNAM(anEvent.fZNAM),
+  fQVectorCache(NULL),
   fNumberOfPOItypes(anEvent.fNumberOfPOItypes),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -286,6 +290,7 @@ AliFlowEventSimple& AliFlowEventSimple::operator=(const AliFlowEventSimple& anEv
     fV0A[i] = anEvent.fV0A[i];
   }
   delete [] fShuffledIndexes;
+  InvalidateQVectors();
   return *this;
 }
 
@@ -301,6 +306,7 @@ AliFlowEventSimple::~AliFlowEventSimple()
   delete fMCReactionPlaneAngleWrap;
   delete fShuffledIndexes;
   delete fMothersCollection;
+  delete fQVectorCache;
   delete [] fNumberOfPOIs;
 }
 
@@ -446,6 +452,7 @@ void AliFlowEventSimple::AddTrack( AliFlowTrackSimple* track )
 void AliFlowEventSimple::TrackAdded()
 {
   //book keeping after a new track has been added
+  InvalidateQVectors();
   fNumberOfTracks++;
   if (fShuffledIndexes)
   {
@@ -868,6 +875,7 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
   fRun(-1),
   fZNCM(0.),
   fZNAM(0.),
+  fQVectorCache(NULL),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -930,6 +938,7 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
 void AliFlowEventSimple::CloneTracks(Int_t n)
 {
   //clone every track n times to add non-flow
+  InvalidateQVectors();
   if (n<=0) return; //no use to clone stuff zero or less times
   Int_t ntracks = fNumberOfTracks;
   fTrackCollection->Expand((n+1)*fNumberOfTracks);
@@ -949,6 +958,7 @@ void AliFlowEventSimple::CloneTracks(Int_t n)
 void AliFlowEventSimple::ResolutionPt(Double_t res)
 {
   //smear pt of all tracks by gaussian with sigma=res
+  InvalidateQVectors();
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -964,6 +974,7 @@ void AliFlowEventSimple::TagSubeventsInEta( Double_t etaMinA,
                                             Double_t etaMaxB )
 {
   //Flag two subevents in given eta ranges
+  InvalidateQVectors();
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -979,6 +990,7 @@ void AliFlowEventSimple::TagSubeventsInEta( Double_t etaMinA,
 void AliFlowEventSimple::TagSubeventsByCharge()
 {
   //Flag two subevents in given eta ranges
+  InvalidateQVectors();
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -994,6 +1006,7 @@ void AliFlowEventSimple::TagSubeventsByCharge()
 void AliFlowEventSimple::AddV1( Double_t v1 )
 {
   //add v2 to all tracks wrt the reaction plane angle
+  InvalidateQVectors();
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1011,6 +1024,7 @@ void AliFlowEventSimple::AddV1( Double_t v1 )
 void AliFlowEventSimple::AddV2( Double_t v2 )
 {
   //add v2 to all tracks wrt the reaction plane angle
+  InvalidateQVectors();
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1028,6 +1042,7 @@ void AliFlowEventSimple::AddV2( Double_t v2 )
 void AliFlowEventSimple::AddV3( Double_t v3 )
 {
   //add v3 to all tracks wrt the reaction plane angle
+  InvalidateQVectors();
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1045,6 +1060,7 @@ void AliFlowEventSimple::AddV3( Double_t v3 )
 void AliFlowEventSimple::AddV4( Double_t v4 )
 {
   //add v4 to all tracks wrt the reaction plane angle
+  InvalidateQVectors();
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1062,6 +1078,7 @@ void AliFlowEventSimple::AddV4( Double_t v4 )
 void AliFlowEventSimple::AddV5( Double_t v5 )
 {
   //add v4 to all tracks wrt the reaction plane angle
+  InvalidateQVectors();
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1080,6 +1097,7 @@ void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_
                                   Double_t rp1, Double_t rp2, Double_t rp3, Double_t rp4, Double_t rp5 )
 {
   //add flow to all tracks wrt the reaction plane angle, for all harmonic separate angle
+  InvalidateQVectors();
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1092,6 +1110,7 @@ void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_
 void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_t v4, Double_t v5 )
 {
   //add flow to all tracks wrt the reaction plane angle
+  InvalidateQVectors();
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1104,6 +1123,7 @@ void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_
 void AliFlowEventSimple::AddV2( TF1* ptDepV2 )
 {
   //add v2 to all tracks wrt the reaction plane angle
+  InvalidateQVectors();
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1118,6 +1138,7 @@ void AliFlowEventSimple::AddV2( TF1* ptDepV2 )
 void AliFlowEventSimple::AddV2( TF2* ptEtaDepV2 )
 {
   //add v2 to all tracks wrt the reaction plane angle
+  InvalidateQVectors();
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1132,6 +1153,7 @@ void AliFlowEventSimple::AddV2( TF2* ptEtaDepV2 )
 void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
 {
   //tag tracks as reference particles (RPs)
+  InvalidateQVectors();
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1154,6 +1176,7 @@ void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
 void AliFlowEventSimple::TagPOI( const AliFlowTrackSimpleCuts* cuts, Int_t poiType )
 {
   //tag tracks as particles of interest (POIs)
+  InvalidateQVectors();
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1187,6 +1210,7 @@ void AliFlowEventSimple::DefineDeadZone( Double_t etaMin,
 {
   //mark tracks in given eta-phi region as dead
   //by resetting the flow bits
+  InvalidateQVectors();
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
@@ -1209,6 +1233,7 @@ Int_t AliFlowEventSimple::CleanUpDeadTracks()
 {
   //remove tracks that have no flow tags set and cleanup the container
   //returns number of cleaned tracks
+  InvalidateQVectors();
   Int_t ncleaned=0;
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1247,6 +1272,7 @@ TF1* AliFlowEventSimple::SimplePtSpectrum()
 void AliFlowEventSimple::ClearFast()
 {
   //clear the counters without deleting allocated objects so they can be reused
+  InvalidateQVectors();
   fReferenceMultiplicity = 0;
   fNumberOfTracks = 0;
   for (Int_t i=0; i<fNumberOfPOItypes; i++)
@@ -1259,3 +1285,16 @@ void AliFlowEventSimple::ClearFast()
   fUserModified = kFALSE;
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
 }
+
+//-----------------------------------------------------------------------
+const AliFlowQVectorCache* AliFlowEventSimple::GetQVectors(Int_t maxHarmonic, Int_t maxPower,
+                                                          AliFlowQVectorCache::EWeight w,
+                                                          AliFlowQVectorCache::ESubset s)
+{
+  //get read-only Q-vectors Q_{h,k} of RPs for h<=maxHarmonic and k<=maxPower,
+  //evaluated once per event for the union of all requests of the flow methods
+  if (!fQVectorCache) fQVectorCache = new AliFlowQVectorCache();
+  fQVectorCache->Request(maxHarmonic,maxPower,w,s);
+  if (!fQVectorCache->IsValid()) fQVectorCache->Evaluate(this);
+  return fQVectorCache;
+}
@@ -20,6 +20,7 @@
 #include "TParameter.h"
 #include "TMath.h"
 #include "AliFlowVector.h"
+#include "AliFlowQVectorCache.h"
 class TTree;
 class TF1;
 class TF2;
@@ -117,6 +118,11 @@ class AliFlowEventSimple: public TObject {
   void TrackAdded();
   AliFlowTrackSimple* MakeNewTrack();
  
+  const AliFlowQVectorCache* GetQVectors(Int_t maxHarmonic, Int_t maxPower,
+                                         AliFlowQVectorCache::EWeight w=AliFlowQVectorCache::kUnitWeight,
+                                         AliFlowQVectorCache::ESubset s=AliFlowQVectorCache::kAllRPs);
+  void InvalidateQVectors() { if (fQVectorCache) fQVectorCache->Invalidate(); }
+
   virtual AliFlowVector GetQ(Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void Get2Qsub(AliFlowVector* Qarray, Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void GetZDC2Qsub(AliFlowVector* Qarray);
@@ -189,6 +195,7 @@ class AliFlowEventSimple: public TObject {
   Double_t                fZNCM;                      // total energy from ZNC-C
   Double_t                fZNAM;                      // total energy from ZNC-A
   Double_t                fVtxPos[3];                 // Primary vertex position (x,y,z)
+  AliFlowQVectorCache*    fQVectorCache;              //! shared Q-vectors for all flow methods analysing this event
  
  private:
   Int_t                   fNumberOfPOItypes;    // how many different flow particle types do we have? (RP,POI,POI_2,...)
@@ -0,0 +1,129 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include "AliFlowQVectorCache.h"
+#include "AliFlowQVectorKernel.h"
+#include "AliFlowEventSimple.h"
+#include "AliFlowTrackSimple.h"
+
+//********************************************************************
+// AliFlowQVectorCache:                                              *
+// Per-event Q-vector service, see header for details.               *
+//********************************************************************
+
+ClassImp(AliFlowQVectorCache)
+
+//________________________________________________________________________
+
+AliFlowQVectorCache::AliFlowQVectorCache():
+  TObject(),
+  fValid(kFALSE)
+{
+  // default constructor
+  for(Int_t w=0;w<kNWeights;w++)
+  {
+    for(Int_t s=0;s<kNSubsets;s++)
+    {
+      fMaxHarmonic[w][s] = -1;
+      fMaxPower[w][s] = -1;
+    }
+  }
+  for(Int_t s=0;s<kNSubsets;s++){fNumberOfRPs[s] = 0;}
+}
+
+//________________________________________________________________________
+
+AliFlowQVectorCache::~AliFlowQVectorCache()
+{
+  // destructor
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorCache::Request(Int_t maxHarmonic, Int_t maxPower, EWeight w, ESubset s)
+{
+  // Extend the set of calculated Q-vectors to cover harmonics 0,...,maxHarmonic and
+  // weight powers 0,...,maxPower. Extending the request invalidates the current event.
+  if(maxHarmonic<0 || maxPower<0){return;}
+  if(IsRequested(maxHarmonic,maxPower,w,s)){return;}
+  if(maxHarmonic>fMaxHarmonic[w][s]){fMaxHarmonic[w][s] = maxHarmonic;}
+  if(maxPower>fMaxPower[w][s]){fMaxPower[w][s] = maxPower;}
+  fValid = kFALSE;
+}
+
+//________________________________________________________________________
+
+Bool_t AliFlowQVectorCache::IsRequested(Int_t maxHarmonic, Int_t maxPower, EWeight w, ESubset s) const
+{
+  // Are harmonics up to maxHarmonic and powers up to maxPower already requested?
+  return (maxHarmonic<=fMaxHarmonic[w][s] && maxPower<=fMaxPower[w][s]);
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorCache::Evaluate(AliFlowEventSimple* anEvent)
+{
+  // Calculate all requested Q-vectors for this event in one pass over the tracks.
+
+  fValid = kFALSE;
+  if(!anEvent){return;}
+
+  // Buffer phi and track weight of RPs per subset:
+  Int_t nTracks = anEvent->NumberOfTracks();
+  for(Int_t s=0;s<kNSubsets;s++)
+  {
+    fNumberOfRPs[s] = 0;
+    if(fPhi[s].GetSize()<nTracks)
+    {
+      fPhi[s].Set(nTracks);
+      fWeight[s].Set(nTracks);
+    }
+  }
+  for(Int_t i=0;i<nTracks;i++)
+  {
+    AliFlowTrackSimple* pTrack = anEvent->GetTrack(i);
+    if(!pTrack || !pTrack->InRPSelection()){continue;}
+    Double_t dPhi = pTrack->Phi();
+    Double_t dWeight = pTrack->Weight();
+    for(Int_t s=0;s<kNSubsets;s++)
+    {
+      if(s==kSubevent0 && !pTrack->InSubevent(0)){continue;}
+      if(s==kSubevent1 && !pTrack->InSubevent(1)){continue;}
+      fPhi[s][fNumberOfRPs[s]] = dPhi;
+      fWeight[s][fNumberOfRPs[s]] = dWeight;
+      fNumberOfRPs[s]++;
+    }
+  }
+
+  // Evaluate requested Q-vectors; row h=0 holds S_{k}:
+  for(Int_t w=0;w<kNWeights;w++)
+  {
+    for(Int_t s=0;s<kNSubsets;s++)
+    {
+      if(fMaxHarmonic[w][s]<0){continue;}
+      Int_t nPowers = fMaxPower[w][s]+1;
+      Int_t nEntries = (fMaxHarmonic[w][s]+1)*nPowers;
+      fReQ[w][s].Set(nEntries);
+      fImQ[w][s].Set(nEntries);
+      fReQ[w][s].Reset();
+      fImQ[w][s].Reset();
+      AliFlowQVectorKernel::Fill(fNumberOfRPs[s],fPhi[s].GetArray(),(w==kTrackWeight ? fWeight[s].GetArray() : NULL),
+                                 1.,fMaxHarmonic[w][s],nPowers,
+                                 fReQ[w][s].GetArray()+nPowers,fImQ[w][s].GetArray()+nPowers,fReQ[w][s].GetArray());
+    }
+  }
+
+  fValid = kTRUE;
+}
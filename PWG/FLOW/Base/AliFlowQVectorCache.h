@@ -0,0 +1,69 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+#ifndef ALIFLOWQVECTORCACHE_H
+#define ALIFLOWQVECTORCACHE_H
+
+#include "TObject.h"
+#include "TArrayD.h"
+
+class AliFlowEventSimple;
+
+//********************************************************************
+// AliFlowQVectorCache:                                              *
+// Per-event Q-vector service attached to AliFlowEventSimple.        *
+// Flow methods analysing the same event request the harmonics and   *
+// weight powers they need; the union of all requests is evaluated   *
+// lazily in a single pass over the RPs (with AliFlowQVectorKernel)  *
+// and handed out read-only:                                         *
+//   Q_{h,k} = sum_i w_i^k exp(i*h*phi_i), h = 0,...,maxHarmonic     *
+//   S_{k}   = sum_i w_i^k = Q_{0,k},      k = 0,...,maxPower        *
+// Requests are kept when the event is cleared, so after the first   *
+// event every method finds its Q-vectors already calculated.        *
+//********************************************************************
+
+class AliFlowQVectorCache: public TObject {
+ public:
+  enum EWeight { kUnitWeight,   // w_i = 1
+                 kTrackWeight,  // w_i = AliFlowTrackSimple::Weight()
+                 kNWeights };
+  enum ESubset { kAllRPs,       // all reference particles
+                 kSubevent0,    // RPs in subevent 0
+                 kSubevent1,    // RPs in subevent 1
+                 kNSubsets };
+
+  AliFlowQVectorCache();
+  virtual ~AliFlowQVectorCache();
+
+  void Request(Int_t maxHarmonic, Int_t maxPower, EWeight w=kUnitWeight, ESubset s=kAllRPs);
+  Bool_t IsRequested(Int_t maxHarmonic, Int_t maxPower, EWeight w=kUnitWeight, ESubset s=kAllRPs) const;
+  void Invalidate() {fValid=kFALSE;}
+  Bool_t IsValid() const {return fValid;}
+  void Evaluate(AliFlowEventSimple* anEvent);
+
+  // Read-only views, valid only after Evaluate():
+  Int_t GetMaxHarmonic(EWeight w=kUnitWeight, ESubset s=kAllRPs) const {return fMaxHarmonic[w][s];}
+  Int_t GetMaxPower(EWeight w=kUnitWeight, ESubset s=kAllRPs) const {return fMaxPower[w][s];}
+  Int_t GetNumberOfRPs(ESubset s=kAllRPs) const {return fNumberOfRPs[s];}
+  Double_t ReQ(Int_t h, Int_t k, EWeight w=kUnitWeight, ESubset s=kAllRPs) const {return fReQ[w][s].At(h*(fMaxPower[w][s]+1)+k);}
+  Double_t ImQ(Int_t h, Int_t k, EWeight w=kUnitWeight, ESubset s=kAllRPs) const {return fImQ[w][s].At(h*(fMaxPower[w][s]+1)+k);}
+  Double_t S(Int_t k, EWeight w=kUnitWeight, ESubset s=kAllRPs) const {return fReQ[w][s].At(k);}
+
+ private:
+  AliFlowQVectorCache(const AliFlowQVectorCache& qc);
+  AliFlowQVectorCache& operator=(const AliFlowQVectorCache& qc);
+
+  Bool_t fValid;                           // Q-vectors of the current event are calculated
+  Int_t fMaxHarmonic[kNWeights][kNSubsets]; // requested maximum harmonic (-1 if not requested)
+  Int_t fMaxPower[kNWeights][kNSubsets];    // requested maximum weight power
+  Int_t fNumberOfRPs[kNSubsets];            // number of RPs used in the current event
+  TArrayD fReQ[kNWeights][kNSubsets];       // Re[Q_{h,k}], index h*(maxPower+1)+k
+  TArrayD fImQ[kNWeights][kNSubsets];       // Im[Q_{h,k}], index h*(maxPower+1)+k
+  TArrayD fPhi[kNSubsets];                  // buffered phi of RPs
+  TArrayD fWeight[kNSubsets];               // buffered track weights of RPs
+
+  ClassDef(AliFlowQVectorCache, 1)
+};
+
+#endif
@@ -0,0 +1,160 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include "AliFlowQVectorKernel.h"
+#include "TMath.h"
+
+//********************************************************************
+// AliFlowQVectorKernel:                                             *
+// Batched evaluation of weighted Q-vectors, see header for details. *
+//********************************************************************
+
+ClassImp(AliFlowQVectorKernel)
+
+//________________________________________________________________________
+
+void AliFlowQVectorKernel::Fill(Int_t nTracks, const Double_t *phi, const Double_t *weight,
+                                Double_t harmonic, Int_t nHarmonics, Int_t nPowers,
+                                Double_t *reQ, Double_t *imQ, Double_t *sumW)
+{
+ // Accumulate Q_{m*n,k} and S_{k} for a block of tracks.
+ //
+ // Tracks are processed in blocks of kBlockSize. Within a block:
+ //  a) cos(n*phi) and sin(n*phi) are evaluated once per track;
+ //  b) the table of weight powers w^k is built by successive multiplication;
+ //  c) the harmonics (m+1)*n are obtained from the complex recurrence
+ //     exp(i(m+1)n*phi) = exp(i*m*n*phi) * exp(i*n*phi).
+ // All inner loops run over the tracks of the block and have no
+ // loop-carried dependencies apart from the reductions, so they vectorize.
+
+ if(nTracks<=0 || !phi){return;}
+ if(nHarmonics<0){nHarmonics=0;}
+ if(nPowers<1){return;}
+ if(nPowers>kMaxPowers)
+ {
+  // Fall back to the reference implementation for unusually many powers:
+  FillReference(nTracks,phi,weight,harmonic,nHarmonics,nPowers,reQ,imQ,sumW);
+  return;
+ }
+
+ Double_t c1[kBlockSize]; // cos(n*phi)
+ Double_t s1[kBlockSize]; // sin(n*phi)
+ Double_t cm[kBlockSize]; // cos((m+1)*n*phi)
+ Double_t sm[kBlockSize]; // sin((m+1)*n*phi)
+ Double_t wk[kMaxPowers][kBlockSize]; // w^k
+
+ for(Int_t i0=0;i0<nTracks;i0+=kBlockSize)
+ {
+  const Int_t nb = (nTracks-i0 < kBlockSize) ? nTracks-i0 : kBlockSize;
+  const Double_t *bphi = phi+i0;
+
+  // a) one cos/sin pair per track:
+  for(Int_t i=0;i<nb;i++)
+  {
+   c1[i] = TMath::Cos(harmonic*bphi[i]);
+   s1[i] = TMath::Sin(harmonic*bphi[i]);
+  }
+
+  // b) weight powers:
+  for(Int_t i=0;i<nb;i++){wk[0][i] = 1.;}
+  if(weight)
+  {
+   const Double_t *bw = weight+i0;
+   for(Int_t k=1;k<nPowers;k++)
+   {
+    for(Int_t i=0;i<nb;i++){wk[k][i] = wk[k-1][i]*bw[i];}
+   }
+  } else
+    {
+     for(Int_t k=1;k<nPowers;k++)
+     {
+      for(Int_t i=0;i<nb;i++){wk[k][i] = 1.;}
+     }
+    }
+
+  if(sumW)
+  {
+   for(Int_t k=0;k<nPowers;k++)
+   {
+    Double_t s = 0.;
+    for(Int_t i=0;i<nb;i++){s += wk[k][i];}
+    sumW[k] += s;
+   }
+  }
+
+  if(nHarmonics==0 || !(reQ || imQ)){continue;}
+
+  // c) harmonics via complex multiplication:
+  for(Int_t i=0;i<nb;i++)
+  {
+   cm[i] = c1[i];
+   sm[i] = s1[i];
+  }
+  for(Int_t m=0;m<nHarmonics;m++)
+  {
+   for(Int_t k=0;k<nPowers;k++)
+   {
+    Double_t re = 0.;
+    Double_t im = 0.;
+    for(Int_t i=0;i<nb;i++)
+    {
+     re += wk[k][i]*cm[i];
+     im += wk[k][i]*sm[i];
+    }
+    if(reQ){reQ[m*nPowers+k] += re;}
+    if(imQ){imQ[m*nPowers+k] += im;}
+   }
+   if(m+1<nHarmonics)
+   {
+    for(Int_t i=0;i<nb;i++)
+    {
+     const Double_t c = cm[i]*c1[i]-sm[i]*s1[i];
+     const Double_t s = sm[i]*c1[i]+cm[i]*s1[i];
+     cm[i] = c;
+     sm[i] = s;
+    }
+   }
+  } // end of for(Int_t m=0;m<nHarmonics;m++)
+ } // end of for(Int_t i0=0;i0<nTracks;i0+=kBlockSize)
+
+} // end of void AliFlowQVectorKernel::Fill(...)
+
+//________________________________________________________________________
+
+void AliFlowQVectorKernel::FillReference(Int_t nTracks, const Double_t *phi, const Double_t *weight,
+                                         Double_t harmonic, Int_t nHarmonics, Int_t nPowers,
+                                         Double_t *reQ, Double_t *imQ, Double_t *sumW)
+{
+ // Straightforward evaluation, as originally done per track in AliFlowAnalysisWithQCumulants::Make().
+
+ if(nTracks<=0 || !phi){return;}
+ for(Int_t i=0;i<nTracks;i++)
+ {
+  const Double_t w = weight ? weight[i] : 1.;
+  for(Int_t m=0;m<nHarmonics;m++)
+  {
+   for(Int_t k=0;k<nPowers;k++)
+   {
+    if(reQ){reQ[m*nPowers+k] += pow(w,k)*TMath::Cos((m+1)*harmonic*phi[i]);}
+    if(imQ){imQ[m*nPowers+k] += pow(w,k)*TMath::Sin((m+1)*harmonic*phi[i]);}
+   }
+  }
+  if(sumW)
+  {
+   for(Int_t k=0;k<nPowers;k++){sumW[k] += pow(w,k);}
+  }
+ }
+
+} // end of void AliFlowQVectorKernel::FillReference(...)
@@ -0,0 +1,46 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+#ifndef ALIFLOWQVECTORKERNEL_H
+#define ALIFLOWQVECTORKERNEL_H
+
+#include "Rtypes.h"
+
+//********************************************************************
+// AliFlowQVectorKernel:                                             *
+// Batched evaluation of weighted Q-vectors                          *
+//   Q_{m*n,k} = sum_i w_i^k exp(i*m*n*phi_i)                        *
+//   S_{k}     = sum_i w_i^k                                         *
+// on a structure-of-arrays view of the tracks (phi[], weight[]).    *
+// Harmonics are built with complex multiplication recurrences and   *
+// weight powers incrementally, so only one cos/sin pair per track   *
+// is needed instead of one pow/cos/sin triplet per (m,k) entry.     *
+//********************************************************************
+
+class AliFlowQVectorKernel {
+ public:
+  enum { kBlockSize = 64,  // number of tracks processed per block
+         kMaxPowers = 16   // maximum number of weight powers k = 0,...,kMaxPowers-1
+  };
+
+  // Accumulate (+=) into reQ/imQ [nHarmonics*nPowers] (row m = harmonic (m+1)*n, column k = power)
+  // and into sumW [nPowers]; weight == NULL means unit weights; reQ, imQ or sumW may be NULL.
+  static void Fill(Int_t nTracks, const Double_t *phi, const Double_t *weight,
+                   Double_t harmonic, Int_t nHarmonics, Int_t nPowers,
+                   Double_t *reQ, Double_t *imQ, Double_t *sumW);
+
+  // Reference implementation with explicit pow/cos/sin per entry (for validation and benchmarks)
+  static void FillReference(Int_t nTracks, const Double_t *phi, const Double_t *weight,
+                            Double_t harmonic, Int_t nHarmonics, Int_t nPowers,
+                            Double_t *reQ, Double_t *imQ, Double_t *sumW);
+
+ private:
+  AliFlowQVectorKernel();                                        // static methods only
+  AliFlowQVectorKernel(const AliFlowQVectorKernel& k);           // not implemented
+  AliFlowQVectorKernel& operator=(const AliFlowQVectorKernel& k); // not implemented
+
+  ClassDef(AliFlowQVectorKernel, 0)
+};
+
+#endif
@@ -44,5 +44,7 @@
 #pragma link C++ class AliFlowAnalysisWithNestedLoops+;
 #pragma link C++ class AliFlowOnTheFlyEventGenerator+;
 #pragma link C++ class AliFlowAnalysisWithMultiparticleCorrelations+;
+#pragma link C++ class AliFlowQVectorKernel+;
+#pragma link C++ class AliFlowQVectorCache+;
 
 #endif
@@ -59,7 +59,8 @@ fUseParticleWeights(useParticleWeights),
 fUsePhiWeights(kFALSE),
 fUsePtWeights(kFALSE),
 fUseEtaWeights(kFALSE),
-fWeightsList(NULL)
+fWeightsList(NULL),
+fUseSharedQVectors(kFALSE)
 {
  // constructor
  cout<<"AliAnalysisTaskMixedHarmonics::AliAnalysisTaskMixedHarmonics(const char *name, Bool_t useParticleWeights)"<<endl;
@@ -96,7 +97,8 @@ fUseParticleWeights(kFALSE),
 fUsePhiWeights(kFALSE),
 fUsePtWeights(kFALSE),
 fUseEtaWeights(kFALSE),
-fWeightsList(NULL)
+fWeightsList(NULL),
+fUseSharedQVectors(kFALSE)
 {
  // Dummy constructor
  cout<<"AliAnalysisTaskMixedHarmonics::AliAnalysisTaskMixedHarmonics()"<<endl;
@@ -123,6 +125,7 @@ void AliAnalysisTaskMixedHarmonics::UserCreateOutputObjects()
  fMH->SetPrintOnTheScreen(fPrintOnTheScreen); 
  fMH->SetCalculateVsM(fCalculateVsM); 
  fMH->SetShowBinLabelsVsM(fShowBinLabelsVsM);
+ fMH->SetUseSharedQVectors(fUseSharedQVectors);
  if(fUseParticleWeights)
  {
   // Pass the flags to class:
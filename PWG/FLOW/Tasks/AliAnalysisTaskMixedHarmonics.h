@@ -66,6 +66,8 @@ class AliAnalysisTaskMixedHarmonics : public AliAnalysisTaskSE{
   Bool_t GetUsePtWeights() const {return this->fUsePtWeights;};
   void SetUseEtaWeights(Bool_t const uEtaW) {this->fUseEtaWeights = uEtaW;};
   Bool_t GetUseEtaWeights() const {return this->fUseEtaWeights;};
+  void SetUseSharedQVectors(Bool_t const usqv) {this->fUseSharedQVectors = usqv;};
+  Bool_t GetUseSharedQVectors() const {return this->fUseSharedQVectors;};
  
  private:
   AliAnalysisTaskMixedHarmonics(const AliAnalysisTaskMixedHarmonics& aatmh);
@@ -91,8 +93,9 @@ class AliAnalysisTaskMixedHarmonics : public AliAnalysisTaskSE{
   Bool_t fUsePtWeights; // use pt weights
   Bool_t fUseEtaWeights; // use eta weights  
   TList *fWeightsList; // list with weights
+  Bool_t fUseSharedQVectors; // take Q-vectors shared by all flow methods from AliFlowEventSimple
   
-  ClassDef(AliAnalysisTaskMixedHarmonics, 1); 
+  ClassDef(AliAnalysisTaskMixedHarmonics, 2); 
 };
 
 //================================================================================================================
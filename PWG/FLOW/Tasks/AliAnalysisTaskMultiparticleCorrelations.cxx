@@ -55,6 +55,7 @@ AliAnalysisTaskMultiparticleCorrelations::AliAnalysisTaskMultiparticleCorrelatio
  fSkipSomeIntervals(kFALSE),
  fCalculateQvector(kFALSE),
  fCalculateDiffQvectors(kFALSE),
+ fUseSharedQvector(kFALSE),
  fProduction(""),
  fCalculateCorrelations(kFALSE),
  fCalculateIsotropic(kFALSE),
@@ -187,6 +188,7 @@ AliAnalysisTaskMultiparticleCorrelations::AliAnalysisTaskMultiparticleCorrelatio
  fSkipSomeIntervals(kFALSE),
  fCalculateQvector(kFALSE),
  fCalculateDiffQvectors(kFALSE),
+ fUseSharedQvector(kFALSE),
  fProduction(""),
  fCalculateCorrelations(kFALSE),
  fCalculateIsotropic(kFALSE),
@@ -312,6 +314,7 @@ void AliAnalysisTaskMultiparticleCorrelations::UserCreateOutputObjects()
  fMPC->SetFillMultCorrelationsHist(fFillMultCorrelationsHist);
  fMPC->SetCalculateQvector(fCalculateQvector);
  fMPC->SetCalculateDiffQvectors(fCalculateDiffQvectors);
+ fMPC->SetUseSharedQvector(fUseSharedQvector);
  fMPC->SetCalculateCorrelations(fCalculateCorrelations);
  fMPC->SetCalculateIsotropic(fCalculateIsotropic);
  fMPC->SetCalculateSame(fCalculateSame);
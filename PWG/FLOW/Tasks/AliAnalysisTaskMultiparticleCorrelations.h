@@ -72,6 +72,8 @@ class AliAnalysisTaskMultiparticleCorrelations : public AliAnalysisTaskSE{
   Bool_t GetCalculateQvector() const {return this->fCalculateQvector;};
   void SetCalculateDiffQvectors(Bool_t cdqv) {this->fCalculateDiffQvectors = cdqv;};
   Bool_t GetCalculateDiffQvectors() const {return this->fCalculateDiffQvectors;};
+  void SetUseSharedQvector(Bool_t usqv) {this->fUseSharedQvector = usqv;};
+  Bool_t GetUseSharedQvector() const {return this->fUseSharedQvector;};
 
   // Weights:              
   void SetWeightsHist(TH1D* const hist, const char *type, const char *variable); // .cxx
@@ -198,6 +200,7 @@ class AliAnalysisTaskMultiparticleCorrelations : public AliAnalysisTaskSE{
   // Q-vectors:
   Bool_t fCalculateQvector;      // to calculate or not to calculate Q-vector components, that's a Boolean...
   Bool_t fCalculateDiffQvectors; // to calculate or not to calculate p- and q-vector components, that's a Boolean...
+  Bool_t fUseSharedQvector;      // take Q-vector components shared by all flow methods from AliFlowEventSimple
 
   // Weights:
   Bool_t fUseWeights[2][3]; // use weights [RP,POI][phi,pt,eta]
@@ -249,7 +252,7 @@ class AliAnalysisTaskMultiparticleCorrelations : public AliAnalysisTaskSE{
   // Eta gaps:
   Bool_t fCalculateEtaGaps; // calculate correlations with eta gaps
 
-  ClassDef(AliAnalysisTaskMultiparticleCorrelations,6);
+  ClassDef(AliAnalysisTaskMultiparticleCorrelations,7);
 
 };
 
@@ -70,6 +70,7 @@ AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants(const char *name, Bool_t us
  fUse2DHistograms(kFALSE),
  fFillProfilesVsMUsingWeights(kTRUE),
  fUseQvectorTerms(kFALSE),
+ fUseSharedQVectors(kFALSE),
  fnBinsMult(10000),
  fMinMult(0.),  
  fMaxMult(10000.), 
@@ -168,6 +169,7 @@ AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants():
  fUse2DHistograms(kFALSE),
  fFillProfilesVsMUsingWeights(kTRUE),
  fUseQvectorTerms(kFALSE),
+ fUseSharedQVectors(kFALSE),
  fnBinsMult(0),
  fMinMult(0.),  
  fMaxMult(0.), 
@@ -283,6 +285,7 @@ void AliAnalysisTaskQCumulants::UserCreateOutputObjects()
  fQC->SetUse2DHistograms(fUse2DHistograms);
  fQC->SetFillProfilesVsMUsingWeights(fFillProfilesVsMUsingWeights);
  fQC->SetUseQvectorTerms(fUseQvectorTerms);
+ fQC->SetUseSharedQVectors(fUseSharedQVectors);
 
  // Store phi distribution for one event to illustrate flow:
  fQC->SetStorePhiDistributionForOneEvent(fStorePhiDistributionForOneEvent);
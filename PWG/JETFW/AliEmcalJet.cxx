@@ -60,9 +60,15 @@ AliEmcalJet::AliEmcalJet() :
   fTriggers(0),
   fLabel(-1),
   fHasGhost(kFALSE),
-  fGhosts(),
+  fGhostScale(1),
+  fGhostPx(),
+  fGhostPy(),
+  fGhostPz(),
+  fGhostE(),
   fJetShapeProperties(0),
-  fJetAcceptanceType(0)
+  fJetAcceptanceType(0),
+  fClusterIDsOrder(kOrderUnknown),
+  fTrackIDsOrder(kOrderUnknown)
 {
   fClosestJets[0] = 0;
   fClosestJets[1] = 0;
@@ -110,9 +116,15 @@ AliEmcalJet::AliEmcalJet(Double_t px, Double_t py, Double_t pz) :
   fTriggers(0),
   fLabel(-1),
   fHasGhost(kFALSE),
-  fGhosts(),
+  fGhostScale(1),
+  fGhostPx(),
+  fGhostPy(),
+  fGhostPz(),
+  fGhostE(),
   fJetShapeProperties(0),
-  fJetAcceptanceType(0)
+  fJetAcceptanceType(0),
+  fClusterIDsOrder(kOrderUnknown),
+  fTrackIDsOrder(kOrderUnknown)
 {
   if (fPt != 0) {
     fPhi = TVector2::Phi_0_2pi(TMath::ATan2(py, px));
@@ -165,9 +177,15 @@ AliEmcalJet::AliEmcalJet(Double_t pt, Double_t eta, Double_t phi, Double_t m) :
   fTriggers(0),
   fLabel(-1),
   fHasGhost(kFALSE),
-  fGhosts(),
+  fGhostScale(1),
+  fGhostPx(),
+  fGhostPy(),
+  fGhostPz(),
+  fGhostE(),
   fJetShapeProperties(0),
-  fJetAcceptanceType(0)
+  fJetAcceptanceType(0),
+  fClusterIDsOrder(kOrderUnknown),
+  fTrackIDsOrder(kOrderUnknown)
 {
   fPhi = TVector2::Phi_0_2pi(fPhi);
 
@@ -214,9 +232,15 @@ AliEmcalJet::AliEmcalJet(const AliEmcalJet& jet) :
   fTriggers(jet.fTriggers),
   fLabel(jet.fLabel),
   fHasGhost(jet.fHasGhost),
-  fGhosts(jet.fGhosts),
+  fGhostScale(jet.fGhostScale),
+  fGhostPx(jet.fGhostPx),
+  fGhostPy(jet.fGhostPy),
+  fGhostPz(jet.fGhostPz),
+  fGhostE(jet.fGhostE),
   fJetShapeProperties(0),
-  fJetAcceptanceType(jet.fJetAcceptanceType)
+  fJetAcceptanceType(jet.fJetAcceptanceType),
+  fClusterIDsOrder(jet.fClusterIDsOrder),
+  fTrackIDsOrder(jet.fTrackIDsOrder)
 {
   // Copy constructor.
   fClosestJets[0]     = jet.fClosestJets[0];
@@ -268,6 +292,8 @@ AliEmcalJet& AliEmcalJet::operator=(const AliEmcalJet& jet)
     fNEmc               = jet.fNEmc;
     fClusterIDs         = jet.fClusterIDs;
     fTrackIDs           = jet.fTrackIDs;
+    fClusterIDsOrder    = jet.fClusterIDsOrder;
+    fTrackIDsOrder      = jet.fTrackIDsOrder;
     fClosestJets[0]     = jet.fClosestJets[0];
     fClosestJets[1]     = jet.fClosestJets[1];
     fClosestJetsDist[0] = jet.fClosestJetsDist[0];
@@ -279,8 +305,12 @@ AliEmcalJet& AliEmcalJet::operator=(const AliEmcalJet& jet)
     fPtSubVect          = jet.fPtSubVect;
     fTriggers           = jet.fTriggers;
     fLabel              = jet.fLabel;
-    fHasGhost = jet.fHasGhost;
-    fGhosts   = jet.fGhosts;
+    fHasGhost   = jet.fHasGhost;
+    fGhostScale = jet.fGhostScale;
+    fGhostPx    = jet.fGhostPx;
+    fGhostPy    = jet.fGhostPy;
+    fGhostPz    = jet.fGhostPz;
+    fGhostE     = jet.fGhostE;
     if (jet.fJetShapeProperties) {
       fJetShapeProperties = new AliEmcalJetShapeProperties(*(jet.fJetShapeProperties));
     }
@@ -374,12 +404,14 @@ TLorentzVector AliEmcalJet::SubtractRhoVect(Double_t rho, Bool_t save)
 
 /**
  *  Sort constituent by index (increasing).
- *
+ *  ContainsTrack(Int_t) and ContainsCluster(Int_t) then use a binary search.
  */
 void AliEmcalJet::SortConstituents()
 {
   std::sort(fClusterIDs.GetArray(), fClusterIDs.GetArray() + fClusterIDs.GetSize());
   std::sort(fTrackIDs.GetArray(), fTrackIDs.GetArray() + fTrackIDs.GetSize());
+  fClusterIDsOrder = kOrderSorted;
+  fTrackIDsOrder = kOrderSorted;
 }
 
 /**
@@ -531,10 +563,7 @@ void AliEmcalJet::ResetMatching()
  */
 Int_t AliEmcalJet::ContainsTrack(Int_t it) const
 {
-  for (Int_t i = 0; i < fTrackIDs.GetSize(); i++) {
-    if (it == fTrackIDs[i]) return i;
-  }
-  return -1;
+  return FindConstituent(fTrackIDs, it, fTrackIDsOrder);
 }
 
 /**
@@ -544,8 +573,33 @@ Int_t AliEmcalJet::ContainsTrack(Int_t it) const
  */
 Int_t AliEmcalJet::ContainsCluster(Int_t ic) const
 {
-  for (Int_t i = 0; i < fClusterIDs.GetSize(); i++) {
-    if (ic == fClusterIDs[i]) return i;
+  return FindConstituent(fClusterIDs, ic, fClusterIDsOrder);
+}
+
+/**
+ * Looks for a constituent id. The order of the ids is checked at the first search
+ * after they have been modified: sorted ids (e.g. after SortConstituents(), as done
+ * by the jet finder) are searched with a binary search, otherwise all of them are compared.
+ * @param ids Constituent ids
+ * @param id Id to search
+ * @param order Order of the ids (see EConstituentOrder), updated if unknown
+ * @return The position of the first occurrence of id in ids, -1 if not found
+ */
+Int_t AliEmcalJet::FindConstituent(const TArrayI &ids, Int_t id, Char_t &order)
+{
+  const Int_t n = ids.GetSize();
+  const Int_t *first = ids.GetArray();
+
+  if (order == kOrderUnknown) order = std::is_sorted(first, first + n) ? kOrderSorted : kOrderUnsorted;
+
+  if (order == kOrderSorted) {
+    const Int_t *pos = std::lower_bound(first, first + n, id);
+    if (pos != first + n && *pos == id) return pos - first;
+    return -1;
+  }
+
+  for (Int_t i = 0; i < n; i++) {
+    if (id == first[i]) return i;
   }
   return -1;
 }
@@ -649,12 +703,41 @@ std::ostream &operator<<(std::ostream &in, const AliEmcalJet &myjet) {
  */
 void AliEmcalJet::AddGhost(const Double_t dPx, const Double_t dPy, const Double_t dPz, const Double_t dE)
 {
-  TLorentzVector ghost(dPx, dPy, dPz, dE);
-  fGhosts.push_back(ghost);
+  // The ghosts are stored in single precision relative to the momentum scale of the first one,
+  // as their momenta (~1e-100 GeV/c) are below the range of a float
+  if (fGhostPx.empty()) {
+    fGhostScale = TMath::Max(TMath::Max(TMath::Abs(dPx), TMath::Abs(dPy)), TMath::Max(TMath::Abs(dPz), TMath::Abs(dE)));
+    if (!(fGhostScale > 0)) fGhostScale = 1;
+  }
+  fGhostPx.push_back(dPx / fGhostScale);
+  fGhostPy.push_back(dPy / fGhostScale);
+  fGhostPz.push_back(dPz / fGhostScale);
+  fGhostE.push_back(dE / fGhostScale);
   if (!fHasGhost) fHasGhost = kTRUE;
   return;
 }
 
+/**
+ * Retrieve a ghost particle.
+ * @param i Position of the ghost particle
+ * @param ghost Four-momentum of the ghost particle (output)
+ */
+void AliEmcalJet::GetGhost(Int_t i, TLorentzVector &ghost) const
+{
+  ghost.SetPxPyPzE(fGhostPx[i] * fGhostScale, fGhostPy[i] * fGhostScale, fGhostPz[i] * fGhostScale, fGhostE[i] * fGhostScale);
+}
+
+/**
+ * Retrieve all the ghost particles. GetGhost() avoids the copy.
+ * @return Vector with the four-momenta of the ghost particles
+ */
+const std::vector<TLorentzVector> AliEmcalJet::GetGhosts() const
+{
+  std::vector<TLorentzVector> ghosts(fGhostPx.size());
+  for (UInt_t i = 0; i < ghosts.size(); i++) GetGhost(i, ghosts[i]);
+  return ghosts;
+}
+
 /**
  * Clear this object: remove matching information, jet constituents, ghosts
  */
@@ -668,8 +751,14 @@ void AliEmcalJet::Clear(Option_t */*option*/)
   fClosestJetsDist[1] = 0;
   fMatched = 0;
   fPtSub = 0;
-  fGhosts.clear();
+  fGhostScale = 1;
+  fGhostPx.clear();
+  fGhostPy.clear();
+  fGhostPz.clear();
+  fGhostE.clear();
   fHasGhost = kFALSE;
+  fClusterIDsOrder = kOrderUnknown;
+  fTrackIDsOrder = kOrderUnknown;
 }
 
 /**
@@ -710,7 +799,14 @@ AliVParticle* AliEmcalJet::TrackAt(Int_t idx, TClonesArray *ta) const
 Int_t AliEmcalJet::ContainsTrack(AliVParticle* track, TClonesArray* tracks) const
 {
   if (!tracks || !track) return 0;
-  return ContainsTrack(tracks->IndexOf(track));
+
+  // compare the objects pointed by the constituent ids instead of looking for the track in the whole array
+  const Int_t n = tracks->GetEntriesFast();
+  for (Int_t i = 0; i < fTrackIDs.GetSize(); i++) {
+    Int_t it = fTrackIDs[i];
+    if (it >= 0 && it < n && tracks->UncheckedAt(it) == track) return i;
+  }
+  return -1;
 }
 
 /**
@@ -752,7 +848,14 @@ AliVCluster* AliEmcalJet::ClusterAt(Int_t idx, TClonesArray *ca) const
 Int_t AliEmcalJet::ContainsCluster(AliVCluster* cluster, TClonesArray* clusters) const
 {
   if (!clusters || !cluster) return 0;
-  return ContainsCluster(clusters->IndexOf(cluster));
+
+  // compare the objects pointed by the constituent ids instead of looking for the cluster in the whole array
+  const Int_t n = clusters->GetEntriesFast();
+  for (Int_t i = 0; i < fClusterIDs.GetSize(); i++) {
+    Int_t ic = fClusterIDs[i];
+    if (ic >= 0 && ic < n && clusters->UncheckedAt(ic) == cluster) return i;
+  }
+  return -1;
 }
 
 /**
@@ -84,6 +84,16 @@ class AliEmcalJet : public AliVParticle
     kBckgrd3 = 1<<6     ///< Generic background 3
   };
 
+  /**
+   * @enum EConstituentOrder
+   * @brief Order of the constituent ids, sorted ids are searched with a binary search
+   */
+  enum EConstituentOrder {
+    kOrderUnknown  = 0,  ///< Not checked yet
+    kOrderSorted   = 1,  ///< Sorted by increasing id
+    kOrderUnsorted = 2   ///< Not sorted
+  };
+
   AliEmcalJet();
   AliEmcalJet(Double_t px, Double_t py, Double_t pz);
   AliEmcalJet(Double_t pt, Double_t eta, Double_t phi, Double_t m);
@@ -190,8 +200,8 @@ class AliEmcalJet : public AliVParticle
   void              SetMaxNeutralPt(Double32_t t)      { fMaxNPt  = t;                     }
   void              SetMaxChargedPt(Double32_t t)      { fMaxCPt  = t;                     }
   void              SetNEF(Double_t nef)               { fNEF     = nef;                   }
-  void              SetNumberOfClusters(Int_t n)       { fClusterIDs.Set(n);               }
-  void              SetNumberOfTracks(Int_t n)         { fTrackIDs.Set(n);                 }
+  void              SetNumberOfClusters(Int_t n)       { fClusterIDs.Set(n); fClusterIDsOrder = kOrderUnknown; }
+  void              SetNumberOfTracks(Int_t n)         { fTrackIDs.Set(n); fTrackIDsOrder = kOrderUnknown;     }
   void              SetNumberOfCharged(Int_t n)        { fNch = n;                         }
   void              SetNumberOfNeutrals(Int_t n)       { fNn = n;                          }
   void              SetMCPt(Double_t p)                { fMCPt = p;                        }
@@ -199,8 +209,8 @@ class AliEmcalJet : public AliVParticle
   void              SetPtEmc(Double_t pt)              { fPtEmc          = pt;             }
   void              SetPtSub(Double_t ps)              { fPtSub          = ps;             }
   void              SetPtSubVect(Double_t ps)          { fPtSubVect      = ps;             }
-  void              AddClusterAt(Int_t clus, Int_t idx){ fClusterIDs.AddAt(clus, idx);     }
-  void              AddTrackAt(Int_t track, Int_t idx) { fTrackIDs.AddAt(track, idx);      }
+  void              AddClusterAt(Int_t clus, Int_t idx){ fClusterIDs.AddAt(clus, idx); fClusterIDsOrder = kOrderUnknown; }
+  void              AddTrackAt(Int_t track, Int_t idx) { fTrackIDs.AddAt(track, idx); fTrackIDsOrder = kOrderUnknown;    }
   void              Clear(Option_t */*option*/="");
 
   // Sorting methods
@@ -223,6 +233,7 @@ class AliEmcalJet : public AliVParticle
   AliEmcalJet*      SecondClosestJet()                        const { return fClosestJets[1]                          ; }
   Double_t          SecondClosestJetDistance()                const { return fClosestJetsDist[1]                      ; }
   AliEmcalJet*      MatchedJet()                              const { return fMatched < 2 ? fClosestJets[fMatched] : 0; }
+  Double_t          MatchedJetDistance()                      const { return fMatched < 2 ? fClosestJetsDist[fMatched] : -1; }
   UShort_t          GetMatchingType()                         const { return fMatchingType                            ; }
 
   // Jet tagging
@@ -234,7 +245,9 @@ class AliEmcalJet : public AliVParticle
   // Ghosts
   void AddGhost(const Double_t dPx, const Double_t dPy, const Double_t dPz, const Double_t dE);
   Bool_t HasGhost() const                               { return fHasGhost; }
-  const std::vector<TLorentzVector> GetGhosts()   const { return fGhosts  ; }
+  Int_t  GetNumberOfGhosts() const                      { return fGhostPx.size(); }
+  void   GetGhost(Int_t i, TLorentzVector &ghost) const;
+  const std::vector<TLorentzVector> GetGhosts()   const;
 
   // Debug printouts
   void Print(Option_t* /*opt*/ = "") const;
@@ -308,12 +321,20 @@ class AliEmcalJet : public AliVParticle
   Int_t             fLabel;               //!<! Label to inclusive jet for constituent subtracted jet
 
   Bool_t            fHasGhost;            //!<! Whether ghost particle are included within the constituents
-  std::vector<TLorentzVector> fGhosts;    //!<! Vector containing the ghost particles
+  Double_t          fGhostScale;          //!<! Scale of the ghost four-momenta, the components below are relative to it
+  std::vector<Float_t> fGhostPx;          //!<! Px of the ghost particles
+  std::vector<Float_t> fGhostPy;          //!<! Py of the ghost particles
+  std::vector<Float_t> fGhostPz;          //!<! Pz of the ghost particles
+  std::vector<Float_t> fGhostE;           //!<! Energy of the ghost particles
 
   AliEmcalJetShapeProperties *fJetShapeProperties; //!<! Pointer to the jet shape properties
   UInt_t fJetAcceptanceType;    //!<!  Jet acceptance type (stored bitwise)
+  mutable Char_t    fClusterIDsOrder;     //!<! Whether fClusterIDs is sorted (see EConstituentOrder), checked at the first search, reset on read
+  mutable Char_t    fTrackIDsOrder;       //!<! Whether fTrackIDs is sorted (see EConstituentOrder), checked at the first search, reset on read
 
  private:
+  static Int_t      FindConstituent(const TArrayI &ids, Int_t id, Char_t &order);
+
   /**
    * @struct sort_descend
    * @brief Simple C structure to allow sorting in descending order
@@ -324,7 +345,7 @@ class AliEmcalJet : public AliVParticle
   };
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJet,19);
+  ClassDef(AliEmcalJet,20);
   /// \endcond
 };
 
@@ -13,6 +13,9 @@
  * provided "as is" without express or implied warranty.                  *
  **************************************************************************/
 
+#include <algorithm>
+#include <utility>
+
 #include <TClonesArray.h>
 
 #include "AliVEvent.h"
@@ -63,7 +66,13 @@ AliJetContainer::AliJetContainer():
   fGeom(0),
   fRunNumber(0),
   fTpcHolePos(0),
-  fTpcHoleWidth(0)
+  fTpcHoleWidth(0),
+  fBuildConstituentIndex(kFALSE),
+  fConstituentIndexValid(kFALSE),
+  fTrackIndexIDs(),
+  fTrackIndexJets(),
+  fClusterIndexIDs(),
+  fClusterIndexJets()
 {
   fBaseClassName = "AliEmcalJet";
   SetClassName("AliEmcalJet");
@@ -104,7 +113,13 @@ AliJetContainer::AliJetContainer(const char *name):
   fGeom(0),
   fRunNumber(0),
   fTpcHolePos(0),
-  fTpcHoleWidth(0)
+  fTpcHoleWidth(0),
+  fBuildConstituentIndex(kFALSE),
+  fConstituentIndexValid(kFALSE),
+  fTrackIndexIDs(),
+  fTrackIndexJets(),
+  fClusterIndexIDs(),
+  fClusterIndexJets()
 {
   fBaseClassName = "AliEmcalJet";
   SetClassName("AliEmcalJet");
@@ -154,7 +169,13 @@ AliJetContainer::AliJetContainer(EJetType_t jetType, EJetAlgo_t jetAlgo, ERecoSc
   fLocalRho(0),
   fRhoMass(0),
   fGeom(0),
-  fRunNumber(0)
+  fRunNumber(0),
+  fBuildConstituentIndex(kFALSE),
+  fConstituentIndexValid(kFALSE),
+  fTrackIndexIDs(),
+  fTrackIndexJets(),
+  fClusterIndexIDs(),
+  fClusterIndexJets()
 {
   fBaseClassName = "AliEmcalJet";
   SetClassName("AliEmcalJet");
@@ -854,6 +875,116 @@ Double_t AliJetContainer::GetFractionSharedPt(const AliEmcalJet *jet1, AliPartic
   return fraction;
 }
 
+/**
+ * Invalidates the constituent index (see GetJetsWithTrack()) for the new event.
+ */
+void AliJetContainer::NextEvent()
+{
+  AliParticleContainer::NextEvent();
+  fConstituentIndexValid = kFALSE;
+}
+
+/**
+ * Finds the jets having a given track among their constituents.
+ * If SetBuildConstituentIndex() was called, an index of the constituents of all the jets
+ * is built at the first call in each event (NextEvent() must be called at each event, as done
+ * by AliAnalysisTaskEmcalJet) and each call is then a binary search in this index.
+ * Otherwise each jet is searched with AliEmcalJet::ContainsTrack().
+ * @param trackId Id of the track, as stored in the jets (see AliEmcalJet::TrackAt())
+ * @param jets Indices of the jets containing the track, in increasing order (output)
+ * @return Number of jets containing the track
+ */
+Int_t AliJetContainer::GetJetsWithTrack(Int_t trackId, std::vector<Int_t> &jets)
+{
+  jets.clear();
+
+  if (!fBuildConstituentIndex) {
+    for (Int_t i = 0; i < GetNJets(); i++) {
+      AliEmcalJet *jet = GetJet(i);
+      if (jet && jet->ContainsTrack(trackId) >= 0) jets.push_back(i);
+    }
+    return jets.size();
+  }
+
+  if (!fConstituentIndexValid) BuildConstituentIndex();
+  return FindInConstituentIndex(fTrackIndexIDs, fTrackIndexJets, trackId, jets);
+}
+
+/**
+ * Finds the jets having a given cluster among their constituents, see GetJetsWithTrack().
+ * @param clusterId Id of the cluster, as stored in the jets (see AliEmcalJet::ClusterAt())
+ * @param jets Indices of the jets containing the cluster, in increasing order (output)
+ * @return Number of jets containing the cluster
+ */
+Int_t AliJetContainer::GetJetsWithCluster(Int_t clusterId, std::vector<Int_t> &jets)
+{
+  jets.clear();
+
+  if (!fBuildConstituentIndex) {
+    for (Int_t i = 0; i < GetNJets(); i++) {
+      AliEmcalJet *jet = GetJet(i);
+      if (jet && jet->ContainsCluster(clusterId) >= 0) jets.push_back(i);
+    }
+    return jets.size();
+  }
+
+  if (!fConstituentIndexValid) BuildConstituentIndex();
+  return FindInConstituentIndex(fClusterIndexIDs, fClusterIndexJets, clusterId, jets);
+}
+
+/**
+ * Builds the index of the track and cluster constituents of all the jets in the current event:
+ * pairs (constituent id, jet index) sorted by id, then by jet index.
+ */
+void AliJetContainer::BuildConstituentIndex()
+{
+  std::vector<std::pair<Int_t, Int_t> > tracks;
+  std::vector<std::pair<Int_t, Int_t> > clusters;
+
+  for (Int_t i = 0; i < GetNJets(); i++) {
+    AliEmcalJet *jet = GetJet(i);
+    if (!jet) continue;
+    for (Int_t j = 0; j < jet->GetNumberOfTracks(); j++) tracks.push_back(std::make_pair(jet->TrackAt(j), i));
+    for (Int_t j = 0; j < jet->GetNumberOfClusters(); j++) clusters.push_back(std::make_pair(jet->ClusterAt(j), i));
+  }
+
+  std::sort(tracks.begin(), tracks.end());
+  tracks.erase(std::unique(tracks.begin(), tracks.end()), tracks.end());
+  std::sort(clusters.begin(), clusters.end());
+  clusters.erase(std::unique(clusters.begin(), clusters.end()), clusters.end());
+
+  fTrackIndexIDs.resize(tracks.size());
+  fTrackIndexJets.resize(tracks.size());
+  for (UInt_t k = 0; k < tracks.size(); k++) {
+    fTrackIndexIDs[k] = tracks[k].first;
+    fTrackIndexJets[k] = tracks[k].second;
+  }
+
+  fClusterIndexIDs.resize(clusters.size());
+  fClusterIndexJets.resize(clusters.size());
+  for (UInt_t k = 0; k < clusters.size(); k++) {
+    fClusterIndexIDs[k] = clusters[k].first;
+    fClusterIndexJets[k] = clusters[k].second;
+  }
+
+  fConstituentIndexValid = kTRUE;
+}
+
+/**
+ * Looks up a constituent id in the constituent index.
+ * @param ids Sorted constituent ids
+ * @param jetIndex Jet index for each entry of ids
+ * @param id Constituent id to search
+ * @param jets Indices of the jets containing the constituent (output)
+ * @return Number of jets containing the constituent
+ */
+Int_t AliJetContainer::FindInConstituentIndex(const std::vector<Int_t> &ids, const std::vector<Int_t> &jetIndex, Int_t id, std::vector<Int_t> &jets)
+{
+  std::pair<std::vector<Int_t>::const_iterator, std::vector<Int_t>::const_iterator> range = std::equal_range(ids.begin(), ids.end(), id);
+  jets.assign(jetIndex.begin() + (range.first - ids.begin()), jetIndex.begin() + (range.second - ids.begin()));
+  return jets.size();
+}
+
 /**
  * Generate the jet branch name according to a given jet definition.
  * @param jetType Type of the jet (full, charged, neutral)
@@ -13,6 +13,8 @@ class AliParticleContainer;
 class AliClusterContainer;
 class AliLocalRhoParameter;
 
+#include <vector>
+
 #include <TMath.h>
 #include <TLorentzVector.h>
 #include "AliRhoParameter.h"
@@ -120,6 +122,7 @@ class AliJetContainer : public AliParticleContainer {
   void                        SetLeadingHadronType(Int_t t)                        { fLeadingHadronType = t             ; }
   void                        SetJetTrigger(UInt_t t=AliVEvent::kEMCEJE)           { fJetTrigger     = t                ; }
   void                        SetTagStatus(Int_t i)                                { fTagStatus      = i                ; }
+  void                        SetBuildConstituentIndex(Bool_t b = kTRUE)           { fBuildConstituentIndex = b; fConstituentIndexValid = kFALSE; }
 
   void                        SetRhoName(const char *n)                            { fRhoName        = n                ; }
   void                        SetLocalRhoName(const char *n)                       { fLocalRhoName   = n                ; }
@@ -175,11 +178,15 @@ class AliJetContainer : public AliParticleContainer {
   Double_t                    GetJetPhiMax()                        const    {return GetMaxPhi(); }
   Double_t                    GetJetPtCut()                         const    {return GetMinPt() ; }
   Double_t                    GetJetPtCutMax()                      const    {return GetMaxPt() ; }
+  Float_t                     GetJetAreaCut()                       const    {return fJetAreaCut; }
 
   void                        SetArray(const AliVEvent *event);
   AliParticleContainer       *GetParticleContainer() const                   {return fParticleContainer;}
   AliClusterContainer        *GetClusterContainer() const                    {return fClusterContainer;}
   Double_t                    GetFractionSharedPt(const AliEmcalJet *jet, AliParticleContainer *cont2 = 0x0) const;
+  Int_t                       GetJetsWithTrack(Int_t trackId, std::vector<Int_t> &jets);
+  Int_t                       GetJetsWithCluster(Int_t clusterId, std::vector<Int_t> &jets);
+  virtual void                NextEvent();
 
   const char*                 GetTitle() const;
 
@@ -224,11 +231,21 @@ class AliJetContainer : public AliParticleContainer {
   Int_t                       fRunNumber;            //!<! run number
   Double_t                    fTpcHolePos;           ///   position(in radians) of the malfunctioning TPC sector
   Double_t                    fTpcHoleWidth;         ///   width of the malfunctioning TPC area
+  Bool_t                      fBuildConstituentIndex; ///  build a constituent -> jet index once per event for GetJetsWithTrack/Cluster()
+  Bool_t                      fConstituentIndexValid; //!<! constituent index up to date for the current event
+  std::vector<Int_t>          fTrackIndexIDs;        //!<! track constituent ids of all the jets, sorted
+  std::vector<Int_t>          fTrackIndexJets;       //!<! jet containing the track constituent at the same position in fTrackIndexIDs
+  std::vector<Int_t>          fClusterIndexIDs;      //!<! cluster constituent ids of all the jets, sorted
+  std::vector<Int_t>          fClusterIndexJets;     //!<! jet containing the cluster constituent at the same position in fClusterIndexIDs
+
+  void                        BuildConstituentIndex();
+  static Int_t                FindInConstituentIndex(const std::vector<Int_t> &ids, const std::vector<Int_t> &jetIndex, Int_t id, std::vector<Int_t> &jets);
+
  private:
   AliJetContainer(const AliJetContainer& obj); // copy constructor
   AliJetContainer& operator=(const AliJetContainer& other); // assignment
 
-  ClassDef(AliJetContainer, 18);
+  ClassDef(AliJetContainer, 19);
 };
 
 #endif
@@ -9,6 +9,8 @@
 #pragma link C++ class AliAnalysisTaskEmcalJet+;
 #pragma link C++ class AliAnalysisTaskEmcalJetLight+;
 #pragma link C++ class AliEmcalJet+;
+// the constituent order flags are transient: objects read into reused TClonesArray slots must check their ids again
+#pragma read sourceClass="AliEmcalJet" targetClass="AliEmcalJet" version="[1-]" source="" target="fClusterIDsOrder,fTrackIDsOrder" code="{ fClusterIDsOrder = AliEmcalJet::kOrderUnknown; fTrackIDsOrder = AliEmcalJet::kOrderUnknown; }"
 #pragma link C++ class AliJetContainer+;
 #pragma link C++ class AliLocalRhoParameter+;
 #pragma link C++ class AliRhoParameter+;
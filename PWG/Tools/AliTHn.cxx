@@ -37,6 +37,7 @@
 #include "AliLog.h"
 #include "TArrayF.h"
 #include "TArrayD.h"
+#include "TBuffer.h"
 #include "THnSparse.h"
 #include "TMath.h"
 
@@ -53,7 +54,14 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT() :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fUniformCache(0),
+  fXminCache(0),
+  fXmaxCache(0),
+  fEdgesCache(0),
+  fNShards(0),
+  fShardValues(0),
+  fShardSumw2(0)
 {
   // Constructor
 }
@@ -69,7 +77,14 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const Char_t* name, const Char_t*
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fUniformCache(0),
+  fXminCache(0),
+  fXmaxCache(0),
+  fEdgesCache(0),
+  fNShards(0),
+  fShardValues(0),
+  fShardSumw2(0)
 {
   // Constructor
 
@@ -106,12 +121,22 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const AliTHnT &c) :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fUniformCache(0),
+  fXminCache(0),
+  fXmaxCache(0),
+  fEdgesCache(0),
+  fNShards(0),
+  fShardValues(0),
+  fShardSumw2(0)
 {
   //
   // AliTHnT copy constructor
   //
 
+  // content filled in shards of c is copied as well
+  const_cast<AliTHnT&>(c).ReduceShards();
+
   memset(fValues,0,fNSteps*sizeof(TemplateArray*));
   memset(fSumw2,0,fNSteps*sizeof(TemplateArray*));
 
@@ -135,6 +160,12 @@ AliTHnT<TemplateArray, TemplateType>::~AliTHnT()
   delete[] fNbinsCache;
   delete[] fLastVars;
   delete[] fLastBins;
+  delete[] fUniformCache;
+  delete[] fXminCache;
+  delete[] fXmaxCache;
+  delete[] fEdgesCache;
+  
+  DeleteShards();
 }
 
 template <class TemplateArray, typename TemplateType>
@@ -165,6 +196,7 @@ AliTHnT<TemplateArray, TemplateType> &AliTHnT<TemplateArray, TemplateType>::oper
   // assigment operator
 
   if (this != &c) {
+    const_cast<AliTHnT&>(c).ReduceShards();
     AliCFContainer::operator=(c);
     fNBins=c.fNBins;
     fNVars=c.fNVars;
@@ -191,9 +223,24 @@ AliTHnT<TemplateArray, TemplateType> &AliTHnT<TemplateArray, TemplateType>::oper
       fValues = 0;
       fSumw2 = 0;
     }
+    // caches are rebuilt from the own axes at the next fill
     delete [] axisCache;
-    axisCache = new TAxis*[fNVars];
-    memcpy(axisCache, c.axisCache, fNVars*sizeof(TAxis*));
+    delete [] fNbinsCache;
+    delete [] fLastVars;
+    delete [] fLastBins;
+    delete [] fUniformCache;
+    delete [] fXminCache;
+    delete [] fXmaxCache;
+    delete [] fEdgesCache;
+    axisCache = 0;
+    fNbinsCache = 0;
+    fLastVars = 0;
+    fLastBins = 0;
+    fUniformCache = 0;
+    fXminCache = 0;
+    fXmaxCache = 0;
+    fEdgesCache = 0;
+    DeleteShards();
   }
   return *this;
 }
@@ -206,6 +253,8 @@ void AliTHnT<TemplateArray, TemplateType>::Copy(TObject& c) const
 
   AliTHnT& target = (AliTHnT &) c;
   
+  const_cast<AliTHnT*>(this)->ReduceShards();
+  
   AliCFContainer::Copy(target);
   
   target.fNSteps = fNSteps;
@@ -244,6 +293,8 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
   
   AliCFContainer::Merge(list);
 
+  ReduceShards();
+
   TIterator* iter = list->MakeIterator();
   TObject* obj;
   
@@ -254,6 +305,8 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
     if (entry == 0) 
       continue;
 
+    entry->ReduceShards();
+
     for (Int_t i=0; i<fNSteps; i++)
     {
       if (entry->fValues[i])
@@ -288,15 +341,10 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 
   // fill axis cache
   if (!axisCache)
+    InitCache();
+  
+  if (!fLastVars)
   {
-    axisCache = new TAxis*[fNVars];
-    fNbinsCache = new Int_t[fNVars];
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      axisCache[i] = GetAxis(i, 0);
-      fNbinsCache[i] = axisCache[i]->GetNbins();
-    }
-    
     fLastVars = new Double_t[fNVars];
     fLastBins = new Int_t[fNVars];
     
@@ -360,6 +408,250 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 //   AliCFContainer::Fill(var, istep, weight);
 }
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::InitCache()
+{
+  // fills axis cache
+  
+  axisCache = new TAxis*[fNVars];
+  fNbinsCache = new Int_t[fNVars];
+  fUniformCache = new Bool_t[fNVars];
+  fXminCache = new Double_t[fNVars];
+  fXmaxCache = new Double_t[fNVars];
+  fEdgesCache = new const Double_t*[fNVars];
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    axisCache[i] = GetAxis(i, 0);
+    fNbinsCache[i] = axisCache[i]->GetNbins();
+    fXminCache[i] = axisCache[i]->GetXmin();
+    fXmaxCache[i] = axisCache[i]->GetXmax();
+    fUniformCache[i] = (axisCache[i]->GetXbins()->GetSize() == 0);
+    fEdgesCache[i] = (fUniformCache[i]) ? 0 : axisCache[i]->GetXbins()->GetArray();
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillN(Int_t n, const Double_t *vars, const Int_t *steps, const Double_t *weights)
+{
+  // fills n entries at once
+  // vars contains the variables of the entries one after the other (vars[i*fNVars + j] is variable j of entry i)
+  // steps contains the step of each entry, weights the weight of each entry (all weights 1 if weights == 0)
+  // same result as calling Fill for each entry
+  
+  if (!axisCache)
+    InitCache();
+  
+  for (Int_t i=0; i<n; i+=kFillBlockSize)
+    FillBlock(fValues, fSumw2, TMath::Min((Int_t) kFillBlockSize, n-i), vars + (Long64_t) i*fNVars, steps + i, (weights) ? weights + i : 0);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillBlock(TemplateArray** values, TemplateArray** sumw2, Int_t n, const Double_t *vars, const Int_t *steps, const Double_t *weights)
+{
+  // fills a block of at most kFillBlockSize entries into the containers <values> and <sumw2>
+  // the global bin indices are calculated axis by axis for the whole block:
+  //   fixed bin width: bin from the same arithmetic as TAxis::FindBin
+  //   variable bin width: binary search in the bin edges
+  // does not use fLastVars/fLastBins, so it can be called from several threads for different containers
+  
+  Long64_t bins[kFillBlockSize];
+  Bool_t valid[kFillBlockSize];
+  
+  for (Int_t k=0; k<n; k++)
+  {
+    bins[k] = 0;
+    valid[k] = kTRUE;
+  }
+  
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    const Int_t nbins = fNbinsCache[i];
+    const Double_t xmin = fXminCache[i];
+    const Double_t xmax = fXmaxCache[i];
+    
+    if (fUniformCache[i])
+    {
+      for (Int_t k=0; k<n; k++)
+      {
+	const Double_t x = vars[(Long64_t) k*fNVars + i];
+	// under/overflow not supported
+	const Bool_t inRange = (x >= xmin && x < xmax);
+	const Int_t tmpBin = (inRange) ? (Int_t) (nbins*(x-xmin)/(xmax-xmin)) : 0;
+	valid[k] = valid[k] && inRange && tmpBin < nbins;
+	// bins start from 0 here
+	bins[k] = bins[k] * nbins + tmpBin;
+      }
+    }
+    else
+    {
+      const Double_t* edges = fEdgesCache[i];
+      for (Int_t k=0; k<n; k++)
+      {
+	const Double_t x = vars[(Long64_t) k*fNVars + i];
+	const Bool_t inRange = (x >= xmin && x < xmax);
+	const Int_t tmpBin = (inRange) ? (Int_t) TMath::BinarySearch(nbins+1, edges, x) : 0;
+	valid[k] = valid[k] && inRange;
+	bins[k] = bins[k] * nbins + tmpBin;
+      }
+    }
+  }
+  
+  for (Int_t k=0; k<n; k++)
+  {
+    if (!valid[k])
+      continue;
+    
+    const Int_t istep = steps[k];
+    const Double_t weight = (weights) ? weights[k] : 1.;
+    
+    if (!values[istep])
+    {
+      values[istep] = new TemplateArray(fNBins);
+      AliInfo(Form("Created values container for step %d", istep));
+    }
+
+    if (weight != 1 && !sumw2[istep])
+    {
+      // initialize with already filled entries (which have been filled with weight == 1), in this case fSumw2 := fValues
+      sumw2[istep] = new TemplateArray(*values[istep]);
+      AliInfo(Form("Created sumw2 container for step %d", istep));
+    }
+    
+    values[istep]->GetArray()[bins[k]] += weight;
+    if (sumw2[istep])
+      sumw2[istep]->GetArray()[bins[k]] += weight * weight;
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::SetNShards(Int_t nShards)
+{
+  // sets the number of shards for sharded filling
+  // each worker thread fills with FillShard/FillNShard into its own shard without locking,
+  // the shards are added to the main container in ReduceShards (called by Merge, FillParent, GetValues, GetSumw2, ReduceAxis, copying and when the object is streamed)
+  // to be called before the worker threads start filling; existing shards are reduced
+  
+  ReduceShards();
+  DeleteShards();
+  
+  if (!axisCache)
+    InitCache();
+  
+  if (nShards <= 0)
+    return;
+  
+  fNShards = nShards;
+  fShardValues = new TemplateArray**[fNShards];
+  fShardSumw2 = new TemplateArray**[fNShards];
+  for (Int_t s=0; s<fNShards; s++)
+  {
+    fShardValues[s] = new TemplateArray*[fNSteps];
+    fShardSumw2[s] = new TemplateArray*[fNSteps];
+    memset(fShardValues[s],0,fNSteps*sizeof(TemplateArray*));
+    memset(fShardSumw2[s],0,fNSteps*sizeof(TemplateArray*));
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillNShard(Int_t shard, Int_t n, const Double_t *vars, const Int_t *steps, const Double_t *weights)
+{
+  // fills n entries into shard <shard>, see FillN for the layout of the arguments
+  // different shards can be filled concurrently from different threads
+  
+  if (shard < 0 || shard >= fNShards)
+  {
+    AliFatal(Form("Shard %d does not exist (%d shards)", shard, fNShards));
+    return;
+  }
+  
+  for (Int_t i=0; i<n; i+=kFillBlockSize)
+    FillBlock(fShardValues[shard], fShardSumw2[shard], TMath::Min((Int_t) kFillBlockSize, n-i), vars + (Long64_t) i*fNVars, steps + i, (weights) ? weights + i : 0);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::ReduceShards()
+{
+  // adds the content of all shards to the main container and releases the shards' memory
+  // the shards stay available for further filling
+  
+  for (Int_t s=0; s<fNShards; s++)
+  {
+    for (Int_t i=0; i<fNSteps; i++)
+    {
+      TemplateArray* shardValues = fShardValues[s][i];
+      TemplateArray* shardSumw2 = fShardSumw2[s][i];
+      if (!shardValues)
+	continue;
+      
+      if (!fValues[i])
+	fValues[i] = new TemplateArray(fNBins);
+      
+      // entries filled with weight == 1 before have sumw2 == values
+      if (shardSumw2 && !fSumw2[i])
+	fSumw2[i] = new TemplateArray(*fValues[i]);
+      
+      TemplateType* target = fValues[i]->GetArray();
+      const TemplateType* source = shardValues->GetArray();
+      for (Long64_t l = 0; l<fNBins; l++)
+	target[l] += source[l];
+      
+      if (fSumw2[i])
+      {
+	target = fSumw2[i]->GetArray();
+	source = (shardSumw2) ? shardSumw2->GetArray() : shardValues->GetArray();
+	for (Long64_t l = 0; l<fNBins; l++)
+	  target[l] += source[l];
+      }
+      
+      delete shardValues;
+      delete shardSumw2;
+      fShardValues[s][i] = 0;
+      fShardSumw2[s][i] = 0;
+    }
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::Streamer(TBuffer &R__b)
+{
+  // stream an object of class AliTHnT
+  // the shards are transient: on writing they are added to the main container first,
+  // so that the content filled with FillShard/FillNShard is written by any I/O path (Write, TList::Write, merging)
+  
+  if (R__b.IsReading())
+  {
+    DeleteShards();
+    R__b.ReadClassBuffer(AliTHnT<TemplateArray, TemplateType>::Class(), this);
+  }
+  else
+  {
+    ReduceShards();
+    R__b.WriteClassBuffer(AliTHnT<TemplateArray, TemplateType>::Class(), this);
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::DeleteShards()
+{
+  // deletes the shards without adding their content
+  
+  for (Int_t s=0; s<fNShards; s++)
+  {
+    for (Int_t i=0; i<fNSteps; i++)
+    {
+      delete fShardValues[s][i];
+      delete fShardSumw2[s][i];
+    }
+    delete[] fShardValues[s];
+    delete[] fShardSumw2[s];
+  }
+  delete[] fShardValues;
+  delete[] fShardSumw2;
+  fShardValues = 0;
+  fShardSumw2 = 0;
+  fNShards = 0;
+}
+
 template <class TemplateArray, typename TemplateType>
 Long64_t AliTHnT<TemplateArray, TemplateType>::GetGlobalBinIndex(const Int_t* binIdx)
 {
@@ -382,6 +674,8 @@ void AliTHnT<TemplateArray, TemplateType>::FillContainer(AliCFContainer* cont)
 {
   // fills the information stored in the buffer in this class into the container <cont>
   
+  ReduceShards();
+  
   for (Int_t i=0; i<fNSteps; i++)
   {
     if (!fValues[i])
@@ -459,6 +753,8 @@ void AliTHnT<TemplateArray, TemplateType>::ReduceAxis()
   
   Int_t axis = fNVars-1;
   
+  ReduceShards();
+  
   for (Int_t i=0; i<fNSteps; i++)
   {
     if (!fValues[i])
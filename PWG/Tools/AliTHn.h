@@ -26,6 +26,12 @@ public:
   AliTHnBase(const Char_t* name, const Char_t* title,const Int_t nSelStep, const Int_t nVarIn, const Int_t* nBinIn) : AliCFContainer(name, title, nSelStep, nVarIn, nBinIn) { }
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) = 0;
+  virtual void FillN(Int_t n, const Double_t *vars, const Int_t *steps, const Double_t *weights=0)
+  {
+    // fills n entries, vars[i*GetNVar() + j] is variable j of entry i (all weights 1 if weights == 0)
+    for (Int_t i=0; i<n; i++)
+      Fill(vars + (Long64_t) i*GetNVar(), steps[i], (weights) ? weights[i] : 1.);
+  }
   virtual void FillParent() = 0;
   virtual void FillContainer(AliCFContainer* cont) = 0;
 
@@ -48,11 +54,19 @@ class AliTHnT : public AliTHnBase
   virtual ~AliTHnT();
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  virtual void FillN(Int_t n, const Double_t *vars, const Int_t *steps, const Double_t *weights=0);
   virtual void FillParent();
+
+  // sharded filling: each worker thread fills its own shard, shards are summed by ReduceShards()
+  void SetNShards(Int_t nShards);
+  Int_t GetNShards() const { return fNShards; }
+  void FillShard(Int_t shard, const Double_t *var, Int_t istep, Double_t weight=1.) { FillNShard(shard, 1, var, &istep, &weight); }
+  void FillNShard(Int_t shard, Int_t n, const Double_t *vars, const Int_t *steps, const Double_t *weights=0);
+  void ReduceShards();
   virtual void FillContainer(AliCFContainer* cont);
   
-  virtual TArray* GetValues(Int_t step) { return fValues[step]; }
-  virtual TArray* GetSumw2(Int_t step)  { return fSumw2[step]; }
+  virtual TArray* GetValues(Int_t step) { ReduceShards(); return fValues[step]; }
+  virtual TArray* GetSumw2(Int_t step)  { ReduceShards(); return fSumw2[step]; }
   
   virtual void DeleteContainers();
   virtual void ReduceAxis();
@@ -65,7 +79,12 @@ class AliTHnT : public AliTHnBase
   
 protected:
   void Init();
+  void InitCache();
   Long64_t GetGlobalBinIndex(const Int_t* binIdx);
+  void FillBlock(TemplateArray** values, TemplateArray** sumw2, Int_t n, const Double_t *vars, const Int_t *steps, const Double_t *weights);
+  void DeleteShards();
+
+  enum { kFillBlockSize = 256 }; // number of entries for which bin indices are calculated at once in FillN
   
   Long64_t fNBins;   // number of total bins
   Int_t    fNVars;   // number of variables
@@ -77,6 +96,14 @@ protected:
   Int_t* fNbinsCache; //! cache Nbins per axis
   Double_t* fLastVars; //! caching of last used bins (in many loops some vars are the same for a while)
   Int_t* fLastBins; //! caching of last used bins (in many loops some vars are the same for a while)
+  Bool_t* fUniformCache; //! axis has fixed bin width (bin from arithmetic in FillN, otherwise binary search)
+  Double_t* fXminCache; //! cache lower edge per axis
+  Double_t* fXmaxCache; //! cache upper edge per axis
+  const Double_t** fEdgesCache; //! cache bin edges per axis (variable bin width only)
+
+  Int_t fNShards; //! number of shards for sharded filling
+  TemplateArray*** fShardValues; //! [fNShards][fNSteps] values filled in shards
+  TemplateArray*** fShardSumw2;  //! [fNShards][fNSteps] sumw2 filled in shards
   
   ClassDef(AliTHnT, 5) // THn like container
 };
@@ -26,10 +26,12 @@
 #include <TH3.h>
 #include <THnSparse.h>
 #include <THashList.h>
+#include <TMap.h>
 #include <TMath.h>
 #include <TObjArray.h>
 #include <TObjString.h>
 #include <TProfile.h>
+#include <TStopwatch.h>
 #include <TString.h>
 
 #include "TBinning.h"
@@ -42,14 +44,16 @@ ClassImp(THistManager)
 THistManager::THistManager():
 		TNamed(),
 		fHistos(NULL),
-		fIsOwner(true)
+		fIsOwner(true),
+		fLookup(NULL)
 {
 }
 
 THistManager::THistManager(const char *name):
 		TNamed(name, Form("Histogram container %s", name)),
 		fHistos(NULL),
-		fIsOwner(true)
+		fIsOwner(true),
+		fLookup(NULL)
 {
 	fHistos = new THashList();
 	fHistos->SetName(Form("histos%s", name));
@@ -58,6 +62,7 @@ THistManager::THistManager(const char *name):
 
 THistManager::~THistManager(){
 	if(fHistos && fIsOwner) delete fHistos;
+	if(fLookup) delete fLookup;
 }
 
 THashList* THistManager::CreateHistoGroup(const char *groupname) {
@@ -409,17 +414,118 @@ void THistManager::SetObject(TObject * const o, const char *group) {
 }
 
 void THistManager::FillTH1(const char *name, double x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
+	TH1 *hist = dynamic_cast<TH1 *>(FindHistogram(name, "THistManager::FillTH1"));
+	if(!hist){
+		Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
 		return;
 	}
-	TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
+	FillTH1(TH1Handle(hist), x, weight, opt);
+}
+
+void THistManager::FillTH1(const char *name, const char *label, double weight, Option_t *opt) {
+	TH1 *hist = dynamic_cast<TH1 *>(FindHistogram(name, "THistManager::FillTH1"));
+	if(!hist){
+		Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
+		return;
+	}
+	FillTH1(TH1Handle(hist), label, weight, opt);
+}
+
+void THistManager::FillTH2(const char *name, double x, double y, double weight, Option_t *opt) {
+	TH2 *hist = dynamic_cast<TH2 *>(FindHistogram(name, "THistManager::FillTH2"));
+	if(!hist){
+		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
+		return;
+	}
+	FillTH2(TH2Handle(hist), x, y, weight, opt);
+}
+
+void THistManager::FillTH2(const char *name, double *point, double weight, Option_t *opt) {
+	TH2 *hist = dynamic_cast<TH2 *>(FindHistogram(name, "THistManager::FillTH2"));
+	if(!hist){
+		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
+		return;
+	}
+	FillTH2(TH2Handle(hist), point, weight, opt);
+}
+
+void THistManager::FillTH2(const char *name, const char *labelX, const char *labelY, double weight, Option_t *opt) {
+	TH2 *hist = dynamic_cast<TH2 *>(FindHistogram(name, "THistManager::FillTH2"));
+	if(!hist){
+		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
+		return;
+	}
+	FillTH2(TH2Handle(hist), labelX, labelY, weight, opt);
+}
+
+void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *opt) {
+	TH3 *hist = dynamic_cast<TH3 *>(FindHistogram(name, "THistManager::FillTH3"));
+	if(!hist){
+		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
+		return;
+	}
+	FillTH3(TH3Handle(hist), x, y, z, weight, opt);
+}
+
+void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
+	TH3 *hist = dynamic_cast<TH3 *>(FindHistogram(name, "THistManager::FillTH3"));
+	if(!hist){
+		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
+		return;
+	}
+	FillTH3(TH3Handle(hist), point, weight, opt);
+}
+
+void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
+	THnSparse *hist = dynamic_cast<THnSparseD *>(FindHistogram(name, "THistManager::FillTHnSparse"));
+	if(!hist){
+		Fatal("THistManager::FillTHnSparse", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
+		return;
+	}
+	FillTHnSparse(THnSparseHandle(hist), x, weight, opt);
+}
+
+void THistManager::FillProfile(const char* name, double x, double y, double weight){
+	TProfile *hist = dynamic_cast<TProfile *>(FindHistogram(name, "THistManager::FillTProfile"));
 	if(!hist){
-		Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTProfile", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
 		return;
 	}
+	FillProfile(TProfileHandle(hist), x, y, weight);
+}
+
+THistManager::TH1Handle THistManager::GetTH1Handle(const char *name) {
+	TH1 *hist = dynamic_cast<TH1 *>(FindHistogram(name, "THistManager::GetTH1Handle"));
+	if(!hist) Fatal("THistManager::GetTH1Handle", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
+	return TH1Handle(hist);
+}
+
+THistManager::TH2Handle THistManager::GetTH2Handle(const char *name) {
+	TH2 *hist = dynamic_cast<TH2 *>(FindHistogram(name, "THistManager::GetTH2Handle"));
+	if(!hist) Fatal("THistManager::GetTH2Handle", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
+	return TH2Handle(hist);
+}
+
+THistManager::TH3Handle THistManager::GetTH3Handle(const char *name) {
+	TH3 *hist = dynamic_cast<TH3 *>(FindHistogram(name, "THistManager::GetTH3Handle"));
+	if(!hist) Fatal("THistManager::GetTH3Handle", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
+	return TH3Handle(hist);
+}
+
+THistManager::THnSparseHandle THistManager::GetTHnSparseHandle(const char *name) {
+	THnSparse *hist = dynamic_cast<THnSparseD *>(FindHistogram(name, "THistManager::GetTHnSparseHandle"));
+	if(!hist) Fatal("THistManager::GetTHnSparseHandle", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
+	return THnSparseHandle(hist);
+}
+
+THistManager::TProfileHandle THistManager::GetTProfileHandle(const char *name) {
+	TProfile *hist = dynamic_cast<TProfile *>(FindHistogram(name, "THistManager::GetTProfileHandle"));
+	if(!hist) Fatal("THistManager::GetTProfileHandle", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
+	return TProfileHandle(hist);
+}
+
+void THistManager::FillTH1(const TH1Handle &handle, double x, double weight, Option_t *opt) {
+	TH1 *hist = handle.Get();
 	TString optionstring(opt);
 	if(optionstring.Contains("w")){
 	  // use bin width as weight
@@ -431,18 +537,8 @@ void THistManager::FillTH1(const char *name, double x, double weight, Option_t *
 	hist->Fill(x, weight);
 }
 
-void THistManager::FillTH1(const char *name, const char *label, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
-  if(!hist){
-    Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-    return;
-  }
+void THistManager::FillTH1(const TH1Handle &handle, const char *label, double weight, Option_t *opt) {
+	TH1 *hist = handle.Get();
 	TString optionstring(opt);
 	if(optionstring.Contains("w")){
 	  // use bin width as weight
@@ -452,21 +548,11 @@ void THistManager::FillTH1(const char *name, const char *label, double weight, O
 	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
 	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
 	}
-  hist->Fill(label, weight);
+	hist->Fill(label, weight);
 }
 
-void THistManager::FillTH2(const char *name, double x, double y, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
+void THistManager::FillTH2(const TH2Handle &handle, double x, double y, double weight, Option_t *opt) {
+	TH2 *hist = handle.Get();
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
@@ -480,18 +566,8 @@ void THistManager::FillTH2(const char *name, double x, double y, double weight,
 	hist->Fill(x, y, myweight);
 }
 
-void THistManager::FillTH2(const char *name, double *point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
+void THistManager::FillTH2(const TH2Handle &handle, double *point, double weight, Option_t *opt) {
+	TH2 *hist = handle.Get();
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
@@ -505,43 +581,23 @@ void THistManager::FillTH2(const char *name, double *point, double weight, Optio
 	hist->Fill(point[0], point[1], weight);
 }
 
-void THistManager::FillTH2(const char *name, const char *labelX, const char *labelY, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-  if(!hist){
-    Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-    return;
-  }
-  TString optstring(opt);
-  Double_t myweight = optstring.Contains("w") ? 1. : weight;
-  if(optstring.Contains("wx")){
-    Int_t binx = hist->GetXaxis()->FindBin(labelY);
-    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-  }
-  if(optstring.Contains("wy")){
-    Int_t biny = hist->GetYaxis()->FindBin(labelX);
-    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-  }
-  hist->Fill(labelX, labelY, weight);
-}
-
-void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
+void THistManager::FillTH2(const TH2Handle &handle, const char *labelX, const char *labelY, double weight, Option_t *opt) {
+	TH2 *hist = handle.Get();
+	TString optstring(opt);
+	Double_t myweight = optstring.Contains("w") ? 1. : weight;
+	if(optstring.Contains("wx")){
+	  Int_t binx = hist->GetXaxis()->FindBin(labelY);
+	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
 	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
+	if(optstring.Contains("wy")){
+	  Int_t biny = hist->GetYaxis()->FindBin(labelX);
+	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
 	}
+	hist->Fill(labelX, labelY, weight);
+}
+
+void THistManager::FillTH3(const TH3Handle &handle, double x, double y, double z, double weight, Option_t *opt) {
+	TH3 *hist = handle.Get();
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
@@ -559,18 +615,8 @@ void THistManager::FillTH3(const char* name, double x, double y, double z, doubl
 	hist->Fill(x, y, z, weight);
 }
 
-void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
+void THistManager::FillTH3(const TH3Handle &handle, const double* point, double weight, Option_t *opt) {
+	TH3 *hist = handle.Get();
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
@@ -588,18 +634,8 @@ void THistManager::FillTH3(const char* name, const double* point, double weight,
 	hist->Fill(point[0], point[1], point[2], weight);
 }
 
-void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTHnSparse", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	THnSparseD *hist = dynamic_cast<THnSparseD *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTHnSparse", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
+void THistManager::FillTHnSparse(const THnSparseHandle &handle, const double *x, double weight, Option_t *opt) {
+	THnSparse *hist = handle.Get();
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	for(Int_t iaxis = 0; iaxis < hist->GetNdimensions(); iaxis++){
@@ -614,15 +650,8 @@ void THistManager::FillTHnSparse(const char *name, const double *x, double weigh
 	hist->Fill(x, weight);
 }
 
-void THistManager::FillProfile(const char* name, double x, double y, double weight){
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent)
-		Fatal("THistManager::FillTProfile", "Parent group %s does not exist", dirname.Data());
-  TProfile *hist = dynamic_cast<TProfile *>(parent->FindObject(hname));
-  if(!hist)
-		Fatal("THistManager::FillTProfile", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-  hist->Fill(x, y, weight);
+void THistManager::FillProfile(const TProfileHandle &handle, double x, double y, double weight){
+	handle->Fill(x, y, weight);
 }
 
 TObject *THistManager::FindObject(const char *name) const {
@@ -647,6 +676,30 @@ THashList *THistManager::FindGroup(const char *dirname) const {
 	return nullptr;
 }
 
+TObject *THistManager::FindHistogram(const char *name, const char *caller) {
+	if(fLookup){
+		TObject *cached = fLookup->GetValue(name);
+		if(cached) return cached;
+	}
+	TString dirname(basename(name)), hname(histname(name));
+	THashList *parent(FindGroup(dirname));
+	if(!parent){
+		Fatal(caller, "Parent group %s does not exist", dirname.Data());
+		return NULL;
+	}
+	TObject *hist = parent->FindObject(hname);
+	if(!hist){
+		Fatal(caller, "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		return NULL;
+	}
+	if(!fLookup){
+		fLookup = new TMap;
+		fLookup->SetOwnerKeyValue(kTRUE, kFALSE);
+	}
+	fLookup->Add(new TObjString(name), hist);
+	return hist;
+}
+
 TString THistManager::basename(const TString &path) const {
 	int index = path.Last('/');
 	if(index < 0) return "";  // no directory structure
@@ -930,6 +983,133 @@ namespace TestTHistManager {
   }
 
 
+  int THistManagerTestSuite::TestFillSimpleHistogramsHandles(){
+    THistManager testmgr("testmgr");
+
+    testmgr.CreateTH1("Test1", "Test fill 1D histogram", 1, 0., 1.);
+    testmgr.CreateTH2("Test2", "Test fill 2D histogram", 1, 0., 1., 1, 0., 1.);
+    testmgr.CreateTH3("Test3", "Test fill 3D histogram", 1, 0., 1., 1, 0., 1., 1, 0., 1.);
+    int nbins[4] = {1,1,1,1}; double min[4] = {0.,0.,0.,0.}, max[4] = {1.,1.,1.,1.};
+    testmgr.CreateTHnSparse("TestN", "Test Fill THnSparse", 4, nbins, min, max);
+    testmgr.CreateTProfile("Group1/TestProfile", "Test fill Profile histogram in group", 1, 0., 1.);
+
+    THistManager::TH1Handle h1 = testmgr.GetTH1Handle("Test1");
+    THistManager::TH2Handle h2 = testmgr.GetTH2Handle("Test2");
+    THistManager::TH3Handle h3 = testmgr.GetTH3Handle("Test3");
+    THistManager::THnSparseHandle hN = testmgr.GetTHnSparseHandle("TestN");
+    THistManager::TProfileHandle hProfile = testmgr.GetTProfileHandle("Group1/TestProfile");
+
+    double point[4] = {0.5, 0.5, 0.5, 0.5};
+    for(int i = 0; i < 100; i++){
+      testmgr.FillTH1(h1, 0.5);
+      testmgr.FillTH2(h2, 0.5, 0.5);
+      testmgr.FillTH3(h3, 0.5, 0.5, 0.5);
+      testmgr.FillProfile(hProfile, 0.5, 1.);
+      testmgr.FillTHnSparse(hN, point);
+    }
+
+    // Evalutate test
+    // tell user why test has failed
+    bool success(true);
+
+    if(!(h1.IsValid() && h2.IsValid() && h3.IsValid() && hN.IsValid() && hProfile.IsValid())){
+      std::cout << "Invalid handle" << std::endl;
+      return 1;
+    }
+    if(h1.Get() != testmgr.FindObject("Test1") || hProfile.Get() != testmgr.FindObject("Group1/TestProfile")){
+      std::cout << "Handle not pointing to the histogram in the manager" << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(h1->GetBinContent(1) - 100) > DBL_EPSILON){
+      std::cout << "Test1: Mismatch in values, expected 100, found " <<  h1->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(h2->GetBinContent(1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Test2: Mismatch in values, expected 100, found " <<  h2->GetBinContent(1,1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(h3->GetBinContent(1, 1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Test3: Mismatch in values, expected 100, found " <<  h3->GetBinContent(1,1,1) << std::endl;
+      success = false;
+    }
+    int index[4] = {1,1,1,1};
+    if(TMath::Abs(hN->GetBinContent(index) - 100) > DBL_EPSILON){
+      std::cout << "TestN: Mismatch in values, expected 100, found " <<  hN->GetBinContent(index) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(hProfile->GetBinContent(1) - 1) > DBL_EPSILON){
+      std::cout << "TestProfile: Mismatch in values, expected 1, found " <<  hProfile->GetBinContent(1) << std::endl;
+      success = false;
+    }
+
+    return success ? 0 : 1;
+  }
+
+  int THistManagerTestSuite::BenchmarkFillSimpleHistograms(int nfill){
+    THistManager mgrname("mgrname"), mgrhandle("mgrhandle");
+    THistManager *managers[2] = {&mgrname, &mgrhandle};
+    int nbins[4] = {10,10,10,10}; double min[4] = {0.,0.,0.,0.}, max[4] = {1.,1.,1.,1.};
+    for(auto mgr : managers){
+      mgr->CreateTH1("Group1/Test1", "Benchmark 1D histogram", 10, 0., 1.);
+      mgr->CreateTH2("Group1/Test2", "Benchmark 2D histogram", 10, 0., 1., 10, 0., 1.);
+      mgr->CreateTH3("Group2/Subgroup1/Test3", "Benchmark 3D histogram", 10, 0., 1., 10, 0., 1., 10, 0., 1.);
+      mgr->CreateTHnSparse("Group2/Subgroup1/TestN", "Benchmark THnSparse", 4, nbins, min, max);
+      mgr->CreateTProfile("Group2/TestProfile", "Benchmark Profile histogram", 10, 0., 1.);
+    }
+
+    double point[4];
+    TStopwatch timer;
+    timer.Start();
+    for(int i = 0; i < nfill; i++){
+      for(int j = 0; j < 4; j++) point[j] = double((i + j) % 10) / 10. + 0.05;
+      mgrname.FillTH1("Group1/Test1", point[0]);
+      mgrname.FillTH2("Group1/Test2", point[0], point[1]);
+      mgrname.FillTH3("Group2/Subgroup1/Test3", point[0], point[1], point[2]);
+      mgrname.FillTHnSparse("Group2/Subgroup1/TestN", point);
+      mgrname.FillProfile("Group2/TestProfile", point[0], point[1]);
+    }
+    timer.Stop();
+    double timename = timer.RealTime();
+
+    timer.Start();
+    THistManager::TH1Handle h1 = mgrhandle.GetTH1Handle("Group1/Test1");
+    THistManager::TH2Handle h2 = mgrhandle.GetTH2Handle("Group1/Test2");
+    THistManager::TH3Handle h3 = mgrhandle.GetTH3Handle("Group2/Subgroup1/Test3");
+    THistManager::THnSparseHandle hN = mgrhandle.GetTHnSparseHandle("Group2/Subgroup1/TestN");
+    THistManager::TProfileHandle hProfile = mgrhandle.GetTProfileHandle("Group2/TestProfile");
+    for(int i = 0; i < nfill; i++){
+      for(int j = 0; j < 4; j++) point[j] = double((i + j) % 10) / 10. + 0.05;
+      mgrhandle.FillTH1(h1, point[0]);
+      mgrhandle.FillTH2(h2, point[0], point[1]);
+      mgrhandle.FillTH3(h3, point[0], point[1], point[2]);
+      mgrhandle.FillTHnSparse(hN, point);
+      mgrhandle.FillProfile(hProfile, point[0], point[1]);
+    }
+    timer.Stop();
+    double timehandle = timer.RealTime();
+
+    std::cout << "Filling " << nfill << " entries into 5 histograms" << std::endl;
+    std::cout << "By name:     " << timename << " s" << std::endl;
+    std::cout << "Via handles: " << timehandle << " s" << std::endl;
+
+    // Both methods must lead to the same histograms
+    bool success(true);
+    const char *names[5] = {"Group1/Test1", "Group1/Test2", "Group2/Subgroup1/Test3", "Group2/Subgroup1/TestN", "Group2/TestProfile"};
+    for(auto name : names){
+      TObject *hname = mgrname.FindObject(name), *hhandle = mgrhandle.FindObject(name);
+      TH1 *h1name = dynamic_cast<TH1 *>(hname), *h1handle = dynamic_cast<TH1 *>(hhandle);
+      THnSparse *hnname = dynamic_cast<THnSparse *>(hname), *hnhandle = dynamic_cast<THnSparse *>(hhandle);
+      bool equal(false);
+      if(h1name && h1handle) equal = TMath::Abs(h1name->GetSumOfWeights() - h1handle->GetSumOfWeights()) < DBL_EPSILON && TMath::Abs(h1name->GetMean() - h1handle->GetMean()) < DBL_EPSILON;
+      else if(hnname && hnhandle) equal = hnname->GetNbins() == hnhandle->GetNbins() && TMath::Abs(hnname->GetSumw() - hnhandle->GetSumw()) < DBL_EPSILON;
+      if(!equal){
+        std::cout << name << ": Mismatch between fill by name and fill via handle" << std::endl;
+        success = false;
+      }
+    }
+    return success ? 0 : 1;
+  }
+
   int THistManagerTestSuite::TestFillGroupedHistograms(){
     THistManager testmgr("testmgr");
 
@@ -1050,6 +1230,10 @@ namespace TestTHistManager {
     testresult += testsuite.TestFillGroupedHistograms();
     std::cout << "Result after test: " << testresult << std::endl;
 
+    std::cout << "Running test: Fill Simple via handles" << std::endl;
+    testresult += testsuite.TestFillSimpleHistogramsHandles();
+    std::cout << "Result after test: " << testresult << std::endl;
+
     return testresult;
   }
 
@@ -1072,4 +1256,14 @@ namespace TestTHistManager {
     THistManagerTestSuite testsuite;
     return testsuite.TestFillGroupedHistograms();
   }
+
+  int TestRunFillSimpleHandles(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillSimpleHistogramsHandles();
+  }
+
+  int BenchmarkRunFillSimple(int nfill){
+    THistManagerTestSuite testsuite;
+    return testsuite.BenchmarkFillSimpleHistograms(nfill);
+  }
 }
@@ -10,6 +10,7 @@
 
 class TArrayD;
 class TAxis;
+class TMap;
 class TBinning;
 class TList;
 class TH1;
@@ -95,10 +96,66 @@ class TProfile;
  * an argument for options. Automatic correction for the bin width is done when
  * specifying the argument *W*, followed by the direction. Adding multiple directions
  * the weight is calculated for all directions at the same time.
+ *
+ * ## Filling via pre-resolved handles
+ *
+ * Filling by name needs to resolve the histogram path at each call. For
+ * histograms filled per track or per cluster the path can be resolved once,
+ * e.g. in UserCreateOutputObjects, into a typed handle. Fill methods taking
+ * the handle instead of the name do not perform any string operation:
+ *
+ * ~~~{.cxx}
+ * THistManager::TH1Handle hPt = mgr.GetTH1Handle("hPt");
+ * for(auto en : ROOT::TSeqI(0, 10000)) {
+ *   mgr.FillTH1(hPt, gRandom->Exp(-1));
+ * }
+ * ~~~
+ *
+ * Fill methods by name are kept. They resolve each path only once and
+ * keep the result in a hash map from the path to the histogram.
  */
 class THistManager : public TNamed {
 public:
 
+  /**
+   * @class THistHandle
+   * @brief Pre-resolved, typed handle to a histogram inside the manager
+   * @ingroup Histmanager
+   *
+   * Handles are obtained via the GetXXXHandle functions of the histogram
+   * manager. They stay valid as long as the histogram manager owns the
+   * histogram.
+   */
+  template<typename HistType>
+  class THistHandle {
+  public:
+    THistHandle(): fHist(nullptr) {}
+    explicit THistHandle(HistType *hist): fHist(hist) {}
+    ~THistHandle() {}
+
+    /**
+     * @brief Check whether the handle points to a histogram
+     * @return True if the handle is connected to a histogram
+     */
+    bool IsValid() const { return fHist != nullptr; }
+
+    /**
+     * @brief Access to the underlying histogram
+     * @return The histogram connected to the handle
+     */
+    HistType *Get() const { return fHist; }
+    HistType *operator->() const { return fHist; }
+
+  private:
+    HistType *fHist;          ///< Histogram connected to the handle (not owned)
+  };
+
+  typedef THistHandle<TH1> TH1Handle;               ///< Handle for 1D histograms
+  typedef THistHandle<TH2> TH2Handle;               ///< Handle for 2D histograms
+  typedef THistHandle<TH3> TH3Handle;               ///< Handle for 3D histograms
+  typedef THistHandle<THnSparse> THnSparseHandle;   ///< Handle for THnSparse
+  typedef THistHandle<TProfile> TProfileHandle;     ///< Handle for profile histograms
+
   /**
    * @class iterator
    * @brief stl-iterator for the histogram manager
@@ -634,6 +691,129 @@ public:
 	 */
   void FillProfile(const char *name, double x, double y, double weight = 1.);
 
+  /**
+   * @brief Resolve the path of a 1D histogram into a handle.
+   *
+   * Fatal in case the histogram is not found or not of the requested type.
+   * @param[in] name Name of the histogram (including parent groups)
+   * @return Handle to the histogram
+   */
+  TH1Handle GetTH1Handle(const char *name);
+
+  /**
+   * @brief Resolve the path of a 2D histogram into a handle. See @ref GetTH1Handle
+   * @param[in] name Name of the histogram (including parent groups)
+   * @return Handle to the histogram
+   */
+  TH2Handle GetTH2Handle(const char *name);
+
+  /**
+   * @brief Resolve the path of a 3D histogram into a handle. See @ref GetTH1Handle
+   * @param[in] name Name of the histogram (including parent groups)
+   * @return Handle to the histogram
+   */
+  TH3Handle GetTH3Handle(const char *name);
+
+  /**
+   * @brief Resolve the path of a THnSparse into a handle. See @ref GetTH1Handle
+   * @param[in] name Name of the histogram (including parent groups)
+   * @return Handle to the histogram
+   */
+  THnSparseHandle GetTHnSparseHandle(const char *name);
+
+  /**
+   * @brief Resolve the path of a profile histogram into a handle. See @ref GetTH1Handle
+   * @param[in] name Name of the histogram (including parent groups)
+   * @return Handle to the histogram
+   */
+  TProfileHandle GetTProfileHandle(const char *name);
+
+  /**
+   * @brief Fill a 1D histogram via its handle. Same options as
+   * the fill by name.
+   * @param[in] hist Handle of the histogram
+   * @param[in] x x-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] option Optional filling arguments
+   */
+  void FillTH1(const TH1Handle &hist, double x, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a 1D histogram via its handle using a bin label.
+   * @param[in] hist Handle of the histogram
+   * @param[in] label Label of the bin to fill
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] option Optional filling arguments
+   */
+  void FillTH1(const TH1Handle &hist, const char *label, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a 2D histogram via its handle.
+   * @param[in] hist Handle of the histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] option Optional filling arguments
+   */
+  void FillTH2(const TH2Handle &hist, double x, double y, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a 2D histogram via its handle using bin labels.
+   * @param[in] hist Handle of the histogram
+   * @param[in] labelX x-coordinate
+   * @param[in] labelY y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] option Optional filling arguments
+   */
+  void FillTH2(const TH2Handle &hist, const char *labelX, const char *labelY, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a 2D histogram via its handle.
+   * @param[in] hist Handle of the histogram
+   * @param[in] point coordinates of the data
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] option Optional filling arguments
+   */
+  void FillTH2(const TH2Handle &hist, double *point, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a 3D histogram via its handle.
+   * @param[in] hist Handle of the histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] z z-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] option Optional filling arguments
+   */
+  void FillTH3(const TH3Handle &hist, double x, double y, double z, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a 3D histogram via its handle.
+   * @param[in] hist Handle of the histogram
+   * @param[in] point 3D-coordinate (x,y,z) of the point to be filled
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] option Optional filling arguments
+   */
+  void FillTH3(const TH3Handle &hist, const double *point, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a THnSparse via its handle.
+   * @param[in] hist Handle of the histogram
+   * @param[in] x coordinates of the data
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] option Optional filling arguments
+   */
+  void FillTHnSparse(const THnSparseHandle &hist, const double *x, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a profile histogram via its handle.
+   * @param[in] hist Handle of the profile histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillProfile(const TProfileHandle &hist, double x, double y, double weight = 1.);
+
   /**
    * @brief Create forward iterator starting at the beginning of the
    * container
@@ -705,6 +885,18 @@ private:
 	 */
 	THashList *FindGroup(const char *dirname) const;
 
+	/**
+	 * @brief Find a histogram by its path, using the cache of resolved paths.
+	 *
+	 * Paths resolved once are stored in a hash map from the path to the
+	 * histogram, so that later lookups do not split the path. Fatal in case
+	 * the histogram does not exist.
+	 * @param[in] name Path of the histogram
+	 * @param[in] caller Name of the calling function (for error messages)
+	 * @return The histogram (NULL if not found)
+	 */
+	TObject *FindHistogram(const char *name, const char *caller);
+
 	/**
 	 * @brief Extracting the basename from a given histogram path.
 	 * @param[in] path histogram path
@@ -721,9 +913,10 @@ private:
 
 	THashList *fHistos;                   ///< List of histograms
 	bool fIsOwner;                        ///< Set the ownership
+	TMap *fLookup;                        //!<! Cache of resolved histogram paths (path -> histogram)
 
   /// \cond CLASSIMP
-	ClassDef(THistManager, 1);  // Container for histograms
+	ClassDef(THistManager, 2);  // Container for histograms
   /// \endcond
 };
 
@@ -845,6 +1038,28 @@ public:
    * @return 0 if test is passed, 1 if it failed
    */
   int TestFillGroupedHistograms();
+
+  /**
+   * Purpose of the test: Check whether filling via pre-resolved handles is equivalent to the fill by name
+   * Relies on: TestFillSimpleHistograms
+   *
+   * Same setup as TestFillSimpleHistograms, histograms are filled via handles obtained
+   * with the GetXXXHandle functions.
+   *
+   * Test passed:
+   * - All histograms need to have in its 1 bin the bin content 100
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillSimpleHistogramsHandles();
+
+  /**
+   * Benchmark for the fill by name and the fill via handles on the setup
+   * of TestFillSimpleHistograms, using nfill entries per histogram. Timing
+   * of both methods is printed to the screen.
+   * @param[in] nfill Number of entries per histogram
+   * @return 0 if the histograms filled by both methods agree, 1 otherwise
+   */
+  int BenchmarkFillSimpleHistograms(int nfill);
 };
 
 /**
@@ -882,5 +1097,20 @@ int TestRunFillSimple();
  */
 int TestRunFillGrouped();
 
+/**
+ * Run the test for filling histograms via handles. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillSimpleHandles();
+
+/**
+ * Run the benchmark comparing the fill by name and the fill via handles.
+ * See @ref THistManagerTestSuite for details.
+ * @param[in] nfill Number of entries per histogram
+ * @return 0 if both methods agree, 1 otherwise
+ */
+int BenchmarkRunFillSimple(int nfill = 1000000);
+
 }
 #endif
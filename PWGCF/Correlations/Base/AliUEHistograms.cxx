@@ -25,6 +25,7 @@
 #include "AliUEHistograms.h"
 
 #include "AliCFContainer.h"
+#include "AliTHn.h"
 #include "AliBasicParticle.h"
 #include "AliVParticle.h"
 #include "AliAODTrack.h"
@@ -35,6 +36,8 @@
 #include "TH1F.h"
 #include "TH3F.h"
 #include "TMath.h"
+#include "TArrayC.h"
+#include "TArrayD.h"
 #include "TLorentzVector.h"
 
 ClassImp(AliUEHistograms)
@@ -686,7 +689,53 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       }
     }
     
-    for (Int_t i=0; i<particles->GetEntriesFast(); i++)
+    // pack the kinematics of trigger and associated particles into contiguous arrays
+    // so that the pair loop below does not need virtual calls on scattered objects
+    const Int_t iMax = particles->GetEntriesFast();
+    TArrayD triggerPt_(iMax), triggerPhi_(iMax);
+    TArrayF triggerCharge_(iMax);
+    for (Int_t i=0; i<iMax; i++)
+    {
+      AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
+      triggerPt_[i] = triggerParticle->Pt();
+      triggerPhi_[i] = triggerParticle->Phi();
+      triggerCharge_[i] = triggerParticle->Charge();
+    }
+    TArrayD assocPt_(jMax), assocPhi_(jMax);
+    TArrayF assocCharge_(jMax);
+    TArrayC assocAccepted_(jMax), pairAccepted_(jMax);
+    for (Int_t j=0; j<jMax; j++)
+    {
+      AliVParticle* particle = (AliVParticle*) input->UncheckedAt(j);
+      assocPt_[j] = particle->Pt();
+      assocPhi_[j] = particle->Phi();
+      assocCharge_[j] = particle->Charge();
+      
+      // selections on the associated particle only
+      Bool_t accept = kTRUE;
+      if (fAssociatedSelectCharge != 0 && assocCharge_[j] * fAssociatedSelectCharge < 0)
+        accept = kFALSE;
+      if (fRejectResonanceDaughters > 0 && particle->TestBit(kResonanceDaughterFlag))
+        accept = kFALSE;
+      assocAccepted_[j] = accept;
+    }
+    const Double_t* assocPt = assocPt_.GetArray();
+    const Double_t* assocPhi = assocPhi_.GetArray();
+    const Float_t* assocCharge = assocCharge_.GetArray();
+    const Char_t* assocAccepted = assocAccepted_.GetArray();
+    Char_t* pairAccepted = pairAccepted_.GetArray();
+    
+    // buffer for batched filling of the pairs
+    AliCFContainer* trackHist = fNumberDensityPhi->GetTrackHist(AliUEHist::kToward);
+    const Int_t nTrackHistVars = trackHist->GetNVar();
+    const Int_t kFillBatchSize = 256;
+    TArrayD fillVars_(kFillBatchSize*nTrackHistVars);
+    Double_t* fillVars = fillVars_.GetArray();
+    Int_t fillSteps[kFillBatchSize];
+    Double_t fillWeights[kFillBatchSize];
+    Int_t nFill = 0;
+    
+    for (Int_t i=0; i<iMax; i++)
     {
       AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
       
@@ -713,9 +762,31 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  continue;
 	}
 	
+      // pair loop, step 1: selections which only need the packed arrays, for all associated particles at once
+      // (no branches and no virtual calls, can be vectorized)
+      const Double_t triggerPt = triggerPt_[i];
+      const Double_t triggerPhi = triggerPhi_[i];
+      const Float_t triggerCharge = triggerCharge_[i];
+      for (Int_t j=0; j<jMax; j++)
+      {
+        Bool_t accept = assocAccepted[j];
+        if (!mixed)
+          accept = accept && (i != j);
+        if (fPtOrder)
+          accept = accept && (assocPt[j] < triggerPt);
+        if (fSelectCharge == 1)
+          accept = accept && (assocCharge[j] * triggerCharge <= 0); // skip like sign
+        if (fSelectCharge == 2)
+          accept = accept && (assocCharge[j] * triggerCharge >= 0); // skip unlike sign
+        if (fEtaOrdering)
+          accept = accept && !(triggerEta < 0 && eta[j] < triggerEta) && !(triggerEta > 0 && eta[j] > triggerEta);
+        pairAccepted[j] = accept;
+      }
+
+      // pair loop, step 2: remaining selections (which need the particle objects or fill control histograms) for the accepted pairs
       for (Int_t j=0; j<jMax; j++)
       {
-        if (!mixed && i == j)
+        if (!pairAccepted[j])
           continue;
       
         AliVParticle* particle = 0;
@@ -738,48 +809,14 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
         else if (mixed && triggerParticle->IsEqual(particle))
           continue;
         
-        if (fPtOrder)
-	  if (particle->Pt() >= triggerParticle->Pt())
-	    continue;
-	
-	if (fAssociatedSelectCharge != 0)
-	  if (particle->Charge() * fAssociatedSelectCharge < 0)
-	    continue;
-
-        if (fSelectCharge > 0)
-        {
-          // skip like sign
-          if (fSelectCharge == 1 && particle->Charge() * triggerParticle->Charge() > 0)
-            continue;
-            
-          // skip unlike sign
-          if (fSelectCharge == 2 && particle->Charge() * triggerParticle->Charge() < 0)
-            continue;
-        }
-        
-	if (fEtaOrdering)
-	{
-	  if (triggerEta < 0 && eta[j] < triggerEta)
-	    continue;
-	  if (triggerEta > 0 && eta[j] > triggerEta)
-	    continue;
-	}
-
-	if (fRejectResonanceDaughters > 0)
-	  if (particle->TestBit(kResonanceDaughterFlag))
-	  {
-// 	    Printf("Skipped j=%d", j);
-	    continue;
-	  }
-
 	// conversions
-	if (fCutConversionsV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutConversionsV > 0 && assocCharge[j] * triggerCharge < 0)
 	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt[j], eta[j], assocPhi[j], 0.510e-3, 0.510e-3);
 	  
 	  if (mass < fCutConversionsV * 5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+	    mass = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt[j], eta[j], assocPhi[j], 0.510e-3, 0.510e-3);
 	    
 	    fControlConvResoncances->Fill(0.0, mass);
 
@@ -789,15 +826,15 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	// K0s
-	if (fCutResonancesV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutResonancesV > 0 && assocCharge[j] * triggerCharge < 0)
 	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt[j], eta[j], assocPhi[j], 0.1396, 0.1396);
 	  
 	  const Float_t kK0smass = 0.4976;
 	  
 	  if (TMath::Abs(mass - kK0smass*kK0smass) < fCutResonancesV * 5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	    mass = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt[j], eta[j], assocPhi[j], 0.1396, 0.1396);
 	    
 	    fControlConvResoncances->Fill(1, mass - kK0smass*kK0smass);
 
@@ -807,16 +844,16 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	// Lambda
-	if (fCutResonancesV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutResonancesV > 0 && assocCharge[j] * triggerCharge < 0)
 	{
-	  Float_t mass1 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
-	  Float_t mass2 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
+	  Float_t mass1 = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt[j], eta[j], assocPhi[j], 0.1396, 0.9383);
+	  Float_t mass2 = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt[j], eta[j], assocPhi[j], 0.9383, 0.1396);
 	  
 	  const Float_t kLambdaMass = 1.115;
 
 	  if (TMath::Abs(mass1 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
 	  {
-	    mass1 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
+	    mass1 = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt[j], eta[j], assocPhi[j], 0.1396, 0.9383);
 
 	    fControlConvResoncances->Fill(2, mass1 - kLambdaMass*kLambdaMass);
 	    
@@ -825,7 +862,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 	  if (TMath::Abs(mass2 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
 	  {
-	    mass2 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
+	    mass2 = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt[j], eta[j], assocPhi[j], 0.9383, 0.1396);
 
 	    fControlConvResoncances->Fill(2, mass2 - kLambdaMass*kLambdaMass);
 
@@ -839,13 +876,13 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  // the variables & cuthave been developed by the HBT group 
 	  // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
 
-	  Float_t phi1 = triggerParticle->Phi();
-	  Float_t pt1 = triggerParticle->Pt();
-	  Float_t charge1 = triggerParticle->Charge();
+	  Float_t phi1 = triggerPhi;
+	  Float_t pt1 = triggerPt;
+	  Float_t charge1 = triggerCharge;
 	    
-	  Float_t phi2 = particle->Phi();
-	  Float_t pt2 = particle->Pt();
-	  Float_t charge2 = particle->Charge();
+	  Float_t phi2 = assocPhi[j];
+	  Float_t pt2 = assocPt[j];
+	  Float_t charge2 = assocCharge[j];
 	      
 	  Float_t deta = triggerEta - eta[j];
 	      
@@ -890,10 +927,10 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
         
         Double_t vars[6];
         vars[0] = triggerEta - eta[j];
-        vars[1] = particle->Pt();
-        vars[2] = triggerParticle->Pt();
+        vars[1] = assocPt[j];
+        vars[2] = triggerPt;
         vars[3] = centrality;
-        vars[4] = triggerParticle->Phi() - particle->Phi();
+        vars[4] = triggerPhi - assocPhi[j];
         if (vars[4] > 1.5 * TMath::Pi()) 
           vars[4] -= TMath::TwoPi();
         if (vars[4] < -0.5 * TMath::Pi())
@@ -901,7 +938,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	vars[5] = zVtx;
 	
 	if (fillpT)
-	  weight = particle->Pt();
+	  weight = assocPt[j];
 	
 	Double_t useWeight = weight;
 	if (applyEfficiency)
@@ -939,7 +976,16 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
     
         // fill all in toward region and do not use the other regions
-	fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->Fill(vars, step, useWeight);
+        // the entries are collected and filled in batches
+        for (Int_t k=0; k<nTrackHistVars; k++)
+          fillVars[nFill*nTrackHistVars + k] = (k < 6) ? vars[k] : 0;
+        fillSteps[nFill] = step;
+        fillWeights[nFill] = useWeight;
+        if (++nFill == kFillBatchSize)
+        {
+          FillTrackHistBatch(trackHist, nFill, fillVars, fillSteps, fillWeights);
+          nFill = 0;
+        }
 
 // 	Printf("%.2f %.2f --> %.2f", triggerEta, eta[j], vars[0]);
       }
@@ -989,6 +1035,9 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       }
     }
     
+    if (nFill > 0)
+      FillTrackHistBatch(trackHist, nFill, fillVars, fillSteps, fillWeights);
+    
     if (triggerWeighting)
     {
       delete triggerWeighting;
@@ -1000,6 +1049,24 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
   fCentralityCorrelation->Fill(centrality, particles->GetEntriesFast());
   FillEvent(centrality, step);
 }
+
+//____________________________________________________________________
+void AliUEHistograms::FillTrackHistBatch(AliCFContainer* trackHist, Int_t n, const Double_t* vars, const Int_t* steps, const Double_t* weights)
+{
+  // fills a batch of n entries into <trackHist>
+  // vars[i*GetNVar() + j] is variable j of entry i
+  // AliTHn computes the bin indices for the full batch at once
+  
+  AliTHnBase* thn = dynamic_cast<AliTHnBase*> (trackHist);
+  if (thn)
+  {
+    thn->FillN(n, vars, steps, weights);
+    return;
+  }
+  
+  for (Int_t i=0; i<n; i++)
+    trackHist->Fill(vars + i*trackHist->GetNVar(), steps[i], weights[i]);
+}
   
 //____________________________________________________________________
 void AliUEHistograms::FillTrackingEfficiency(TObjArray* mc, TObjArray* recoPrim, TObjArray* recoAll, TObjArray* recoPrimPID, TObjArray* recoAllPID, TObjArray* fake, Int_t particleType, Double_t centrality, Double_t zVtx)
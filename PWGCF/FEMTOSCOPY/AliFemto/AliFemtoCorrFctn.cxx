@@ -6,6 +6,8 @@
 
 void AliFemtoCorrFctn::AddRealPair(AliFemtoPair*) { cout << "Not implemented" << endl; }
 void AliFemtoCorrFctn::AddMixedPair(AliFemtoPair*) { cout << "Not implemented" << endl; }
+void AliFemtoCorrFctn::AddRealPairs(AliFemtoPair** aPairs, int aNPairs) { for (int i = 0; i < aNPairs; i++) AddRealPair(aPairs[i]); }
+void AliFemtoCorrFctn::AddMixedPairs(AliFemtoPair** aPairs, int aNPairs) { for (int i = 0; i < aNPairs; i++) AddMixedPair(aPairs[i]); }
 
 AliFemtoCorrFctn::AliFemtoCorrFctn(const AliFemtoCorrFctn& /* c */):fyAnalysis(0),fPairCut(0x0) {}
 AliFemtoCorrFctn::AliFemtoCorrFctn(): fyAnalysis(0),fPairCut(0x0) {/* no-op */}
@@ -25,6 +25,11 @@ public:
   virtual void AddRealPair(AliFemtoPair* aPair);
   virtual void AddMixedPair(AliFemtoPair* aPir);
 
+  // Batched versions, called by the analysis with a span of pairs which
+  // all passed the pair cut; the default forwards to AddRealPair/AddMixedPair
+  virtual void AddRealPairs(AliFemtoPair** aPairs, int aNPairs);
+  virtual void AddMixedPairs(AliFemtoPair** aPairs, int aNPairs);
+
   virtual void EventBegin(const AliFemtoEvent* aEvent);
   virtual void EventEnd(const AliFemtoEvent* aEvent);
   virtual void Finish() = 0;
@@ -162,14 +162,6 @@ void AliFemtoCorrFctnDPhiStarDEta::AddRealPair(AliFemtoPair* pair)
   const AliFemtoThreeVector p1 = track1->P(),
                             p2 = track2->P();
 
-  // Prepare variables:
-  double phi1 = p1.Phi();
-  double phi2 = p2.Phi();
-  double chg1 = track1->Charge();
-  double chg2 = track2->Charge();
-  double pt1 = track1->Pt();
-  double pt2 = track2->Pt();
-
   // Check magnetic field sign:
   AliAODInputHandler *aodH = dynamic_cast<AliAODInputHandler*> (AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler());
   Double_t magsign = 0.0;
@@ -192,10 +184,9 @@ void AliFemtoCorrFctnDPhiStarDEta::AddRealPair(AliFemtoPair* pair)
   Double_t rad;
   rad = fMinRad;
 
-  // Calculate dPhiStar:
-  double afsi0b = -0.07510020733*chg1*fMagSign*rad/pt1;
-  double afsi1b = -0.07510020733*chg2*fMagSign*rad/pt2;
-  Double_t dphistar =  phi2 - phi1 + TMath::ASin(afsi1b) - TMath::ASin(afsi0b);
+  // Calculate dPhiStar (phi* is cached per particle):
+  Double_t dphistar = pair->Track2()->PhiStar(0.07510020733*fMagSign, rad)
+                    - pair->Track1()->PhiStar(0.07510020733*fMagSign, rad);
 
   //double dphistar = phistar1 - phistar2;
   //while (dphistar<fPhiStarRangeLow) dphistar += PIT;
@@ -225,13 +216,6 @@ void AliFemtoCorrFctnDPhiStarDEta::AddMixedPair( AliFemtoPair* pair){
   const AliFemtoThreeVector p1 = track1->P(),
                             p2 = track2->P();
 
-  double phi1 = p1.Phi();
-  double phi2 = p2.Phi();
-  double chg1 = track1->Charge();
-  double chg2 = track2->Charge();
-  double pt1 = track1->Pt();
-  double pt2 = track2->Pt();
-
   // Check magnetic field sign:
   AliAODInputHandler *aodH = dynamic_cast<AliAODInputHandler*> (AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler());
   Double_t magsign = 0.0;
@@ -254,10 +238,9 @@ void AliFemtoCorrFctnDPhiStarDEta::AddMixedPair( AliFemtoPair* pair){
   Double_t rad;
   rad = fMinRad;
 
-  // Calculate dPhiStar:
-  double afsi0b = -0.07510020733*chg1*fMagSign*rad/pt1;
-  double afsi1b = -0.07510020733*chg2*fMagSign*rad/pt2;
-  Double_t dphistar =  phi2 - phi1 + TMath::ASin(afsi1b) - TMath::ASin(afsi0b);
+  // Calculate dPhiStar (phi* is cached per particle):
+  Double_t dphistar = pair->Track2()->PhiStar(0.07510020733*fMagSign, rad)
+                    - pair->Track1()->PhiStar(0.07510020733*fMagSign, rad);
 
   //double dphistar = phistar1 - phistar2;
   //while (dphistar<fPhiStarRangeLow) dphistar += PIT;
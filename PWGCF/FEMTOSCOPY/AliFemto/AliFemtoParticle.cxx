@@ -6,6 +6,8 @@
 #include "AliFemtoParticle.h"
 #include "AliFemtoXi.h"
 
+#include "TMath.h"
+
 double AliFemtoParticle::fgPrimPimPar0 = 9.05632e-01;
 double AliFemtoParticle::fgPrimPimPar1 = -2.26737e-01;
 double AliFemtoParticle::fgPrimPimPar2 = -1.03922e-01;
@@ -42,7 +44,8 @@ AliFemtoParticle::AliFemtoParticle() :
   fTpcV0PosExitPoint(),
   fHelixV0Neg(),
   fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fTpcV0NegExitPoint(),
+  fPhiStarCacheNext(0)
 {
   // Default constructor
   std::fill_n(fPurity, 6, 0.0);
@@ -63,10 +66,13 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoParticle &aParticle):
   fTpcV0PosExitPoint(aParticle.fTpcV0PosExitPoint),
   fHelixV0Neg(aParticle.fHelixV0Neg),
   fTpcV0NegEntrancePoint(aParticle.fTpcV0NegEntrancePoint),
-  fTpcV0NegExitPoint(aParticle.fTpcV0NegExitPoint)
+  fTpcV0NegExitPoint(aParticle.fTpcV0NegExitPoint),
+  fPhiStarCacheNext(aParticle.fPhiStarCacheNext)
 {
   // Copy constructor
   memcpy(fPurity, aParticle.fPurity, sizeof(fPurity));
+  for (int i = 0; i < kPhiStarCacheSize; i++)
+    fPhiStarCache[i] = aParticle.fPhiStarCache[i];
   if (aParticle.fTrack)
     fTrack = new AliFemtoTrack(*aParticle.fTrack);
   if (aParticle.fV0)
@@ -106,7 +112,8 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoTrack *const hbtTrack, const do
   fTpcV0PosExitPoint(),
   fHelixV0Neg(),
   fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fTpcV0NegExitPoint(),
+  fPhiStarCacheNext(0)
 {
   // Constructor from normal track
   /* TO JA ODZNACZYLEM NIE WIEM DLACZEGO
@@ -140,7 +147,8 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoV0 *const hbtV0, const double &
   fTpcV0PosExitPoint(),
   fHelixV0Neg(hbtV0->HelixNeg()),
   fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fTpcV0NegExitPoint(),
+  fPhiStarCacheNext(0)
 {
   // Constructor from V0
 
@@ -167,7 +175,8 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoKink *const hbtKink, const doub
   fTpcV0PosExitPoint(),
   fHelixV0Neg(),
   fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fTpcV0NegExitPoint(),
+  fPhiStarCacheNext(0)
 {
   // Constructor from Kink
   for (int ip = 0; ip < 6; ip++) fPurity[ip] = 0.0;
@@ -191,7 +200,8 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoXi *const hbtXi, const double &
   fTpcV0PosExitPoint(),
   fHelixV0Neg(),
   fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fTpcV0NegExitPoint(),
+  fPhiStarCacheNext(0)
 {
   // Constructor from Xi
   for (int ip = 0; ip < 6; ip++) fPurity[ip] = 0.0;
@@ -280,8 +290,56 @@ AliFemtoParticle &AliFemtoParticle::operator=(const AliFemtoParticle &aParticle)
   fTpcV0NegEntrancePoint = aParticle.fTpcV0NegEntrancePoint;
   fTpcV0NegExitPoint = aParticle.fTpcV0NegExitPoint;
 
+  for (int i = 0; i < kPhiStarCacheSize; i++)
+    fPhiStarCache[i] = aParticle.fPhiStarCache[i];
+  fPhiStarCacheNext = aParticle.fPhiStarCacheNext;
+
   return *this;
 }
+//_____________________
+const double* AliFemtoParticle::PhiStar(double afsi, double rMin, double rMax, double rStep, int &nRadii) const
+{
+  // Return the phi* table for the given field and radii, computing it if needed
+
+  for (int i = 0; i < kPhiStarCacheSize; i++) {
+    const PhiStarTable &table = fPhiStarCache[i];
+    if (table.fValid && table.fAfsi == afsi && table.fRMin == rMin
+        && table.fRMax == rMax && table.fRStep == rStep) {
+      nRadii = table.fPhiStar.size();
+      return table.fPhiStar.empty() ? NULL : &table.fPhiStar[0];
+    }
+  }
+
+  PhiStarTable &table = fPhiStarCache[fPhiStarCacheNext];
+  fPhiStarCacheNext = (fPhiStarCacheNext + 1) % kPhiStarCacheSize;
+
+  table.fValid = true;
+  table.fAfsi = afsi;
+  table.fRMin = rMin;
+  table.fRMax = rMax;
+  table.fRStep = rStep;
+  table.fPhiStar.clear();
+
+  const double phi = fTrack->P().Phi();
+  const double curv = afsi * fTrack->Charge() / fTrack->Pt();
+
+  if (rStep <= 0.0) {
+    table.fPhiStar.push_back(phi - TMath::ASin(curv * rMin));
+  } else {
+    for (double rad = rMin; rad < rMax; rad += rStep) {
+      table.fPhiStar.push_back(phi - TMath::ASin(curv * rad));
+    }
+  }
+
+  nRadii = table.fPhiStar.size();
+  return table.fPhiStar.empty() ? NULL : &table.fPhiStar[0];
+}
+//_____________________
+double AliFemtoParticle::PhiStar(double afsi, double radius) const
+{
+  int nRadii = 0;
+  return *PhiStar(afsi, radius, radius, 0.0, nRadii);
+}
 // //_____________________
 // const AliFemtoThreeVector& AliFemtoParticle::NominalTpcExitPoint() const{
 //   // in future, may want to calculate this "on demand" only, sot this routine may get more sophisticated
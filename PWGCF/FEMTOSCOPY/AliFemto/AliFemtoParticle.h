@@ -17,6 +17,8 @@
 #include "AliFemtoXi.h"
 #include "AliFmPhysicalHelixD.h"
 
+#include <vector>
+
 // ***
 class AliFemtoHiddenInfo;
 // ***
@@ -64,6 +66,24 @@ public:
 
   void ResetFourMomentum(const AliFemtoLorentzVector &fourMomentum);
 
+  /// Azimuthal angle of the track at the transverse radii
+  /// R = rMin, rMin + rStep, ... (R < rMax):
+  ///
+  ///   phi* = phi - TMath::ASin(afsi * charge * R / pT)
+  ///
+  /// with afsi = 0.3 * B[T] / 2 including the sign of the field. The radii
+  /// are accumulated exactly like in the radius loops of the merging cuts,
+  /// so the phi* separation of a pair at every radius is one subtraction.
+  /// The table is computed on first use and kept for the lifetime of the
+  /// particle (up to kPhiStarCacheSize parameter sets). Only for particles
+  /// made of a track.
+  const double* PhiStar(double afsi, double rMin, double rMax, double rStep, int &nRadii) const;
+
+  /// phi* at a single radius (see above)
+  double PhiStar(double afsi, double radius) const;
+
+  enum { kPhiStarCacheSize = 4 };
+
   const AliFemtoHiddenInfo* HiddenInfo() const;
 
   AliFemtoHiddenInfo* GetHiddenInfo() const;
@@ -126,6 +146,17 @@ private:
   AliFmPhysicalHelixD fHelixV0Neg;            // helix for negative V0 daughter
   AliFemtoThreeVector fTpcV0NegEntrancePoint; // negative V0 daughter entrance point to TPC
   AliFemtoThreeVector fTpcV0NegExitPoint;     // negative V0 daughter exit point from TPC
+
+  /// phi* at a set of radii, see PhiStar()
+  struct PhiStarTable {
+    PhiStarTable(): fValid(false), fAfsi(0.0), fRMin(0.0), fRMax(0.0), fRStep(0.0), fPhiStar() {}
+    bool fValid;
+    double fAfsi, fRMin, fRMax, fRStep;
+    std::vector<double> fPhiStar;
+  };
+
+  mutable PhiStarTable fPhiStarCache[kPhiStarCacheSize]; // lazily computed phi* tables
+  mutable int fPhiStarCacheNext;                         // next slot of fPhiStarCache to be replaced
 };
 
 inline AliFemtoTrack *AliFemtoParticle::Track() const
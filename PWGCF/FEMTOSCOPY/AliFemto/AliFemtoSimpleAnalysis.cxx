@@ -13,6 +13,11 @@
 #include <string>
 #include <iostream>
 #include <iterator>
+#include <vector>
+#include <cmath>
+#include <cfloat>
+
+#include "TMath.h"
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -175,7 +180,14 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis():
   fMinSizePartCollection(0),
   fVerbose(kTRUE),
   fPerformSharedDaughterCut(kFALSE),
-  fEnablePairMonitors(kFALSE)
+  fEnablePairMonitors(kFALSE),
+  fPrefilterKtMin(0.0),
+  fPrefilterKtMax(0.0),
+  fPrefilterQinvMax(0.0),
+  fPrefilterDEtaMax(0.0),
+  fPrefilterDPhiStarMax(0.0),
+  fPrefilterRadius(1.2),
+  fPrefilterBField(0.5)
 {
   // Default constructor
   fCorrFctnCollection = new AliFemtoCorrFctnCollection;
@@ -197,7 +209,14 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis(const AliFemtoSimpleAnalysis& a):
   fMinSizePartCollection(a.fMinSizePartCollection),
   fVerbose(a.fVerbose),
   fPerformSharedDaughterCut(a.fPerformSharedDaughterCut),
-  fEnablePairMonitors(a.fEnablePairMonitors)
+  fEnablePairMonitors(a.fEnablePairMonitors),
+  fPrefilterKtMin(a.fPrefilterKtMin),
+  fPrefilterKtMax(a.fPrefilterKtMax),
+  fPrefilterQinvMax(a.fPrefilterQinvMax),
+  fPrefilterDEtaMax(a.fPrefilterDEtaMax),
+  fPrefilterDPhiStarMax(a.fPrefilterDPhiStarMax),
+  fPrefilterRadius(a.fPrefilterRadius),
+  fPrefilterBField(a.fPrefilterBField)
 {
   /// Copy constructor
 
@@ -393,6 +412,13 @@ AliFemtoSimpleAnalysis& AliFemtoSimpleAnalysis::operator=(const AliFemtoSimpleAn
   fVerbose = aAna.fVerbose;
   fPerformSharedDaughterCut = aAna.fPerformSharedDaughterCut;
   fEnablePairMonitors = aAna.fEnablePairMonitors;
+  fPrefilterKtMin = aAna.fPrefilterKtMin;
+  fPrefilterKtMax = aAna.fPrefilterKtMax;
+  fPrefilterQinvMax = aAna.fPrefilterQinvMax;
+  fPrefilterDEtaMax = aAna.fPrefilterDEtaMax;
+  fPrefilterDPhiStarMax = aAna.fPrefilterDPhiStarMax;
+  fPrefilterRadius = aAna.fPrefilterRadius;
+  fPrefilterBField = aAna.fPrefilterBField;
 
   return *this;
 }
@@ -572,13 +598,121 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
 }
 
 //_________________________
+namespace {
+
+/// Packed momenta of a particle collection, used by the pair pre-filter
+/// of AliFemtoSimpleAnalysis::MakePairs. Keeping the components in
+/// separate arrays lets the pre-filter loop over a whole inner-loop range
+/// without touching the AliFemtoParticle objects.
+struct PackedMomenta {
+  std::vector<double> px, py, pz, e, eta, phistar;
+  std::vector<char> reach;  ///< 1 if the particle reaches the phi* radius
+
+  /// \param curvature 0.15 * B (T) * R (m), so that phi* = phi - asin(q * curvature / pT)
+  void Fill(const AliFemtoParticleCollection *coll, double curvature)
+  {
+    const size_t n = coll->size();
+    px.resize(n);
+    py.resize(n);
+    pz.resize(n);
+    e.resize(n);
+    eta.resize(n);
+    phistar.resize(n);
+    reach.resize(n);
+
+    size_t i = 0;
+    for (AliFemtoParticleConstIterator it = coll->begin(); it != coll->end(); ++it, ++i) {
+      const AliFemtoLorentzVector &p = (*it)->FourMomentum();
+      px[i] = p.px();
+      py[i] = p.py();
+      pz[i] = p.pz();
+      e[i] = p.e();
+      eta[i] = p.vect().PseudoRapidity();
+
+      // neutral particles (no track) go straight: phi* = phi
+      const AliFemtoTrack *track = (*it)->Track();
+      const double pt = std::sqrt(px[i] * px[i] + py[i] * py[i]);
+      const double arg = (track && pt > 0.0) ? curvature * track->Charge() / pt : 0.0;
+      reach[i] = std::fabs(arg) <= 1.0;
+      phistar[i] = std::atan2(py[i], px[i]) - (reach[i] ? std::asin(arg) : 0.0);
+    }
+  }
+};
+
+/// Windows of the pair pre-filter, squared where possible
+struct PrefilterWindows {
+  double kt2Min, kt2Max, q2Max, dEtaMax, dPhiStarMax;
+};
+
+/// Evaluate the pre-filter for particle i of a against particles [begin,end)
+/// of b; mask[j-begin] is set to 1 if the pair is kept. The loop body is
+/// branch-free so that the compiler can vectorize it.
+void PrefilterPairs(const PackedMomenta &a, size_t i,
+                    const PackedMomenta &b, size_t begin, size_t end,
+                    const PrefilterWindows &w,
+                    char *mask)
+{
+  const double kTwoPi = TMath::TwoPi();
+  const double px1 = a.px[i], py1 = a.py[i], pz1 = a.pz[i], e1 = a.e[i],
+               eta1 = a.eta[i], phistar1 = a.phistar[i];
+  const bool reach1 = a.reach[i];
+
+  for (size_t j = begin; j < end; ++j) {
+    const double sx = px1 + b.px[j],
+                 sy = py1 + b.py[j];
+    const double kt2 = 0.25 * (sx * sx + sy * sy);
+
+    // qinv^2 = |dp|^2 - dE^2 (AliFemtoPair::QInv is -m of the difference)
+    const double dx = px1 - b.px[j],
+                 dy = py1 - b.py[j],
+                 dz = pz1 - b.pz[j],
+                 de = e1 - b.e[j];
+    const double q2 = dx * dx + dy * dy + dz * dz - de * de;
+
+    double dphi = phistar1 - b.phistar[j];
+    dphi -= kTwoPi * std::floor(dphi / kTwoPi + 0.5);
+    const bool close = reach1 & (b.reach[j] != 0)
+                     & (std::fabs(eta1 - b.eta[j]) < w.dEtaMax)
+                     & (std::fabs(dphi) < w.dPhiStarMax);
+
+    mask[j - begin] = (kt2 >= w.kt2Min) & (kt2 <= w.kt2Max) & (q2 <= w.q2Max) & !close;
+  }
+}
+
+/// Hand a batch of pairs to all correlation functions
+void AddPairsToCorrFctns(AliFemtoCorrFctnCollection *corrFctns,
+                         const string &type,
+                         AliFemtoPair **pairs,
+                         int npairs)
+{
+  if (npairs == 0) {
+    return;
+  }
+
+  for (AliFemtoCorrFctnIterator tCorrFctnIter = corrFctns->begin();
+                                tCorrFctnIter != corrFctns->end();
+                              ++tCorrFctnIter) {
+
+    AliFemtoCorrFctn* tCorrFctn = *tCorrFctnIter;
+
+    if (type == "real")
+      tCorrFctn->AddRealPairs(pairs, npairs);
+    else if(type == "mixed")
+      tCorrFctn->AddMixedPairs(pairs, npairs);
+    else
+      cout << "Problem with pair type, type = " << type << endl;
+  } // loop over corellatoin functions
+}
+
+} // namespace
+
 void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
                                        AliFemtoParticleCollection *partCollection1,
                                        AliFemtoParticleCollection *partCollection2,
                                        Bool_t enablePairMonitors)
 {
-/// Build pairs, check pair cuts, and call CFs' AddRealPair() or
-/// AddMixedPair() methods. If no second particle collection is
+/// Build pairs, check pair cuts, and call CFs' AddRealPairs() or
+/// AddMixedPairs() methods. If no second particle collection is
 /// specfied, make pairs within first particle collection.
 
   const string type = typeIn;
@@ -608,17 +742,51 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
     tEndInnerLoop   = partCollection2->end();    //
   }
   else {                                         // One collection:
+    if (partCollection1->empty()) {
+      return;
+    }
     tEndOuterLoop--;                             //   Outer loop goes to next-to-last particle
     tEndInnerLoop = partCollection1->end() ;     //   Inner loop goes to last particle
   }
 
-  // Create the pair outside the loop - only allocate once
-  AliFemtoPair* tPair = new AliFemtoPair;
+  // Pack momenta for the pre-filter. Pair monitors must see every pair,
+  // so the pre-filter is bypassed when they are enabled.
+  const bool usePrefilter = PairPrefilterActive() && !enablePairMonitors;
+  PackedMomenta tPacked1, tPacked2;
+  PrefilterWindows tWindows;
+  std::vector<char> tMask;
+  if (usePrefilter) {
+    const double curvature = 0.15 * fPrefilterBField * fPrefilterRadius;
+    tPacked1.Fill(partCollection1, curvature);
+    if (partCollection2) {
+      tPacked2.Fill(partCollection2, curvature);
+    }
+    tMask.resize(partCollection2 ? partCollection2->size() : partCollection1->size());
+
+    const double ktMin = fPrefilterKtMax > 0.0 ? TMath::Max(fPrefilterKtMin, 0.0) : 0.0;
+    tWindows.kt2Min = ktMin * ktMin;
+    tWindows.kt2Max = fPrefilterKtMax > 0.0 ? fPrefilterKtMax * fPrefilterKtMax : DBL_MAX;
+    tWindows.q2Max = fPrefilterQinvMax > 0.0 ? fPrefilterQinvMax * fPrefilterQinvMax : DBL_MAX;
+    const bool useCloseTracks = fPrefilterDEtaMax > 0.0 && fPrefilterDPhiStarMax > 0.0;
+    tWindows.dEtaMax = useCloseTracks ? fPrefilterDEtaMax : -1.0;
+    tWindows.dPhiStarMax = useCloseTracks ? fPrefilterDPhiStarMax : -1.0;
+  }
+  const PackedMomenta &tPackedInner = partCollection2 ? tPacked2 : tPacked1;
+
+  // Pool of pairs - allocated once, filled with pairs passing the cut and
+  // handed to the correlation functions when full
+  AliFemtoPair *tPairPool = new AliFemtoPair[kPairBatchSize];
+  AliFemtoPair *tPairs[kPairBatchSize];
+  for (int i = 0; i < kPairBatchSize; i++) {
+    tPairs[i] = &tPairPool[i];
+  }
+  int tNPairs = 0;
 
   // Begin the outer loop
+  size_t tIndex1 = 0;
   for (AliFemtoParticleConstIterator tPartIter1 = tStartOuterLoop;
                                      tPartIter1 != tEndOuterLoop;
-                                     ++tPartIter1) {
+                                   ++tPartIter1, ++tIndex1) {
 
     // If analyzing identical particles, start inner loop at the particle
     // after the current outer loop position, (loops until end)
@@ -626,25 +794,40 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
       tStartInnerLoop = tPartIter1;
       tStartInnerLoop++;
     }
+    const size_t tInnerBegin = partCollection2 ? 0 : tIndex1 + 1;
 
-    // If we have two collections - set the first track
-    if (partCollection2 != NULL) {
-      tPair->SetTrack1(*tPartIter1);
+    if (usePrefilter) {
+      PrefilterPairs(tPacked1, tIndex1, tPackedInner, tInnerBegin, tMask.size(), tWindows, &tMask[0]);
     }
 
     // Begin the inner loop
+    size_t tIndex2 = tInnerBegin;
     for (AliFemtoParticleConstIterator tPartIter2 = tStartInnerLoop;
                                        tPartIter2 != tEndInnerLoop;
-                                     ++tPartIter2) {
-      // If we have two collections - only set the second track
+                                     ++tPartIter2, ++tIndex2) {
+
+      // Consume the swap flag also for pre-filtered pairs, so that the
+      // ordering of the surviving pairs does not depend on the pre-filter
+      const bool tSwap = swpart;
+      if (!partCollection2) {
+        swpart = !swpart;
+      }
+
+      if (usePrefilter && !tMask[tIndex2 - tInnerBegin]) {
+        continue;
+      }
+
+      AliFemtoPair* tPair = tPairs[tNPairs];
+
+      // If we have two collections - no swapping
       if (partCollection2 != NULL) {
+        tPair->SetTrack1(*tPartIter1);
         tPair->SetTrack2(*tPartIter2);
 
       // Swap between first and second particles to avoid biased ordering
       } else {
-        tPair->SetTrack1(swpart ? *tPartIter2 : *tPartIter1);
-        tPair->SetTrack2(swpart ? *tPartIter1 : *tPartIter2);
-        swpart = !swpart;
+        tPair->SetTrack1(tSwap ? *tPartIter2 : *tPartIter1);
+        tPair->SetTrack2(tSwap ? *tPartIter1 : *tPartIter2);
       }
 
       // check if the pair passes the cut
@@ -655,27 +838,19 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
         fPairCut->FillCutMonitor(tPair, tmpPassPair);
       }
 
-      // If pair passes cut, loop over CF's and add pair to real/mixed
-      if (tmpPassPair) {
-        for (AliFemtoCorrFctnIterator tCorrFctnIter = fCorrFctnCollection->begin();
-                                      tCorrFctnIter != fCorrFctnCollection->end();
-                                    ++tCorrFctnIter) {
-
-          AliFemtoCorrFctn* tCorrFctn = *tCorrFctnIter;
-
-          if (type == "real")
-            tCorrFctn->AddRealPair(tPair);
-          else if(type == "mixed")
-            tCorrFctn->AddMixedPair(tPair);
-          else
-            cout << "Problem with pair type, type = " << type << endl;
-        } // loop over corellatoin functions
+      // If pair passes cut, keep it in the pool; flush the pool to the
+      // CF's when it is full
+      if (tmpPassPair && ++tNPairs == kPairBatchSize) {
+        AddPairsToCorrFctns(fCorrFctnCollection, type, tPairs, tNPairs);
+        tNPairs = 0;
       }
     }    // loop over second particle
   }      // loop over first particle
 
-  // we are done with the pair
-  delete tPair;
+  AddPairsToCorrFctns(fCorrFctnCollection, type, tPairs, tNPairs);
+
+  // we are done with the pairs
+  delete [] tPairPool;
 }
 //_________________________
 void AliFemtoSimpleAnalysis::EventBegin(const AliFemtoEvent* ev)
@@ -99,6 +99,23 @@ public:
   void SetEnablePairMonitors(Bool_t aEnable);
   Bool_t EnablePairMonitors();
 
+  /// Optional pair pre-filter, evaluated on packed particle momenta before
+  /// any AliFemtoPair is built. It must be at least as loose as the pair cut:
+  /// pairs it rejects are never seen by the pair cut nor by the correlation
+  /// functions. It is bypassed while pair monitors are enabled, so that the
+  /// monitors keep seeing all pairs. All windows are disabled by default.
+  ///
+  /// - SetPairPrefilterKtRange: keep pairs with ktMin <= kT <= ktMax
+  /// - SetPairPrefilterQinvMax: keep pairs with qinv <= qinvMax
+  /// - SetPairPrefilterCloseTracks: reject pairs with |deta| < dEtaMax and
+  ///   |dphi*| < dPhiStarMax, where phi* is the azimuth at the given radius
+  ///   (in m) in a solenoidal field bField (in T)
+  void SetPairPrefilterKtRange(Double_t ktMin, Double_t ktMax);
+  void SetPairPrefilterQinvMax(Double_t qinvMax);
+  void SetPairPrefilterCloseTracks(Double_t dEtaMax, Double_t dPhiStarMax,
+                                   Double_t radius=1.2, Double_t bField=0.5);
+  Bool_t PairPrefilterActive() const;
+
   unsigned int NumEventsToMix() const;
   void SetNumEventsToMix(const unsigned int& NumberOfEventsToMix);
   AliFemtoPicoEvent* CurrentPicoEvent();
@@ -154,11 +171,18 @@ protected:
   ///
   /// \param type Either the string "real" or "mixed", specifying which method
   ///             to call (AddRealPair or AddMixedPair)
+  ///
+  /// Pairs passing the pair cut are collected in a pool of kPairBatchSize
+  /// AliFemtoPair objects and handed to the CFs' AddRealPairs() or
+  /// AddMixedPairs() methods one batch at a time.
   void MakePairs(const char* type,
                  AliFemtoParticleCollection* ParticlesPassingCut1,
                  AliFemtoParticleCollection* ParticlesPssingCut2=NULL,
                  Bool_t enablePairMonitors=kFALSE);
 
+  /// Number of pairs handed to the correlation functions in one call
+  enum { kPairBatchSize = 128 };
+
   AliFemtoPicoEventCollectionVectorHideAway* fPicoEventCollectionVectorHideAway; //!<! Mixing Buffer used for Analyses which wrap this one
 
   AliFemtoPairCut*             fPairCut;             ///< cut applied to pairs
@@ -178,6 +202,14 @@ protected:
   Bool_t fPerformSharedDaughterCut;
   Bool_t fEnablePairMonitors;
 
+  Double_t fPrefilterKtMin;          ///< pair pre-filter: minimum kT
+  Double_t fPrefilterKtMax;          ///< pair pre-filter: maximum kT (<= 0 disables the kT window)
+  Double_t fPrefilterQinvMax;        ///< pair pre-filter: maximum qinv (<= 0 disables)
+  Double_t fPrefilterDEtaMax;        ///< pair pre-filter: close-track |deta| window (<= 0 disables)
+  Double_t fPrefilterDPhiStarMax;    ///< pair pre-filter: close-track |dphi*| window
+  Double_t fPrefilterRadius;         ///< pair pre-filter: radius (m) at which phi* is evaluated
+  Double_t fPrefilterBField;         ///< pair pre-filter: magnetic field (T)
+
 #ifdef __ROOT__
   /// \cond CLASSIMP
   ClassDef(AliFemtoSimpleAnalysis, 0);
@@ -305,4 +337,31 @@ inline void AliFemtoSimpleAnalysis::SetEnablePairMonitors(Bool_t aEnable)
   fEnablePairMonitors = aEnable;
 }
 
+inline void AliFemtoSimpleAnalysis::SetPairPrefilterKtRange(Double_t ktMin, Double_t ktMax)
+{
+  fPrefilterKtMin = ktMin;
+  fPrefilterKtMax = ktMax;
+}
+
+inline void AliFemtoSimpleAnalysis::SetPairPrefilterQinvMax(Double_t qinvMax)
+{
+  fPrefilterQinvMax = qinvMax;
+}
+
+inline void AliFemtoSimpleAnalysis::SetPairPrefilterCloseTracks(Double_t dEtaMax, Double_t dPhiStarMax,
+                                                                Double_t radius, Double_t bField)
+{
+  fPrefilterDEtaMax = dEtaMax;
+  fPrefilterDPhiStarMax = dPhiStarMax;
+  fPrefilterRadius = radius;
+  fPrefilterBField = bField;
+}
+
+inline Bool_t AliFemtoSimpleAnalysis::PairPrefilterActive() const
+{
+  return (fPrefilterKtMax > 0.0)
+      || (fPrefilterQinvMax > 0.0)
+      || (fPrefilterDEtaMax > 0.0 && fPrefilterDPhiStarMax > 0.0);
+}
+
 #endif
@@ -78,8 +78,6 @@ bool AliFemtoPairCutRadialDistance::Pass(const AliFemtoPair* pair){
 //    double pih = 3.14159265358979312;
 //    double pit = 6.28318530717958623;
 
-  double phi1 = pair->Track1()->Track()->P().Phi();
-  double phi2 = pair->Track2()->Track()->P().Phi();
   double chg1 = pair->Track1()->Track()->Charge();
   double chg2 = pair->Track2()->Track()->Charge();
   double ptv1 = pair->Track1()->Track()->Pt();
@@ -116,15 +114,21 @@ bool AliFemtoPairCutRadialDistance::Pass(const AliFemtoPair* pair){
 
   rad = fMinRad;
 
+  // phi* tables are cached per particle, so the separation at each radius
+  // is a plain difference
   if (fPhistarmin) {
-    for (rad = fMinRad; rad < fMaxRad; rad += 0.01) {
-      Double_t dps = (phi2-phi1+(TMath::ASin(-0.075*chg2*fMagSign*rad/ptv2))-(TMath::ASin(-0.075*chg1*fMagSign*rad/ptv1)));
-      dps = TVector2::Phi_mpi_pi(dps);
-      Double_t etad = eta2 - eta1;
-      if (fabs(etad)<fEtaMin && fabs(dps)<fDPhiStarMin) {
-        // cout << "5% cut is not passed - returning" << endl;
-        pass5 = kFALSE;
-        break;
+    Int_t nrad1 = 0, nrad2 = 0;
+    const double *phistar1 = pair->Track1()->PhiStar(0.075*fMagSign, fMinRad, fMaxRad, 0.01, nrad1);
+    const double *phistar2 = pair->Track2()->PhiStar(0.075*fMagSign, fMinRad, fMaxRad, 0.01, nrad2);
+    Double_t etad = eta2 - eta1;
+    if (fabs(etad)<fEtaMin) {
+      for (Int_t irad = 0; irad < nrad1 && irad < nrad2; irad++) {
+        Double_t dps = TVector2::Phi_mpi_pi(phistar2[irad] - phistar1[irad]);
+        if (fabs(dps)<fDPhiStarMin) {
+          // cout << "5% cut is not passed - returning" << endl;
+          pass5 = kFALSE;
+          break;
+        }
       }
     }
   }
@@ -136,7 +140,8 @@ bool AliFemtoPairCutRadialDistance::Pass(const AliFemtoPair* pair){
     if (fabs(afsi0b) >=1.) return kTRUE;
     if (fabs(afsi1b) >=1.) return kTRUE;
 
-    Double_t dps =  phi2 - phi1 + TMath::ASin(afsi1b) - TMath::ASin(afsi0b);
+    Double_t dps = pair->Track2()->PhiStar(-0.07510020733*fMagSign, rad)
+                 - pair->Track1()->PhiStar(-0.07510020733*fMagSign, rad);
     dps = TVector2::Phi_mpi_pi(dps);
 
     Double_t etad = eta2 - eta1;
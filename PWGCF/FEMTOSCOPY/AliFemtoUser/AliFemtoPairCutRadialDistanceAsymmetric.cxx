@@ -87,12 +87,6 @@ bool AliFemtoPairCutRadialDistanceAsymmetric::Pass(const AliFemtoPair* pair) {
     return true;
   
   // Prepare variables:
-  double phi1 = pair->Track1()->Track()->P().Phi();
-  double phi2 = pair->Track2()->Track()->P().Phi();
-  double chg1 = pair->Track1()->Track()->Charge();
-  double chg2 = pair->Track2()->Track()->Charge();
-  double pt1 = pair->Track1()->Track()->Pt();
-  double pt2 = pair->Track2()->Track()->Pt();
   double eta1 = pair->Track1()->Track()->P().PseudoRapidity();
   double eta2 = pair->Track2()->Track()->P().PseudoRapidity();
 
@@ -137,15 +131,14 @@ bool AliFemtoPairCutRadialDistanceAsymmetric::Pass(const AliFemtoPair* pair) {
   
   // Iterate through all radii in range (fRadiusMin, fRadiusMax):
   if(fCalculateRadiusRange == true) {
-    for(double irad = fRadiusMin; irad < fRadiusMax; irad = irad + 0.01) {
-    
-      // Calculate radius:
-      Double_t rad = irad;
+    // phi* at all radii, cached per particle:
+    Int_t nrad1 = 0, nrad2 = 0;
+    const double *phistar1 = pair->Track1()->PhiStar(0.07510020733*fMagSign, fRadiusMin, fRadiusMax, 0.01, nrad1);
+    const double *phistar2 = pair->Track2()->PhiStar(0.07510020733*fMagSign, fRadiusMin, fRadiusMax, 0.01, nrad2);
+    for(Int_t irad = 0; irad < nrad1 && irad < nrad2; irad++) {
 
       // Calculate dPhiStar:
-      double afsi0b = -0.07510020733*chg1*fMagSign*rad/pt1;
-      double afsi1b = -0.07510020733*chg2*fMagSign*rad/pt2;
-      Double_t dphistar =  phi2 - phi1 + TMath::ASin(afsi1b) - TMath::ASin(afsi0b);
+      Double_t dphistar = phistar2[irad] - phistar1[irad];
       dphistar = TVector2::Phi_mpi_pi(dphistar); // returns phi angle in the interval [-PI,PI)
 
       // Check if pair parameters meet the requirements:
@@ -169,9 +162,8 @@ bool AliFemtoPairCutRadialDistanceAsymmetric::Pass(const AliFemtoPair* pair) {
     Double_t rad = fRadiusMin;
 
     // Calculate dPhiStar:
-    double afsi0b = -0.07510020733*chg1*fMagSign*rad/pt1;
-    double afsi1b = -0.07510020733*chg2*fMagSign*rad/pt2;
-    Double_t dphistar =  phi2 - phi1 + TMath::ASin(afsi1b) - TMath::ASin(afsi0b);
+    Double_t dphistar = pair->Track2()->PhiStar(0.07510020733*fMagSign, rad)
+                      - pair->Track1()->PhiStar(0.07510020733*fMagSign, rad);
     dphistar = TVector2::Phi_mpi_pi(dphistar); // returns phi angle in the interval [-PI,PI)
 
     // Check if pair parameters meet the requirements:
@@ -45,6 +45,7 @@ The names are available via the function PairClassName(Int_t i)
 #include <TString.h>
 #include <TList.h>
 #include <TMath.h>
+#include <TDatabasePDG.h>
 #include <TObject.h>
 #include <TGrid.h>
 
@@ -156,6 +157,13 @@ AliDielectron::AliDielectron() :
   fDontClearArrays(kFALSE),
   fEventProcess(kTRUE),
   fUseGammaTracks(kTRUE),
+  fPreSelMassMin(0.),
+  fPreSelMassMax(0.),
+  fPreSelOpAngleMin(0.),
+  fPreSelPhiVMassMax(0.),
+  fPreSelPhiVMin(0.),
+  fLegKine(),
+  fLegMC(),
   fEstimatorFilename(""),
   fEstimatorObjArray(0x0),
   fTRDpidCorrectionFilename(""),
@@ -167,6 +175,8 @@ AliDielectron::AliDielectron() :
   //
   // Default constructor
   //
+  fNLegs[0]=0;
+  fNLegs[1]=0;
 
 }
 
@@ -229,6 +239,13 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   fDontClearArrays(kFALSE),
   fEventProcess(kTRUE),
   fUseGammaTracks(kTRUE),
+  fPreSelMassMin(0.),
+  fPreSelMassMax(0.),
+  fPreSelOpAngleMin(0.),
+  fPreSelPhiVMassMax(0.),
+  fPreSelPhiVMin(0.),
+  fLegKine(),
+  fLegMC(),
   fEstimatorFilename(""),
   fEstimatorObjArray(0x0),
   fTRDpidCorrectionFilename(""),
@@ -239,6 +256,8 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   //
   // Named constructor
   //
+  fNLegs[0]=0;
+  fNLegs[1]=0;
 
 }
 
@@ -1391,62 +1410,224 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
   Int_t ntrack1=arrTracks1.GetEntriesFast();
   Int_t ntrack2=arrTracks2.GetEntriesFast();
 
+  //
+  // The leg combinations are processed in stages:
+  //  - kinematic pre-selection (SetPairPreSelection, SetPairPreSelectionPhiV) on the packed
+  //    leg momenta, for blocks of kPairBlockSize combinations
+  //  - the pair (KF particles) is built only for the surviving combinations
+  //  - the MC mother labels are taken from a table filled once per leg
+  // The pre-selection is skipped if all combinations are monitored (CF manager, cut QA).
+  // With AliDielectronPair::SetRandomizeDaughters the random sequence of the daughter ordering
+  // is then only drawn for the surviving combinations.
+  //
+  Bool_t preSelect=PairPreSelectionActive() && !fCfManagerPair && !(pairIndex==kEv1PM && fCutQA);
+  Double_t bz=ev ? ev->GetMagneticField() : 0.;
+  FillLegTables(arrTracks1, 0, fPdgLeg1, preSelect);
+  FillLegTables(arrTracks2, 1, fPdgLeg2, preSelect);
+
   AliDielectronPair *candidate=new AliDielectronPair;
   candidate->SetKFUsage(fUseKF);
 
   UInt_t selectedMask=(1<<fPairFilter.GetCuts()->GetEntries())-1;
 
+  UChar_t accept[kPairBlockSize];
   for (Int_t itrack1=0; itrack1<ntrack1; ++itrack1){
     Int_t end=ntrack2;
     if (arr1==arr2) end=itrack1;
-    for (Int_t itrack2=0; itrack2<end; ++itrack2){
-      //create the pair (direct pointer to the memory by this daughter reference are kept also for ME)
-      candidate->SetTracks(&(*static_cast<AliVTrack*>(arrTracks1.UncheckedAt(itrack1))), fPdgLeg1,
-                           &(*static_cast<AliVTrack*>(arrTracks2.UncheckedAt(itrack2))), fPdgLeg2);
-      candidate->SetType(pairIndex);
-
-      Int_t label=AliDielectronMC::Instance()->GetLabelMotherWithPdg(candidate,fPdgMother);
-      candidate->SetLabel(label);
-      if (label>-1) candidate->SetPdgCode(fPdgMother);
-      else candidate->SetPdgCode(0);
-
-      // check for gamma kf particle
-      label=AliDielectronMC::Instance()->GetLabelMotherWithPdg(candidate,22);
-      if (label>-1 && fUseGammaTracks) {
-        candidate->SetGammaTracks(static_cast<AliVTrack*>(arrTracks1.UncheckedAt(itrack1)), fPdgLeg1,
-                                  static_cast<AliVTrack*>(arrTracks2.UncheckedAt(itrack2)), fPdgLeg2);
-      // should we set the pdgmothercode and the label
-      }
+    for (Int_t begin=0; begin<end; begin+=kPairBlockSize){
+      Int_t nPairs=TMath::Min(end-begin,(Int_t)kPairBlockSize);
+      if (preSelect) PreSelectPairs(itrack1, begin, nPairs, bz, accept);
+
+      for (Int_t ipair=0; ipair<nPairs; ++ipair){
+        if (preSelect && !accept[ipair]) continue;
+        Int_t itrack2=begin+ipair;
+
+        //create the pair (direct pointer to the memory by this daughter reference are kept also for ME)
+        candidate->SetTracks(&(*static_cast<AliVTrack*>(arrTracks1.UncheckedAt(itrack1))), fPdgLeg1,
+                             &(*static_cast<AliVTrack*>(arrTracks2.UncheckedAt(itrack2))), fPdgLeg2);
+        candidate->SetType(pairIndex);
+
+        Int_t label=GetLegsMotherLabel(itrack1,itrack2,fPdgMother);
+        candidate->SetLabel(label);
+        if (label>-1) candidate->SetPdgCode(fPdgMother);
+        else candidate->SetPdgCode(0);
+
+        // check for gamma kf particle
+        label=GetLegsMotherLabel(itrack1,itrack2,22);
+        if (label>-1 && fUseGammaTracks) {
+          candidate->SetGammaTracks(static_cast<AliVTrack*>(arrTracks1.UncheckedAt(itrack1)), fPdgLeg1,
+                                    static_cast<AliVTrack*>(arrTracks2.UncheckedAt(itrack2)), fPdgLeg2);
+        // should we set the pdgmothercode and the label
+        }
 
-      //pair cuts
-      UInt_t cutMask=fPairFilter.IsSelected(candidate);
+        //pair cuts
+        UInt_t cutMask=fPairFilter.IsSelected(candidate);
 
-      //CF manager for the pair
-      if (fCfManagerPair) fCfManagerPair->Fill(cutMask,candidate);
+        //CF manager for the pair
+        if (fCfManagerPair) fCfManagerPair->Fill(cutMask,candidate);
 
-      // cut qa
-      if(pairIndex==kEv1PM && fCutQA) {
-        fQAmonitor->FillAll(candidate);
-        fQAmonitor->Fill(cutMask,candidate);
-      }
+        // cut qa
+        if(pairIndex==kEv1PM && fCutQA) {
+          fQAmonitor->FillAll(candidate);
+          fQAmonitor->Fill(cutMask,candidate);
+        }
 
-      //apply cut
-      if (cutMask!=selectedMask) continue;
+        //apply cut
+        if (cutMask!=selectedMask) continue;
 
-      //histogram array for the pair
-      if (fHistoArray) fHistoArray->Fill(pairIndex,candidate);
+        //histogram array for the pair
+        if (fHistoArray) fHistoArray->Fill(pairIndex,candidate);
 
-      //add the candidate to the candidate array
-      PairArray(pairIndex)->Add(candidate);
-      //get a new candidate
-      candidate=new AliDielectronPair;
-      candidate->SetKFUsage(fUseKF);
+        //add the candidate to the candidate array
+        PairArray(pairIndex)->Add(candidate);
+        //get a new candidate
+        candidate=new AliDielectronPair;
+        candidate->SetKFUsage(fUseKF);
+      }
     }
   }
   //delete the surplus candidate
   delete candidate;
 }
 
+//________________________________________________________________
+void AliDielectron::FillLegTables(const TObjArray &arrTracks, Int_t side, Int_t pdgLeg, Bool_t fillKine)
+{
+  //
+  // fill the per leg tables used by FillPairArrays:
+  //   MC pdg code, mother label and mother pdg code (see AliDielectronMC::GetLegMotherInfo)
+  //   packed momenta, energy and charge for the kinematic pre-selection (if fillKine)
+  //
+  Int_t nLegs=arrTracks.GetEntriesFast();
+  fNLegs[side]=nLegs;
+
+  if (fLegMC[side].GetSize()<kNLegMC*nLegs) fLegMC[side].Set(kNLegMC*nLegs);
+  Int_t *mc=fLegMC[side].GetArray();
+  AliDielectronMC *dieMC=AliDielectronMC::Instance();
+  for (Int_t ileg=0; ileg<nLegs; ++ileg){
+    const AliVTrack *track=static_cast<const AliVTrack*>(arrTracks.UncheckedAt(ileg));
+    dieMC->GetLegMotherInfo(track, mc[ileg*kNLegMC+kLegMCPdg], mc[ileg*kNLegMC+kLegMCMother], mc[ileg*kNLegMC+kLegMCMotherPdg]);
+  }
+
+  if (!fillKine) return;
+
+  TParticlePDG *legParticle=TDatabasePDG::Instance()->GetParticle(pdgLeg);
+  Double_t mass=legParticle ? legParticle->Mass() : 0.;
+
+  if (fLegKine[side].GetSize()<kNLegKine*nLegs) fLegKine[side].Set(kNLegKine*nLegs);
+  Double_t *kine=fLegKine[side].GetArray();
+  for (Int_t ileg=0; ileg<nLegs; ++ileg){
+    const AliVTrack *track=static_cast<const AliVTrack*>(arrTracks.UncheckedAt(ileg));
+    Double_t px=track->Px();
+    Double_t py=track->Py();
+    Double_t pz=track->Pz();
+    Double_t p2=px*px+py*py+pz*pz;
+    kine[kLegPx*nLegs+ileg]=px;
+    kine[kLegPy*nLegs+ileg]=py;
+    kine[kLegPz*nLegs+ileg]=pz;
+    kine[kLegE*nLegs+ileg]=TMath::Sqrt(p2+mass*mass);
+    kine[kLegP*nLegs+ileg]=TMath::Sqrt(p2);
+    kine[kLegQ*nLegs+ileg]=track->Charge();
+  }
+}
+
+//________________________________________________________________
+void AliDielectron::PreSelectPairs(Int_t itrack1, Int_t begin, Int_t nPairs, Double_t bz, UChar_t *accept) const
+{
+  //
+  // kinematic pre-selection of the leg combinations (itrack1, begin ... begin+nPairs-1)
+  // from the packed leg momenta. The pair variables are calculated from the track momenta
+  // without vertexing, hence they differ slightly from the ones of the AliDielectronPair:
+  // the windows have to be set looser than the corresponding pair cuts.
+  //   mass window:    fPreSelMassMin < M < fPreSelMassMax
+  //   opening angle:  > fPreSelOpAngleMin
+  //   phiV:           reject unlike-sign pairs with M < fPreSelPhiVMassMax and phiV > fPreSelPhiVMin
+  //                   (same convention as AliDielectronPair::PhivPair, needs the magnetic field)
+  //
+  const Int_t n1=fNLegs[0];
+  const Double_t *kine1=fLegKine[0].GetArray();
+  const Double_t px1=kine1[kLegPx*n1+itrack1];
+  const Double_t py1=kine1[kLegPy*n1+itrack1];
+  const Double_t pz1=kine1[kLegPz*n1+itrack1];
+  const Double_t e1=kine1[kLegE*n1+itrack1];
+  const Double_t p1=kine1[kLegP*n1+itrack1];
+  const Double_t q1=kine1[kLegQ*n1+itrack1];
+
+  const Int_t n2=fNLegs[1];
+  const Double_t *kine2=fLegKine[1].GetArray();
+  const Double_t *px2=kine2+kLegPx*n2+begin;
+  const Double_t *py2=kine2+kLegPy*n2+begin;
+  const Double_t *pz2=kine2+kLegPz*n2+begin;
+  const Double_t *e2=kine2+kLegE*n2+begin;
+  const Double_t *p2=kine2+kLegP*n2+begin;
+  const Double_t *q2=kine2+kLegQ*n2+begin;
+
+  const Bool_t useMass=fPreSelMassMax>fPreSelMassMin;
+  const Double_t mass2Min=(useMass && fPreSelMassMin>0.) ? fPreSelMassMin*fPreSelMassMin : -1.e30;
+  const Double_t mass2Max=useMass ? fPreSelMassMax*fPreSelMassMax : 1.e30;
+  const Double_t cosOpMax=fPreSelOpAngleMin>0. ? TMath::Cos(fPreSelOpAngleMin) : 2.;
+  const Bool_t usePhiV=fPreSelPhiVMassMax>0. && bz!=0.;
+  const Double_t phiVMass2Max=fPreSelPhiVMassMax*fPreSelPhiVMassMax;
+  const Double_t cosPhiVMin=TMath::Cos(fPreSelPhiVMin);
+
+  for (Int_t i=0; i<nPairs; ++i){
+    const Double_t px=px1+px2[i];
+    const Double_t py=py1+py2[i];
+    const Double_t pz=pz1+pz2[i];
+    const Double_t e=e1+e2[i];
+    const Double_t mass2=e*e-px*px-py*py-pz*pz;
+    const Double_t cosOp=(px1*px2[i]+py1*py2[i]+pz1*pz2[i])/(p1*p2[i]);
+    accept[i]=(mass2>mass2Min) & (mass2<mass2Max) & !(cosOp>cosOpMax);
+  }
+
+  if (!usePhiV) return;
+
+  for (Int_t i=0; i<nPairs; ++i){
+    if (!accept[i] || q1*q2[i]>=0.) continue;
+    const Double_t px=px1+px2[i];
+    const Double_t py=py1+py2[i];
+    const Double_t pz=pz1+pz2[i];
+    const Double_t e=e1+e2[i];
+    if (e*e-px*px-py*py-pz*pz>=phiVMass2Max) continue;
+
+    // PhivPair puts the positive leg first for bz>0, the negative one otherwise;
+    // swapping the legs flips the sign of cos(phiV)
+    const Double_t sign=((q1>0.)==(bz>0.)) ? 1. : -1.;
+    const Double_t pp=TMath::Sqrt(px*px+py*py+pz*pz);
+    const Double_t pt=TMath::Sqrt(px*px+py*py);
+    const Double_t ux=px/pp, uy=py/pp, uz=pz/pp;
+    const Double_t ax=py/pt, ay=-px/pt;
+    Double_t vx=py1*pz2[i]-pz1*py2[i];
+    Double_t vy=pz1*px2[i]-px1*pz2[i];
+    Double_t vz=px1*py2[i]-py1*px2[i];
+    const Double_t vp=TMath::Sqrt(vx*vx+vy*vy+vz*vz);
+    vx/=vp; vy/=vp; vz/=vp;
+    const Double_t wx=uy*vz-uz*vy;
+    const Double_t wy=uz*vx-ux*vz;
+    const Double_t cosPhiV=sign*(wx*ax+wy*ay);
+    // degenerate configurations (NaN) are kept
+    if (cosPhiV<cosPhiVMin) accept[i]=0;
+  }
+}
+
+//________________________________________________________________
+Int_t AliDielectron::GetLegsMotherLabel(Int_t itrack1, Int_t itrack2, Int_t pdgMother) const
+{
+  //
+  // same as AliDielectronMC::GetLabelMotherWithPdg for the legs itrack1 and itrack2
+  // of FillPairArrays, from the leg tables filled in FillLegTables. The result
+  // does not depend on the order of the legs.
+  //
+  const Int_t *mc1=fLegMC[0].GetArray()+itrack1*kNLegMC;
+  const Int_t *mc2=fLegMC[1].GetArray()+itrack2*kNLegMC;
+  if (mc1[kLegMCMother]<0) return -1;
+  if (mc1[kLegMCMother]!=mc2[kLegMCMother]) return -1;
+  if (TMath::Abs(mc1[kLegMCPdg])!=11) return -1;
+  if (mc1[kLegMCPdg]!=-mc2[kLegMCPdg]) return -1;
+  if (mc1[kLegMCMotherPdg]!=pdgMother) return -1;
+  return mc1[kLegMCMother];
+}
+
 //________________________________________________________________
 void AliDielectron::FillPairArrayTR()
 {
@@ -18,6 +18,8 @@
 
 #include <TNamed.h>
 #include <TObjArray.h>
+#include <TArrayD.h>
+#include <TArrayI.h>
 #include <THnBase.h>
 #include <TSpline.h>
 
@@ -180,6 +182,14 @@ public:
   void SetEventProcess(Bool_t setValue=kTRUE) { fEventProcess=setValue; }
   Bool_t GammaTracksUsed() const { return fUseGammaTracks; }
   void SetUseGammaTracks(Bool_t setValue=kTRUE) { fUseGammaTracks=setValue; }
+  // kinematic pre-selection of the leg combinations before the pair is built,
+  // the windows must be looser than the pair cuts (see FillPairArrays)
+  void SetPairPreSelection(Double_t massMin, Double_t massMax, Double_t openingAngleMin=0.)
+    { fPreSelMassMin=massMin; fPreSelMassMax=massMax; fPreSelOpAngleMin=openingAngleMin; }
+  void SetPairPreSelectionPhiV(Double_t massMax, Double_t phiVMin)
+    { fPreSelPhiVMassMax=massMax; fPreSelPhiVMin=phiVMin; }
+  Bool_t PairPreSelectionActive() const
+    { return fPreSelMassMax>fPreSelMassMin || fPreSelOpAngleMin>0. || fPreSelPhiVMassMax>0.; }
   void  FillHistogramsFromPairArray(Bool_t pairInfoOnly=kFALSE);
 
 private:
@@ -259,10 +269,27 @@ private:
   Bool_t fEventProcess;         //Process event (or pair array)
   Bool_t fUseGammaTracks;       // use function SetGammaTracks for MCtruth photons
 
+  Double_t fPreSelMassMin;      // pair pre-selection: minimum mass from the leg momenta
+  Double_t fPreSelMassMax;      // pair pre-selection: maximum mass (window off if max<=min)
+  Double_t fPreSelOpAngleMin;   // pair pre-selection: minimum opening angle (off if <=0)
+  Double_t fPreSelPhiVMassMax;  // pair pre-selection: reject unlike-sign pairs below this mass ...
+  Double_t fPreSelPhiVMin;      // ... with phiV above this value (off if mass<=0)
+
+  enum { kLegPx=0, kLegPy, kLegPz, kLegE, kLegP, kLegQ, kNLegKine };   // packed leg kinematics
+  enum { kLegMCPdg=0, kLegMCMother, kLegMCMotherPdg, kNLegMC };      // per leg MC information
+  enum { kPairBlockSize=256 };  // number of leg combinations pre-selected in one go
+
+  Int_t   fNLegs[2];            //! number of legs in the tables below
+  TArrayD fLegKine[2];          //! leg kinematics of FillPairArrays, index var*nLegs+leg
+  TArrayI fLegMC[2];            //! leg MC information of FillPairArrays, index leg*kNLegMC+var
+
   void FillTrackArrays(AliVEvent * const ev, Int_t eventNr=0);
   void EventPlanePreFilter(Int_t arr1, Int_t arr2, TObjArray arrTracks1, TObjArray arrTracks2, const AliVEvent *ev);
   void PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1, TObjArray &arrTracks2, const AliVEvent *ev, Int_t prefilterN);
   void FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev = 0x0);
+  void FillLegTables(const TObjArray &arrTracks, Int_t side, Int_t pdgLeg, Bool_t fillKine);
+  void PreSelectPairs(Int_t itrack1, Int_t begin, Int_t nPairs, Double_t bz, UChar_t *accept) const;
+  Int_t GetLegsMotherLabel(Int_t itrack1, Int_t itrack2, Int_t pdgMother) const;
   void FillPairArrayTR();
 
   Int_t GetPairIndex(Int_t arr1, Int_t arr2) const {return arr1>=arr2?arr1*(arr1+1)/2+arr2:arr2*(arr2+1)/2+arr1;}
@@ -297,7 +324,7 @@ private:
   AliDielectron(const AliDielectron &c);
   AliDielectron &operator=(const AliDielectron &c);
 
-  ClassDef(AliDielectron,17);
+  ClassDef(AliDielectron,18);
 };
 
 inline void AliDielectron::InitPairCandidateArrays()
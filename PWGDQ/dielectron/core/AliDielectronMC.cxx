@@ -669,6 +669,52 @@ Int_t AliDielectronMC::GetLabelMotherWithPdgAOD(const AliVParticle *particle1, c
   return lblMother1;
 }
 
+//____________________________________________________________
+Bool_t AliDielectronMC::GetLegMotherInfo(const AliVParticle *particle, Int_t &pdg, Int_t &lblMother, Int_t &pdgMother) const
+{
+  //
+  // MC information of a single leg as it enters GetLabelMotherWithPdg:
+  //   pdg code of the associated MC particle, label and pdg code of its mother
+  // lblMother is -1 if the mother is not available
+  // returns kFALSE if there is no associated MC particle
+  //
+  // GetLabelMotherWithPdg(particle1, particle2, pdgMother) is equivalent to
+  //   lblMother1>=0 && lblMother1==lblMother2 && |pdg1|==11 && pdg1==-pdg2 && pdgMother1==pdgMother
+  // which allows to look up the legs once per event instead of once per pair
+  //
+  pdg=0;
+  lblMother=-1;
+  pdgMother=0;
+
+  Int_t lblPart = TMath::Abs(particle->GetLabel());
+  if (fAnaType==kESD){
+    if (!fMCEvent) return kFALSE;
+    AliMCParticle *mcPart=static_cast<AliMCParticle*>(GetMCTrackFromMCEvent(lblPart));
+    if (!mcPart) return kFALSE;
+    pdg=mcPart->PdgCode();
+    AliMCParticle *mcMother=static_cast<AliMCParticle*>(GetMCTrackFromMCEvent(mcPart->GetMother()));
+    if (mcMother) {
+      lblMother=mcPart->GetMother();
+      pdgMother=mcMother->PdgCode();
+    }
+    return kTRUE;
+  }
+  else if (fAnaType==kAOD){
+    if (!fMcArray) return kFALSE;
+    AliAODMCParticle *mcPart=static_cast<AliAODMCParticle*>(GetMCTrackFromMCEvent(lblPart));
+    if (!mcPart) return kFALSE;
+    pdg=mcPart->GetPdgCode();
+    AliAODMCParticle *mcMother=static_cast<AliAODMCParticle*>(GetMCTrackFromMCEvent(mcPart->GetMother()));
+    if (mcMother) {
+      lblMother=mcPart->GetMother();
+      pdgMother=mcMother->GetPdgCode();
+    }
+    return kTRUE;
+  }
+
+  return kFALSE;
+}
+
 //____________________________________________________________
 void AliDielectronMC::GetDaughters(const TObject *mother, AliVParticle* &d1, AliVParticle* &d2)
 {
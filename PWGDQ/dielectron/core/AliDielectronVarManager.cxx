@@ -648,6 +648,16 @@ TH3D*           AliDielectronVarManager::fgTRDpidEff[10][4] = {{0x0}};
 TObject*        AliDielectronVarManager::fgLegEffMap           = 0x0;
 TObject*        AliDielectronVarManager::fgPairEffMap          = 0x0;
 TBits*          AliDielectronVarManager::fgFillMap          = 0x0;
+Bool_t          AliDielectronVarManager::fgCompactFill      = kFALSE;
+Int_t           AliDielectronVarManager::fgNCompactFill     = 0;
+UInt_t          AliDielectronVarManager::fgCompactFillList[AliDielectronVarManager::kNMaxValues-AliDielectronVarManager::kPairMax] = {0};
+Int_t           AliDielectronVarManager::fgNCompactFillMaps = 0;
+const TBits*    AliDielectronVarManager::fgCompactFillMaps[AliDielectronVarManager::kMaxCompactFillMaps] = {0x0};
+Bool_t          AliDielectronVarManager::fgCompactFillVars[AliDielectronVarManager::kNMaxValues-AliDielectronVarManager::kPairMax] = {kFALSE};
+Int_t           AliDielectronVarManager::fgNLegEffVars      = -1;
+UInt_t          AliDielectronVarManager::fgLegEffVars[AliDielectronVarManager::kMaxEffMapDims] = {0};
+Int_t           AliDielectronVarManager::fgNPairEffVars     = -1;
+UInt_t          AliDielectronVarManager::fgPairEffVars[AliDielectronVarManager::kMaxEffMapDims] = {0};
 Double_t        AliDielectronVarManager::fgTRDpidEffCentRanges[10][4] = {{0.0}};
 TString         AliDielectronVarManager::fgVZEROCalibrationFile = "";
 TString         AliDielectronVarManager::fgVZERORecenteringFile = "";
@@ -742,3 +752,116 @@ UInt_t AliDielectronVarManager::GetValueType(const char* valname) {
   }
   return -1;
 }
+
+//________________________________________________________________
+void AliDielectronVarManager::SetLegEffMap(TObject *map)
+{
+  //
+  // set the single leg efficiency map, the variables of its axes are looked up only once
+  //
+  if (map!=fgLegEffMap) fgNLegEffVars=ResolveEffMapVars(map,fgLegEffVars);
+  fgLegEffMap=map;
+  if (fgCompactFill) UpdateCompactFillList();
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::SetPairEffMap(TObject *map)
+{
+  //
+  // set the pair efficiency map, the variables of its axes are looked up only once
+  //
+  if (map!=fgPairEffMap) fgNPairEffVars=ResolveEffMapVars(map,fgPairEffVars);
+  fgPairEffMap=map;
+  if (fgCompactFill) UpdateCompactFillList();
+}
+
+//________________________________________________________________
+Int_t AliDielectronVarManager::ResolveEffMapVars(const TObject *map, UInt_t *vars)
+{
+  //
+  // Get the value types of the axes of an efficiency map (THnBase or TSpline3),
+  // as done by GetSingleLegEff and GetPairEff from the axis names.
+  // Returns the number of axes, -1 if the names have to be looked up at run time.
+  //
+  if (!map) return -1;
+  if (map->InheritsFrom(THnBase::Class())) {
+    const THnBase *eff = static_cast<const THnBase*>(map);
+    Int_t dim=eff->GetNdimensions();
+    if (dim>kMaxEffMapDims) return -1;
+    for (Int_t idim=0; idim<dim; idim++) vars[idim]=GetValueType(eff->GetAxis(idim)->GetName());
+    return dim;
+  }
+  if (map->IsA()==TSpline3::Class()) {
+    TSpline3 *eff = static_cast<TSpline3*>(const_cast<TObject*>(map));
+    if (!eff->GetHistogram()) return -1;
+    vars[0]=GetValueType(eff->GetHistogram()->GetXaxis()->GetName());
+    return 1;
+  }
+  return -1;
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::SetCompactFill(Bool_t compact)
+{
+  //
+  // Copy only the event variables used by the consumers into the track and pair arrays.
+  // The list of variables is the union of all fill maps passed to SetFillMap afterwards,
+  // so values filled for one consumer are complete also when another consumer
+  // (e.g. PID or event cuts) replaced the fill map in between.
+  // The content of a fill map must not change after it was passed to SetFillMap.
+  //
+  fgCompactFill=compact;
+  fgNCompactFillMaps=0;
+  for (Int_t i=0; i<kNMaxValues-kPairMax; ++i) fgCompactFillVars[i]=kFALSE;
+  if (fgCompactFill && fgFillMap) AddCompactFillMap(fgFillMap);
+  else UpdateCompactFillList();
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::AddCompactFillMap(const TBits *map)
+{
+  //
+  // Add the event variables of a new fill map to the compact fill list.
+  // Done once per fill map, SetFillMap only compares the pointer afterwards.
+  //
+  if (fgNCompactFillMaps==kMaxCompactFillMaps) {
+    AliWarningClass(Form("More than %d fill maps, compact fill is switched off",kMaxCompactFillMaps));
+    fgCompactFill=kFALSE;
+    return;
+  }
+  fgCompactFillMaps[fgNCompactFillMaps++]=map;
+
+  const UInt_t nbits=TMath::Min(map->GetNbits(),(UInt_t)kNMaxValues);
+  for (UInt_t i=map->FirstSetBit(kPairMax); i<nbits; i=map->FirstSetBit(i+1))
+    fgCompactFillVars[i-kPairMax]=kTRUE;
+  UpdateCompactFillList();
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::UpdateCompactFillList()
+{
+  //
+  // Build the list of event variables copied into the track and pair arrays with SetCompactFill:
+  // the event variables of all fill maps seen so far and the ones the efficiency maps depend on.
+  //
+  Bool_t used[kNMaxValues-kPairMax];
+  for (Int_t i=0; i<kNMaxValues-kPairMax; ++i) used[i]=fgCompactFillVars[i];
+
+  const Int_t    nEffVars[2]={fgNLegEffVars, fgNPairEffVars};
+  const UInt_t  *effVars[2] ={fgLegEffVars,  fgPairEffVars};
+  const TObject *effMaps[2] ={fgLegEffMap,   fgPairEffMap};
+  for (Int_t imap=0; imap<2; ++imap) {
+    if (!effMaps[imap]) continue;
+    for (Int_t ivar=0; ivar<nEffVars[imap]; ++ivar) {
+      UInt_t var=effVars[imap][ivar];
+      if (var<(UInt_t)kPairMax || var>=(UInt_t)kNMaxValues) continue;
+      used[var-kPairMax]=kTRUE;
+    }
+    // axes not known in advance, copy all event variables
+    if (nEffVars[imap]<0) for (Int_t i=0; i<kNMaxValues-kPairMax; ++i) used[i]=kTRUE;
+  }
+
+  fgNCompactFill=0;
+  for (Int_t i=kPairMax; i<kNMaxValues; ++i)
+    if (used[i-kPairMax]) fgCompactFillList[fgNCompactFill++]=i;
+}
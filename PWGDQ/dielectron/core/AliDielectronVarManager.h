@@ -682,9 +682,11 @@ public:
   static void InitEstimatorAvg(const Char_t* filename);
   static void InitEstimatorObjArrayAvg(const TObjArray* array);
   static void InitTRDpidEffHistograms(const Char_t* filename);
-  static void SetLegEffMap( TObject *map) { fgLegEffMap=map; }
-  static void SetPairEffMap(TObject *map) { fgPairEffMap=map; }
-  static void SetFillMap(   TBits   *map) { fgFillMap=map; }
+  static void SetLegEffMap( TObject *map);
+  static void SetPairEffMap(TObject *map);
+  static void SetFillMap(   TBits   *map) { fgFillMap=map; if (fgCompactFill && map && !IsCompactFillMap(map)) AddCompactFillMap(map); }
+  static void SetCompactFill(Bool_t compact=kTRUE);
+  static Bool_t GetCompactFill() { return fgCompactFill; }
   static void SetVZEROCalibrationFile(const Char_t* filename) {fgVZEROCalibrationFile = filename;}
 
   static void SetVZERORecenteringFile(const Char_t* filename) {fgVZERORecenteringFile = filename;}
@@ -723,6 +725,11 @@ private:
   static const char* fgkParticleNames[kNMaxValues][3];  //variable names
 
   static Bool_t Req(ValueTypes var) { return (fgFillMap ? fgFillMap->TestBitNumber(var) : kTRUE); }
+  static void FillEventData(Double_t * const values);
+  static void UpdateCompactFillList();
+  static Bool_t IsCompactFillMap(const TBits *map) { for (Int_t i=0; i<fgNCompactFillMaps; ++i) if (fgCompactFillMaps[i]==map) return kTRUE; return kFALSE; }
+  static void AddCompactFillMap(const TBits *map);
+  static Int_t ResolveEffMapVars(const TObject *map, UInt_t *vars);
   static void FillVarESDtrack(const AliESDtrack *particle,           Double_t * const values);
   static void FillVarAODTrack(const AliAODTrack *particle,           Double_t * const values);
   static void FillVarVTrdTrack(const AliVParticle *particle,         Double_t * const values);
@@ -752,6 +759,18 @@ private:
   static TObject         *fgLegEffMap;             // single electron efficiencies
   static TObject         *fgPairEffMap;             // pair efficiencies
   static TBits           *fgFillMap;             // map for requested variable filling
+  static Bool_t           fgCompactFill;         // copy only the requested event variables (see SetCompactFill)
+  static Int_t            fgNCompactFill;        // number of entries in fgCompactFillList
+  static UInt_t           fgCompactFillList[kNMaxValues-kPairMax]; // event variables of all fill maps
+  enum { kMaxCompactFillMaps=64 };
+  static Int_t            fgNCompactFillMaps;    // number of fill maps in fgCompactFillMaps
+  static const TBits     *fgCompactFillMaps[kMaxCompactFillMaps]; // fill maps seen with SetCompactFill
+  static Bool_t           fgCompactFillVars[kNMaxValues-kPairMax]; // union of the event variables of fgCompactFillMaps
+  enum { kMaxEffMapDims=20 };
+  static Int_t            fgNLegEffVars;         // number of resolved axes of fgLegEffMap (-1: not resolved)
+  static UInt_t           fgLegEffVars[kMaxEffMapDims];  // variables of the fgLegEffMap axes
+  static Int_t            fgNPairEffVars;        // number of resolved axes of fgPairEffMap (-1: not resolved)
+  static UInt_t           fgPairEffVars[kMaxEffMapDims]; // variables of the fgPairEffMap axes
   static TString          fgVZEROCalibrationFile;  // file with VZERO channel-by-channel calibrations
   static TString          fgVZERORecenteringFile;  // file with VZERO Q-vector averages needed for event plane recentering
   static TProfile2D      *fgVZEROCalib[64];           // 1 histogram per VZERO channel
@@ -849,8 +868,7 @@ inline void AliDielectronVarManager::FillVarVParticle(const AliVParticle *partic
   }
 
 //   if ( fgEvent ) AliDielectronVarManager::Fill(fgEvent, values);
-  for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
-    values[i]=fgData[i];
+  FillEventData(values);
 }
 
 inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle, Double_t * const values)
@@ -2281,8 +2299,7 @@ inline void AliDielectronVarManager::FillVarKFParticle(const AliKFParticle *part
   values[AliDielectronVarManager::kHasCocktailGrandMother]=0;
 
 //   if ( fgEvent ) AliDielectronVarManager::Fill(fgEvent, values);
-  for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
-    values[i]=fgData[i];
+  FillEventData(values);
 
 }
 
@@ -3069,7 +3086,7 @@ inline Double_t AliDielectronVarManager::GetSingleLegEff(Double_t * const values
     Int_t dim=eff->GetNdimensions();
     Int_t idx[dim];
     for(Int_t idim=0; idim<dim; idim++) {
-      UInt_t var = GetValueType(eff->GetAxis(idim)->GetName());
+      UInt_t var = (fgNLegEffVars==dim ? fgLegEffVars[idim] : GetValueType(eff->GetAxis(idim)->GetName()));
       idx[idim] = eff->GetAxis(idim)->FindBin(values[var]);
       if(idx[idim] < 0 || idx[idim]>eff->GetAxis(idim)->GetNbins()) return 0.0;
     }
@@ -3090,7 +3107,7 @@ inline Double_t AliDielectronVarManager::GetPairEff(Double_t * const values) {
     Int_t dim=eff->GetNdimensions();
     Int_t idx[dim];
     for(Int_t idim=0; idim<dim; idim++) {
-      UInt_t var = GetValueType(eff->GetAxis(idim)->GetName());
+      UInt_t var = (fgNPairEffVars==dim ? fgPairEffVars[idim] : GetValueType(eff->GetAxis(idim)->GetName()));
       idx[idim] = eff->GetAxis(idim)->FindBin(values[var]);
       if(idx[idim] < 0 || idx[idim]>eff->GetAxis(idim)->GetNbins()) return 0.0;
     }
@@ -3100,7 +3117,7 @@ inline Double_t AliDielectronVarManager::GetPairEff(Double_t * const values) {
   if(fgPairEffMap->IsA()== TSpline3::Class()) {
     TSpline3 *eff = static_cast<TSpline3*>(fgPairEffMap);
     if(!eff->GetHistogram()) { printf("no histogram added to the spline\n"); return -1.;}
-    UInt_t var = GetValueType(eff->GetHistogram()->GetXaxis()->GetName());
+    UInt_t var = (fgNPairEffVars==1 ? fgPairEffVars[0] : GetValueType(eff->GetHistogram()->GetXaxis()->GetName()));
     return (eff->Eval(values[var]));
   }
 
@@ -3266,6 +3283,22 @@ inline void AliDielectronVarManager::SetEventData(const Double_t data[AliDielect
   for (Int_t i=kPairMax; i<kNMaxValues;++i) fgData[i]=data[i];
 }
 
+inline void AliDielectronVarManager::FillEventData(Double_t * const values)
+{
+  //
+  // Copy the event information from the local buffer into the array of a track or pair.
+  // With SetCompactFill only the event variables requested in any of the fill maps
+  // (and the ones needed for the efficiency maps) are copied, the others are left untouched.
+  // Without fill map all event variables are copied.
+  //
+  if (fgCompactFill && fgFillMap) {
+    for (Int_t i=0; i<fgNCompactFill; ++i) values[fgCompactFillList[i]]=fgData[fgCompactFillList[i]];
+    return;
+  }
+  for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
+    values[i]=fgData[i];
+}
+
 
 //______________________________________________________________________________
 inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t* d0z0, Double_t* covd0z0)
@@ -14,6 +14,8 @@
 #include "TProfile2D.h"
 #include "TH3.h"
 #include "TH3F.h"
+#include "TArrayI.h"
+#include "TBits.h"
 #include <vector>
 #include <map>
 
@@ -43,6 +45,10 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     void SetDoPlotVsCentrality(Bool_t flag)                       { fDoPlotVsCentrality         = flag    ;}
     void SetDoTHnSparse(Bool_t flag)                              { fDoTHnSparse                = flag    ;}
     void SetDoCentFlattening(Int_t flag)                          { fDoCentralityFlat           = flag    ;}
+    // Cut sets with identical event and photon cut strings (e.g. differing only in the meson cut)
+    // share one evaluation of the photon selection per V0; the photon cut QA histograms are then
+    // only filled for the first of them
+    void SetShareIdenticalPhotonCuts(Bool_t flag)                 { fShareIdenticalPhotonCuts   = flag    ;}
     void ProcessPhotonCandidates();
     void ProcessClusters();
     void CalculatePi0Candidates();
@@ -302,12 +308,16 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     Bool_t                            fDoMaterialBudgetWeightingOfGammasForTrueMesons;
     TTree*                            tBrokenFiles;                               // tree for keeping track of broken files
     TObjString*                       fFileNameBroken;                            // string object for broken file name
+    Bool_t                            fShareIdenticalPhotonCuts;                  // share photon selection between identical event+photon cut sets
+    TArrayI                           fPhotonCutRepresentative;                   //! first cut set with the same event and photon cut strings
+    TBits                             fPhotonCutMask;                             //! bit iV0*fnCuts+iCut: V0 selected by photon cut iCut in this event
+    TBits                             fPhotonCutMaskFilled;                       //! bit iCut: photon selection of iCut evaluated in this event
 
   private:
 
     AliAnalysisTaskGammaConvV1(const AliAnalysisTaskGammaConvV1&); // Prevent copy-construction
     AliAnalysisTaskGammaConvV1 &operator=(const AliAnalysisTaskGammaConvV1&); // Prevent assignment
-    ClassDef(AliAnalysisTaskGammaConvV1, 40);
+    ClassDef(AliAnalysisTaskGammaConvV1, 41);
 };
 
 #endif
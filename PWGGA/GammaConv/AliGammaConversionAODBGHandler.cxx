@@ -44,7 +44,10 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler() :
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(),
 	fBGEventsENeg(),
-	fBGEventsMeson()
+	fBGEventsMeson(),
+	fBGEventsArena(NULL),
+	fBGEventsENegArena(NULL),
+	fBGEventsMesonArena(NULL)
 {
 	// constructor
 }
@@ -64,7 +67,10 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t binsZ,Int_t
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
-	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents)))
+	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
+	fBGEventsArena(NULL),
+	fBGEventsENegArena(NULL),
+	fBGEventsMesonArena(NULL)
 {
 	// constructor
 }
@@ -86,7 +92,10 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t collisionSy
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
-	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents)))
+	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
+	fBGEventsArena(NULL),
+	fBGEventsENegArena(NULL),
+	fBGEventsMesonArena(NULL)
 {
 	// constructor
     if(fNBinsZ>8) fNBinsZ = 8;
@@ -357,9 +366,13 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(const AliGammaCon
 	fBinLimitsArrayMultiplicity(original.fBinLimitsArrayMultiplicity),
 	fBGEvents(original.fBGEvents),
 	fBGEventsENeg(original.fBGEventsENeg),
-	fBGEventsMeson(original.fBGEventsMeson)
+	fBGEventsMeson(original.fBGEventsMeson),
+	fBGEventsArena(NULL),
+	fBGEventsENegArena(NULL),
+	fBGEventsMesonArena(NULL)
 {
 	//copy constructor	
+	//the stored particles stay owned by the arenas of the original
 }
 
 //_____________________________________________________________________________________________________________________________
@@ -413,6 +426,11 @@ AliGammaConversionAODBGHandler::~AliGammaConversionAODBGHandler(){
 	if(fBinLimitsArrayMultiplicity){
 		delete[] fBinLimitsArrayMultiplicity;
 	}
+
+	// the arenas own all stored particles
+	if(fBGEventsArena) delete fBGEventsArena;
+	if(fBGEventsENegArena) delete fBGEventsENegArena;
+	if(fBGEventsMesonArena) delete fBGEventsMesonArena;
 }
 
 //_____________________________________________________________________________________________________________________________
@@ -588,15 +606,15 @@ void AliGammaConversionAODBGHandler::AddEvent(TList* const eventGammas,Double_t
 	//  cout<<"Checking the entries: Z="<<z<<", M="<<m<<", eventCounter="<<eventCounter<<endl;
 
 	//  cout<<"The size of this vector is: "<<fBGEvents[z][m][eventCounter].size()<<endl;
-    for(Int_t d=0;d<fBGEvents[z][m][eventCounter].size();d++){
-		delete (AliAODConversionPhoton*)(fBGEvents[z][m][eventCounter][d]);
-	}
+	// the photons of the previous event in this slot are overwritten in place
+	TClonesArray *arena = GetArena(fBGEventsArena,"AliAODConversionPhoton",z,m,eventCounter);
+	arena->Clear();
 	fBGEvents[z][m][eventCounter].clear();
 	
 	// add the gammas to the vector
 	for(Int_t i=0; i< eventGammas->GetEntries();i++){
 		//    AliKFParticle *t = new AliKFParticle(*(AliKFParticle*)(eventGammas->At(i)));
-		fBGEvents[z][m][eventCounter].push_back(new AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventGammas->At(i))));
+		fBGEvents[z][m][eventCounter].push_back(new((*arena)[i]) AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventGammas->At(i))));
 	}
 	fBGEventCounter[z][m]++;
 }
@@ -619,15 +637,14 @@ void AliGammaConversionAODBGHandler::AddMesonEvent(TList* const eventMothers, Do
 	fBGEventVertex[z][m][eventCounter].fZ = zvalue;
 	fBGEventVertex[z][m][eventCounter].fEP = epvalue;
 
-	//first clear the vector
-    for(Int_t d=0;d<fBGEvents[z][m][eventCounter].size();d++){
-		delete (AliAODConversionMother*)(fBGEventsMeson[z][m][eventCounter][d]);
-	}
+	//first clear the vector, the mesons of the previous event in this slot are overwritten in place
+	TClonesArray *arena = GetArena(fBGEventsMesonArena,"AliAODConversionMother",z,m,eventCounter);
+	arena->Clear();
 	fBGEventsMeson[z][m][eventCounter].clear();
 	
 	// add the gammas to the vector
 	for(Int_t i=0; i< eventMothers->GetEntries();i++){
-		fBGEventsMeson[z][m][eventCounter].push_back(new AliAODConversionMother(*(AliAODConversionMother*)(eventMothers->At(i))));
+		fBGEventsMeson[z][m][eventCounter].push_back(new((*arena)[i]) AliAODConversionMother(*(AliAODConversionMother*)(eventMothers->At(i))));
 	}
 	fBGEventMesonCounter[z][m]++;
 }
@@ -649,20 +666,37 @@ void AliGammaConversionAODBGHandler::AddElectronEvent(TClonesArray* const eventE
 	//  cout<<"Checking the entries: Z="<<z<<", M="<<m<<", eventCounter="<<eventCounter<<endl;
 
 	//  cout<<"The size of this vector is: "<<fBGEvents[z][m][eventCounter].size()<<endl;
-    for(Int_t d=0;d<fBGEventsENeg[z][m][eventENegCounter].size();d++){
-		delete (AliAODConversionPhoton*)(fBGEventsENeg[z][m][eventENegCounter][d]);
-	}
-
+	TClonesArray *arena = GetArena(fBGEventsENegArena,"AliAODConversionPhoton",z,m,eventENegCounter);
+	arena->Clear();
 	fBGEventsENeg[z][m][eventENegCounter].clear();
 
 	// add the electron to the vector
 	for(Int_t i=0; i< eventENeg->GetEntriesFast();i++){
 		//    AliKFParticle *t = new AliKFParticle(*(AliKFParticle*)(eventGammas->At(i)));
-		fBGEventsENeg[z][m][eventENegCounter].push_back(new AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventENeg->At(i))));
+		fBGEventsENeg[z][m][eventENegCounter].push_back(new((*arena)[i]) AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventENeg->At(i))));
 	}
 	fBGEventENegCounter[z][m]++;
 }
 
+//_____________________________________________________________________________________________________________________________
+TClonesArray* AliGammaConversionAODBGHandler::GetArena(TObjArray *&arenas, const char *className, Int_t z, Int_t m, Int_t event){
+	// Storage of the particles of one pool slot (z bin, multiplicity bin, event).
+	// The memory of a slot is kept when the slot is refilled, so after the
+	// pools have been filled once no allocation happens anymore.
+	Int_t nSlots = fNBinsZ*fNBinsMultiplicity*fNEvents;
+	if(!arenas){
+		arenas = new TObjArray(nSlots);
+		arenas->SetOwner(kTRUE);
+	}
+	Int_t slot = (z*fNBinsMultiplicity+m)*fNEvents+event;
+	TClonesArray *arena = (TClonesArray*)arenas->UncheckedAt(slot);
+	if(!arena){
+		arena = new TClonesArray(className,10);
+		arenas->AddAt(arena,slot);
+	}
+	return arena;
+}
+
 //_____________________________________________________________________________________________________________________________
 AliGammaConversionAODVector* AliGammaConversionAODBGHandler::GetBGGoodV0s(Int_t zbin, Int_t mbin, Int_t event){
 	//see headerfile for documentation
@@ -19,6 +19,7 @@
 #include "AliAODConversionPhoton.h"
 #include "AliAODConversionMother.h"
 #include "TClonesArray.h"
+#include "TObjArray.h"
 #include "AliESDVertex.h"
 
 #if __GNUC__ >= 3
@@ -82,6 +83,8 @@ class AliGammaConversionAODBGHandler : public TObject {
 
 	private:
 
+		TClonesArray* GetArena(TObjArray *&arenas, const char *className, Int_t z, Int_t m, Int_t event);
+
 		Int_t 								fNEvents; 						// number of events
 		Int_t ** 							fBGEventCounter;				//! bg counter
 		Int_t ** 							fBGEventENegCounter;			//! bg electron counter
@@ -95,7 +98,10 @@ class AliGammaConversionAODBGHandler : public TObject {
 		AliGammaConversionBGVector 			fBGEvents; 						// photon background events
 		AliGammaConversionBGVector 			fBGEventsENeg; 					// electron background electron events
 		AliGammaConversionMotherBGVector 	fBGEventsMeson; 				// neutral meson background events
+		TObjArray *							fBGEventsArena;					//! photon storage, one TClonesArray per pool slot
+		TObjArray *							fBGEventsENegArena;				//! electron storage, one TClonesArray per pool slot
+		TObjArray *							fBGEventsMesonArena;			//! meson storage, one TClonesArray per pool slot
 		
-	ClassDef(AliGammaConversionAODBGHandler,5)
+	ClassDef(AliGammaConversionAODBGHandler,6)
 };
 #endif
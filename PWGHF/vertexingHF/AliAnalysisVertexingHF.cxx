@@ -157,7 +157,9 @@ fMassDplus(0.),
 fMassDs(0.),
 fMassLambdaC(0.),
 fMassDstar(0.),
-fMassJpsi(0.)
+fMassJpsi(0.),
+fCachePairDCA(kTRUE),
+fPairDCA()
 {
   /// Default constructor
 
@@ -252,7 +254,9 @@ fMassDplus(source.fMassDplus),
 fMassDs(source.fMassDs),
 fMassLambdaC(source.fMassLambdaC),
 fMassDstar(source.fMassDstar),
-fMassJpsi(source.fMassJpsi)
+fMassJpsi(source.fMassJpsi),
+fCachePairDCA(source.fCachePairDCA),
+fPairDCA()
 {
   ///
   /// Copy constructor
@@ -344,6 +348,7 @@ AliAnalysisVertexingHF &AliAnalysisVertexingHF::operator=(const AliAnalysisVerte
   fMassLambdaC = source.fMassLambdaC;
   fMassDstar = source.fMassDstar;
   fMassJpsi = source.fMassJpsi;
+  fCachePairDCA = source.fCachePairDCA;
 
   return *this;
 }
@@ -617,6 +622,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
   AliDebug(1,Form(" Selected tracks: %d",nSeleTrks));
   fnSeleTrksTotal += nSeleTrks;
+  ResetPairDCACache(nSeleTrks);
 
 
   TObjArray *twoTrackArray1    = new TObjArray(2);
@@ -867,7 +873,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
       negtrack1->GetPxPyPz(momneg1);
 
       // DCA between the two tracks
-      dcap1n1 = postrack1->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
+      dcap1n1 = GetPairDCA(postrack1,iTrkP1,negtrack1,iTrkN1,nSeleTrks);
       if(dcap1n1>dcaMax) { negtrack1=0; continue; }
 
       // Vertexing
@@ -1131,9 +1137,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 	//printf("********** %d %d %d\n",postrack1->GetID(),postrack2->GetID(),negtrack1->GetID());
 
-	dcap2n1 = postrack2->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
+	dcap2n1 = GetPairDCA(postrack2,iTrkP2,negtrack1,iTrkN1,nSeleTrks);
 	if(dcap2n1>dcaMax) { postrack2=0; continue; }
-	dcap1p2 = postrack2->GetDCA(postrack1,fBzkG,xdummy,ydummy);
+	dcap1p2 = GetPairDCA(postrack2,iTrkP2,postrack1,iTrkP1,nSeleTrks);
 	if(dcap1p2>dcaMax) { postrack2=0; continue; }
 
 	// check invariant mass cuts for D+,Ds,Lc
@@ -1275,9 +1281,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
 	    SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 
-	    dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	    dcap1n2 = GetPairDCA(postrack1,iTrkP1,negtrack2,iTrkN2,nSeleTrks);
 	    if(dcap1n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
-            dcap2n2 = postrack2->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+            dcap2n2 = GetPairDCA(postrack2,iTrkP2,negtrack2,iTrkN2,nSeleTrks);
             if(dcap2n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
 
 
@@ -1409,9 +1415,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 	//printf("********** %d %d %d\n",postrack1->GetID(),negtrack1->GetID(),negtrack2->GetID());
 
-	dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	dcap1n2 = GetPairDCA(postrack1,iTrkP1,negtrack2,iTrkN2,nSeleTrks);
 	if(dcap1n2>dcaMax) { negtrack2=0; continue; }
-	dcan1n2 = negtrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	dcan1n2 = GetPairDCA(negtrack1,iTrkN1,negtrack2,iTrkN2,nSeleTrks);
 	if(dcan1n2>dcaMax) { negtrack2=0; continue; }
 
 	threeTrackArray->AddAt(negtrack1,0);
@@ -3697,6 +3703,37 @@ void AliAnalysisVertexingHF::SetParametersAtVertex(AliESDtrack* esdt, const AliE
   return;
 }
 //-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::ResetPairDCACache(Int_t nSeleTrks){
+  /// Invalidate the pair DCAs of the previous event.
+  /// The cache is only used when 3- or 4-prong candidates are built, since
+  /// only there the same pair enters the loops more than once.
+
+  if(!fCachePairDCA || (!f3Prong && !f4Prong) || nSeleTrks>kMaxTrksPairDCACache) return;
+  Int_t nPairs=nSeleTrks*nSeleTrks;
+  if(fPairDCA.GetSize()<nPairs) fPairDCA.Set(nPairs);
+  Double_t *dca=fPairDCA.GetArray();
+  for(Int_t i=0; i<nPairs; i++) dca[i]=-1.;
+  return;
+}
+//-----------------------------------------------------------------------------
+Double_t AliAnalysisVertexingHF::GetPairDCA(AliESDtrack *trk1,Int_t iTrk1,
+					    AliESDtrack *trk2,Int_t iTrk2,
+					    Int_t nSeleTrks){
+  /// DCA between two selected tracks, trk1->GetDCA(trk2).
+  /// Both tracks must have been set to their parameters at the primary
+  /// vertex (SetParametersAtVertex), which makes the result a function of
+  /// the pair only: it is therefore computed once per event and ordered
+  /// pair of tracks instead of once per triplet/quadruplet.
+
+  Double_t xdummy,ydummy;
+  if(!fCachePairDCA || (!f3Prong && !f4Prong) || nSeleTrks>kMaxTrksPairDCACache) {
+    return trk1->GetDCA(trk2,fBzkG,xdummy,ydummy);
+  }
+  Double_t &dca=fPairDCA[iTrk1*nSeleTrks+iTrk2];
+  if(dca<0.) dca=trk1->GetDCA(trk2,fBzkG,xdummy,ydummy);
+  return dca;
+}
+//-----------------------------------------------------------------------------
 void AliAnalysisVertexingHF::SetMasses(){
   /// Set the hadron mass values from TDatabasePDG
 
@@ -15,6 +15,7 @@
 
 #include <TNamed.h>
 #include <TList.h>
+#include <TArrayD.h>
 
 #include "AliAnalysisFilter.h"
 #include "AliESDtrackCuts.h"
@@ -179,6 +180,8 @@ class AliAnalysisVertexingHF : public TNamed {
   void SetCutsDStartoKpipi(AliRDHFCutsDStartoKpipi* cuts) { fCutsDStartoKpipi = cuts; }
   AliRDHFCutsDStartoKpipi* GetCutsDStartoKpipi() const { return fCutsDStartoKpipi; }
   void SetMassCutBeforeVertexing(Bool_t flag) { fMassCutBeforeVertexing=flag; }
+  void SetCachePairDCA(Bool_t flag=kTRUE) { fCachePairDCA=flag; }
+  Bool_t GetCachePairDCA() const { return fCachePairDCA; }
 
   void SetMasses();
   Bool_t CheckCutsConsistency();
@@ -247,6 +250,7 @@ class AliAnalysisVertexingHF : public TNamed {
  private:
   //
   enum { kBitDispl = 0, kBitSoftPi = 1, kBit3Prong = 2, kBitPionCompat = 3, kBitKaonCompat = 4, kBitProtonCompat = 5, kBitBachelor = 6};
+  enum { kMaxTrksPairDCACache = 3000 }; /// above this number of selected tracks the pair DCAs are not cached
 
   Bool_t fInputAOD; /// input from AOD (kTRUE) or ESD (kFALSE)
   Int_t fAODMapSize; /// size of fAODMap
@@ -348,6 +352,9 @@ class AliAnalysisVertexingHF : public TNamed {
   Double_t fMassDstar;
   Double_t fMassJpsi;
 
+  Bool_t fCachePairDCA; /// compute the DCA of each ordered pair of selected tracks only once per event
+  TArrayD fPairDCA;     //! per-event DCA cache, index iTrk1*nSeleTrks+iTrk2 (<0: not yet computed)
+
 
   //
   void AddRefs(AliAODVertex *v,AliAODRecoDecayHF *rd,const AliVEvent *event,
@@ -411,6 +418,8 @@ class AliAnalysisVertexingHF : public TNamed {
 				   Int_t &nSeleTrks,
 				   UChar_t *seleFlags,Int_t *evtNumber);
   void SetParametersAtVertex(AliESDtrack* esdt, const AliExternalTrackParam* extpar) const;
+  void ResetPairDCACache(Int_t nSeleTrks);
+  Double_t GetPairDCA(AliESDtrack *trk1,Int_t iTrk1,AliESDtrack *trk2,Int_t iTrk2,Int_t nSeleTrks);
 
   Bool_t SingleTrkCuts(AliESDtrack *trk,Float_t centralityperc, Bool_t &okDisplaced,Bool_t &okSoftPi, Bool_t &ok3prong, Bool_t &okBachelor) const;
 
@@ -420,7 +429,7 @@ class AliAnalysisVertexingHF : public TNamed {
 				  TObjArray *twoTrackArrayV0);
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisVertexingHF,27);  // Reconstruction of HF decay candidates
+  ClassDef(AliAnalysisVertexingHF,28);  // Reconstruction of HF decay candidates
   /// \endcond
 };
 
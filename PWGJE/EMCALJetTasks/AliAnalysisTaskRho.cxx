@@ -15,6 +15,7 @@
 #include "AliEmcalJet.h"
 #include "AliLog.h"
 #include "AliRhoParameter.h"
+#include "AliRhoEstimator.h"
 
 ClassImp(AliAnalysisTaskRho)
 
@@ -49,63 +50,28 @@ Bool_t AliAnalysisTaskRho::Run()
 
   const Int_t Njets   = fJets->GetEntries();
 
-  Int_t maxJetIds[]   = {-1, -1};
-  Float_t maxJetPts[] = { 0,  0};
+  AliRhoEstimator *rhoEst = GetRhoEstimator();
 
-  if (fNExclLeadJets > 0) {
-    for (Int_t ij = 0; ij < Njets; ++ij) {
-      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ij));
+  // single pass over the jets, unless another rho task already did it for this event
+  if (!IsRhoEstimatorCurrent()) {
+    rhoEst->Reset(Njets, InputEvent(), Entry());
+
+    for (Int_t iJets = 0; iJets < Njets; ++iJets) {
+      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
       if (!jet) {
-	AliError(Form("%s: Could not receive jet %d", GetName(), ij));
+	AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
 	continue;
       } 
 
-      if (!AcceptJet(jet))
-        continue;
-
-      if (jet->Pt() > maxJetPts[0]) {
-	maxJetPts[1] = maxJetPts[0];
-	maxJetIds[1] = maxJetIds[0];
-	maxJetPts[0] = jet->Pt();
-	maxJetIds[0] = ij;
-      } else if (jet->Pt() > maxJetPts[1]) {
-	maxJetPts[1] = jet->Pt();
-	maxJetIds[1] = ij;
-      }
-    }
-    if (fNExclLeadJets < 2) {
-      maxJetIds[1] = -1;
-      maxJetPts[1] = 0;
+      rhoEst->SetJet(iJets, jet->Pt(), jet->Area(), AcceptJet(jet) ? AliRhoEstimator::kAccepted : 0);
     }
-  }
-
-  static Double_t rhovec[999];
-  Int_t NjetAcc = 0;
-
-  // push all jets within selected acceptance into stack
-  for (Int_t iJets = 0; iJets < Njets; ++iJets) {
-
-    // exlcuding lead jets
-    if (iJets == maxJetIds[0] || iJets == maxJetIds[1])
-      continue;
-
-    AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
-    if (!jet) {
-      AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
-      continue;
-    } 
 
-    if (!AcceptJet(jet))
-      continue;
-
-    rhovec[NjetAcc] = jet->Pt() / jet->Area();
-    ++NjetAcc;
+    rhoEst->Compute();
   }
 
-
-  if (NjetAcc > 0) {
+  if (rhoEst->GetNJetsUsed() > 0) {
     //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = rhoEst->GetRho();
     fOutRho->SetVal(rho);
 
     if (fOutRhoScaled) {
@@ -116,3 +82,11 @@ Bool_t AliAnalysisTaskRho::Run()
 
   return kTRUE;
 } 
+
+//________________________________________________________________________
+void AliAnalysisTaskRho::InitRhoEstimator(AliRhoEstimator *e)
+{
+  // Configure the median estimator.
+
+  e->SetExcludeLeadJets(fNExclLeadJets);
+}
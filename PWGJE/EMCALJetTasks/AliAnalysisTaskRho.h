@@ -16,6 +16,7 @@ class AliAnalysisTaskRho : public AliAnalysisTaskRhoBase {
 
  protected:
   Bool_t           Run();
+  void             InitRhoEstimator(AliRhoEstimator *e);
 
   UInt_t           fNExclLeadJets;                 // number of leading jets to be excluded from the median calculation
 
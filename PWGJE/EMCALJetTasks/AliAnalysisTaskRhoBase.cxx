@@ -15,7 +15,9 @@
 
 #include "AliLog.h"
 #include "AliRhoParameter.h"
+#include "AliRhoEstimator.h"
 #include "AliEmcalJet.h"
+#include "AliJetContainer.h"
 #include "AliParticleContainer.h"
 #include "AliClusterContainer.h"
 #include "AliVVZERO.h"
@@ -36,10 +38,13 @@ AliAnalysisTaskRhoBase::AliAnalysisTaskRhoBase() :
   fInEventSigmaRho(35.83),
   fAttachToEvent(kTRUE),
   fIsPbPb(kTRUE),
+  fRhoEstimatorName(),
   fOutRho(0),
   fOutRhoScaled(0),
   fCompareRho(0),
   fCompareRhoScaled(0),
+  fRhoEstimator(0),
+  fOwnRhoEstimator(kFALSE),
   fHistJetPtvsCent(0),
   fHistJetAreavsCent(0),
   fHistJetRhovsCent(0),
@@ -81,10 +86,13 @@ AliAnalysisTaskRhoBase::AliAnalysisTaskRhoBase(const char *name, Bool_t histo) :
   fInEventSigmaRho(35.83),
   fAttachToEvent(kTRUE),
   fIsPbPb(kTRUE),
+  fRhoEstimatorName(),
   fOutRho(0),
   fOutRhoScaled(0),
   fCompareRho(0),
   fCompareRhoScaled(0),
+  fRhoEstimator(0),
+  fOwnRhoEstimator(kFALSE),
   fHistJetPtvsCent(0),
   fHistJetAreavsCent(0),
   fHistJetRhovsCent(0),
@@ -115,6 +123,15 @@ AliAnalysisTaskRhoBase::AliAnalysisTaskRhoBase(const char *name, Bool_t histo) :
   SetMakeGeneralHistograms(histo);
 }
 
+//________________________________________________________________________
+AliAnalysisTaskRhoBase::~AliAnalysisTaskRhoBase()
+{
+  // Destructor.
+
+  if (fOwnRhoEstimator)
+    delete fRhoEstimator;
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskRhoBase::UserCreateOutputObjects()
 {
@@ -445,6 +462,42 @@ void AliAnalysisTaskRhoBase::ExecOnce()
   AliAnalysisTaskEmcalJet::ExecOnce();
 }
 
+//________________________________________________________________________
+AliRhoEstimator* AliAnalysisTaskRhoBase::GetRhoEstimator()
+{
+  // Median estimator of the jet collection, created on first use.
+  // If a shared name is set, an estimator with the same settings
+  // already attached to the event by another rho task is reused.
+
+  if (!fRhoEstimator) {
+    AliRhoEstimator *e = new AliRhoEstimator(fRhoEstimatorName, fJets ? fJets->GetName() : "");
+    AliJetContainer *cont = GetJetContainer(0);
+    if (cont)
+      e->SetJetAcceptance(cont->GetJetEtaMin(), cont->GetJetEtaMax(), cont->GetJetPhiMin(), cont->GetJetPhiMax(),
+                          cont->GetJetPtCut(), cont->GetJetPtCutMax(), cont->GetJetAreaCut());
+    InitRhoEstimator(e);
+    fRhoEstimator = AliRhoEstimator::Attach(InputEvent(), e);
+
+    // an estimator which could not be attached stays private to this task
+    fOwnRhoEstimator = (fRhoEstimatorName.IsNull() || !InputEvent() ||
+                        InputEvent()->FindListObject(fRhoEstimatorName) != fRhoEstimator);
+  }
+
+  return fRhoEstimator;
+}
+
+//________________________________________________________________________
+Bool_t AliAnalysisTaskRhoBase::IsRhoEstimatorCurrent()
+{
+  // Whether another rho task already computed the shared estimate for this
+  // event. A private estimator is always recomputed.
+
+  if (!fRhoEstimator || fOwnRhoEstimator)
+    return kFALSE;
+
+  return fRhoEstimator->IsCurrent(InputEvent(), Entry());
+}
+
 //________________________________________________________________________
 Double_t AliAnalysisTaskRhoBase::GetRhoFactor(Double_t cent)
 {
@@ -9,6 +9,7 @@ class TH1F;
 class TH2F;
 class TH3F;
 class AliRhoParameter;
+class AliRhoEstimator;
 
 #include "AliAnalysisTaskEmcalJet.h"
 
@@ -16,7 +17,7 @@ class AliAnalysisTaskRhoBase : public AliAnalysisTaskEmcalJet {
  public:
   AliAnalysisTaskRhoBase();
   AliAnalysisTaskRhoBase(const char *name, Bool_t histo=kFALSE);
-  virtual ~AliAnalysisTaskRhoBase() {}
+  virtual ~AliAnalysisTaskRhoBase();
 
   void                   UserCreateOutputObjects();
 
@@ -30,6 +31,9 @@ class AliAnalysisTaskRhoBase : public AliAnalysisTaskEmcalJet {
   void                   SetInEventSigmaRho(Double_t s)                        { fInEventSigmaRho      = s       ;                   }
   void                   SetAttachToEvent(Bool_t a)                            { fAttachToEvent        = a       ;                   }
   void                   SetSmallSystem(Bool_t setter = kTRUE)                 { fIsPbPb               = !setter ;                   }
+  // Tasks with the same name share one estimate per event. They must use the same jet
+  // container: only its eta, phi, pt and area cuts are checked when attaching.
+  void                   SetSharedRhoEstimatorName(const char *name)           { fRhoEstimatorName     = name    ;                   }
 
   const char*            GetOutRhoName() const                                 { return fOutRhoName.Data()       ;                   }
   const char*            GetOutRhoScaledName() const                           { return fOutRhoScaledName.Data() ;                   }
@@ -41,6 +45,9 @@ class AliAnalysisTaskRhoBase : public AliAnalysisTaskEmcalJet {
 
   virtual Double_t       GetRhoFactor(Double_t cent);
   virtual Double_t       GetScaleFactor(Double_t cent);
+  virtual void           InitRhoEstimator(AliRhoEstimator */*e*/)             {;}
+  AliRhoEstimator       *GetRhoEstimator();
+  Bool_t                 IsRhoEstimatorCurrent();
 
   TString                fOutRhoName;                    // name of output rho object
   TString                fOutRhoScaledName;              // name of output scaled rho object
@@ -51,11 +58,14 @@ class AliAnalysisTaskRhoBase : public AliAnalysisTaskEmcalJet {
   Double_t               fInEventSigmaRho;               // in-event sigma rho
   Bool_t                 fAttachToEvent;                 // whether or not attach rho to the event objects list
   Bool_t                 fIsPbPb;                        // different histogram ranges for pp/pPb and PbPb
+  TString                fRhoEstimatorName;              // name under which the median estimate is shared with other rho tasks (empty: not shared)
   
   AliRhoParameter       *fOutRho;                        //!output rho object
   AliRhoParameter       *fOutRhoScaled;                  //!output scaled rho object
   AliRhoParameter       *fCompareRho;                    //!rho object to compare
   AliRhoParameter       *fCompareRhoScaled;              //!scaled rho object to compare
+  AliRhoEstimator       *fRhoEstimator;                  //!median background estimate of the jet collection
+  Bool_t                 fOwnRhoEstimator;               //!estimator not attached to the event, deleted with the task
 
   TH2F                  *fHistJetPtvsCent;               //!jet pt vs. centrality
   TH2F                  *fHistJetAreavsCent;             //!jet area vs. centrality
@@ -83,6 +93,6 @@ class AliAnalysisTaskRhoBase : public AliAnalysisTaskEmcalJet {
   AliAnalysisTaskRhoBase(const AliAnalysisTaskRhoBase&);             // not implemented
   AliAnalysisTaskRhoBase& operator=(const AliAnalysisTaskRhoBase&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRhoBase, 11); // Rho base task
+  ClassDef(AliAnalysisTaskRhoBase, 13); // Rho base task
 };
 #endif
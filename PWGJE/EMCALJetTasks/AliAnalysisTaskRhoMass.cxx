@@ -15,6 +15,7 @@
 #include "AliEmcalJet.h"
 #include "AliLog.h"
 #include "AliRhoParameter.h"
+#include "AliRhoEstimator.h"
 
 ClassImp(AliAnalysisTaskRhoMass)
 
@@ -71,78 +72,55 @@ Bool_t AliAnalysisTaskRhoMass::Run()
 
   const Int_t Njets   = fJets->GetEntries();
 
-  Int_t maxJetIds[]   = {-1, -1};
-  Float_t maxJetPts[] = { 0,  0};
+  AliRhoEstimator *rhoEst = GetRhoEstimator();
 
-  if (fNExclLeadJets > 0) {
-    for (Int_t ij = 0; ij < Njets; ++ij) {
-      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ij));
+  // single pass over the jets, unless another rho task already did it for this event
+  if (!IsRhoEstimatorCurrent()) {
+    rhoEst->Reset(Njets, InputEvent(), Entry());
+
+    for (Int_t iJets = 0; iJets < Njets; ++iJets) {
+      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
       if (!jet) {
-	AliError(Form("%s: Could not receive jet %d", GetName(), ij));
+	AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
 	continue;
       } 
 
-      if (!AcceptJet(jet))
-        continue;
+      UInt_t flags = 0;
+      Double_t md = 0.;
+      if (AcceptJet(jet)) {
+	flags |= AliRhoEstimator::kAccepted;
 
-      if (jet->Pt() > maxJetPts[0]) {
-	maxJetPts[1] = maxJetPts[0];
-	maxJetIds[1] = maxJetIds[0];
-	maxJetPts[0] = jet->Pt();
-	maxJetIds[0] = ij;
-      } else if (jet->Pt() > maxJetPts[1]) {
-	maxJetPts[1] = jet->Pt();
-	maxJetIds[1] = ij;
+	// m_delta requires a loop over the constituents: only for jets which can enter the median
+	if (jet->Area()>0.)
+	  md = GetMd(jet);
       }
-    }
-    if (fNExclLeadJets < 2) {
-      maxJetIds[1] = -1;
-      maxJetPts[1] = 0;
-    }
-  }
 
-  static Double_t rhomvec[999];
-  static Double_t Evec[999];
-  static Double_t Mvec[999];
-  Int_t NjetAcc = 0;
-
-  // push all jets within selected acceptance into stack
-  for (Int_t iJets = 0; iJets < Njets; ++iJets) {
-
-    // exlcuding lead jets
-    if (iJets == maxJetIds[0] || iJets == maxJetIds[1])
-      continue;
-
-    AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
-    if (!jet) {
-      AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
-      continue;
-    } 
-
-    if (!AcceptJet(jet))
-      continue;
-
-    // Double_t sumM = GetSumMConstituents(jet);
-    // Double_t sumPt = GetSumPtConstituents(jet);
-    if(jet->Area()>0.) {// && (jet->M()*jet->M() + jet->Pt()*jet->Pt())>0.) {
-      //rhomvec[NjetAcc] = (TMath::Sqrt(sumM*sumM + sumPt*sumPt) - sumPt ) / jet->Area();
-      // rhomvec[NjetAcc] = (TMath::Sqrt(jet->M()*jet->M() + jet->Pt()*jet->Pt()) - jet->Pt() ) / jet->Area();
-      rhomvec[NjetAcc] = GetMd(jet) / jet->Area();
-      fHistMdAreavsCent->Fill(fCent,rhomvec[NjetAcc]);
-      Evec[NjetAcc] = jet->E();
-      Mvec[NjetAcc] = jet->M();
-      ++NjetAcc;
+      rhoEst->SetJet(iJets, jet->Pt(), jet->Area(), flags, md);
     }
+
+    rhoEst->Compute();
   }
 
+  const Int_t NjetAcc = rhoEst->GetNJetsUsed();
+
   if (NjetAcc > 0) {
     //find median value
-    Double_t rhom = TMath::Median(NjetAcc, rhomvec);
+    Double_t rhom = rhoEst->GetRhoM();
     fOutRhoMass->SetVal(rhom);
 
     Int_t Ntracks = fTracks->GetEntries();
-    Double_t meanM = TMath::Mean(NjetAcc, Mvec);
-    Double_t meanE = TMath::Mean(NjetAcc, Evec);
+    Double_t sumM = 0.;
+    Double_t sumE = 0.;
+    for (Int_t iJets = 0; iJets < Njets; ++iJets) {
+      if (!rhoEst->IsJetUsed(iJets))
+        continue;
+      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
+      fHistMdAreavsCent->Fill(fCent,rhoEst->GetJetMd(iJets) / rhoEst->GetJetArea(iJets));
+      sumE += jet->E();
+      sumM += jet->M();
+    }
+    Double_t meanM = sumM/NjetAcc;
+    Double_t meanE = sumE/NjetAcc;
     Double_t gamma = 0.;
     if(meanM>0.) gamma = meanE/meanM;
     fHistGammaVsNtrack->Fill(Ntracks,gamma);
@@ -156,6 +134,16 @@ Bool_t AliAnalysisTaskRhoMass::Run()
   return kTRUE;
 } 
 
+//________________________________________________________________________
+void AliAnalysisTaskRhoMass::InitRhoEstimator(AliRhoEstimator *e)
+{
+  // Configure the median estimator: rho_m from m_delta, jets with positive area only.
+
+  e->SetExcludeLeadJets(fNExclLeadJets);
+  e->SetRequirePositiveArea(kTRUE);
+  e->SetComputeRhoM(kTRUE);
+}
+
 //________________________________________________________________________
 Double_t AliAnalysisTaskRhoMass::GetSumMConstituents(AliEmcalJet *jet) {
   
@@ -26,6 +26,7 @@ class AliAnalysisTaskRhoMass : public AliAnalysisTaskRhoMassBase {
 
  protected:
   Bool_t           Run();
+  void             InitRhoEstimator(AliRhoEstimator *e);
 
   Double_t         GetSumMConstituents(AliEmcalJet *jet);
   Double_t         GetSumPtConstituents(AliEmcalJet *jet);
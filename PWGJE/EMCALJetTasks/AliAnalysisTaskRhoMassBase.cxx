@@ -12,7 +12,9 @@
 
 #include "AliLog.h"
 #include "AliRhoParameter.h"
+#include "AliRhoEstimator.h"
 #include "AliEmcalJet.h"
+#include "AliJetContainer.h"
 #include "AliParticleContainer.h"
 #include "AliClusterContainer.h"
 
@@ -30,10 +32,13 @@ AliAnalysisTaskRhoMassBase::AliAnalysisTaskRhoMassBase() :
   fRhoMassFunction(0),
   fScaleFunction(0),
   fAttachToEvent(kTRUE),
+  fRhoEstimatorName(),
   fOutRhoMass(0),
   fOutRhoMassScaled(0),
   fCompareRhoMass(0),
   fCompareRhoMassScaled(0),
+  fRhoEstimator(0),
+  fOwnRhoEstimator(kFALSE),
   fHistJetMassvsCent(0),
   fHistRhoMassvsCent(0),
   fHistRhoMassScaledvsCent(0),
@@ -60,10 +65,13 @@ AliAnalysisTaskRhoMassBase::AliAnalysisTaskRhoMassBase(const char *name, Bool_t
   fRhoMassFunction(0),
   fScaleFunction(0),
   fAttachToEvent(kTRUE),
+  fRhoEstimatorName(),
   fOutRhoMass(0),
   fOutRhoMassScaled(0),
   fCompareRhoMass(0),
   fCompareRhoMassScaled(0),
+  fRhoEstimator(0),
+  fOwnRhoEstimator(kFALSE),
   fHistJetMassvsCent(0),
   fHistRhoMassvsCent(0),
   fHistRhoMassScaledvsCent(0),
@@ -82,6 +90,15 @@ AliAnalysisTaskRhoMassBase::AliAnalysisTaskRhoMassBase(const char *name, Bool_t
   SetMakeGeneralHistograms(histo);
 }
 
+//________________________________________________________________________
+AliAnalysisTaskRhoMassBase::~AliAnalysisTaskRhoMassBase()
+{
+  // Destructor.
+
+  if (fOwnRhoEstimator)
+    delete fRhoEstimator;
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskRhoMassBase::UserCreateOutputObjects()
 {
@@ -323,6 +340,42 @@ void AliAnalysisTaskRhoMassBase::ExecOnce()
   AliAnalysisTaskEmcalJet::ExecOnce();
 }
 
+//________________________________________________________________________
+AliRhoEstimator* AliAnalysisTaskRhoMassBase::GetRhoEstimator()
+{
+  // Median estimator of the jet collection, created on first use.
+  // If a shared name is set, an estimator with the same settings
+  // already attached to the event by another rho task is reused.
+
+  if (!fRhoEstimator) {
+    AliRhoEstimator *e = new AliRhoEstimator(fRhoEstimatorName, fJets ? fJets->GetName() : "");
+    AliJetContainer *cont = GetJetContainer(0);
+    if (cont)
+      e->SetJetAcceptance(cont->GetJetEtaMin(), cont->GetJetEtaMax(), cont->GetJetPhiMin(), cont->GetJetPhiMax(),
+                          cont->GetJetPtCut(), cont->GetJetPtCutMax(), cont->GetJetAreaCut());
+    InitRhoEstimator(e);
+    fRhoEstimator = AliRhoEstimator::Attach(InputEvent(), e);
+
+    // an estimator which could not be attached stays private to this task
+    fOwnRhoEstimator = (fRhoEstimatorName.IsNull() || !InputEvent() ||
+                        InputEvent()->FindListObject(fRhoEstimatorName) != fRhoEstimator);
+  }
+
+  return fRhoEstimator;
+}
+
+//________________________________________________________________________
+Bool_t AliAnalysisTaskRhoMassBase::IsRhoEstimatorCurrent()
+{
+  // Whether another rho task already computed the shared estimate for this
+  // event. A private estimator is always recomputed.
+
+  if (!fRhoEstimator || fOwnRhoEstimator)
+    return kFALSE;
+
+  return fRhoEstimator->IsCurrent(InputEvent(), Entry());
+}
+
 //________________________________________________________________________
 Double_t AliAnalysisTaskRhoMassBase::GetRhoMassFactor(Double_t cent)
 {
@@ -8,6 +8,7 @@ class TF1;
 class TH1F;
 class TH2F;
 class AliRhoParameter;
+class AliRhoEstimator;
 
 #include "AliAnalysisTaskEmcalJet.h"
 
@@ -15,7 +16,7 @@ class AliAnalysisTaskRhoMassBase : public AliAnalysisTaskEmcalJet {
  public:
   AliAnalysisTaskRhoMassBase();
   AliAnalysisTaskRhoMassBase(const char *name, Bool_t histo=kFALSE);
-  virtual ~AliAnalysisTaskRhoMassBase() {}
+  virtual ~AliAnalysisTaskRhoMassBase();
 
   void                   UserCreateOutputObjects();
 
@@ -27,6 +28,9 @@ class AliAnalysisTaskRhoMassBase : public AliAnalysisTaskEmcalJet {
   void                   SetRhoMassFunction(TF1* rf)                           { fRhoMassFunction      = rf   ;                       }
   void                   SetAttachToEvent(Bool_t a)                            { fAttachToEvent        = a    ;                       }
   void                   SetSmallSystem(Bool_t setter = kTRUE)                 {fIsPbPb = !setter; }
+  // Tasks with the same name share one estimate per event. They must use the same jet
+  // container: only its eta, phi, pt and area cuts are checked when attaching.
+  void                   SetSharedRhoEstimatorName(const char *name)           { fRhoEstimatorName     = name ;                       }
 
 
   const TString&         GetOutRhoMassName() const                             { return fOutRhoMassName;                              }
@@ -39,6 +43,9 @@ class AliAnalysisTaskRhoMassBase : public AliAnalysisTaskEmcalJet {
 
   virtual Double_t       GetRhoMassFactor(Double_t cent);
   virtual Double_t       GetScaleFactor(Double_t cent);
+  virtual void           InitRhoEstimator(AliRhoEstimator */*e*/)             {;}
+  AliRhoEstimator       *GetRhoEstimator();
+  Bool_t                 IsRhoEstimatorCurrent();
 
   TString                fOutRhoMassName;                // name of output rho mass object
   TString                fOutRhoMassScaledName;          // name of output scaled rho mass object
@@ -48,11 +55,14 @@ class AliAnalysisTaskRhoMassBase : public AliAnalysisTaskEmcalJet {
   TF1                   *fScaleFunction;                 // pre-computed scale factor as a function of centrality
   Bool_t                 fAttachToEvent;                 // whether or not attach rho mass to the event objects list
   Bool_t                 fIsPbPb;                        // different histogram ranges for pp/pPb and PbPb
+  TString                fRhoEstimatorName;              // name under which the median estimate is shared with other rho tasks (empty: not shared)
   
   AliRhoParameter       *fOutRhoMass;                    //!output rho object
   AliRhoParameter       *fOutRhoMassScaled;              //!output scaled rho object
   AliRhoParameter       *fCompareRhoMass;                //!rho object to compare
   AliRhoParameter       *fCompareRhoMassScaled;          //!scaled rho object to compare
+  AliRhoEstimator       *fRhoEstimator;                  //!median background estimate of the jet collection
+  Bool_t                 fOwnRhoEstimator;               //!estimator not attached to the event, deleted with the task
 
   TH2F                  *fHistJetMassvsCent;             //!jet mass vs. centrality
   TH2F                  *fHistRhoMassvsCent;             //!rho mass vs. centrality
@@ -73,6 +83,6 @@ class AliAnalysisTaskRhoMassBase : public AliAnalysisTaskEmcalJet {
   AliAnalysisTaskRhoMassBase(const AliAnalysisTaskRhoMassBase&);             // not implemented
   AliAnalysisTaskRhoMassBase& operator=(const AliAnalysisTaskRhoMassBase&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRhoMassBase, 2); // Rho mass base task
+  ClassDef(AliAnalysisTaskRhoMassBase, 4); // Rho mass base task
 };
 #endif
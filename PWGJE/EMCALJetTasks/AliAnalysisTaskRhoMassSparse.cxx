@@ -15,6 +15,7 @@
 #include "AliEmcalJet.h"
 #include "AliLog.h"
 #include "AliRhoParameter.h"
+#include "AliRhoEstimator.h"
 #include "AliJetContainer.h"
 
 ClassImp(AliAnalysisTaskRhoMassSparse)
@@ -101,117 +102,69 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
     return kFALSE;
 
   const Int_t Njets   = fJets->GetEntries();
-  
+
   AliJetContainer *sigjets = static_cast<AliJetContainer*>(fJetCollArray.At(1));
   
   Int_t NjetsSig = 0;
   if (sigjets) NjetsSig = sigjets->GetNJets();
 
-  Int_t maxJetIds[]   = {-1, -1};
-  Float_t maxJetPts[] = { 0,  0};
+  AliRhoEstimator *rhoEst = GetRhoEstimator();
 
-  if (fNExclLeadJets > 0) {
-    for (Int_t ij = 0; ij < Njets; ++ij) {
-      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ij));
+  // single pass over the jets, unless another rho task already did it for this event
+  if (!IsRhoEstimatorCurrent()) {
+    rhoEst->Reset(Njets, InputEvent(), Entry());
+
+    for (Int_t iJets = 0; iJets < Njets; ++iJets) {
+      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
       if (!jet) {
-	AliError(Form("%s: Could not receive jet %d", GetName(), ij));
+	AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
 	continue;
       } 
 
-      if (!AcceptJet(jet))
-        continue;
-
-      if (jet->Pt() > maxJetPts[0]) {
-	maxJetPts[1] = maxJetPts[0];
-	maxJetIds[1] = maxJetIds[0];
-	maxJetPts[0] = jet->Pt();
-	maxJetIds[0] = ij;
-      } else if (jet->Pt() > maxJetPts[1]) {
-	maxJetPts[1] = jet->Pt();
-	maxJetIds[1] = ij;
-      }
-    }
-    if (fNExclLeadJets < 2) {
-      maxJetIds[1] = -1;
-      maxJetPts[1] = 0;
-    }
-  }
-
-  static Double_t rhomvec[999];
-  static Double_t Evec[999];
-  static Double_t Mvec[999];
-  Int_t NjetAcc = 0;
-  Double_t TotaljetArea=0;
-  Double_t TotaljetAreaPhys=0;
-
-  // push all jets within selected acceptance into stack
-  for (Int_t iJets = 0; iJets < Njets; ++iJets) {
-
-    // exlcuding lead jets
-    if (iJets == maxJetIds[0] || iJets == maxJetIds[1])
-      continue;
-
-    AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
-    if (!jet) {
-      AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
-      continue;
-    } 
-
-    TotaljetArea+=jet->Area();
-
-    if(jet->Pt()>0.1){
-      TotaljetAreaPhys+=jet->Area();
-    }
+      UInt_t flags = 0;
+      Double_t md = 0.;
+      if (AcceptJet(jet)) {
+	flags |= AliRhoEstimator::kAccepted;
 
-    if (!AcceptJet(jet))
-      continue;
-
-      // Search for overlap with signal jets
-    Bool_t isOverlapping = kFALSE;
-    if (sigjets) {
-      for(Int_t j=0;j<NjetsSig;j++)
-	{
-	  AliEmcalJet* signalJet = sigjets->GetAcceptJet(j);
-	  if(!signalJet)
-	    continue;
-	  if(!IsJetSignal(signalJet))     
-	    continue;
-	  
-	  if(IsJetOverlapping(signalJet, jet))
+	// Search for overlap with signal jets
+	if (sigjets) {
+	  for(Int_t j=0;j<NjetsSig;j++)
 	    {
-	      isOverlapping = kTRUE;
-	      break;
+	      AliEmcalJet* signalJet = sigjets->GetAcceptJet(j);
+	      if(!signalJet)
+		continue;
+	      if(!IsJetSignal(signalJet))     
+		continue;
+	  
+	      if(IsJetOverlapping(signalJet, jet))
+		{
+		  flags |= AliRhoEstimator::kSignalOverlap;
+		  break;
+		}
 	    }
 	}
-    }
-
-    if(isOverlapping) 
-      continue;
 
-    // Double_t sumM = GetSumMConstituents(jet);
-    // Double_t sumPt = GetSumPtConstituents(jet);
+	// m_delta requires a loop over the constituents: only for jets which can enter the median
+	if (!(flags & AliRhoEstimator::kSignalOverlap) && jet->Area()>0.)
+	  md = GetMd(jet);
+      }
 
-    if(jet->Area()>0.) {// && (jet->M()*jet->M() + jet->Pt()*jet->Pt())>0.) {
-       //rhomvec[NjetAcc] = (TMath::Sqrt(sumM*sumM + sumPt*sumPt) - sumPt ) / jet->Area();
-      // rhomvec[NjetAcc] = (TMath::Sqrt(jet->M()*jet->M() + jet->Pt()*jet->Pt()) - jet->Pt() ) / jet->Area();
-      rhomvec[NjetAcc] = GetMd(jet) / jet->Area();
-      fHistMdAreavsCent->Fill(fCent,rhomvec[NjetAcc]);
-      Evec[NjetAcc] = jet->E();
-      Mvec[NjetAcc] = jet->M();
-      ++NjetAcc;
+      rhoEst->SetJet(iJets, jet->Pt(), jet->Area(), flags, md);
     }
+
+    rhoEst->Compute();
   }
 
-  Double_t OccCorr=0.0;
-  if(TotaljetArea>0) OccCorr=TotaljetAreaPhys/TotaljetArea;
+  Double_t OccCorr = rhoEst->GetOccupancy();
  
   if (fCreateHisto)
     fHistOccCorrvsCent->Fill(fCent, OccCorr);
 
+  const Int_t NjetAcc = rhoEst->GetNJetsUsed();
 
   if (NjetAcc > 0) {
     //find median value
-    Double_t rhom = TMath::Median(NjetAcc, rhomvec);
+    Double_t rhom = rhoEst->GetRhoM();
     if(fRhoCMS){
       rhom = rhom * OccCorr;
     }
@@ -219,8 +172,18 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
     fOutRhoMass->SetVal(rhom);
 
     Int_t Ntracks = fTracks->GetEntries();
-    Double_t meanM = TMath::Mean(NjetAcc, Mvec);
-    Double_t meanE = TMath::Mean(NjetAcc, Evec);
+    Double_t sumM = 0.;
+    Double_t sumE = 0.;
+    for (Int_t iJets = 0; iJets < Njets; ++iJets) {
+      if (!rhoEst->IsJetUsed(iJets))
+        continue;
+      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
+      fHistMdAreavsCent->Fill(fCent,rhoEst->GetJetMd(iJets) / rhoEst->GetJetArea(iJets));
+      sumE += jet->E();
+      sumM += jet->M();
+    }
+    Double_t meanM = sumM/NjetAcc;
+    Double_t meanE = sumE/NjetAcc;
     Double_t gamma = 0.;
     if(meanM>0.) gamma = meanE/meanM;
     fHistGammaVsNtrack->Fill(Ntracks,gamma);
@@ -234,6 +197,19 @@ Bool_t AliAnalysisTaskRhoMassSparse::Run()
   return kTRUE;
 } 
 
+//________________________________________________________________________
+void AliAnalysisTaskRhoMassSparse::InitRhoEstimator(AliRhoEstimator *e)
+{
+  // Configure the median estimator: rho_m from m_delta, jets with positive area only.
+
+  AliJetContainer *sigjets = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  e->SetExcludeLeadJets(fNExclLeadJets);
+  e->SetRequirePositiveArea(kTRUE);
+  e->SetComputeRhoM(kTRUE);
+  if (sigjets) e->SetSignalJetsName(sigjets->GetArrayName());
+}
+
 //________________________________________________________________________
 Double_t AliAnalysisTaskRhoMassSparse::GetSumMConstituents(AliEmcalJet *jet) {
   
@@ -30,6 +30,7 @@ class AliAnalysisTaskRhoMassSparse : public AliAnalysisTaskRhoMassBase {
 
  protected:
   Bool_t           Run();
+  void             InitRhoEstimator(AliRhoEstimator *e);
 
   Double_t         GetSumMConstituents(AliEmcalJet *jet);
   Double_t         GetSumPtConstituents(AliEmcalJet *jet);
@@ -15,6 +15,7 @@
 #include "AliEmcalJet.h"
 #include "AliLog.h"
 #include "AliRhoParameter.h"
+#include "AliRhoEstimator.h"
 #include "AliJetContainer.h"
 
 ClassImp(AliAnalysisTaskRhoSparse)
@@ -96,100 +97,56 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
   Int_t NjetsSig = 0;
   if (sigjets) NjetsSig = sigjets->GetNJets();
 
-  Int_t maxJetIds[]   = {-1, -1};
-  Float_t maxJetPts[] = { 0,  0};
+  AliRhoEstimator *rhoEst = GetRhoEstimator();
 
-  if (fNExclLeadJets > 0) {
-    for (Int_t ij = 0; ij < Njets; ++ij) {
-      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ij));
+  // single pass over the jets, unless another rho task already did it for this event
+  if (!IsRhoEstimatorCurrent()) {
+    rhoEst->Reset(Njets, InputEvent(), Entry());
+
+    for (Int_t iJets = 0; iJets < Njets; ++iJets) {
+      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
       if (!jet) {
-	AliError(Form("%s: Could not receive jet %d", GetName(), ij));
+	AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
 	continue;
       } 
 
-      if (!AcceptJet(jet))
-        continue;
-
-      if (jet->Pt() > maxJetPts[0]) {
-	maxJetPts[1] = maxJetPts[0];
-	maxJetIds[1] = maxJetIds[0];
-	maxJetPts[0] = jet->Pt();
-	maxJetIds[0] = ij;
-      } else if (jet->Pt() > maxJetPts[1]) {
-	maxJetPts[1] = jet->Pt();
-	maxJetIds[1] = ij;
-      }
-    }
-    if (fNExclLeadJets < 2) {
-      maxJetIds[1] = -1;
-      maxJetPts[1] = 0;
-    }
-  }
-
-  static Double_t rhovec[999];
-  Int_t NjetAcc = 0;
-  Double_t TotaljetArea=0;
-  Double_t TotaljetAreaPhys=0;
+      UInt_t flags = 0;
+      if (AcceptJet(jet)) {
+	flags |= AliRhoEstimator::kAccepted;
 
-  // push all jets within selected acceptance into stack
-  for (Int_t iJets = 0; iJets < Njets; ++iJets) {
-
-    // exlcuding lead jets
-    if (iJets == maxJetIds[0] || iJets == maxJetIds[1])
-      continue;
-
-    AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
-    if (!jet) {
-      AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
-      continue;
-    } 
-
-    TotaljetArea+=jet->Area();
-    
-    if(jet->Pt()>0.1){
-      TotaljetAreaPhys+=jet->Area();
-    }
-
-    if (!AcceptJet(jet))
-      continue;
-
-   // Search for overlap with signal jets
-    Bool_t isOverlapping = kFALSE;
-    if (sigjets) {
-      for(Int_t j=0;j<NjetsSig;j++)
-	{
-	  AliEmcalJet* signalJet = sigjets->GetAcceptJet(j);
-	  if(!signalJet)
-	    continue;
-	  if(!IsJetSignal(signalJet))     
-	    continue;
-	  
-	  if(IsJetOverlapping(signalJet, jet))
+	// Search for overlap with signal jets
+	if (sigjets) {
+	  for(Int_t j=0;j<NjetsSig;j++)
 	    {
-	      isOverlapping = kTRUE;
-	      break;
+	      AliEmcalJet* signalJet = sigjets->GetAcceptJet(j);
+	      if(!signalJet)
+		continue;
+	      if(!IsJetSignal(signalJet))     
+		continue;
+	  
+	      if(IsJetOverlapping(signalJet, jet))
+		{
+		  flags |= AliRhoEstimator::kSignalOverlap;
+		  break;
+		}
 	    }
 	}
-    }
-
-    if(isOverlapping) 
-      continue;
+      }
 
-    if(jet->Pt()>0.1){
-      rhovec[NjetAcc] = jet->Pt() / jet->Area();
-      ++NjetAcc;
+      rhoEst->SetJet(iJets, jet->Pt(), jet->Area(), flags);
     }
+
+    rhoEst->Compute();
   }
 
-  Double_t OccCorr=0.0;
-  if(TotaljetArea>0) OccCorr=TotaljetAreaPhys/TotaljetArea;
+  Double_t OccCorr = rhoEst->GetOccupancy();
  
   if (fCreateHisto)
     fHistOccCorrvsCent->Fill(fCent, OccCorr);
 
-  if (NjetAcc > 0) {
+  if (rhoEst->GetNJetsUsed() > 0) {
     //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = rhoEst->GetRho();
 
     if(fRhoCMS){
       rho = rho * OccCorr;
@@ -205,3 +162,16 @@ Bool_t AliAnalysisTaskRhoSparse::Run()
 
   return kTRUE;
 } 
+
+//________________________________________________________________________
+void AliAnalysisTaskRhoSparse::InitRhoEstimator(AliRhoEstimator *e)
+{
+  // Configure the median estimator: only jets above 0.1 GeV/c and not
+  // overlapping with signal jets enter the median.
+
+  AliJetContainer *sigjets = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  e->SetExcludeLeadJets(fNExclLeadJets);
+  e->SetMinPtForRho(0.1);
+  if (sigjets) e->SetSignalJetsName(sigjets->GetArrayName());
+}
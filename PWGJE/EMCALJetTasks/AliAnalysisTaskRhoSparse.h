@@ -20,6 +20,7 @@ class AliAnalysisTaskRhoSparse : public AliAnalysisTaskRhoBase {
 
  protected:
   Bool_t           Run();
+  void             InitRhoEstimator(AliRhoEstimator *e);
 
   UInt_t           fNExclLeadJets;                 // number of leading jets to be excluded from the median calculation
   Bool_t           fRhoCMS;                        // flag to run CMS method
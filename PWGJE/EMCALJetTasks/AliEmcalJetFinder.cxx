@@ -147,11 +147,11 @@ Bool_t AliEmcalJetFinder::Filter(AliEmcalJet *pJet, AliJetContainer *pContJets,
 //=============================================================================
 
   if (pJet->HasGhost()) {
-    const std::vector<TLorentzVector> aGhosts = pJet->GetGhosts();
-    for (UInt_t i=0; i<aGhosts.size(); i++) AddInputGhost(aGhosts[i].Px(),
-                                                          aGhosts[i].Py(),
-                                                          aGhosts[i].Pz(),
-                                                          aGhosts[i].E());
+    TLorentzVector vGhost;
+    for (Int_t i=0; i<pJet->GetNumberOfGhosts(); i++) {
+      pJet->GetGhost(i, vGhost);
+      AddInputGhost(vGhost.Px(), vGhost.Py(), vGhost.Pz(), vGhost.E());
+    }
   }
 //=============================================================================
 
@@ -315,11 +315,11 @@ Double_t AliEmcalJetFinder::Nsubjettiness(AliEmcalJet *pJet, AliJetContainer *pC
 //=============================================================================
 
   if (pJet->HasGhost()) {
-    const std::vector<TLorentzVector> aGhosts = pJet->GetGhosts();
-    for (UInt_t i=0; i<aGhosts.size(); i++) AddInputGhost(aGhosts[i].Px(),
-                                                          aGhosts[i].Py(),
-                                                          aGhosts[i].Pz(),
-                                                          aGhosts[i].E());
+    TLorentzVector vGhost;
+    for (Int_t i=0; i<pJet->GetNumberOfGhosts(); i++) {
+      pJet->GetGhost(i, vGhost);
+      AddInputGhost(vGhost.Px(), vGhost.Py(), vGhost.Pz(), vGhost.E());
+    }
   }
   //these are all for the jet not subjets
   fFastjetWrapper->SetR(fRadius);
@@ -0,0 +1,474 @@
+// $Id$
+//
+// Matching of two jet collections (e.g. detector and particle level).
+// The jets are set once per event with Reset(), SetJet1() and SetJet2(),
+// then the candidate pairs with their distances d1 (seen from jet 1) and
+// d2 (seen from jet 2) are collected and Assign() selects the matches.
+//
+// Candidate pairs:
+// - FindGeometricalPairs() looks up the jets 2 around each jet 1 in an
+//   eta-phi grid and computes the Delta R to all the candidates in one
+//   loop, keeping the pairs within the maximum distance. The distance is
+//   the same as AliEmcalJet::DeltaR().
+// - Any other definition of the distance is added with AddPair(). For the
+//   shared momentum fractions, the constituents of all the jets 2 are
+//   indexed once per event by their id (e.g. the index of the MC particle)
+//   with AddJet2Constituent() and BuildConstituentIndex(); the constituents
+//   of a jet 1 are then looked up with AddSharedConstituent(), after which
+//   SubtractSharedPt() removes the shared pt from the jet pts for a given
+//   jet 2, without comparing the constituent lists of each pair.
+//   The shared pt is subtracted constituent by constituent of the jet 2,
+//   i.e. in the same order as the nested loops over the two constituent
+//   lists, and each jet 2 constituent is subtracted once with the weight
+//   of the first jet 1 constituent that shares it.
+//
+// The pairs must be added jet 1 by jet 1 with increasing jet index. Pairs
+// with a negative distance are never matched.
+//
+// Assignments:
+// - kClosestMutual: a jet 1 and a jet 2 are matched if each one is the
+//   closest of the other (first one for equal distances) and if their
+//   distances are within the maximum distances.
+// - kHungarian: among the pairs within the maximum distances, the largest
+//   number of matches with the minimum sum d1 + d2 (Hungarian algorithm).
+// - kGreedy: the pairs within the maximum distances are taken in order of
+//   increasing d1 + d2 if none of the two jets is already matched; with
+//   the shared momentum fractions this matches the jets with the largest
+//   shared pt first.
+
+#include <algorithm>
+
+#include <TMath.h>
+
+#include "AliJetMatchingEngine.h"
+
+ClassImp(AliJetMatchingEngine)
+
+//________________________________________________________________________
+AliJetMatchingEngine::AliJetMatchingEngine() :
+  TObject(),
+  fAssignment(kClosestMutual),
+  fGrid(),
+  fEta1(),
+  fPhi1(),
+  fUse1(),
+  fEta2(),
+  fPhi2(),
+  fCandidates(),
+  fCandDEta(),
+  fCandDPhi(),
+  fCandDist(),
+  fPairJet1(),
+  fPairJet2(),
+  fPairDist1(),
+  fPairDist2(),
+  fMatch1(),
+  fMatch2(),
+  fConstJet(),
+  fConstPos(),
+  fConstPt(),
+  fIndexIds(),
+  fIndexConst(),
+  fSharedConst(),
+  fSharedPt1(),
+  fSharedW2(),
+  fSharedOrder()
+{
+  // Constructor.
+}
+
+//________________________________________________________________________
+void AliJetMatchingEngine::Reset(Int_t n1, Int_t n2)
+{
+  // Set the number of jets of the event and remove the pairs and the
+  // constituent index of the previous event.
+
+  if (n1 < 0) n1 = 0;
+  if (n2 < 0) n2 = 0;
+
+  fEta1.assign(n1, 0.);
+  fPhi1.assign(n1, 0.);
+  fUse1.assign(n1, kFALSE);
+  fEta2.assign(n2, 0.);
+  fPhi2.assign(n2, 0.);
+
+  fPairJet1.clear();
+  fPairJet2.clear();
+  fPairDist1.clear();
+  fPairDist2.clear();
+  fMatch1.assign(n1, -1);
+  fMatch2.assign(n2, -1);
+
+  fConstJet.clear();
+  fConstPos.clear();
+  fConstPt.clear();
+  fIndexIds.clear();
+  fIndexConst.clear();
+  ResetSharedConstituents();
+}
+
+//________________________________________________________________________
+void AliJetMatchingEngine::SetJet1(Int_t i, Double_t eta, Double_t phi, Bool_t use)
+{
+  // Set the position of jet 1 i; jets with use = kFALSE are not matched
+  // by FindGeometricalPairs().
+
+  fEta1[i] = eta;
+  fPhi1[i] = phi;
+  fUse1[i] = use;
+}
+
+//________________________________________________________________________
+void AliJetMatchingEngine::SetJet2(Int_t i, Double_t eta, Double_t phi)
+{
+  // Set the position of jet 2 i.
+
+  fEta2[i] = eta;
+  fPhi2[i] = phi;
+}
+
+//________________________________________________________________________
+Int_t AliJetMatchingEngine::FindGeometricalPairs(Double_t maxDist)
+{
+  // Add the pairs with Delta R <= maxDist (d1 = d2 = Delta R).
+  // Returns the number of pairs added.
+
+  const Int_t n1 = GetNJets1();
+  const Int_t n2 = GetNJets2();
+  const Int_t nPairs = GetNPairs();
+
+  fGrid.Reset(maxDist);
+  for (Int_t i2 = 0; i2 < n2; i2++) fGrid.Add(i2, fEta2[i2], fPhi2[i2]);
+  fGrid.Build();
+
+  for (Int_t i1 = 0; i1 < n1; i1++) {
+    if (!fUse1[i1]) continue;
+
+    const Int_t nCand = fGrid.GetCandidates(fEta1[i1], fPhi1[i1], fCandidates);
+    fCandDEta.resize(nCand);
+    fCandDPhi.resize(nCand);
+    fCandDist.resize(nCand);
+    for (Int_t k = 0; k < nCand; k++) {
+      fCandDEta[k] = fEta1[i1] - fEta2[fCandidates[k]];
+      fCandDPhi[k] = fPhi1[i1] - fPhi2[fCandidates[k]];
+    }
+
+    // branch-free loop over the candidates; for |dphi| < 3 pi (always the
+    // case with phi in [0, 2 pi)) the same as TVector2::Phi_mpi_pi()
+    Double_t *deta = fCandDEta.data();
+    Double_t *dphi = fCandDPhi.data();
+    Double_t *dist = fCandDist.data();
+    for (Int_t k = 0; k < nCand; k++) {
+      const Double_t p = dphi[k] - TMath::TwoPi() * ((dphi[k] >= TMath::Pi()) - (dphi[k] < -TMath::Pi()));
+      dist[k] = TMath::Sqrt(p * p + deta[k] * deta[k]);
+    }
+
+    for (Int_t k = 0; k < nCand; k++) {
+      if (dist[k] <= maxDist) AddPair(i1, fCandidates[k], dist[k], dist[k]);
+    }
+  }
+
+  return GetNPairs() - nPairs;
+}
+
+//________________________________________________________________________
+void AliJetMatchingEngine::AddPair(Int_t i1, Int_t i2, Double_t d1, Double_t d2)
+{
+  // Add a candidate pair.
+
+  fPairJet1.push_back(i1);
+  fPairJet2.push_back(i2);
+  fPairDist1.push_back(d1);
+  fPairDist2.push_back(d2);
+}
+
+//________________________________________________________________________
+void AliJetMatchingEngine::AddJet2Constituent(Int_t i2, Int_t id, Double_t pt)
+{
+  // Add the next constituent of jet 2 i2. All the constituents of a jet
+  // have to be added one after the other, in the order of the jet.
+
+  const Int_t pos = (!fConstJet.empty() && fConstJet.back() == i2) ? fConstPos.back() + 1 : 0;
+
+  fConstJet.push_back(i2);
+  fConstPos.push_back(pos);
+  fConstPt.push_back(pt);
+  fIndexIds.push_back(id);
+}
+
+//________________________________________________________________________
+void AliJetMatchingEngine::BuildConstituentIndex()
+{
+  // Sort the constituents by id; has to be called after the last
+  // AddJet2Constituent() and before AddSharedConstituent().
+
+  const Int_t n = fIndexIds.size();
+
+  fIndexConst.resize(n);
+  for (Int_t i = 0; i < n; i++) fIndexConst[i] = i;
+
+  const std::vector<Int_t> &ids = fIndexIds;
+  std::stable_sort(fIndexConst.begin(), fIndexConst.end(), [&ids](Int_t a, Int_t b) { return ids[a] < ids[b]; });
+  std::sort(fIndexIds.begin(), fIndexIds.end());
+}
+
+//________________________________________________________________________
+void AliJetMatchingEngine::ResetSharedConstituents()
+{
+  // Remove the shared constituents of the previous jet 1.
+
+  fSharedConst.clear();
+  fSharedPt1.clear();
+  fSharedW2.clear();
+  fSharedOrder.clear();
+}
+
+//________________________________________________________________________
+Int_t AliJetMatchingEngine::AddSharedConstituent(Int_t id, Double_t pt1, Double_t w2)
+{
+  // Add the next constituent of the current jet 1, with pt pt1; if it is
+  // the first one sharing a jet 2 constituent, the jet 2 constituent pt
+  // is subtracted with weight w2. Returns the number of jets 2 containing
+  // the constituent.
+
+  std::pair<std::vector<Int_t>::const_iterator, std::vector<Int_t>::const_iterator> range =
+    std::equal_range(fIndexIds.begin(), fIndexIds.end(), id);
+
+  for (std::vector<Int_t>::const_iterator it = range.first; it != range.second; ++it) {
+    fSharedConst.push_back(fIndexConst[it - fIndexIds.begin()]);
+    fSharedPt1.push_back(pt1);
+    fSharedW2.push_back(w2);
+  }
+
+  return range.second - range.first;
+}
+
+//________________________________________________________________________
+void AliJetMatchingEngine::BuildSharedConstituents()
+{
+  // Group the shared constituents of the current jet 1 by jet 2 and jet 2
+  // constituent, keeping the jet 1 order; has to be called after the last
+  // AddSharedConstituent() of the jet 1.
+
+  const Int_t n = fSharedConst.size();
+
+  fSharedOrder.resize(n);
+  for (Int_t i = 0; i < n; i++) fSharedOrder[i] = i;
+
+  const std::vector<Int_t> &shared = fSharedConst;
+  const std::vector<Int_t> &jets = fConstJet;
+  const std::vector<Int_t> &pos = fConstPos;
+  std::stable_sort(fSharedOrder.begin(), fSharedOrder.end(), [&shared, &jets, &pos](Int_t a, Int_t b) {
+      const Int_t ca = shared[a], cb = shared[b];
+      if (jets[ca] != jets[cb]) return jets[ca] < jets[cb];
+      return pos[ca] < pos[cb];
+    });
+}
+
+//________________________________________________________________________
+Bool_t AliJetMatchingEngine::SubtractSharedPt(Int_t i2, Double_t &pt1, Double_t &pt2) const
+{
+  // Subtract the pt shared by the current jet 1 and jet 2 i2 from pt1 and
+  // pt2. Returns kFALSE if the jets do not share any constituent.
+
+  const std::vector<Int_t> &shared = fSharedConst;
+  const std::vector<Int_t> &jets = fConstJet;
+  std::vector<Int_t>::const_iterator it = std::lower_bound(fSharedOrder.begin(), fSharedOrder.end(), i2,
+                                                           [&shared, &jets](Int_t s, Int_t j) { return jets[shared[s]] < j; });
+
+  Bool_t found = kFALSE;
+  Int_t lastConst = -1;
+  for (; it != fSharedOrder.end() && fConstJet[fSharedConst[*it]] == i2; ++it) {
+    const Int_t c = fSharedConst[*it];
+    pt1 -= fSharedPt1[*it];
+    if (c != lastConst) {
+      pt2 -= fConstPt[c] * fSharedW2[*it];
+      lastConst = c;
+    }
+    found = kTRUE;
+  }
+
+  return found;
+}
+
+//________________________________________________________________________
+void AliJetMatchingEngine::Assign(Double_t maxDist1, Double_t maxDist2)
+{
+  // Select the matched pairs among the candidate pairs.
+
+  fMatch1.assign(GetNJets1(), -1);
+  fMatch2.assign(GetNJets2(), -1);
+
+  switch (fAssignment) {
+  case kHungarian:
+    AssignHungarian(maxDist1, maxDist2);
+    break;
+  case kGreedy:
+    AssignGreedy(maxDist1, maxDist2);
+    break;
+  case kClosestMutual:
+  default:
+    AssignClosestMutual(maxDist1, maxDist2);
+  }
+}
+
+//________________________________________________________________________
+Bool_t AliJetMatchingEngine::IsAllowed(Int_t k, Double_t maxDist1, Double_t maxDist2) const
+{
+  // Whether pair k can be matched.
+
+  return fPairDist1[k] >= 0 && fPairDist2[k] >= 0 && fPairDist1[k] <= maxDist1 && fPairDist2[k] <= maxDist2;
+}
+
+//________________________________________________________________________
+void AliJetMatchingEngine::AssignClosestMutual(Double_t maxDist1, Double_t maxDist2)
+{
+  // Match the jets which are the closest of each other.
+
+  const Int_t nPairs = GetNPairs();
+  std::vector<Int_t> closest1(GetNJets1(), -1);
+  std::vector<Int_t> closest2(GetNJets2(), -1);
+
+  for (Int_t k = 0; k < nPairs; k++) {
+    const Int_t i1 = fPairJet1[k];
+    const Int_t i2 = fPairJet2[k];
+    if (fPairDist1[k] >= 0 && (closest1[i1] < 0 || fPairDist1[k] < fPairDist1[closest1[i1]])) closest1[i1] = k;
+    if (fPairDist2[k] >= 0 && (closest2[i2] < 0 || fPairDist2[k] < fPairDist2[closest2[i2]])) closest2[i2] = k;
+  }
+
+  for (UInt_t i1 = 0; i1 < closest1.size(); i1++) {
+    const Int_t k1 = closest1[i1];
+    if (k1 < 0) continue;
+    const Int_t i2 = fPairJet2[k1];
+    const Int_t k2 = closest2[i2];
+    if (k2 < 0 || fPairJet1[k2] != Int_t(i1)) continue;
+    if (fPairDist1[k1] > maxDist1 || fPairDist2[k2] > maxDist2) continue;
+
+    fMatch1[i1] = k1;
+    fMatch2[i2] = k2;
+  }
+}
+
+//________________________________________________________________________
+void AliJetMatchingEngine::AssignGreedy(Double_t maxDist1, Double_t maxDist2)
+{
+  // Match the pairs in order of increasing d1 + d2.
+
+  std::vector<Int_t> pairs;
+  for (Int_t k = 0; k < GetNPairs(); k++) {
+    if (IsAllowed(k, maxDist1, maxDist2)) pairs.push_back(k);
+  }
+
+  const std::vector<Double_t> &d1 = fPairDist1;
+  const std::vector<Double_t> &d2 = fPairDist2;
+  std::stable_sort(pairs.begin(), pairs.end(), [&d1, &d2](Int_t a, Int_t b) { return d1[a] + d2[a] < d1[b] + d2[b]; });
+
+  for (UInt_t p = 0; p < pairs.size(); p++) {
+    const Int_t k = pairs[p];
+    if (fMatch1[fPairJet1[k]] >= 0 || fMatch2[fPairJet2[k]] >= 0) continue;
+    fMatch1[fPairJet1[k]] = k;
+    fMatch2[fPairJet2[k]] = k;
+  }
+}
+
+//________________________________________________________________________
+void AliJetMatchingEngine::AssignHungarian(Double_t maxDist1, Double_t maxDist2)
+{
+  // Match the largest number of pairs with the minimum sum of d1 + d2
+  // (Hungarian algorithm with potentials, O(n^2 m) for n <= m jets).
+  // Only the jets with at least one allowed pair enter the cost matrix;
+  // the pairs which are not allowed get a cost larger than the sum of all
+  // the allowed ones, so that they are only used when no other choice is
+  // left, and are then dropped.
+
+  const Int_t nPairs = GetNPairs();
+  std::vector<Int_t> row1(GetNJets1(), -1);
+  std::vector<Int_t> col2(GetNJets2(), -1);
+  std::vector<Int_t> jets1, jets2;
+  Double_t sumCost = 0;
+
+  for (Int_t k = 0; k < nPairs; k++) {
+    if (!IsAllowed(k, maxDist1, maxDist2)) continue;
+    if (row1[fPairJet1[k]] < 0) {
+      row1[fPairJet1[k]] = jets1.size();
+      jets1.push_back(fPairJet1[k]);
+    }
+    if (col2[fPairJet2[k]] < 0) {
+      col2[fPairJet2[k]] = jets2.size();
+      jets2.push_back(fPairJet2[k]);
+    }
+    sumCost += fPairDist1[k] + fPairDist2[k];
+  }
+
+  // the rows must not be more than the columns
+  const Bool_t transposed = jets1.size() > jets2.size();
+  const Int_t n = transposed ? jets2.size() : jets1.size();
+  const Int_t m = transposed ? jets1.size() : jets2.size();
+  if (n == 0) return;
+
+  const Double_t forbidden = sumCost + 1;
+  std::vector<Double_t> cost(n * m, forbidden);
+  std::vector<Int_t> pairOf(n * m, -1);
+  for (Int_t k = 0; k < nPairs; k++) {
+    if (!IsAllowed(k, maxDist1, maxDist2)) continue;
+    const Int_t r = transposed ? col2[fPairJet2[k]] : row1[fPairJet1[k]];
+    const Int_t c = transposed ? row1[fPairJet1[k]] : col2[fPairJet2[k]];
+    const Double_t d = fPairDist1[k] + fPairDist2[k];
+    if (pairOf[r * m + c] < 0 || d < cost[r * m + c]) {
+      cost[r * m + c] = d;
+      pairOf[r * m + c] = k;
+    }
+  }
+
+  // u, v: potentials of rows and columns; p[j]: row assigned to column j (1-based, 0 = none)
+  std::vector<Double_t> u(n + 1, 0), v(m + 1, 0), minv(m + 1);
+  std::vector<Int_t> p(m + 1, 0), way(m + 1, 0);
+  std::vector<Bool_t> used(m + 1);
+  for (Int_t i = 1; i <= n; i++) {
+    p[0] = i;
+    Int_t j0 = 0;
+    minv.assign(m + 1, TMath::Infinity());
+    used.assign(m + 1, kFALSE);
+    do {
+      used[j0] = kTRUE;
+      const Int_t i0 = p[j0];
+      Double_t delta = TMath::Infinity();
+      Int_t j1 = 0;
+      for (Int_t j = 1; j <= m; j++) {
+        if (used[j]) continue;
+        const Double_t cur = cost[(i0 - 1) * m + j - 1] - u[i0] - v[j];
+        if (cur < minv[j]) {
+          minv[j] = cur;
+          way[j] = j0;
+        }
+        if (minv[j] < delta) {
+          delta = minv[j];
+          j1 = j;
+        }
+      }
+      for (Int_t j = 0; j <= m; j++) {
+        if (used[j]) {
+          u[p[j]] += delta;
+          v[j] -= delta;
+        }
+        else {
+          minv[j] -= delta;
+        }
+      }
+      j0 = j1;
+    } while (p[j0] != 0);
+    do {
+      const Int_t j1 = way[j0];
+      p[j0] = p[j1];
+      j0 = j1;
+    } while (j0 != 0);
+  }
+
+  for (Int_t j = 1; j <= m; j++) {
+    if (p[j] == 0) continue;
+    const Int_t k = pairOf[(p[j] - 1) * m + j - 1];
+    if (k < 0) continue;
+    fMatch1[fPairJet1[k]] = k;
+    fMatch2[fPairJet2[k]] = k;
+  }
+}
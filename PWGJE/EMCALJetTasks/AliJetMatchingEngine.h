@@ -0,0 +1,96 @@
+#ifndef ALIJETMATCHINGENGINE_H
+#define ALIJETMATCHINGENGINE_H
+
+// $Id$
+
+#include <vector>
+
+#include <TObject.h>
+
+#include "AliEmcalEtaPhiGrid.h"
+
+class AliJetMatchingEngine : public TObject {
+ public:
+  enum EAssignment {
+    kClosestMutual = 0,   // jets matched if each one is the closest of the other
+    kHungarian     = 1,   // maximum number of matches with the minimum total distance
+    kGreedy        = 2    // pairs taken in order of increasing distance (largest shared pt first)
+  };
+
+  AliJetMatchingEngine();
+  virtual ~AliJetMatchingEngine() {}
+
+  void                   SetAssignment(EAssignment a)                          { fAssignment = a                         ; }
+  EAssignment            GetAssignment()                                 const { return fAssignment                      ; }
+
+  void                   Reset(Int_t n1, Int_t n2);
+  void                   SetJet1(Int_t i, Double_t eta, Double_t phi, Bool_t use=kTRUE);
+  void                   SetJet2(Int_t i, Double_t eta, Double_t phi);
+  Bool_t                 IsJet1Used(Int_t i)                             const { return fUse1[i]                         ; }
+
+  Int_t                  FindGeometricalPairs(Double_t maxDist);
+  void                   AddPair(Int_t i1, Int_t i2, Double_t d1, Double_t d2);
+
+  void                   AddJet2Constituent(Int_t i2, Int_t id, Double_t pt);
+  void                   BuildConstituentIndex();
+  void                   ResetSharedConstituents();
+  Int_t                  AddSharedConstituent(Int_t id, Double_t pt1, Double_t w2);
+  void                   BuildSharedConstituents();
+  Bool_t                 SubtractSharedPt(Int_t i2, Double_t &pt1, Double_t &pt2) const;
+
+  void                   Assign(Double_t maxDist1, Double_t maxDist2);
+
+  Int_t                  GetNJets1()                                     const { return fEta1.size()                     ; }
+  Int_t                  GetNJets2()                                     const { return fEta2.size()                     ; }
+  Int_t                  GetNPairs()                                     const { return fPairJet1.size()                 ; }
+  Int_t                  GetPairJet1(Int_t k)                            const { return fPairJet1[k]                     ; }
+  Int_t                  GetPairJet2(Int_t k)                            const { return fPairJet2[k]                     ; }
+  Double_t               GetPairDistance1(Int_t k)                       const { return fPairDist1[k]                    ; }
+  Double_t               GetPairDistance2(Int_t k)                       const { return fPairDist2[k]                    ; }
+  Int_t                  GetMatchedPair1(Int_t i1)                       const { return fMatch1[i1]                      ; }
+  Int_t                  GetMatchedPair2(Int_t i2)                       const { return fMatch2[i2]                      ; }
+
+ protected:
+  Bool_t                 IsAllowed(Int_t k, Double_t maxDist1, Double_t maxDist2) const;
+  void                   AssignClosestMutual(Double_t maxDist1, Double_t maxDist2);
+  void                   AssignGreedy(Double_t maxDist1, Double_t maxDist2);
+  void                   AssignHungarian(Double_t maxDist1, Double_t maxDist2);
+
+  EAssignment            fAssignment;                    // assignment of the pairs
+
+  AliEmcalEtaPhiGrid     fGrid;                          //!grid of the jets 2 for the geometrical candidates
+  std::vector<Double_t>  fEta1;                          //!eta of the jets 1
+  std::vector<Double_t>  fPhi1;                          //!phi of the jets 1
+  std::vector<Bool_t>    fUse1;                          //!jets 1 to be matched
+  std::vector<Double_t>  fEta2;                          //!eta of the jets 2
+  std::vector<Double_t>  fPhi2;                          //!phi of the jets 2
+  std::vector<Int_t>     fCandidates;                    //!geometrical candidates of a jet 1
+  std::vector<Double_t>  fCandDEta;                      //!eta difference to the candidates
+  std::vector<Double_t>  fCandDPhi;                      //!phi difference to the candidates
+  std::vector<Double_t>  fCandDist;                      //!distance to the candidates
+
+  std::vector<Int_t>     fPairJet1;                      //!jet 1 of the pairs
+  std::vector<Int_t>     fPairJet2;                      //!jet 2 of the pairs
+  std::vector<Double_t>  fPairDist1;                     //!distance of the pairs seen from jet 1
+  std::vector<Double_t>  fPairDist2;                     //!distance of the pairs seen from jet 2
+  std::vector<Int_t>     fMatch1;                        //!matched pair of the jets 1 (-1 if none)
+  std::vector<Int_t>     fMatch2;                        //!matched pair of the jets 2 (-1 if none)
+
+  std::vector<Int_t>     fConstJet;                      //!jet 2 of the constituents, in the order they were added
+  std::vector<Int_t>     fConstPos;                      //!position of the constituents in their jet 2
+  std::vector<Double_t>  fConstPt;                       //!pt of the constituents
+  std::vector<Int_t>     fIndexIds;                      //!constituent ids, sorted
+  std::vector<Int_t>     fIndexConst;                    //!constituent with the id in fIndexIds
+
+  std::vector<Int_t>     fSharedConst;                   //!jet 2 constituent of the shared constituents of a jet 1
+  std::vector<Double_t>  fSharedPt1;                     //!pt of the shared constituents in jet 1
+  std::vector<Double_t>  fSharedW2;                      //!weight of the jet 2 constituent pt
+  std::vector<Int_t>     fSharedOrder;                   //!shared constituents sorted by jet 2 and position
+
+ private:
+  AliJetMatchingEngine(const AliJetMatchingEngine&);             // not implemented
+  AliJetMatchingEngine& operator=(const AliJetMatchingEngine&);  // not implemented
+
+  ClassDef(AliJetMatchingEngine, 1); // Matching of two jet collections
+};
+#endif
@@ -46,6 +46,8 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
   fMinJetMCPt(1),
+  fUseMatchingEngine(kFALSE),
+  fMatchingEngine(),
   fEmbeddingQA(),
   fHistoType(0),
   fDeltaPtAxis(0),
@@ -61,6 +63,8 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fJetRelativeEPAngle(0),
   fIsJet1Rho(kFALSE),
   fIsJet2Rho(kFALSE),
+  fEngineJets1(),
+  fEngineJets2(),
   fHistRejectionReason1(0),
   fHistRejectionReason2(0),
   fHistJets1(0),
@@ -135,6 +139,8 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
   fMinJetMCPt(1),
+  fUseMatchingEngine(kFALSE),
+  fMatchingEngine(),
   fEmbeddingQA(),
   fHistoType(0),
   fDeltaPtAxis(0),
@@ -150,6 +156,8 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fJetRelativeEPAngle(0),
   fIsJet1Rho(kFALSE),
   fIsJet2Rho(kFALSE),
+  fEngineJets1(),
+  fEngineJets2(),
   fHistRejectionReason1(0),
   fHistRejectionReason2(0),
   fHistJets1(0),
@@ -1389,6 +1397,8 @@ Bool_t AliJetResponseMaker::DoJetMatching()
     fEmbeddingQA.RecordEmbeddedEventProperties();
   }
 
+  if (fUseMatchingEngine) return DoJetMatchingWithEngine();
+
   DoJetLoop();
 
   AliEmcalJet* jet1 = 0;
@@ -1442,6 +1452,279 @@ void AliJetResponseMaker::DoJetLoop()
   } // jet1 loop
 }
 
+//________________________________________________________________________
+Bool_t AliJetResponseMaker::DoJetMatchingWithEngine()
+{
+  // Jet matching with the matching engine: the geometrical candidates are
+  // looked up in an eta-phi grid (only the pairs within the matching
+  // distance are considered), the MC label matching levels are obtained
+  // from a label -> particle level jet index built once per event, and the
+  // matches are selected with the assignment of the engine.
+  // With the closest-mutual assignment the matches are the same as with
+  // DoJetLoop(); the closest jets of the unmatched jets are only searched
+  // among the candidate pairs. A matched jet which is not the closest
+  // one is stored as the second closest jet.
+
+  AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  AliEmcalJet* jet1 = 0;
+  AliEmcalJet* jet2 = 0;
+
+  fEngineJets1.clear();
+  fEngineJets2.clear();
+
+  jets2->ResetCurrentID();
+  while ((jet2 = jets2->GetNextJet())) {
+    jet2->ResetMatching();
+    fEngineJets2.push_back(jet2);
+  }
+
+  jets1->ResetCurrentID();
+  while ((jet1 = jets1->GetNextJet())) {
+    jet1->ResetMatching();
+    fEngineJets1.push_back(jet1);
+  }
+
+  const Int_t nJets1 = fEngineJets1.size();
+  const Int_t nJets2 = fEngineJets2.size();
+
+  fMatchingEngine.Reset(nJets1, nJets2);
+  for (Int_t i1 = 0; i1 < nJets1; i1++) {
+    jet1 = fEngineJets1[i1];
+    fMatchingEngine.SetJet1(i1, jet1->Eta(), jet1->Phi(), jet1->MCPt() >= fMinJetMCPt);
+  }
+  for (Int_t i2 = 0; i2 < nJets2; i2++) {
+    jet2 = fEngineJets2[i2];
+    fMatchingEngine.SetJet2(i2, jet2->Eta(), jet2->Phi());
+  }
+
+  switch (fMatching) {
+  case kGeometrical:
+    // a pair further away than the smaller matching parameter is never matched
+    fMatchingEngine.FindGeometricalPairs(TMath::Min(fMatchingPar1, fMatchingPar2));
+    break;
+  case kMCLabel:
+    FindMCLabelPairs();
+    break;
+  default:
+    for (Int_t i1 = 0; i1 < nJets1; i1++) {
+      if (!fMatchingEngine.IsJet1Used(i1)) continue;
+      for (Int_t i2 = 0; i2 < nJets2; i2++) {
+        Double_t d1 = -1;
+        Double_t d2 = -1;
+        if (fMatching == kSameCollections) GetSameCollectionsMatchingLevel(fEngineJets1[i1], fEngineJets2[i2], d1, d2);
+        fMatchingEngine.AddPair(i1, i2, d1, d2);
+      }
+    }
+  }
+
+  const Int_t nPairs = fMatchingEngine.GetNPairs();
+  for (Int_t k = 0; k < nPairs; k++) {
+    SetMatchingLevel(fEngineJets1[fMatchingEngine.GetPairJet1(k)], fEngineJets2[fMatchingEngine.GetPairJet2(k)],
+                     fMatchingEngine.GetPairDistance1(k), fMatchingEngine.GetPairDistance2(k));
+  }
+
+  fMatchingEngine.Assign(fMatchingPar1, fMatchingPar2);
+
+  for (Int_t i1 = 0; i1 < nJets1; i1++) {
+    const Int_t k = fMatchingEngine.GetMatchedPair1(i1);
+    if (k < 0) continue;
+
+    jet1 = fEngineJets1[i1];
+    jet2 = fEngineJets2[fMatchingEngine.GetPairJet2(k)];
+
+    // Matched jet found
+    SetMatchedJet(jet1, jet2, fMatchingEngine.GetPairDistance1(k));
+    SetMatchedJet(jet2, jet1, fMatchingEngine.GetPairDistance2(k));
+    AliDebug(2,Form("Found matching: jet1 pt = %f, eta = %f, phi = %f, jet2 pt = %f, eta = %f, phi = %f", 
+        jet1->Pt(), jet1->Eta(), jet1->Phi(),
+        jet2->Pt(), jet2->Eta(), jet2->Phi()));
+  }
+
+  return kTRUE;
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::FindMCLabelPairs()
+{
+  // Add the pairs with the MC label matching levels, jet1 = detector level and jet2 = particle level.
+  // Same matching levels as GetMCLabelMatchingLevel(), but the particle level jets sharing
+  // a constituent with the detector level jet are looked up in the constituent index.
+
+  AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  // tracks1 just serves as a proxy to ensure that tracks are in jets1
+  AliParticleContainer *tracks1   = jets1->GetParticleContainer();
+  // tracks2 is used to retrieve MC labels associated with tracks in the container
+  AliParticleContainer *tracks2   = jets2->GetParticleContainer();
+
+  const Int_t nJets1 = fEngineJets1.size();
+  const Int_t nJets2 = fEngineJets2.size();
+
+  // particle index -> particle level jets, built once per event
+  for (Int_t i2 = 0; i2 < nJets2; i2++) {
+    AliEmcalJet *jet2 = fEngineJets2[i2];
+    for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks(); iTrack2++) {
+      AliVParticle *MCpart = jet2->Track(iTrack2);
+      fMatchingEngine.AddJet2Constituent(i2, jet2->TrackAt(iTrack2), MCpart ? MCpart->Pt() : 0);
+    }
+  }
+  fMatchingEngine.BuildConstituentIndex();
+
+  for (Int_t i1 = 0; i1 < nJets1; i1++) {
+    if (!fMatchingEngine.IsJet1Used(i1)) continue;
+
+    AliEmcalJet *jet1 = fEngineJets1[i1];
+
+    // the total pt of the reconstructed jet is cleaned from the background (label == 0)
+    Double_t totalPt1 = jet1->Pt();
+    fMatchingEngine.ResetSharedConstituents();
+
+    if (tracks1 && tracks1->GetArray()) {
+      for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
+        AliVParticle *track = jet1->Track(iTrack);
+        if (!track) {
+          AliWarning(Form("Could not find track %d!", iTrack));
+          continue;
+        }
+
+        Int_t MClabel = TMath::Abs(track->GetLabel());
+        MClabel -= fMCLabelShift;
+        if (MClabel == 0) totalPt1 -= track->Pt();
+      }
+    }
+
+    if (fUseCellsToMatch && fCaloCells) {
+      for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
+        AliVCluster *clus = jet1->Cluster(iClus);
+        if (!clus) {
+          AliWarning(Form("Could not find cluster %d!", iClus));
+          continue;
+        }
+        AliTLorentzVector part;
+        clus->GetMomentum(part, fVertex);
+
+        for (Int_t iCell = 0; iCell < clus->GetNCells(); iCell++) {
+          Int_t MClabel = TMath::Abs(fCaloCells->GetCellMCLabel(clus->GetCellAbsId(iCell)));
+          MClabel -= fMCLabelShift;
+          if (MClabel == 0) totalPt1 -= part.Pt() * clus->GetCellAmplitudeFraction(iCell);
+        }
+      }
+    }
+    else {
+      for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
+        AliVCluster *clus = jet1->Cluster(iClus);
+        if (!clus) {
+          AliWarning(Form("Could not find cluster %d!", iClus));
+          continue;
+        }
+        TLorentzVector part;
+        clus->GetMomentum(part, fVertex);
+
+        Int_t MClabel = TMath::Abs(clus->GetLabel());
+        MClabel -= fMCLabelShift;
+        if (MClabel == 0) totalPt1 -= part.Pt();
+      }
+    }
+
+    // shared constituents: tracks first, then clusters (or cells), as in GetMCLabelMatchingLevel()
+    for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
+      AliVParticle *track = jet1->Track(iTrack);
+      if (!track) continue;
+
+      Int_t MClabel = TMath::Abs(track->GetLabel());
+      MClabel -= fMCLabelShift;
+      if (MClabel <= 0) continue;
+
+      Int_t index = tracks2->GetIndexFromLabel(MClabel);
+      if (index < 0) {
+        AliDebug(2,Form("Track %d (pT = %f) does not have an associated MC particle (MClabel = %d)!",iTrack,track->Pt(),MClabel));
+        continue;
+      }
+
+      fMatchingEngine.AddSharedConstituent(index, track->Pt(), 1.);
+    }
+
+    for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
+      AliVCluster *clus = jet1->Cluster(iClus);
+      if (!clus) continue;
+
+      AliTLorentzVector part;
+      clus->GetMomentum(part, fVertex);
+
+      if (fUseCellsToMatch && fCaloCells) {
+        for (Int_t iCell = 0; iCell < clus->GetNCells(); iCell++) {
+          Double_t cellFrac = clus->GetCellAmplitudeFraction(iCell);
+
+          Int_t MClabel = TMath::Abs(fCaloCells->GetCellMCLabel(clus->GetCellAbsId(iCell)));
+          MClabel -= fMCLabelShift;
+          if (MClabel <= 0) continue;
+
+          Int_t index = tracks2->GetIndexFromLabel(MClabel);
+          if (index < 0) continue;
+
+          fMatchingEngine.AddSharedConstituent(index, part.Pt() * cellFrac, cellFrac);
+        }
+      }
+      else {
+        Int_t MClabel = TMath::Abs(clus->GetLabel());
+        MClabel -= fMCLabelShift;
+        if (MClabel <= 0) continue;
+
+        Int_t index = tracks2->GetIndexFromLabel(MClabel);
+        if (index < 0) continue;
+
+        fMatchingEngine.AddSharedConstituent(index, part.Pt(), 1.);
+      }
+    }
+
+    fMatchingEngine.BuildSharedConstituents();
+
+    for (Int_t i2 = 0; i2 < nJets2; i2++) {
+      AliEmcalJet *jet2 = fEngineJets2[i2];
+
+      // d1 and d2 represent the matching level: 0 = maximum level of matching, 1 = the two jets are completely unrelated
+      Double_t d1 = totalPt1;
+      Double_t d2 = jet2->Pt();
+      fMatchingEngine.SubtractSharedPt(i2, d1, d2);
+
+      if (d1 < 0)
+        d1 = 0;
+
+      if (d2 < 0)
+        d2 = 0;
+
+      if (totalPt1 < 1)
+        d1 = -1;
+      else
+        d1 /= totalPt1;
+
+      if (jet2->Pt() < 1)
+        d2 = -1;
+      else
+        d2 /= jet2->Pt();
+
+      fMatchingEngine.AddPair(i1, i2, d1, d2);
+    }
+  }
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::SetMatchedJet(AliEmcalJet *jet, AliEmcalJet *matched, Double_t d)
+{
+  // Set the matched jet, which is stored as second closest jet if it is not the closest one.
+
+  if (jet->ClosestJet() == matched) {
+    jet->SetMatchedToClosest(fMatching);
+  }
+  else {
+    if (jet->SecondClosestJet() != matched) jet->SetSecondClosestJet(matched, d);
+    jet->SetMatchedToSecondClosest(fMatching);
+  }
+}
+
 //________________________________________________________________________
 void AliJetResponseMaker::GetGeometricalMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d) const
 {
@@ -1886,6 +2169,14 @@ void AliJetResponseMaker::SetMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2,
     ;
   }
 
+  SetMatchingLevel(jet1, jet2, d1, d2);
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::SetMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t d1, Double_t d2)
+{
+  // Update the closest jets with the matching levels d1 and d2 (negative = no update).
+
   if (d1 >= 0) {
 
     if (d1 < jet1->ClosestJetDistance()) {
@@ -1949,13 +2240,13 @@ Bool_t AliJetResponseMaker::FillHistograms()
       else if (jets1->GetIsParticleLevel() == jets2->GetIsParticleLevel())
         GetSameCollectionsMatchingLevel(jet1, jet2, ce1, ce2);
 
-      d = jet2->ClosestJetDistance();
+      d = jet2->MatchedJetDistance();
     }
     else if (jet2->GetMatchingType() == kMCLabel || jet2->GetMatchingType() == kSameCollections) {
       GetGeometricalMatchingLevel(jet1, jet2, d);
 
-      ce1 = jet1->ClosestJetDistance();
-      ce2 = jet2->ClosestJetDistance();
+      ce1 = jet1->MatchedJetDistance();
+      ce2 = jet2->MatchedJetDistance();
     }
 
     FillMatchingHistos(jet1, jet2, d, ce1, ce2);
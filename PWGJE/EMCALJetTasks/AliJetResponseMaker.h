@@ -24,9 +24,12 @@ class TH2;
 class THnSparse;
 class AliNamedArrayI;
 
+#include <vector>
+
 #include "AliEmcalJet.h"
 #include "AliAnalysisTaskEmcalJet.h"
 #include "AliEmcalEmbeddingQA.h"
+#include "AliJetMatchingEngine.h"
 
 class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
  public:
@@ -44,6 +47,8 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   void                        UserCreateOutputObjects();
 
   void                        SetMatching(MatchingType t, Double_t p1=1, Double_t p2=1)       { fMatching = t; fMatchingPar1 = p1; fMatchingPar2 = p2; }
+  void                        SetUseMatchingEngine(Bool_t b, AliJetMatchingEngine::EAssignment a=AliJetMatchingEngine::kClosestMutual)
+                                                                                              { fUseMatchingEngine = b; fMatchingEngine.SetAssignment(a); }
   void                        SetPtHardBin(Int_t b)                                           { fSelectPtHardBin   = b         ; }
   void                        SetUseCellsToMatch(Bool_t i)                                    { fUseCellsToMatch   = i         ; }
   void                        SetMinJetMCPt(Float_t pt)                                       { fMinJetMCPt        = pt        ; }
@@ -66,7 +71,11 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   Bool_t                      FillHistograms();
   Bool_t                      Run();
   Bool_t                      DoJetMatching();
+  Bool_t                      DoJetMatchingWithEngine();
+  void                        FindMCLabelPairs();
+  void                        SetMatchedJet(AliEmcalJet *jet, AliEmcalJet *matched, Double_t d);
   void                        SetMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, MatchingType matching);
+  void                        SetMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t d1, Double_t d2);
   void                        GetGeometricalMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d) const;
   void                        GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const;
   void                        GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const;
@@ -81,6 +90,8 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   Double_t                    fMatchingPar2;                           // matching parameter for jet2-jet1 matching
   Bool_t                      fUseCellsToMatch;                        // use cells instead of clusters to match jets (slower but sometimes needed)
   Double_t                    fMinJetMCPt;                             // minimum jet MC pt
+  Bool_t                      fUseMatchingEngine;                      // use the matching engine (spatial index, label index, configurable assignment)
+  AliJetMatchingEngine        fMatchingEngine;                         // matching engine
   AliEmcalEmbeddingQA         fEmbeddingQA;                            //!<! Embedding QA hists (will only be added if embedding)
   Int_t                       fHistoType;                              // histogram type (0=TH2, 1=THnSparse)
   Int_t                       fDeltaPtAxis;                            // add delta pt axis in THnSparse (default=0)
@@ -98,6 +109,9 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   Bool_t                      fIsJet1Rho;                              //!whether the jet1 collection has to be average subtracted
   Bool_t                      fIsJet2Rho;                              //!whether the jet2 collection has to be average subtracted
 
+  std::vector<AliEmcalJet*>   fEngineJets1;                            //!jets 1 in the order of the matching engine
+  std::vector<AliEmcalJet*>   fEngineJets2;                            //!jets 2 in the order of the matching engine
+
   TH2                        *fHistRejectionReason1;                   //!Rejection reason vs. jet pt
   TH2                        *fHistRejectionReason2;                   //!Rejection reason vs. jet pt
 
@@ -174,6 +188,6 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   AliJetResponseMaker(const AliJetResponseMaker&);            // not implemented
   AliJetResponseMaker &operator=(const AliJetResponseMaker&); // not implemented
 
-  ClassDef(AliJetResponseMaker, 29) // Jet response matrix producing task
+  ClassDef(AliJetResponseMaker, 30) // Jet response matrix producing task
 };
 #endif
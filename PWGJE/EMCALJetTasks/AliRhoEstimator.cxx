@@ -0,0 +1,345 @@
+// $Id$
+//
+// Median background estimate from a collection of (kt) jets.
+// The rho tasks fill the jets of the event with SetJet() in a single
+// loop and call Compute(), which
+// - flags the leading jets to be excluded (index mask, no copies),
+// - accumulates the occupancy correction (area of the jets above
+//   fOccupancyMinPt over the total area, as in the CMS method),
+// - computes rho = median(pt/A), rho_m = median(m_delta/A) and the
+//   widths sigma = (median - 15.87% quantile) * sqrt(<A>), with the same
+//   definitions as fastjet::ClusterSequenceArea::get_median_rho_and_sigma.
+// The median uses linear-time selection (std::nth_element) and gives the
+// same value as TMath::Median.
+//
+// An estimator with a non-empty name can be attached to the event with
+// Attach(): rho tasks configured with the same name, jet collection,
+// settings and jet acceptance (eta, phi, pt and area cuts) then reuse the
+// estimate computed by the first one in the event. Other jet container
+// cuts (NEF, leading hadron, acceptance type) are not compared: the tasks
+// sharing an estimator must use the same jet container.
+
+#include <algorithm>
+
+#include <TMath.h>
+
+#include "AliLog.h"
+#include "AliVEvent.h"
+
+#include "AliRhoEstimator.h"
+
+ClassImp(AliRhoEstimator)
+
+//________________________________________________________________________
+AliRhoEstimator::AliRhoEstimator() :
+  TNamed(),
+  fJetsName(),
+  fNExclLeadJets(0),
+  fMinPtForRho(-1),
+  fRequirePositiveArea(kFALSE),
+  fOccupancyMinPt(0.1),
+  fSignalJetsName(),
+  fComputeRhoM(kFALSE),
+  fJetEtaMin(-999),
+  fJetEtaMax(999),
+  fJetPhiMin(-999),
+  fJetPhiMax(999),
+  fJetPtMin(0),
+  fJetPtMax(1000),
+  fJetAreaMin(-1),
+  fEvent(0),
+  fRunNumber(-1),
+  fEntry(-1),
+  fComputed(kFALSE),
+  fNJets(0),
+  fNJetsUsed(0),
+  fPt(),
+  fArea(),
+  fMd(),
+  fFlags(),
+  fRhoVec(),
+  fRhoMVec(),
+  fRho(0),
+  fSigma(0),
+  fRhoM(0),
+  fSigmaM(0),
+  fOccupancy(0),
+  fMeanArea(0)
+{
+  // Default constructor.
+}
+
+//________________________________________________________________________
+AliRhoEstimator::AliRhoEstimator(const char *name, const char *jetsName) :
+  TNamed(name, jetsName),
+  fJetsName(jetsName),
+  fNExclLeadJets(0),
+  fMinPtForRho(-1),
+  fRequirePositiveArea(kFALSE),
+  fOccupancyMinPt(0.1),
+  fSignalJetsName(),
+  fComputeRhoM(kFALSE),
+  fJetEtaMin(-999),
+  fJetEtaMax(999),
+  fJetPhiMin(-999),
+  fJetPhiMax(999),
+  fJetPtMin(0),
+  fJetPtMax(1000),
+  fJetAreaMin(-1),
+  fEvent(0),
+  fRunNumber(-1),
+  fEntry(-1),
+  fComputed(kFALSE),
+  fNJets(0),
+  fNJetsUsed(0),
+  fPt(),
+  fArea(),
+  fMd(),
+  fFlags(),
+  fRhoVec(),
+  fRhoMVec(),
+  fRho(0),
+  fSigma(0),
+  fRhoM(0),
+  fSigmaM(0),
+  fOccupancy(0),
+  fMeanArea(0)
+{
+  // Standard constructor.
+}
+
+//________________________________________________________________________
+void AliRhoEstimator::SetJetAcceptance(Double_t etaMin, Double_t etaMax, Double_t phiMin, Double_t phiMax,
+                                       Double_t ptMin, Double_t ptMax, Double_t areaMin)
+{
+  // Acceptance of the jet container used to flag the accepted jets,
+  // compared by IsCompatible().
+
+  fJetEtaMin  = etaMin;
+  fJetEtaMax  = etaMax;
+  fJetPhiMin  = phiMin;
+  fJetPhiMax  = phiMax;
+  fJetPtMin   = ptMin;
+  fJetPtMax   = ptMax;
+  fJetAreaMin = areaMin;
+}
+
+//________________________________________________________________________
+void AliRhoEstimator::Reset(Int_t nJets, const AliVEvent *event, Long64_t entry)
+{
+  // Prepare for the jets of a new event.
+
+  if (nJets < 0) nJets = 0;
+  if (fFlags.GetSize() < nJets) {
+    fPt.Set(nJets);
+    fArea.Set(nJets);
+    fMd.Set(nJets);
+    fFlags.Set(nJets);
+    fRhoVec.Set(nJets);
+    fRhoMVec.Set(nJets);
+  }
+  for (Int_t i = 0; i < nJets; i++) fFlags[i] = 0;
+
+  fNJets     = nJets;
+  fNJetsUsed = 0;
+  fEvent     = event;
+  fRunNumber = event ? event->GetRunNumber() : -1;
+  fEntry     = entry;
+  fComputed  = kFALSE;
+  fRho       = 0;
+  fSigma     = 0;
+  fRhoM      = 0;
+  fSigmaM    = 0;
+  fOccupancy = 0;
+  fMeanArea  = 0;
+}
+
+//________________________________________________________________________
+Bool_t AliRhoEstimator::IsCurrent(const AliVEvent *event, Long64_t entry) const
+{
+  // Whether the estimate was computed for this event. The entry number
+  // alone is not enough: it restarts with each input tree.
+
+  if (!fComputed || !event)
+    return kFALSE;
+
+  return (fEvent == event && fEntry == entry && fRunNumber == event->GetRunNumber());
+}
+
+//________________________________________________________________________
+void AliRhoEstimator::SetJet(Int_t i, Double_t pt, Double_t area, UInt_t flags, Double_t md)
+{
+  // Fill jet i. Jets which are not filled (e.g. missing in the array) are ignored.
+
+  if (i < 0 || i >= fNJets) return;
+
+  fPt[i]    = pt;
+  fArea[i]  = area;
+  fMd[i]    = md;
+  fFlags[i] = (flags & (kAccepted | kSignalOverlap)) | kValid;
+}
+
+//________________________________________________________________________
+void AliRhoEstimator::Compute()
+{
+  // Compute rho, rho_m, their widths and the occupancy correction.
+
+  // leading jets among the accepted ones
+  Int_t maxJetIds[]   = {-1, -1};
+  Float_t maxJetPts[] = { 0,  0};
+
+  if (fNExclLeadJets > 0) {
+    for (Int_t i = 0; i < fNJets; ++i) {
+      if ((fFlags[i] & (kValid | kAccepted)) != (kValid | kAccepted))
+        continue;
+
+      if (fPt[i] > maxJetPts[0]) {
+	maxJetPts[1] = maxJetPts[0];
+	maxJetIds[1] = maxJetIds[0];
+	maxJetPts[0] = fPt[i];
+	maxJetIds[0] = i;
+      } else if (fPt[i] > maxJetPts[1]) {
+	maxJetPts[1] = fPt[i];
+	maxJetIds[1] = i;
+      }
+    }
+    if (fNExclLeadJets < 2) {
+      maxJetIds[1] = -1;
+      maxJetPts[1] = 0;
+    }
+  }
+  for (Int_t j = 0; j < 2; j++) {
+    if (maxJetIds[j] >= 0) fFlags[maxJetIds[j]] |= kExcluded;
+  }
+
+  // single pass: occupancy and inputs of the medians
+  Double_t totalArea     = 0;
+  Double_t totalAreaPhys = 0;
+  Double_t usedArea      = 0;
+  Int_t    nUsed         = 0;
+
+  for (Int_t i = 0; i < fNJets; ++i) {
+    const UInt_t flags = fFlags[i];
+    if (!(flags & kValid) || (flags & kExcluded))
+      continue;
+
+    totalArea += fArea[i];
+    if (fPt[i] > fOccupancyMinPt)
+      totalAreaPhys += fArea[i];
+
+    if (!(flags & kAccepted) || (flags & kSignalOverlap))
+      continue;
+    if (!(fPt[i] > fMinPtForRho))
+      continue;
+    if (fRequirePositiveArea && !(fArea[i] > 0))
+      continue;
+
+    fFlags[i] |= kUsed;
+    fRhoVec[nUsed] = fPt[i] / fArea[i];
+    if (fComputeRhoM)
+      fRhoMVec[nUsed] = fMd[i] / fArea[i];
+    usedArea += fArea[i];
+    ++nUsed;
+  }
+
+  fNJetsUsed = nUsed;
+  if (totalArea > 0)
+    fOccupancy = totalAreaPhys / totalArea;
+
+  if (nUsed > 0) {
+    static const Double_t kSigmaQuantile = (1.0 - 0.6827) / 2.0;
+
+    fMeanArea = usedArea / nUsed;
+    const Double_t sqrtArea = fMeanArea > 0 ? TMath::Sqrt(fMeanArea) : 0;
+
+    fRho   = Median(nUsed, fRhoVec.GetArray());
+    fSigma = (fRho - Quantile(nUsed, fRhoVec.GetArray(), kSigmaQuantile)) * sqrtArea;
+
+    if (fComputeRhoM) {
+      fRhoM   = Median(nUsed, fRhoMVec.GetArray());
+      fSigmaM = (fRhoM - Quantile(nUsed, fRhoMVec.GetArray(), kSigmaQuantile)) * sqrtArea;
+    }
+  }
+
+  fComputed = kTRUE;
+}
+
+//________________________________________________________________________
+Bool_t AliRhoEstimator::IsCompatible(const AliRhoEstimator *e) const
+{
+  // Whether e would compute the same estimate as this one.
+
+  if (!e)
+    return kFALSE;
+
+  return (fJetsName            == e->fJetsName &&
+          fSignalJetsName      == e->fSignalJetsName &&
+          fNExclLeadJets       == e->fNExclLeadJets &&
+          fMinPtForRho         == e->fMinPtForRho &&
+          fRequirePositiveArea == e->fRequirePositiveArea &&
+          fOccupancyMinPt      == e->fOccupancyMinPt &&
+          fComputeRhoM         == e->fComputeRhoM &&
+          fJetEtaMin           == e->fJetEtaMin &&
+          fJetEtaMax           == e->fJetEtaMax &&
+          fJetPhiMin           == e->fJetPhiMin &&
+          fJetPhiMax           == e->fJetPhiMax &&
+          fJetPtMin            == e->fJetPtMin &&
+          fJetPtMax            == e->fJetPtMax &&
+          fJetAreaMin          == e->fJetAreaMin);
+}
+
+//________________________________________________________________________
+AliRhoEstimator *AliRhoEstimator::Attach(AliVEvent *event, AliRhoEstimator *e)
+{
+  // Share e through the event: if a compatible estimator with the same name is
+  // already attached, e is deleted and the attached one is returned;
+  // otherwise e is attached and returned. Unnamed estimators are not shared.
+
+  if (!event || !e || e->fName.IsNull())
+    return e;
+
+  TObject *obj = event->FindListObject(e->GetName());
+  if (!obj) {
+    event->AddObject(e);
+    return e;
+  }
+
+  AliRhoEstimator *shared = dynamic_cast<AliRhoEstimator*>(obj);
+  if (shared == e)
+    return e;
+
+  if (!shared || !shared->IsCompatible(e)) {
+    AliWarningClass(Form("Object %s already attached to the event with different settings, the estimate will not be shared", e->GetName()));
+    return e;
+  }
+
+  delete e;
+  return shared;
+}
+
+//________________________________________________________________________
+Double_t AliRhoEstimator::Quantile(Int_t n, Double_t *a, Double_t q)
+{
+  // Quantile q of the n values in a, interpolated linearly between the order
+  // statistics at position (n-1)*q. Runs in linear time; a is reordered.
+
+  if (n <= 0)
+    return 0;
+
+  const Double_t pos = (n - 1) * q;
+  Int_t i = (Int_t)pos;
+  if (i < 0)
+    i = 0;
+  if (i >= n - 1) {
+    std::nth_element(a, a + n - 1, a + n);
+    return a[n - 1];
+  }
+
+  std::nth_element(a, a + i, a + n);
+  const Double_t lo = a[i];
+  if (pos == i)
+    return lo;
+
+  const Double_t hi = *std::min_element(a + i + 1, a + n);
+  return lo * (i + 1 - pos) + hi * (pos - i);
+}
@@ -0,0 +1,98 @@
+#ifndef ALIRHOESTIMATOR_H
+#define ALIRHOESTIMATOR_H
+
+// $Id$
+
+class AliVEvent;
+
+#include <TNamed.h>
+#include <TArrayD.h>
+#include <TArrayI.h>
+
+class AliRhoEstimator : public TNamed {
+ public:
+  enum EJetFlags {
+    kValid         = BIT(0),   // jet was filled for this event
+    kAccepted      = BIT(1),   // jet passes the jet container cuts
+    kSignalOverlap = BIT(2),   // jet shares constituents with a signal jet
+    kExcluded      = BIT(3),   // jet is one of the excluded leading jets (set by Compute)
+    kUsed          = BIT(4)    // jet enters the median (set by Compute)
+  };
+
+  AliRhoEstimator();
+  AliRhoEstimator(const char *name, const char *jetsName);
+  virtual ~AliRhoEstimator() {}
+
+  void                   SetExcludeLeadJets(UInt_t n)                          { fNExclLeadJets        = n       ; }
+  void                   SetMinPtForRho(Double_t pt)                           { fMinPtForRho          = pt      ; }
+  void                   SetRequirePositiveArea(Bool_t b)                      { fRequirePositiveArea  = b       ; }
+  void                   SetOccupancyMinPt(Double_t pt)                        { fOccupancyMinPt       = pt      ; }
+  void                   SetSignalJetsName(const char *name)                   { fSignalJetsName       = name    ; }
+  void                   SetComputeRhoM(Bool_t b)                              { fComputeRhoM          = b       ; }
+  void                   SetJetAcceptance(Double_t etaMin, Double_t etaMax, Double_t phiMin, Double_t phiMax,
+                                          Double_t ptMin, Double_t ptMax, Double_t areaMin);
+
+  void                   Reset(Int_t nJets, const AliVEvent *event, Long64_t entry);
+  void                   SetJet(Int_t i, Double_t pt, Double_t area, UInt_t flags, Double_t md=0);
+  void                   Compute();
+
+  Bool_t                 IsCurrent(const AliVEvent *event, Long64_t entry) const;
+  Bool_t                 IsCompatible(const AliRhoEstimator *e)          const;
+  Bool_t                 IsJetUsed(Int_t i)                              const { return (fFlags[i] & kUsed) != 0         ; }
+  Double_t               GetJetArea(Int_t i)                             const { return fArea[i]                         ; }
+  Double_t               GetJetMd(Int_t i)                               const { return fMd[i]                           ; }
+  Int_t                  GetNJets()                                      const { return fNJets                           ; }
+  Int_t                  GetNJetsUsed()                                  const { return fNJetsUsed                       ; }
+  Double_t               GetRho()                                        const { return fRho                             ; }
+  Double_t               GetSigma()                                      const { return fSigma                           ; }
+  Double_t               GetRhoM()                                       const { return fRhoM                            ; }
+  Double_t               GetSigmaM()                                     const { return fSigmaM                          ; }
+  Double_t               GetOccupancy()                                  const { return fOccupancy                       ; }
+  Double_t               GetMeanArea()                                   const { return fMeanArea                        ; }
+
+  static AliRhoEstimator *Attach(AliVEvent *event, AliRhoEstimator *e);
+  static Double_t        Quantile(Int_t n, Double_t *a, Double_t q);
+  static Double_t        Median(Int_t n, Double_t *a)                          { return Quantile(n, a, 0.5)              ; }
+
+ protected:
+  TString                fJetsName;                      // name of the jet collection
+  UInt_t                 fNExclLeadJets;                 // number of leading jets to be excluded from the median calculation
+  Double_t               fMinPtForRho;                   // jets must have pt above this value to enter the median
+  Bool_t                 fRequirePositiveArea;           // jets must have a positive area to enter the median
+  Double_t               fOccupancyMinPt;                // pt threshold for the "physical" area of the occupancy correction
+  TString                fSignalJetsName;                // name of the signal jet collection used to flag overlaps (empty if none)
+  Bool_t                 fComputeRhoM;                   // compute rho_m from the m_delta of the jets
+  Double_t               fJetEtaMin;                     // minimum eta of the accepted jets
+  Double_t               fJetEtaMax;                     // maximum eta of the accepted jets
+  Double_t               fJetPhiMin;                     // minimum phi of the accepted jets
+  Double_t               fJetPhiMax;                     // maximum phi of the accepted jets
+  Double_t               fJetPtMin;                      // minimum pt of the accepted jets
+  Double_t               fJetPtMax;                      // maximum pt of the accepted jets
+  Double_t               fJetAreaMin;                    // minimum area of the accepted jets
+
+  const AliVEvent       *fEvent;                         //!event for which the estimate was computed
+  Int_t                  fRunNumber;                     //!run number of that event
+  Long64_t               fEntry;                         //!entry for which the estimate was computed
+  Bool_t                 fComputed;                      //!estimate is up to date for fEntry
+  Int_t                  fNJets;                         //!number of jet slots in this event
+  Int_t                  fNJetsUsed;                     //!number of jets entering the median
+  TArrayD                fPt;                            //!jet pt
+  TArrayD                fArea;                          //!jet area
+  TArrayD                fMd;                            //!jet m_delta
+  TArrayI                fFlags;                         //!jet flags, see EJetFlags
+  TArrayD                fRhoVec;                        //!pt/area of the used jets (reordered by the selection)
+  TArrayD                fRhoMVec;                       //!m_delta/area of the used jets (reordered by the selection)
+  Double_t               fRho;                           //!median of pt/area
+  Double_t               fSigma;                         //!width of the pt/area distribution
+  Double_t               fRhoM;                          //!median of m_delta/area
+  Double_t               fSigmaM;                        //!width of the m_delta/area distribution
+  Double_t               fOccupancy;                     //!occupancy correction (area of jets above fOccupancyMinPt over total area)
+  Double_t               fMeanArea;                      //!mean area of the used jets
+
+ private:
+  AliRhoEstimator(const AliRhoEstimator&);             // not implemented
+  AliRhoEstimator& operator=(const AliRhoEstimator&);  // not implemented
+
+  ClassDef(AliRhoEstimator, 2); // Shared median background estimate
+};
+#endif
@@ -13,6 +13,7 @@
 #pragma link C++ class AliAnalysisTaskRhoSparse+;
 #pragma link C++ class AliAnalysisTaskRhoMassSparse+;
 #pragma link C++ class AliAnalysisTaskLocalRho+;
+#pragma link C++ class AliRhoEstimator+;
 #pragma link C++ class AliAnalysisTaskDeltaPt+;
 #pragma link C++ class AliAnalysisTaskScale+;
 #pragma link C++ class AliEmcalJetByJetCorrection+;
@@ -25,6 +26,7 @@
 #pragma link C++ class AliJetModelMergeBranches+;
 #pragma link C++ class AliJetRandomizerTask+;
 #pragma link C++ class AliJetConstituentTagCopier+;
+#pragma link C++ class AliJetMatchingEngine+;
 #pragma link C++ class AliJetResponseMaker+;
 #pragma link C++ class AliJetTriggerSelectionTask+;
 #pragma link C++ class AliAnalysisTaskEmcalJetQA+;
@@ -60,7 +60,16 @@ AliFMDDensityCalculator::AliFMDDensityCalculator()
     fDoTiming(false),
     fHTiming(0), 
     fMaxOutliers(0.05),
-    fOutlierCut(0.50)
+    fOutlierCut(0.50),
+    fNTablePoints(0),
+    fNTableMax(10),
+    fNTableMaxError(1e-4),
+    fNTableValidate(false),
+    fNTableErrors(0),
+    fNTableDiff(0),
+    fNTableNEta(0),
+    fNTableOffset(0),
+    fNTable(0)
 {
   // 
   // Constructor 
@@ -98,7 +107,16 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const char* title)
     fDoTiming(false),
     fHTiming(0), 
     fMaxOutliers(0.05),
-    fOutlierCut(0.50)
+    fOutlierCut(0.50),
+    fNTablePoints(0),
+    fNTableMax(10),
+    fNTableMaxError(1e-4),
+    fNTableValidate(false),
+    fNTableErrors(0),
+    fNTableDiff(0),
+    fNTableNEta(0),
+    fNTableOffset(0),
+    fNTable(0)
 {
   // 
   // Constructor 
@@ -134,6 +152,12 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const char* title)
   fLowCuts->SetXTitle("#eta");
   fLowCuts->SetDirectory(0);
 
+  fNTableErrors = new TH2D("nParticlesTableErrors", 
+			   "Interpolation error of N-particle tables", 
+			   1, 0, 1, 1, 0, 1);
+  fNTableErrors->SetXTitle("#eta");
+  fNTableErrors->SetDirectory(0);
+
 }
 
 //____________________________________________________________________
@@ -167,7 +191,16 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const
     fDoTiming(o.fDoTiming),
     fHTiming(o.fHTiming), 
   fMaxOutliers(o.fMaxOutliers),
-  fOutlierCut(o.fOutlierCut)
+  fOutlierCut(o.fOutlierCut),
+  fNTablePoints(o.fNTablePoints),
+  fNTableMax(o.fNTableMax),
+  fNTableMaxError(o.fNTableMaxError),
+  fNTableValidate(o.fNTableValidate),
+  fNTableErrors(o.fNTableErrors),
+  fNTableDiff(o.fNTableDiff),
+  fNTableNEta(o.fNTableNEta),
+  fNTableOffset(o.fNTableOffset),
+  fNTable(o.fNTable)
 {
   // 
   // Copy constructor 
@@ -232,6 +265,15 @@ AliFMDDensityCalculator::operator=(const AliFMDDensityCalculator& o)
   fHTiming            = o.fHTiming;
   fMaxOutliers        = o.fMaxOutliers;
   fOutlierCut         = o.fOutlierCut;
+  fNTablePoints       = o.fNTablePoints;
+  fNTableMax          = o.fNTableMax;
+  fNTableMaxError     = o.fNTableMaxError;
+  fNTableValidate     = o.fNTableValidate;
+  fNTableErrors       = o.fNTableErrors;
+  fNTableDiff         = o.fNTableDiff;
+  fNTableNEta         = o.fNTableNEta;
+  fNTableOffset       = o.fNTableOffset;
+  fNTable             = o.fNTable;
 
   fRingHistos.Delete();
   TIter    next(&o.fRingHistos);
@@ -771,6 +813,132 @@ AliFMDDensityCalculator::CacheMaxWeights(const TAxis& axis)
 
   // Cache cuts in histogram
   fCuts.FillHistogram(fLowCuts);
+
+  // Tabulate the fits 
+  CacheNParticlesTable(cor);
+}
+
+//_____________________________________________________________________
+void
+AliFMDDensityCalculator::CacheNParticlesTable(const AliFMDCorrELossFit* cor)
+{
+  // 
+  // Tabulate the weighted number of particles 
+  // (AliFMDCorrELossFit::ELossFit::EvaluateWeighted) versus signal at
+  // fNTablePoints+1 equidistant points in @f$[0,fNTableMax]@f$ for
+  // each ring and eta bin of the energy loss fits, using the same fit
+  // and maximum weight as NParticles.  
+  //
+  // The interpolation error of a table is estimated as the largest
+  // deviation from the fits half-way between the points.  Tables with
+  // an error larger than fNTableMaxError are not used. 
+  // 
+  // Parameters:
+  //    cor Energy loss fits 
+  //
+  DGUARD(fDebug, 2, "Tabulate N-particles in FMD density calculator");
+  fNTableNEta = 0;
+  fNTableOffset.Set(0);
+  fNTable.Set(0);
+  if (fNTablePoints <= 0 || fNTableMax <= 0 || !cor) return;
+
+  const TAxis& eta     = cor->GetEtaAxis();
+  Int_t        nEta    = eta.GetNbins();
+  Int_t        nPoints = fNTablePoints+1;
+  Double_t     dx      = fNTableMax / fNTablePoints;
+  fNTableErrors->SetBins(nEta, eta.GetXmin(), eta.GetXmax(), 5, .5, 5.5);
+  fNTableErrors->GetYaxis()->SetBinLabel(1, "FMD1i");
+  fNTableErrors->GetYaxis()->SetBinLabel(2, "FMD2i");
+  fNTableErrors->GetYaxis()->SetBinLabel(3, "FMD2o");
+  fNTableErrors->GetYaxis()->SetBinLabel(4, "FMD3i");
+  fNTableErrors->GetYaxis()->SetBinLabel(5, "FMD3o");
+
+  // First pass: find the bins with fits 
+  fNTableOffset.Set(5*(nEta+1));
+  fNTableOffset.Reset(-1);
+  Int_t nTables = 0;
+  for (Int_t q = 0; q < 5; q++) { 
+    UShort_t d = (q == 0 ? 1 : (q <= 2 ? 2 : 3));
+    Char_t   r = (q == 0 || q == 1 || q == 3 ? 'I' : 'O');
+    for (Int_t iEta = 1; iEta <= nEta; iEta++) { 
+      if (!cor->FindFit(d, r, iEta, -1)) continue;
+      if (GetMaxWeight(d, r, iEta-1) < 1) continue;
+      fNTableOffset[q*(nEta+1)+iEta] = nTables*nPoints;
+      nTables++;
+    }
+  }
+  fNTable.Set(nTables*nPoints);
+
+  // Second pass: evaluate the fits and estimate the errors 
+  Int_t nGood = 0;
+  for (Int_t q = 0; q < 5; q++) { 
+    UShort_t d = (q == 0 ? 1 : (q <= 2 ? 2 : 3));
+    Char_t   r = (q == 0 || q == 1 || q == 3 ? 'I' : 'O');
+    for (Int_t iEta = 1; iEta <= nEta; iEta++) { 
+      Int_t& off = fNTableOffset[q*(nEta+1)+iEta];
+      if (off < 0) continue;
+      
+      AliFMDCorrELossFit::ELossFit* fit = cor->FindFit(d, r, iEta, -1);
+      UShort_t  n = TMath::Min(fMaxParticles, 
+			       UShort_t(GetMaxWeight(d, r, iEta-1)));
+      Double_t* t = fNTable.GetArray() + off;
+      for (Int_t i = 0; i < nPoints; i++) 
+	t[i] = fit->EvaluateWeighted(i*dx, n);
+
+      Double_t err = 0;
+      for (Int_t i = 0; i < nPoints-1; i++) { 
+	Double_t exact = fit->EvaluateWeighted((i+.5)*dx, n);
+	err            = TMath::Max(err, TMath::Abs(.5*(t[i]+t[i+1])-exact));
+      }
+      fNTableErrors->SetBinContent(iEta, q+1, err);
+      if (err > fNTableMaxError) { 
+	off = -1;
+	continue;
+      }
+      nGood++;
+    }
+  }
+  fNTableNEta = nEta;
+  AliInfoF("Tabulated N-particles for %d of %d ring/eta bins with fits "
+	   "(%d points in [0,%f], max error %g)", 
+	   nGood, nTables, nPoints, fNTableMax, fNTableMaxError);
+}
+
+//_____________________________________________________________________
+Double_t
+AliFMDDensityCalculator::InterpolateNParticles(Double_t mult, 
+					       UShort_t d, 
+					       Char_t   r, 
+					       Int_t    etaBin) const
+{
+  // 
+  // Interpolate the number of particles from the table 
+  // 
+  // Parameters:
+  //    mult     Signal
+  //    d        Detector
+  //    r        Ring 
+  //    etaBin   Eta bin of the energy loss fits (1 based)
+  // 
+  // Return:
+  //    The number of particles, or negative if not tabulated 
+  //
+  if (etaBin <= 0 || etaBin > fNTableNEta) return -1;
+  Int_t q = -1;
+  switch (d) { 
+  case 1: q = 0; break;
+  case 2: q = 1 + (r == 'I' || r == 'i' ? 0 : 1); break;
+  case 3: q = 3 + (r == 'I' || r == 'i' ? 0 : 1); break;
+  }
+  if (q < 0) return -1;
+  Int_t off = fNTableOffset[q*(fNTableNEta+1)+etaBin];
+  if (off < 0) return -1;
+
+  Double_t x = mult / fNTableMax * fNTablePoints;
+  if (x < 0 || x >= fNTablePoints) return -1;
+  Int_t           i = Int_t(x);
+  const Double_t* t = fNTable.GetArray() + off;
+  return t[i] + (x - i) * (t[i+1] - t[i]);
 }
 
 //_____________________________________________________________________
@@ -864,21 +1032,32 @@ AliFMDDensityCalculator::NParticles(Float_t  mult,
   if (lowFlux) return 1;
   
   AliForwardCorrectionManager&  fcm = AliForwardCorrectionManager::Instance();
-  AliFMDCorrELossFit::ELossFit* fit = fcm.GetELossFit()->FindFit(d,r,eta, -1);
-  if (!fit) { 
-    AliWarning(Form("No energy loss fit for FMD%d%c at eta=%f qual=%d", 
-		    d, r, eta, fMinQuality));
-    return 0;
-  }
+  const AliFMDCorrELossFit*     cor = fcm.GetELossFit();
+
+  // Try the table first 
+  Double_t ret = -1;
+  if (fNTableNEta > 0) 
+    ret = InterpolateNParticles(mult, d, r, cor->FindEtaBin(eta));
+
+  if (ret < 0 || fNTableValidate) { 
+    AliFMDCorrELossFit::ELossFit* fit = cor->FindFit(d,r,eta, -1);
+    if (!fit) { 
+      AliWarning(Form("No energy loss fit for FMD%d%c at eta=%f qual=%d", 
+		      d, r, eta, fMinQuality));
+      return 0;
+    }
   
-  Int_t    m   = GetMaxWeight(d,r,eta); // fit->FindMaxWeight();
-  if (m < 1) { 
-    AliWarning(Form("No good fits for FMD%d%c at eta=%f", d, r, eta));
-    return 0;
-  }
+    Int_t    m   = GetMaxWeight(d,r,eta); // fit->FindMaxWeight();
+    if (m < 1) { 
+      AliWarning(Form("No good fits for FMD%d%c at eta=%f", d, r, eta));
+      return 0;
+    }
   
-  UShort_t n   = TMath::Min(fMaxParticles, UShort_t(m));
-  Double_t ret = fit->EvaluateWeighted(mult, n);
+    UShort_t n     = TMath::Min(fMaxParticles, UShort_t(m));
+    Double_t exact = fit->EvaluateWeighted(mult, n);
+    if (ret < 0)          ret = exact;
+    else if (fNTableDiff) fNTableDiff->Fill(ret - exact);
+  }
   
   if (fDebug > 10) {
     AliInfo(Form("FMD%d%c, eta=%7.4f, %8.5f -> %8.5f", d, r, eta, mult, ret));
@@ -1105,6 +1284,17 @@ AliFMDDensityCalculator::CreateOutputObjects(TList* dir)
   d->Add(fAccO);
   d->Add(fMaxWeights);
   d->Add(fLowCuts);
+  if (fNTablePoints > 0) d->Add(fNTableErrors);
+  if (fNTablePoints > 0 && fNTableValidate) { 
+    Double_t range = 10*fNTableMaxError;
+    fNTableDiff = new TH1D("nParticlesTableDiff", 
+			   "N-particle table - energy loss fits", 
+			   200, -range, range);
+    fNTableDiff->SetXTitle("N_{table} - N_{fits}");
+    fNTableDiff->SetFillColor(kRed+1);
+    fNTableDiff->SetDirectory(0);
+    d->Add(fNTableDiff);
+  }
 
   TParameter<int>* nFiles = new TParameter<int>("nFiles", 1);
   nFiles->SetMergeMode('+');
@@ -1120,6 +1310,7 @@ AliFMDDensityCalculator::CreateOutputObjects(TList* dir)
   d->Add(AliForwardUtil::MakeParameter("maxOutliers",  fMaxOutliers));
   d->Add(AliForwardUtil::MakeParameter("outlierCut",   fOutlierCut));
   d->Add(AliForwardUtil::MakeParameter("hitThreshold", fHitThreshold));
+  d->Add(AliForwardUtil::MakeParameter("nTablePoints", fNTablePoints));
   d->Add(nFiles);
   // d->Add(nxi);
   fCuts.Output(d,"lCuts");
@@ -1201,6 +1392,12 @@ AliFMDDensityCalculator::Print(Option_t* option) const
   PFV("Threshold(hit)",         fHitThreshold);
   PFV("Max(outliers)",          fMaxOutliers);
   PFV("Cut(outlier)",           fOutlierCut);
+  PFV("N-particle table points", fNTablePoints);
+  if (fNTablePoints > 0) {
+    PFV("N-particle table range", fNTableMax);
+    PFV("N-particle table error", fNTableMaxError);
+    PFB("N-particle table check", fNTableValidate);
+  }
   PFV("Lower cut", "");
   fCuts.Print();
 
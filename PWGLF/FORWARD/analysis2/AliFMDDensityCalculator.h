@@ -16,6 +16,7 @@
 #include <TNamed.h>
 #include <TList.h>
 #include <TArrayI.h>
+#include <TArrayD.h>
 #include <TVector3.h>
 #include "AliForwardUtil.h"
 #include "AliFMDMultCuts.h"
@@ -211,6 +212,39 @@ public:
    * @param cut Cut value 
    */
   void SetHitThreshold(Double_t cut=0.9) { fHitThreshold = cut; }
+  /** 
+   * Use a table of the weighted number of particles versus signal
+   * (see AliFMDCorrELossFit::ELossFit::EvaluateWeighted) in
+   * NParticles.  The table is made for each ring and @f$\eta@f$ bin
+   * of the energy loss fits when the fits are cached (SetupForData)
+   * and linear interpolation is used between the points.  Tables
+   * with an estimated interpolation error larger than @a maxError
+   * are not used, nor are signals above @a maxSignal.  In those
+   * cases the fits are evaluated directly.
+   * 
+   * @param nPoints   Number of intervals in @f$[0,maxSignal]@f$ (0 disables)
+   * @param maxSignal Largest tabulated signal 
+   * @param maxError  Largest allowed absolute interpolation error
+   */
+  void SetNParticlesTable(UShort_t nPoints=500, 
+			  Double_t maxSignal=10, 
+			  Double_t maxError=1e-4) 
+  { 
+    fNTablePoints   = nPoints; 
+    fNTableMax      = maxSignal; 
+    fNTableMaxError = maxError; 
+  }
+  /** 
+   * If true, also evaluate the fits when the table is used, and
+   * histogram the difference (table - exact).  The tabulated value
+   * is still returned. 
+   * 
+   * @param validate Whether to validate the table 
+   */
+  void SetValidateNParticlesTable(Bool_t validate=true) 
+  { 
+    fNTableValidate = validate; 
+  }
   /** 
    * Get the multiplicity cut.  If the user has set fMultCut (via
    * SetMultCut) then that value is used.  If not, then the lower
@@ -319,6 +353,26 @@ protected:
    * @return max weight or <= 0 in case of problems 
    */
   Int_t GetMaxWeight(UShort_t d, Char_t r, Float_t eta) const;
+  /** 
+   * Make the tables of the weighted number of particles versus
+   * signal for each ring and @f$\eta@f$ bin (see SetNParticlesTable). 
+   * Must be called after the maximum weights are cached. 
+   * 
+   * @param cor Energy loss fits 
+   */
+  void CacheNParticlesTable(const AliFMDCorrELossFit* cor);
+  /** 
+   * Interpolate the number of particles from the table 
+   * 
+   * @param mult   Signal
+   * @param d      Detector
+   * @param r      Ring 
+   * @param etaBin Bin of the energy loss fits (1 based) 
+   * 
+   * @return The number of particles, or negative if not tabulated 
+   */
+  Double_t InterpolateNParticles(Double_t mult, UShort_t d, Char_t r, 
+				 Int_t etaBin) const;
 
   /** 
    * Get the number of particles corresponding to the signal mult
@@ -504,8 +558,17 @@ protected:
   TProfile*              fHTiming;
   Double_t               fMaxOutliers; // Maximum ratio of outlier bins 
   Double_t               fOutlierCut;  // Maximum relative diviation 
+  UShort_t               fNTablePoints;   // Intervals of N-particle table
+  Double_t               fNTableMax;      // Largest signal in table
+  Double_t               fNTableMaxError; // Largest interpolation error 
+  Bool_t                 fNTableValidate; // Compare table to fits 
+  TH2D*                  fNTableErrors;   // Interpolation errors 
+  TH1D*                  fNTableDiff;     // Table - fits (validation)
+  Int_t                  fNTableNEta;     //! Eta bins of tables 
+  TArrayI                fNTableOffset;   //! Table offset per ring, eta
+  TArrayD                fNTable;         //! N-particle tables 
 
-  ClassDef(AliFMDDensityCalculator,16); // Calculate Nch density 
+  ClassDef(AliFMDDensityCalculator,17); // Calculate Nch density 
 };
 
 #endif
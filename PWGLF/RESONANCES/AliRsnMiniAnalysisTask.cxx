@@ -19,6 +19,10 @@
 #include <TList.h>
 #include <TTree.h>
 #include <TStopwatch.h>
+#include <TArrayI.h>
+#include <TArrayF.h>
+#include <TArrayL64.h>
+#include <algorithm>
 #include "TRandom.h"
 
 #include "AliLog.h"
@@ -488,6 +492,9 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    AliRsnMiniOutput *def = 0x0;
    AliRsnMiniOutput::EComputation compType;
 
+   // mixing variables of all events, cached in the single-event loop
+   TArrayF mixVz(nEvents), mixMult(nEvents), mixAngle(nEvents);
+
    Int_t printNum = fMixPrintRefresh;
    if (printNum < 0) {
       if (nEvents>1e5) printNum=nEvents/100;
@@ -503,6 +510,9 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    for (ievt = 0; ievt < nEvents; ievt++) {
       // get next entry
       fEvBuffer->GetEntry(ievt);
+      mixVz[ievt]    = fMiniEvent->Vz();
+      mixMult[ievt]  = fMiniEvent->Mult();
+      mixAngle[ievt] = fMiniEvent->Angle();
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] Std.Event %d/%d",GetName(), ievt,nEvents));
          timer.Stop(); timer.Print(); fflush(stdout); timer.Start(kFALSE);
@@ -552,66 +562,36 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
       return;
    }
 
-   // initialize mixing counter
-   Int_t    nmatched[nEvents];
-   TString *smatched = new TString[nEvents];
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      smatched[ievt] = "|";
-      nmatched[ievt] = 0;
-   }
-
-
    AliInfo(Form("[%s] Std.Event %d/%d",GetName(), nEvents,nEvents));
    timer.Stop(); timer.Print(); timer.Start(); fflush(stdout);
 
-   // search for good matchings
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      if (printNum&&(ievt%printNum==0)) {
-         AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),ievt,nEvents));
-         timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
+   // search for good matchings, using only the cached mixing variables
+   TArrayI nmatched(nEvents), nlisted(nEvents), matched(nEvents * fNMix);
+   FindMixingPartners(nEvents, mixVz.GetArray(), mixMult.GetArray(), mixAngle.GetArray(),
+                      nmatched.GetArray(), nlisted.GetArray(), matched.GetArray());
+   if (AliLog::GetDebugLevel("", ClassName()) >= 1) {
+      for (ievt = 0; ievt < nEvents; ievt++) {
+         TString smatched("|");
+         for (iloop = 0; iloop < nlisted[ievt]; iloop++) smatched.Append(Form("%d|", matched[ievt * fNMix + iloop]));
+         AliDebugClass(1, Form("Matches for event %5d = %d [%s] (missing are declared above)", ievt, nmatched[ievt], smatched.Data()));
       }
-      if (nmatched[ievt] >= fNMix) continue;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      for (iloop = 1; iloop < nEvents; iloop++) {
-         imix = ievt + iloop;
-         if (imix >= nEvents) imix -= nEvents;
-         if (imix == ievt) continue;
-         // text next entry
-         fEvBuffer->GetEntry(imix);
-         // skip if events are not matched
-         if (!EventsMatch(&evMain, fMiniEvent)) continue;
-         // check that the array of good matches for mixed does not already contain main event
-         if (smatched[imix].Contains(Form("|%d|", ievt))) continue;
-         // check that the found good events has not enough matches already
-         if (nmatched[imix] >= fNMix) continue;
-         // add new mixing candidate
-         smatched[ievt].Append(Form("%d|", imix));
-         nmatched[ievt]++;
-         nmatched[imix]++;
-         if (nmatched[ievt] >= fNMix) break;
-      }
-      AliDebugClass(1, Form("Matches for event %5d = %d [%s] (missing are declared above)", evMain.ID(), nmatched[ievt], smatched[ievt].Data()));
    }
 
    AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout); timer.Start();
 
    // perform mixing
-   TObjArray *list = 0x0;
-   TObjString *os = 0x0;
    for (ievt = 0; ievt < nEvents; ievt++) {
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] EventMixing %d/%d",GetName(),ievt,nEvents));
          timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
       }
       ifill = 0;
+      if (!nlisted[ievt]) continue;
       fEvBuffer->GetEntry(ievt);
       AliRsnMiniEvent evMain(*fMiniEvent);
-      list = smatched[ievt].Tokenize("|");
-      TObjArrayIter next(list);
-      while ( (os = (TObjString *)next()) ) {
-         imix = os->GetString().Atoi();
+      for (iloop = 0; iloop < nlisted[ievt]; iloop++) {
+         imix = matched[ievt * fNMix + iloop];
          fEvBuffer->GetEntry(imix);
          for (idef = 0; idef < nDefs; idef++) {
             def = (AliRsnMiniOutput *)fHistograms[idef];
@@ -624,11 +604,8 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
             }
          }
       }
-      delete list;
    }
 
-   delete [] smatched;
-
    AliInfo(Form("[%s] EventMixing %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout);
 
@@ -1422,13 +1399,25 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
 //
 
    if (!event1 || !event2) return kFALSE;
+   return EventsMatch(event1->Vz(), event1->Mult(), event1->Angle(),
+                      event2->Vz(), event2->Mult(), event2->Angle());
+}
+
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniAnalysisTask::EventsMatch(Float_t vz1, Float_t mult1, Float_t angle1,
+                                           Float_t vz2, Float_t mult2, Float_t angle2) const
+{
+//
+// Check if two events are compatible, given their mixing variables.
+//
+
    Int_t ivz1, ivz2, imult1, imult2, iangle1, iangle2;
    Double_t dv, dm, da;
 
    if (fContinuousMix) {
-      dv = TMath::Abs(event1->Vz()    - event2->Vz()   );
-      dm = TMath::Abs(event1->Mult()  - event2->Mult() );
-      da = TMath::Abs(event1->Angle() - event2->Angle());
+      dv = TMath::Abs(vz1    - vz2   );
+      dm = TMath::Abs(mult1  - mult2 );
+      da = TMath::Abs(angle1 - angle2);
       if (dv > fMaxDiffVz) {
          //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Vz = %f", event1->ID(), event2->ID(), dv));
          return kFALSE;
@@ -1443,12 +1432,12 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
       }
       return kTRUE;
    } else {
-      ivz1 = (Int_t)(event1->Vz() / fMaxDiffVz);
-      ivz2 = (Int_t)(event2->Vz() / fMaxDiffVz);
-      imult1 = (Int_t)(event1->Mult() / fMaxDiffMult);
-      imult2 = (Int_t)(event2->Mult() / fMaxDiffMult);
-      iangle1 = (Int_t)(event1->Angle() / fMaxDiffAngle);
-      iangle2 = (Int_t)(event2->Angle() / fMaxDiffAngle);
+      ivz1 = (Int_t)(vz1 / fMaxDiffVz);
+      ivz2 = (Int_t)(vz2 / fMaxDiffVz);
+      imult1 = (Int_t)(mult1 / fMaxDiffMult);
+      imult2 = (Int_t)(mult2 / fMaxDiffMult);
+      iangle1 = (Int_t)(angle1 / fMaxDiffAngle);
+      iangle2 = (Int_t)(angle2 / fMaxDiffAngle);
       if (ivz1 != ivz2) return kFALSE;
       if (imult1 != imult2) return kFALSE;
       if (iangle1 != iangle2) return kFALSE;
@@ -1456,6 +1445,125 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
    }
 }
 
+//__________________________________________________________________________________________________
+Long64_t AliRsnMiniAnalysisTask::MixingBinKey(Float_t vz, Float_t mult, Float_t angle,
+                                              Int_t dvz, Int_t dmult, Int_t dangle) const
+{
+//
+// Key of the mixing bin of an event, shifted by (dvz, dmult, dangle) bins.
+// Bin widths are the maximum allowed differences and bin indices are truncated
+// as in EventsMatch; they are clamped to 21 bits each, which can only merge bins.
+//
+
+   const Double_t maxBin = (1 << 20) - 2;
+   const Long64_t offset = 1 << 20;
+   Double_t q[3] = {vz / fMaxDiffVz, mult / fMaxDiffMult, angle / fMaxDiffAngle};
+   Long64_t ibin[3];
+   for (Int_t i = 0; i < 3; i++) {
+      if (!(q[i] < maxBin)) q[i] = maxBin;
+      if (q[i] < -maxBin) q[i] = -maxBin;
+      ibin[i] = (Int_t)q[i] + offset;
+   }
+   ibin[0] += dvz;
+   ibin[1] += dmult;
+   ibin[2] += dangle;
+   return (ibin[0] << 42) | (ibin[1] << 21) | ibin[2];
+}
+
+namespace {
+   // orders event indices by mixing bin key, then by index
+   struct MixingKeyLess {
+      const Long64_t *fKey;
+      MixingKeyLess(const Long64_t *key) : fKey(key) {}
+      bool operator()(Int_t i, Int_t j) const {return (fKey[i] != fKey[j]) ? (fKey[i] < fKey[j]) : (i < j);}
+   };
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniAnalysisTask::FindMixingPartners(Int_t nEvents, const Float_t *vz, const Float_t *mult, const Float_t *angle,
+                                                Int_t *nmatched, Int_t *nlisted, Int_t *matched)
+{
+//
+// Search mixing partners of all buffered events from their mixing variables.
+// Events are sorted by mixing bin (width = maximum allowed difference), so that
+// the partners of an event are in its own bin (binned mixing) or in the 3x3x3
+// neighbouring bins (continuous mixing). These bins are merged in the cyclic order
+// ievt+1, ievt+2, ... of a plain scan of the buffer, which gives the same matches.
+// Output: nmatched = number of mixings of each event, nlisted = number of partners
+// chosen by each event, stored in matched[ievt * fNMix + i].
+//
+
+   TArrayL64 key(nEvents), sortedKey(nEvents);
+   TArrayI   order(nEvents);
+   Int_t     ievt, imix, i, b;
+   for (ievt = 0; ievt < nEvents; ievt++) {
+      key[ievt] = MixingBinKey(vz[ievt], mult[ievt], angle[ievt]);
+      order[ievt] = ievt;
+      nmatched[ievt] = 0;
+      nlisted[ievt] = 0;
+   }
+   std::sort(order.GetArray(), order.GetArray() + nEvents, MixingKeyLess(key.GetArray()));
+   for (i = 0; i < nEvents; i++) sortedKey[i] = key[order[i]];
+   const Long64_t *keyBegin = sortedKey.GetArray(), *keyEnd = keyBegin + nEvents;
+   const Int_t    *ordBegin = order.GetArray();
+
+   const Int_t nNeighbours = fContinuousMix ? 1 : 0;
+   Int_t first[27], last[27], cur[27], left[27];
+
+   for (ievt = 0; ievt < nEvents; ievt++) {
+      if (nmatched[ievt] >= fNMix) continue;
+      // candidate bins, each one starting after ievt
+      Int_t nBins = 0;
+      for (Int_t dvz = -nNeighbours; dvz <= nNeighbours; dvz++) {
+         for (Int_t dmult = -nNeighbours; dmult <= nNeighbours; dmult++) {
+            for (Int_t dangle = -nNeighbours; dangle <= nNeighbours; dangle++) {
+               Long64_t k = MixingBinKey(vz[ievt], mult[ievt], angle[ievt], dvz, dmult, dangle);
+               Int_t lo = std::lower_bound(keyBegin, keyEnd, k) - keyBegin;
+               Int_t hi = std::upper_bound(keyBegin + lo, keyEnd, k) - keyBegin;
+               if (lo == hi) continue;
+               Int_t start = std::upper_bound(ordBegin + lo, ordBegin + hi, ievt) - ordBegin;
+               first[nBins] = lo;
+               last[nBins]  = hi;
+               cur[nBins]   = (start == hi) ? lo : start;
+               left[nBins]  = hi - lo;
+               nBins++;
+            }
+         }
+      }
+      // visit candidates in cyclic order
+      while (nmatched[ievt] < fNMix) {
+         Int_t best = -1, bestDist = nEvents;
+         for (b = 0; b < nBins; b++) {
+            if (!left[b]) continue;
+            Int_t dist = order[cur[b]] - ievt;
+            if (dist < 0) dist += nEvents;
+            if (dist < bestDist) {
+               bestDist = dist;
+               best = b;
+            }
+         }
+         if (best < 0) break;
+         imix = order[cur[best]];
+         left[best]--;
+         if (++cur[best] == last[best]) cur[best] = first[best];
+         if (imix == ievt) continue;
+         // skip if events are not matched
+         if (!EventsMatch(vz[ievt], mult[ievt], angle[ievt], vz[imix], mult[imix], angle[imix])) continue;
+         // check that the array of good matches for mixed does not already contain main event
+         Bool_t found = kFALSE;
+         for (i = 0; i < nlisted[imix] && !found; i++) found = (matched[imix * fNMix + i] == ievt);
+         if (found) continue;
+         // check that the found good events has not enough matches already
+         if (nmatched[imix] >= fNMix) continue;
+         // add new mixing candidate
+         matched[ievt * fNMix + nlisted[ievt]] = imix;
+         nlisted[ievt]++;
+         nmatched[ievt]++;
+         nmatched[imix]++;
+      }
+   }
+}
+
 //---------------------------------------------------------------------
 Double_t AliRsnMiniAnalysisTask::ApplyCentralityPatchPbPb2011(){
   //This part rejects randomly events such that the centrality gets flat for LHC11h Pb-Pb data
@@ -100,6 +100,10 @@ private:
    void     FillTrueMotherAOD(AliRsnMiniEvent *event);
    void     StoreTrueMother(AliRsnMiniPair *pair, AliRsnMiniEvent *event);
    Bool_t   EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2);
+   Bool_t   EventsMatch(Float_t vz1, Float_t mult1, Float_t angle1, Float_t vz2, Float_t mult2, Float_t angle2) const;
+   Long64_t MixingBinKey(Float_t vz, Float_t mult, Float_t angle, Int_t dvz = 0, Int_t dmult = 0, Int_t dangle = 0) const;
+   void     FindMixingPartners(Int_t nEvents, const Float_t *vz, const Float_t *mult, const Float_t *angle,
+                               Int_t *nmatched, Int_t *nlisted, Int_t *matched);
    AliQnCorrectionsQnVector * GetQnVectorFromList(const TList *list,
                                                         const char *subdetector,
                                                         const char *expectedstep) const;